@@ -0,0 +1,64 @@
+//
+//  SLElementVisibilityBenchmarkTest.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLIntegrationTest.h"
+
+/**
+ Benchmarks the renderer used by `-[SLElement isVisible]` against the renderer
+ used through v1.1, using hierarchies which are deep and which are wide.
+ */
+@interface SLElementVisibilityBenchmarkTest : SLIntegrationTest
+@end
+
+@implementation SLElementVisibilityBenchmarkTest
+
++ (NSString *)testCaseViewControllerClassName {
+    return @"SLElementVisibilityBenchmarkTestViewController";
+}
+
+- (void)compareRenderingTimesOfHierarchyWithDescription:(NSString *)description {
+    static const NSUInteger kIterations = 50;
+    NSDictionary *renderingTimes = SLAskApp1(renderingTimesForIterations:, @(kIterations));
+    NSTimeInterval legacyDuration = [renderingTimes[@"legacy"] doubleValue];
+    NSTimeInterval currentDuration = [renderingTimes[@"current"] doubleValue];
+
+    const BOOL currentIsFaster = (currentDuration <= legacyDuration);
+    SLLog(@"Rendering a %@ hierarchy %lu times took %g s (vs. %g s rendering each view's layer tree): %.1fx %@.",
+          description, (unsigned long)kIterations, currentDuration, legacyDuration,
+          (currentIsFaster ? (legacyDuration / currentDuration) : (currentDuration / legacyDuration)),
+          (currentIsFaster ? @"faster" : @"slower"));
+
+    // allow for some variation in wall-clock times with the load on the machine
+    static const NSTimeInterval kMaxSlowdown = 1.1;
+    SLAssertTrue(currentDuration <= (legacyDuration * kMaxSlowdown),
+                 @"Rendering a %@ hierarchy should not be slower than rendering each view's layer tree.", description);
+}
+
+- (void)testRenderingDeepHierarchy {
+    [self compareRenderingTimesOfHierarchyWithDescription:@"deep"];
+}
+
+- (void)testRenderingWideHierarchy {
+    [self compareRenderingTimesOfHierarchyWithDescription:@"wide"];
+}
+
+@end
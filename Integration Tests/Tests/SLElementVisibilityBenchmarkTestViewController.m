@@ -0,0 +1,193 @@
+//
+//  SLElementVisibilityBenchmarkTestViewController.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLTestCaseViewController.h"
+
+#import <Subliminal/SLTestController+AppHooks.h>
+#import <QuartzCore/QuartzCore.h>
+
+// The benchmark calls Subliminal's renderer directly, so as to bypass the occlusion engine.
+@interface UIView (SLVisibilityBenchmark)
+- (NSUInteger)numberOfRenderedVisiblePointsFromSet:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints;
+@end
+
+
+// The renderer used by Subliminal through v1.1, which rendered each view's layer tree
+// and then recursed into the view's subviews, drawing each view once per ancestor.
+static void SLLegacyRenderViewRecursively(UIView *view, CGContextRef context, UIView *target, UIView *baseView) {
+    if (view.hidden || view.alpha < 0.01) {
+        return;
+    }
+
+    CGContextSaveGState(context);
+    if ([view clipsToBounds]) {
+        CGContextClipToRect(context, [baseView convertRect:view.bounds fromView:view]);
+    }
+
+    CGContextSaveGState(context);
+    const CGPoint viewOrigin = [baseView convertPoint:view.bounds.origin fromView:view];
+    CGContextTranslateCTM(context, viewOrigin.x, viewOrigin.y);
+    if (![view isDescendantOfView:target]) {
+        CGContextSetBlendMode(context, kCGBlendModeDestinationOut);
+        [view.layer renderInContext:context];
+    } else {
+        CGContextSetFillColor(context, (CGFloat[2]){0.0, 1.0});
+        CGContextSetBlendMode(context, kCGBlendModeCopy);
+        CGContextFillRect(context, view.bounds);
+    }
+    CGContextRestoreGState(context);
+
+    for (UIView *subview in [view subviews]) {
+        SLLegacyRenderViewRecursively(subview, context, target, baseView);
+    }
+
+    CGContextRestoreGState(context);
+}
+
+static NSUInteger SLLegacyNumberOfVisiblePoints(UIView *target, const CGPoint *testPointsInWindow, NSUInteger numPoints) {
+    int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        int x = rintf(testPointsInWindow[j].x), y = rintf(testPointsInWindow[j].y);
+        minX = MIN(minX, x); maxX = MAX(maxX, x);
+        minY = MIN(minY, y); maxY = MAX(maxY, y);
+    }
+    size_t columns = maxX - minX + 1;
+    size_t rows = maxY - minY + 1;
+    unsigned char *pixels = (unsigned char *)calloc(columns * rows * 4, 1);
+    CGColorSpaceRef rgbColorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, columns, rows, 8, 4 * columns, rgbColorSpace, kCGBitmapAlphaInfoMask & kCGImageAlphaPremultipliedLast);
+    CGColorSpaceRelease(rgbColorSpace);
+    CGContextTranslateCTM(context, -minX, -minY);
+
+    NSArray *windows = [[UIApplication sharedApplication] windows];
+    for (NSUInteger windowIndex = [windows indexOfObject:target.window]; windowIndex < [windows count]; windowIndex++) {
+        UIWindow *window = windows[windowIndex];
+        SLLegacyRenderViewRecursively(window, context, target, window);
+    }
+
+    NSUInteger count = 0;
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        NSUInteger pixelIndex = (rintf(testPointsInWindow[j].y) - minY) * columns + (rintf(testPointsInWindow[j].x) - minX);
+        if (pixels[4 * pixelIndex + 3] >= 3) count++;
+    }
+
+    CGContextRelease(context);
+    free(pixels);
+    return count;
+}
+
+
+@interface SLElementVisibilityBenchmarkTestViewController : SLTestCaseViewController
+@end
+
+@implementation SLElementVisibilityBenchmarkTestViewController {
+    UIView *_targetView;
+}
+
+- (instancetype)initWithTestCaseWithSelector:(SEL)testCase {
+    self = [super initWithTestCaseWithSelector:testCase];
+    if (self) {
+        [[SLTestController sharedTestController] registerTarget:self forAction:@selector(renderingTimesForIterations:)];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[SLTestController sharedTestController] deregisterTarget:self];
+}
+
+// Every view in the benchmark hierarchies draws content, as the occluding views
+// of a real application are likely to, so that the renderer must draw each one.
+static UILabel *SLBenchmarkLabelWithFrame(CGRect frame, NSUInteger index) {
+    UILabel *label = [[UILabel alloc] initWithFrame:frame];
+    label.backgroundColor = [UIColor colorWithWhite:1.0 alpha:0.5];
+    label.font = [UIFont systemFontOfSize:8.0];
+    label.text = [NSString stringWithFormat:@"%lu", (unsigned long)index];
+    return label;
+}
+
+- (void)loadViewForTestCase:(SEL)testCase {
+    UIView *view = [[UIView alloc] initWithFrame:self.navigationController.view.bounds];
+    view.backgroundColor = [UIColor whiteColor];
+
+    if (testCase == @selector(testRenderingDeepHierarchy)) {
+        // a chain of nested views, each inset from its parent, ending in the target
+        static const NSUInteger kDepth = 100;
+        UIView *parent = view;
+        for (NSUInteger depth = 0; depth < kDepth; depth++) {
+            UILabel *label = SLBenchmarkLabelWithFrame(CGRectInset(parent.bounds, 1.0, 1.0), depth);
+            [parent addSubview:label];
+            parent = label;
+        }
+        _targetView = [[UIView alloc] initWithFrame:CGRectInset(parent.bounds, 1.0, 1.0)];
+        [parent addSubview:_targetView];
+    } else if (testCase == @selector(testRenderingWideHierarchy)) {
+        // a small target surrounded by a grid of sibling views
+        static const NSUInteger kGridSize = 25;
+        const CGSize cellSize = CGSizeMake(CGRectGetWidth(view.bounds) / kGridSize, CGRectGetHeight(view.bounds) / kGridSize);
+        _targetView = [[UIView alloc] initWithFrame:(CGRect){ CGPointZero, cellSize }];
+        _targetView.center = CGPointMake(CGRectGetMidX(view.bounds), CGRectGetMidY(view.bounds));
+        [view addSubview:_targetView];
+        for (NSUInteger row = 0; row < kGridSize; row++) {
+            for (NSUInteger column = 0; column < kGridSize; column++) {
+                CGRect frame = (CGRect){ CGPointMake(column * cellSize.width, row * cellSize.height), cellSize };
+                if (CGRectIntersectsRect(frame, _targetView.frame)) continue;
+                [view addSubview:SLBenchmarkLabelWithFrame(frame, (row * kGridSize) + column)];
+            }
+        }
+    }
+    _targetView.backgroundColor = [UIColor blackColor];
+
+    self.view = view;
+}
+
+#pragma mark - App hooks
+
+- (NSDictionary *)renderingTimesForIterations:(NSNumber *)iterationsNumber {
+    NSUInteger iterations = [iterationsNumber unsignedIntegerValue];
+
+    // test the points that `-slAccessibilityRectIsVisible:` tests when the target's center is covered
+    const CGRect rect = [_targetView convertRect:_targetView.bounds toView:nil];
+    const CGPoint testPoints[5] = {
+        CGPointMake(CGRectGetMidX(rect), CGRectGetMidY(rect)),
+        CGPointMake(CGRectGetMinX(rect), CGRectGetMinY(rect)),
+        CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMinY(rect)),
+        CGPointMake(CGRectGetMinX(rect), CGRectGetMaxY(rect) - 1.0),
+        CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMaxY(rect) - 1.0)
+    };
+
+    NSDate *legacyStart = [NSDate date];
+    for (NSUInteger iteration = 0; iteration < iterations; iteration++) {
+        (void)SLLegacyNumberOfVisiblePoints(_targetView, testPoints, 5);
+    }
+    NSTimeInterval legacyDuration = [[NSDate date] timeIntervalSinceDate:legacyStart];
+
+    NSDate *currentStart = [NSDate date];
+    for (NSUInteger iteration = 0; iteration < iterations; iteration++) {
+        (void)[_targetView numberOfRenderedVisiblePointsFromSet:testPoints count:5];
+    }
+    NSTimeInterval currentDuration = [[NSDate date] timeIntervalSinceDate:currentStart];
+
+    return @{ @"legacy": @(legacyDuration), @"current": @(currentDuration) };
+}
+
+@end
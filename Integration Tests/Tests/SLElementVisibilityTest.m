@@ -232,6 +232,42 @@
     SLAskApp1(hideOtherViewWithTag:, @4);
 }
 
+- (void)testVisibilityOfElementsMatchesIsVisible {
+    SLElement *nonexistentElement = [SLElement elementWithAccessibilityLabel:@"nonexistent"];
+    SLAssertThrowsNamed(([SLElement visibilityOfElements:@[ _testElement, nonexistentElement ]]), SLUIAElementInvalidException,
+                        @"Should have raised an exception because one of the elements does not exist.");
+
+    NSArray *visibilities = [SLElement visibilityOfElements:@[ _testElement ]];
+    SLAssertTrue([visibilities count] == 1, @"Should have returned the visibility of each element.");
+    SLAssertTrue([visibilities[0] boolValue] == [_testElement isVisible], @"Should agree with -isVisible.");
+
+    // an element may be evaluated more than once, even when it must be rendered
+    SLAskApp1(showOtherViewWithTag:, @5);   // center hidden
+    visibilities = [SLElement visibilityOfElements:@[ _testElement, _testElement ]];
+    SLAssertTrue([visibilities[0] boolValue] && [visibilities[1] boolValue], @"Element should be visible.");
+
+    SLAskApp1(showOtherViewWithTag:, @1);   // center and upper left hidden
+    visibilities = [SLElement visibilityOfElements:@[ _testElement, _testElement ]];
+    SLAssertFalse([visibilities[0] boolValue] || [visibilities[1] boolValue], @"Element should not be visible.");
+    SLAssertTrue([visibilities[0] boolValue] == [_testElement isVisible], @"Should agree with -isVisible.");
+}
+
+- (void)testVisibleFractionMeasuresUncoveredAreaOfElement {
+    SLAssertVisibleFraction(_testElement, 1.0, @"The element should have been entirely visible.");
+
+    // the 20x20 cover obscures 4% of the 100x100 element
+    SLAskApp1(showOtherViewWithTag:, @5);   // center hidden
+    CGFloat visibleFraction = [UIAElement(_testElement) visibleFraction];
+    SLAssertTrue(fabs(visibleFraction - 0.96) < 0.005, @"96%% of the element should have been visible, but %g%% was.", visibleFraction * 100.0);
+    SLAssertVisibleFraction(_testElement, 0.95, @"The element should have been substantially visible.");
+
+    // the cover over the upper left corner overlaps a further 10x10 area of the element
+    SLAskApp1(showOtherViewWithTag:, @1);
+    visibleFraction = [UIAElement(_testElement) visibleFraction];
+    SLAssertTrue(fabs(visibleFraction - 0.95) < 0.005, @"95%% of the element should have been visible, but %g%% was.", visibleFraction * 100.0);
+    SLAssertFalse([_testElement isVisible], @"The element should not be visible, despite most of it being visible.");
+}
+
 - (void)testViewIsVisibleIfItsCenterIsCoveredByClearRegion {
     if (kCFCoreFoundationVersionNumber <= kCFCoreFoundationVersionNumber_iOS_6_1) {
         SLAssertFalse([_testElement uiaIsVisible], @"UIAutomation should say that the element is not visible (even though it is!).");
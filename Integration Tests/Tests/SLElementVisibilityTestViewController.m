@@ -206,7 +206,9 @@
         nibName = @"SLElementVisibilityTestLowAlpha";
     } else if (testCase == @selector(testViewIsNotVisibleIfItIsOffscreen)) {
         nibName = @"SLElementVisibilityTestOffscreen";
-    } else if (testCase == @selector(testViewIsNotVisibleIfCenterAndAnyCornerAreCovered)) {
+    } else if ((testCase == @selector(testViewIsNotVisibleIfCenterAndAnyCornerAreCovered)) ||
+               (testCase == @selector(testVisibilityOfElementsMatchesIsVisible)) ||
+               (testCase == @selector(testVisibleFractionMeasuresUncoveredAreaOfElement))) {
         nibName = @"SLElementVisibilityTestCovered";
     } else if (testCase == @selector(testViewIsVisibleIfItsCenterIsCoveredByClearRegion)) {
         nibName = @"SLElementVisibilityTestCoveredByClearRegion";
@@ -22,6 +22,7 @@
 
 #import "SLIntegrationTest.h"
 #import "SLUIAElement+Subclassing.h"
+#import "SLWatchdog.h"
 
 @interface SLTerminalTest : SLIntegrationTest
 @end
@@ -247,6 +248,64 @@
                         @"Should have thrown because the function was called with an argument of the wrong type.");
 }
 
+#pragma mark - Interrupted evaluation tests
+
+- (void)testEvalSucceedsAfterAnInterruptedEval {
+    // interrupt the evaluation of a script that will throw after we've moved on
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.5 name:@"interrupted eval"];
+    SLAssertThrowsNamed(([watchdog guardBlock:^{
+        [[SLTerminal sharedTerminal] eval:@"UIATarget.localTarget().delay(2.0); throw 'late exception';"];
+    }]), SLTestTimeoutException, @"The evaluation should have been interrupted.");
+
+    // `SLTerminal.js` will still be evaluating the abandoned script when we write the next
+    id result;
+    SLAssertNoThrow((result = [[SLTerminal sharedTerminal] eval:@"'foo'"]),
+                    @"The exception of the abandoned script should not have been reported as that of the next script.");
+    SLAssertTrue([result isEqual:@"foo"], @"-eval: did not return the result of the next script.");
+
+    SLAssertNoThrow((result = [[SLTerminal sharedTerminal] eval:@"'bar'"]), @"Should not have thrown.");
+    SLAssertTrue([result isEqual:@"bar"], @"The terminal should have remained in sync with `SLTerminal.js`.");
+}
+
+- (void)testTimingOutDoesNotInterruptTheLogger {
+    dispatch_queue_t loggingQueue = dispatch_queue_create("com.inkling.subliminal.SLTerminalTest.loggingQueue", DISPATCH_QUEUE_SERIAL);
+    NSException *__block loggingException = nil;
+
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.5 name:@"interrupted eval"];
+    [watchdog guardBlock:^{
+        // keep the logger flushing on another thread while (and after) the watchdog expires
+        dispatch_async(loggingQueue, ^{
+            @try {
+                for (NSUInteger i = 0; i < 10; i++) {
+                    SLLog(@"Logged from another thread (%lu).", (unsigned long)i);
+                    [[SLLogger sharedLogger] flush];
+                }
+            }
+            @catch (NSException *exception) {
+                loggingException = exception;
+            }
+        });
+
+        SLAssertThrowsNamed([[SLTerminal sharedTerminal] eval:@"UIATarget.localTarget().delay(2.0);"],
+                            SLTestTimeoutException, @"The evaluation should have been interrupted.");
+
+        // the logger should not be interrupted even when it flushes on the test's thread
+        SLAssertNoThrow([[SLLogger sharedLogger] logMessage:@"Logged after the time limit elapsed."],
+                        @"The logger should not have been interrupted.");
+        SLAssertNoThrow([[SLLogger sharedLogger] flush], @"The logger should not have been interrupted.");
+    }];
+
+    // wait for the other thread to finish logging
+    dispatch_sync(loggingQueue, ^{});
+    dispatch_release(loggingQueue);
+    SLAssertTrue(loggingException == nil,
+                 @"The logger should not have been interrupted on another thread, but threw: %@", loggingException);
+
+    id result;
+    SLAssertNoThrow((result = [[SLTerminal sharedTerminal] eval:@"'foo'"]), @"Should not have thrown.");
+    SLAssertTrue([result isEqual:@"foo"], @"The terminal should have remained in sync with `SLTerminal.js`.");
+}
+
 #pragma mark - Waiting on boolean expressions and functions tests
 
 static const NSTimeInterval kWaitUntilTrueRetryDelay = 0.25;
@@ -21,6 +21,7 @@
 //
 
 #import "SLIntegrationTest.h"
+#import <OCMock/OCMock.h>
 
 @interface SLTextFieldTest : SLIntegrationTest
 
@@ -30,6 +31,8 @@
     // _textField is id-typed so that it can represent SLTextFields
     // and SLWebTextFields
     id _textField;
+
+    id _loggerMock;
 }
 
 + (NSString *)testCaseViewControllerClassName {
@@ -42,6 +45,8 @@
     if (testSelector == @selector(testSetText) ||
         testSelector == @selector(testSetTextWithinTableViewCell) ||
         testSelector == @selector(testSetTextCanHandleTapHoldCharacters) ||
+        testSelector == @selector(testSetTextUsingChunkedStrategy) ||
+        testSelector == @selector(testSetTextUsingSetValueStrategy) ||
         testSelector == @selector(testSetTextClearsCurrentText) ||
         testSelector == @selector(testSetTextClearsCurrentTextWithinTableViewCell) ||
         testSelector == @selector(testSetTextWhenFieldClearsOnBeginEditing) ||
@@ -62,6 +67,13 @@
     }
 }
 
+- (void)tearDownTestCaseWithSelector:(SEL)testSelector {
+    [_loggerMock stopMocking];
+    _loggerMock = nil;
+
+    [super tearDownTestCaseWithSelector:testSelector];
+}
+
 #pragma mark - SLTextField test cases
 
 - (void)testSetText {
@@ -82,6 +94,31 @@
     SLAssertTrue([SLAskApp(text) isEqualToString:expectedText], @"Text was not set to expected value.");
 }
 
+- (void)testSetTextUsingChunkedStrategy {
+    ((SLTextField *)_textField).textEntryStrategy = SLTextEntryStrategyChunked;
+
+    // the text should have been typed, rather than set
+    _loggerMock = [OCMockObject partialMockForObject:[SLLogger sharedLogger]];
+    [[_loggerMock reject] logWarning:[OCMArg checkWithBlock:^BOOL(NSString *warning) {
+        return ([warning rangeOfString:@"fell back on UIAElement.setValue"].location != NSNotFound);
+    }]];
+
+    // long enough to be typed in several chunks
+    NSString *const expectedText = @"foo’s a string typed in several chunks";
+    SLAssertNoThrow([UIAElement(_textField) setText:expectedText], @"Should not have thrown.");
+    SLAssertTrue([SLAskApp(text) isEqualToString:expectedText], @"Text was not set to expected value.");
+
+    SLAssertNoThrow([_loggerMock verify], @"The text should have been typed without falling back on setting the value.");
+}
+
+- (void)testSetTextUsingSetValueStrategy {
+    ((SLTextField *)_textField).textEntryStrategy = SLTextEntryStrategySetValue;
+
+    NSString *const expectedText = @"foo’s a difficult string to type!";
+    SLAssertNoThrow([UIAElement(_textField) setText:expectedText], @"Should not have thrown.");
+    SLAssertTrue([SLAskApp(text) isEqualToString:expectedText], @"Text was not set to expected value.");
+}
+
 - (void)testSetTextClearsCurrentText {
     NSString *const expectedText1 = @"foo";
     SLAssertNoThrow([UIAElement(_textField) setText:expectedText1], @"Should not have thrown.");
@@ -43,6 +43,8 @@
     if (testCase == @selector(testSetText) ||
         testCase == @selector(testSetTextWithinTableViewCell) ||
         testCase == @selector(testSetTextCanHandleTapHoldCharacters) ||
+        testCase == @selector(testSetTextUsingChunkedStrategy) ||
+        testCase == @selector(testSetTextUsingSetValueStrategy) ||
         testCase == @selector(testSetTextClearsCurrentText) ||
         testCase == @selector(testSetTextClearsCurrentTextWithinTableViewCell) ||
         testCase == @selector(testSetTextWhenFieldClearsOnBeginEditing) ||
@@ -162,6 +164,8 @@
     if (self.testCase == @selector(testSetText) ||
         self.testCase == @selector(testSetTextWithinTableViewCell) ||
         self.testCase == @selector(testSetTextCanHandleTapHoldCharacters) ||
+        self.testCase == @selector(testSetTextUsingChunkedStrategy) ||
+        self.testCase == @selector(testSetTextUsingSetValueStrategy) ||
         self.testCase == @selector(testSetTextClearsCurrentText) ||
         self.testCase == @selector(testSetTextClearsCurrentTextWithinTableViewCell) ||
         self.testCase == @selector(testSetTextWhenFieldClearsOnBeginEditing) ||
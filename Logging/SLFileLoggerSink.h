@@ -0,0 +1,58 @@
+//
+//  SLFileLoggerSink.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLLoggerSink.h"
+
+/**
+ An `SLFileLoggerSink` writes events to a file, as an event log.
+
+ The format of the event log is described in `SLLogger`'s class documentation.
+ The [shared logger](+[SLLogger sharedLogger]) delivers events to such a sink
+ if the `SL_EVENT_LOG_PATH` environment variable is set when the application launches.
+ */
+@interface SLFileLoggerSink : NSObject <SLLoggerSink>
+
+/**
+ Initializes and returns a newly allocated sink which writes events to the specified file.
+
+ If a file exists at _path_, it is replaced.
+
+ This is the designated initializer.
+
+ @param path The path of the file to which to write events. If this path is relative,
+ it is resolved relative to the application's home directory.
+
+ @return An initialized sink, or `nil` if the file could not be opened.
+ */
+- (instancetype)initWithPath:(NSString *)path;
+
+/// The absolute path of the file to which the receiver writes events.
+@property (nonatomic, readonly) NSString *path;
+
+/**
+ The minimum level of the events to be written to the file.
+
+ Defaults to `SLLogLevelDebug`.
+ */
+@property (atomic) SLLogLevel minimumLevel;
+
+@end
@@ -0,0 +1,84 @@
+//
+//  SLFileLoggerSink.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLFileLoggerSink.h"
+
+/// The version of the event log format. Increment this when making incompatible changes to the format.
+static const NSUInteger kEventLogVersion = 1;
+
+@implementation SLFileLoggerSink {
+    FILE *_file;
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+    NSParameterAssert([path length]);
+
+    self = [super init];
+    if (self) {
+        if (![path isAbsolutePath]) {
+            path = [NSHomeDirectory() stringByAppendingPathComponent:path];
+        }
+        _path = [path copy];
+        _minimumLevel = SLLogLevelDebug;
+
+        _file = fopen([_path fileSystemRepresentation], "w");
+        if (!_file) return nil;
+
+        // The header lets readers convert the monotonic timestamps of subsequent events to dates.
+        [self writeEvent:@{
+            @"timestamp": @([SLLogRecord currentTimestamp]),
+            @"type": @"logStarted",
+            @"version": @(kEventLogVersion),
+            @"date": @([[NSDate date] timeIntervalSince1970])
+        }];
+        fflush(_file);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_file) fclose(_file);
+}
+
+// Each event is written to the file as a JSON object, on its own line.
+- (void)writeEvent:(NSDictionary *)event {
+    NSError *error = nil;
+    NSData *eventData = [NSJSONSerialization dataWithJSONObject:event options:0 error:&error];
+    NSAssert(eventData, @"Could not serialize event %@: %@", event, error);
+
+    fwrite([eventData bytes], 1, [eventData length], _file);
+    fputc('\n', _file);
+}
+
+- (void)logRecords:(NSArray *)records {
+    for (SLLogRecord *record in records) {
+        NSMutableDictionary *event = [[NSMutableDictionary alloc] initWithDictionary:record.info];
+        event[@"timestamp"] = @(record.timestamp);
+        event[@"type"] = record.type;
+        if (record.message) event[@"message"] = record.message;
+        [self writeEvent:event];
+    }
+    // make the events available to readers as soon as they are delivered
+    fflush(_file);
+}
+
+@end
@@ -22,6 +22,12 @@
 
 #import <Foundation/Foundation.h>
 
+#import "SLLoggerSink.h"
+#import "SLUIALoggerSink.h"
+#import "SLFileLoggerSink.h"
+#import "SLRingBufferLoggerSink.h"
+#import "SLStandardOutputLoggerSink.h"
+
 
 #pragma mark Convenience Functions
 
@@ -36,6 +42,18 @@
  */
 void SLLog(NSString *format, ...) NS_FORMAT_FUNCTION(1,2);
 
+/**
+ Logs a debug message to the testing environment.
+
+ The message is output using `[[SLLogger sharedLogger] logDebug:]`. If none of the
+ shared logger's sinks would output debug messages, the message is not formatted,
+ so debug messages may be logged liberally at little cost when disabled.
+
+ @param format A format string (in the manner of `-[NSString stringWithFormat:]`).
+ @param ... (Optional) A comma-separated list of arguments to substitute into `format`.
+ */
+void SLLogDebug(NSString *format, ...) NS_FORMAT_FUNCTION(1,2);
+
 /**
  Asynchronously logs a message to the testing environment.
  
@@ -47,6 +65,18 @@ void SLLog(NSString *format, ...) NS_FORMAT_FUNCTION(1,2);
  */
 void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
 
+/**
+ Logs a message to the testing environment at most once per test case.
+
+ The message is output using `[[SLLogger sharedLogger] logOnce:level:]`
+ with a level of `SLLogLevelMessage`. This function returns immediately,
+ so, like `SLLogAsync`, it may be used by the application and other main thread contexts.
+
+ @param format A format string (in the manner of `-[NSString stringWithFormat:]`).
+ @param ... (Optional) A comma-separated list of arguments to substitute into `format`.
+ */
+void SLLogOnce(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
+
 
 /**
  The shared `SLLogger` used by Subliminal to log test progress. It may also be
@@ -70,15 +100,87 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
 
  ### Providing alternate log formats
 
- `SLLogger` is not designed to be subclassed, because the Automation instrument
- is the only way for tests running on a device to report their status to the
- test runner. However, when the `subliminal-test` command-line tool is invoked with
- an output directory, it will save the logs to that directory as a `.plist`,
+ `SLLogger` is not designed to be subclassed. Rather, it delivers the events that
+ it logs to one or more [sinks](-addSink:), objects conforming to the `SLLoggerSink`
+ protocol. By default, the shared logger delivers events to an `SLUIALoggerSink`,
+ which outputs them to the Automation instrument. That sink should not be removed,
+ because the Automation instrument is the only way for tests running on a device
+ to report their status to the test runner; but other sinks may be added, for instance
+ an `SLRingBufferLoggerSink` to retain detailed logs in memory, or an
+ `SLStandardOutputLoggerSink` to output the logs to Xcode's console.
+
+ Each sink has a [minimum level](-[SLLoggerSink minimumLevel]) below which
+ it will not receive events (excepting events describing the progress of the test run,
+ which every sink receives). Messages below the thresholds of all sinks are discarded
+ as soon as they are logged, and `SLLog` and `SLLogDebug` will not even format them.
+ For example, to record debug messages in memory without sending them to UIAutomation:
+
+    SLUIALoggerSink *uiaLoggerSink = [[SLLogger sharedLogger] sinks][0];
+    uiaLoggerSink.minimumLevel = SLLogLevelMessage;
+    [[SLLogger sharedLogger] addSink:[[SLRingBufferLoggerSink alloc] initWithCapacity:1000]];
+
+ When the `subliminal-test` command-line tool is invoked with an output directory,
+ it will also save the Automation instrument's logs to that directory as a `.plist`,
  with all log events available as structured dictionaries. That `.plist` may be
  parsed into other formats after testing concludes.
 
  The `subliminal_uialog_to_junit` script, for example, parses the `.plist`
  into a JUnit report.
+
+ ### Buffering
+
+ Because each message output to the Automation instrument requires a round trip
+ to UIAutomation, `SLLogger` buffers [messages](-logMessage:) and [debug messages](-logDebug:),
+ returning immediately, and outputs them in batches. Buffered messages are output
+ within a fraction of a second of being logged, and before any [warning](-logWarning:),
+ [error](-logError:), or test status (e.g. a test case starting or failing) is output,
+ so the order of the log is preserved. Use `-flush` to output buffered messages immediately.
+
+ ### Logging repeated messages
+
+ Messages logged in the course of polling, e.g. while waiting for an element
+ to become valid, may be logged many times in succession. To avoid flooding the log,
+ such messages should be logged using `-logOnce:level:` or `SLLogOnce`: the first
+ occurrence of a particular message at a particular level is output as usual,
+ and further occurrences are only counted. When the current test case (or set-up
+ or tear-down method) finishes, the logger outputs the number of times that each
+ message was logged, if more than once, and begins logging the messages anew.
+
+ ### Writing an event log
+
+ If the `SL_EVENT_LOG_PATH` environment variable is set when the application launches,
+ the shared logger will also write every event that it logs to a file at that path
+ (resolved relative to the application's home directory if the path is relative),
+ using an `SLFileLoggerSink`.
+ In the Simulator, the path may refer to a location on the host machine,
+ from which the `subliminal-instrument` tool (invoked with its `--event-log` option)
+ may read the events as the tests run, rather than parsing Instruments' output.
+
+ The event log is written in the [JSON Lines](http://jsonlines.org) format: each line
+ is a JSON object describing one event, with the following fields:
+
+ *   `timestamp`:   the time at which the event was logged, in seconds, by a monotonic clock.
+ *   `type`:        the type of the event, e.g. `message`, `warning`, `failure`, `testCaseStarted`,
+                    or `testCasePassed`.
+ *   `message`:     the message logged to the Automation instrument (if any) for the event.
+ *   `test`, `testCase`:    the test and test case during which the event occurred, if any.
+ *   `fileName`, `lineNumber`:  the call site of a test failure, if known.
+ *   `duration`:    for events marking the end of a test case, test, or the test run,
+                    the number of seconds that the test case, test, or run took to execute.
+
+ Events describing the results of tests have further fields corresponding to the
+ arguments of the methods in the `SLLogger (SLTestController)` and `SLLogger (SLTest)` categories,
+ e.g. `numCasesExecuted`, or the `attempt` of a `testCaseRetried` event.
+ The first line of the event log is a `logStarted` event whose `date` field specifies
+ the time at which the log was created, in seconds since 1970, and whose `version` field
+ specifies the version of the log's format.
+
+ When an event log is being written, [messages](-logMessage:) and [debug messages](-logDebug:)
+ are written only to the event log, sparing the round trips to UIAutomation:
+ the minimum level of the shared logger's `SLUIALoggerSink` is set to `SLLogLevelWarning`.
+ Test status, warnings, and errors are still output to the Automation instrument,
+ whose results determine the outcome of the run and which takes screenshots
+ when warnings and errors are logged.
  */
 @interface SLLogger : NSObject
 
@@ -94,6 +196,49 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
  */
 + (SLLogger *)sharedLogger;
 
+#pragma mark - Managing Sinks
+/// -------------------------------------
+/// @name Managing Sinks
+/// -------------------------------------
+
+/**
+ The sinks to which the receiver delivers the events that it logs,
+ in the order in which they were added.
+
+ @return An array of objects conforming to `SLLoggerSink`.
+ */
+- (NSArray *)sinks;
+
+/**
+ Adds a sink to which the receiver will deliver the events that it logs.
+
+ Events logged before this method is called will not be delivered to _sink_.
+
+ @param sink The sink to add. If _sink_ has already been added, this method does nothing.
+ */
+- (void)addSink:(id<SLLoggerSink>)sink;
+
+/**
+ Removes a sink previously added to the receiver.
+
+ Events logged before this method is called will be delivered to _sink_
+ before this method returns.
+
+ @param sink The sink to remove.
+ */
+- (void)removeSink:(id<SLLoggerSink>)sink;
+
+/**
+ Whether any of the receiver's sinks would receive messages of the specified level.
+
+ Use this method to avoid formatting messages that would be discarded.
+
+ @param level A logging level.
+ @return `YES` if the [minimum level](-[SLLoggerSink minimumLevel]) of any of the
+ receiver's sinks is less than or equal to _level_, otherwise `NO`.
+ */
+- (BOOL)isLoggingLevel:(SLLogLevel)level;
+
 #pragma mark - Primitive Methods
 /// -------------------------------------
 /// @name Primitive Methods
@@ -125,6 +270,13 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
  */
 - (void)logMessage:(NSString *)message;
 
+/**
+ Delivers any buffered messages to the receiver's sinks.
+
+ This method does not return until the messages have been output.
+ */
+- (void)flush;
+
 #pragma mark - Logging with Severity Levels
 /// -------------------------------------
 /// @name Logging with Severity Levels
@@ -151,6 +303,26 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
  */
 - (void)logError:(NSString *)error;
 
+#pragma mark - Logging Repeated Messages
+/// -------------------------------------
+/// @name Logging Repeated Messages
+/// -------------------------------------
+
+/**
+ Logs a message at the specified level if it has not yet been logged at that level
+ during the current test case.
+
+ Later occurrences of the message are counted rather than output. When the current
+ test case (or set-up or tear-down method) starts or finishes, the logger outputs
+ how many times each such message was logged, if more than once, and forgets the messages.
+
+ This method returns immediately, deduplicating the message on the `loggingQueue`.
+
+ @param message The message to log.
+ @param level The level at which to log _message_.
+ */
+- (void)logOnce:(NSString *)message level:(SLLogLevel)level;
+
 @end
 
 
@@ -274,6 +446,18 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
  */
 - (void)logException:(NSException *)exception expected:(BOOL)expected;
 
+/**
+ Logs an exception thrown by an attempt of a test case which will be
+ [retried](+[SLTest numberOfRetriesForTestCaseWithSelector:]).
+
+ The exception is logged, with call-site information as by `-logException:expected:`,
+ as a warning rather than as an error: the test case will pass or fail according to its last attempt.
+
+ @param exception   The exception to be logged.
+ @param expected    YES if the exception was "expected", otherwise NO.
+ */
+- (void)logRetriedException:(NSException *)exception expected:(BOOL)expected;
+
 /**
  Logs that the specified test case has started.
  
@@ -292,6 +476,29 @@ void SLLogAsync(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
  */
 - (void)logTest:(NSString *)test casePass:(NSString *)testCase;
 
+/**
+ Logs that the specified test case has failed, but will be [retried](+[SLTest numberOfRetriesForTestCaseWithSelector:]).
+
+ The failure is logged as a warning rather than as a test case failure:
+ the test case will pass or fail according to its last attempt.
+
+ @param test The test that is currently running.
+ @param testCase The test case that has failed.
+ @param attempt The number of the attempt that failed, starting from `1`.
+ */
+- (void)logTest:(NSString *)test caseRetry:(NSString *)testCase afterAttempt:(NSUInteger)attempt;
+
+/**
+ Logs that the specified test case has passed, having failed on previous attempts.
+
+ The test case is reported as having passed, with a warning that it may be flaky.
+
+ @param test The test that is currently running.
+ @param testCase The test case that has passed.
+ @param numAttempts The number of attempts, including the last, that it took for the test case to pass.
+ */
+- (void)logTest:(NSString *)test caseFlakyPass:(NSString *)testCase numAttempts:(NSUInteger)numAttempts;
+
 /**
  Logs that the specified test case has failed.
  
@@ -22,9 +22,10 @@
 
 #import "SLLogger.h"
 
-#import "SLLogger.h"
-#import "SLTerminal.h"
-#import "SLStringUtilities.h"
+#import "SLUIALoggerSink.h"
+#import "SLFileLoggerSink.h"
+
+#import <mach/mach_time.h>
 
 
 NSString *const SLLoggerExceptionFilenameKey      = @"SLLoggerExceptionFilenameKey";
@@ -37,15 +38,70 @@ NSString *const SLLoggerUnknownCallSite           = @"Unknown location";
  */
 static const void *const kLoggingQueueIdentifier = &kLoggingQueueIdentifier;
 
+/// The maximum number of records that the logger will buffer before flushing them.
+static const NSUInteger kMaxBufferedRecordCount = 32;
+
+/// The maximum interval for which the logger will buffer a record before flushing it.
+static const NSTimeInterval kMaxBufferInterval = 0.25;
+
+/// The environment variable which, if set, specifies the path of the event log.
+static NSString *const kEventLogPathEnvironmentVariable = @"SL_EVENT_LOG_PATH";
+
+// Event types. These are written to the event log, so must not change.
+static NSString *const kEventTypeMessage                    = @"message";
+static NSString *const kEventTypeDebug                      = @"debug";
+static NSString *const kEventTypeWarning                    = @"warning";
+static NSString *const kEventTypeError                      = @"error";
+static NSString *const kEventTypeFailure                    = @"failure";
+static NSString *const kEventTypeException                  = @"exception";
+static NSString *const kEventTypeTestingStarted             = @"testingStarted";
+static NSString *const kEventTypeTestStarted                = @"testStarted";
+static NSString *const kEventTypeTestCaseStarted            = @"testCaseStarted";
+static NSString *const kEventTypeTestCasePassed             = @"testCasePassed";
+static NSString *const kEventTypeTestCaseFailed             = @"testCaseFailed";
+static NSString *const kEventTypeTestCaseFailedUnexpectedly = @"testCaseFailedUnexpectedly";
+static NSString *const kEventTypeTestCaseRetried            = @"testCaseRetried";
+static NSString *const kEventTypeTestCaseFlakyPassed        = @"testCaseFlakyPassed";
+static NSString *const kEventTypeTestFinished               = @"testFinished";
+static NSString *const kEventTypeTestTerminatedAbnormally   = @"testTerminatedAbnormally";
+static NSString *const kEventTypeTestingFinished            = @"testingFinished";
+
+/// Key in the current thread's dictionary under which `-logException:expected:`
+/// and `-logUncaughtException:` describe the exception being logged to `-logError:`.
+static NSString *const kLoggedExceptionInfoKey = @"SLLoggerLoggedExceptionInfo";
+
 
 void SLLog(NSString *format, ...) {
+    // don't bother formatting the message if no sink would output it
+    if (![[SLLogger sharedLogger] isLoggingLevel:SLLogLevelMessage]) return;
+
     va_list args;
     va_start(args, format);
     [[SLLogger sharedLogger] logMessage:[[NSString alloc] initWithFormat:format arguments:args]];
     va_end(args);
 }
 
+void SLLogDebug(NSString *format, ...) {
+    if (![[SLLogger sharedLogger] isLoggingLevel:SLLogLevelDebug]) return;
+
+    va_list args;
+    va_start(args, format);
+    [[SLLogger sharedLogger] logDebug:[[NSString alloc] initWithFormat:format arguments:args]];
+    va_end(args);
+}
+
+void SLLogOnce(NSString *format, ...) {
+    if (![[SLLogger sharedLogger] isLoggingLevel:SLLogLevelMessage]) return;
+
+    va_list args;
+    va_start(args, format);
+    [[SLLogger sharedLogger] logOnce:[[NSString alloc] initWithFormat:format arguments:args] level:SLLogLevelMessage];
+    va_end(args);
+}
+
 void SLLogAsync(NSString *format, ...) {
+    if (![[SLLogger sharedLogger] isLoggingLevel:SLLogLevelMessage]) return;
+
     va_list args;
     va_start(args, format);
     NSString *message = [[NSString alloc] initWithFormat:format arguments:args];
@@ -56,8 +112,104 @@ void SLLogAsync(NSString *format, ...) {
     });
 }
 
+
+@interface SLLogRecord ()
+
++ (instancetype)recordWithLevel:(SLLogLevel)level type:(NSString *)type message:(NSString *)message;
+
+/// The logger adds information to the record, e.g. the test during which it was logged,
+/// before delivering it to its sinks.
+@property (nonatomic, readonly) NSMutableDictionary *mutableInfo;
+
+@end
+
+@implementation SLLogRecord
+
++ (NSTimeInterval)currentTimestamp {
+    static mach_timebase_info_data_t timebaseInfo;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebaseInfo);
+    });
+    return ((double)mach_absolute_time() * timebaseInfo.numer / timebaseInfo.denom) / NSEC_PER_SEC;
+}
+
++ (NSSet *)testStatusTypes {
+    static NSSet *__testStatusTypes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        __testStatusTypes = [[NSSet alloc] initWithObjects:
+                             kEventTypeTestingStarted, kEventTypeTestStarted,
+                             kEventTypeTestCaseStarted, kEventTypeTestCasePassed,
+                             kEventTypeTestCaseFailed, kEventTypeTestCaseFailedUnexpectedly,
+                             kEventTypeTestCaseRetried, kEventTypeTestCaseFlakyPassed,
+                             kEventTypeTestFinished, kEventTypeTestTerminatedAbnormally,
+                             kEventTypeTestingFinished, nil];
+    });
+    return __testStatusTypes;
+}
+
++ (instancetype)recordWithLevel:(SLLogLevel)level type:(NSString *)type message:(NSString *)message {
+    SLLogRecord *record = [[self alloc] init];
+    if (record) {
+        record->_timestamp = [self currentTimestamp];
+        record->_level = level;
+        record->_type = [type copy];
+        record->_message = [message copy];
+        record->_mutableInfo = [[NSMutableDictionary alloc] init];
+        record->_testStatus = [[self testStatusTypes] containsObject:type];
+    }
+    return record;
+}
+
+- (NSDictionary *)info {
+    return _mutableInfo;
+}
+
+@end
+
+
+@interface SLLogger ()
+
+/**
+ Logs the specified record.
+
+ @param record The record to log.
+ @param flush If `YES`, the record and any records buffered before it will be output
+ before this method returns. If `NO`, the record may be buffered and this method
+ returns immediately.
+ */
+- (void)logRecord:(SLLogRecord *)record flush:(BOOL)flush;
+
+/**
+ Initializes a logger which delivers events to an `SLUIALoggerSink`
+ and, if _eventLogPath_ is non-`nil`, an `SLFileLoggerSink`.
+
+ This is the designated initializer. `-init` invokes it with the path specified
+ by the `SL_EVENT_LOG_PATH` environment variable, if any.
+
+ @param eventLogPath The path of the event log, or `nil` if the logger should not
+ write an event log. If this path is relative, it is resolved relative to the
+ application's home directory.
+ */
+- (instancetype)initWithEventLogPath:(NSString *)eventLogPath;
+
+@end
+
+
 @implementation SLLogger {
     dispatch_queue_t _loggingQueue;
+
+    // Guarded by `self`, as sinks may be added or removed on any queue.
+    NSArray *_sinks;
+
+    // Only accessed on the logging queue.
+    NSMutableArray *_bufferedRecords;
+    NSString *_currentTest, *_currentTestCase;
+    NSTimeInterval _testingStartTime, _testStartTime, _testCaseStartTime;
+    NSMutableArray *_onceRecordKeys;
+    NSMutableDictionary *_onceRecordsByKey;
+    NSCountedSet *_onceRecordOccurrences;
 }
 
 + (SLLogger *)sharedLogger {
@@ -70,10 +222,36 @@ void SLLogAsync(NSString *format, ...) {
 }
 
 - (id)init {
+    return [self initWithEventLogPath:[[NSProcessInfo processInfo] environment][kEventLogPathEnvironmentVariable]];
+}
+
+- (instancetype)initWithEventLogPath:(NSString *)eventLogPath {
     self = [super init];
     if (self) {
         _loggingQueue = dispatch_queue_create("com.inkling.subliminal.SLUIALogger.loggingQueue", DISPATCH_QUEUE_SERIAL);
         dispatch_queue_set_specific(_loggingQueue, kLoggingQueueIdentifier, (void *)kLoggingQueueIdentifier, NULL);
+        _bufferedRecords = [[NSMutableArray alloc] init];
+        _onceRecordKeys = [[NSMutableArray alloc] init];
+        _onceRecordsByKey = [[NSMutableDictionary alloc] init];
+        _onceRecordOccurrences = [[NSCountedSet alloc] init];
+
+        SLUIALoggerSink *uiaLoggerSink = [[SLUIALoggerSink alloc] init];
+        _sinks = @[ uiaLoggerSink ];
+
+        if ([eventLogPath length]) {
+            SLFileLoggerSink *eventLogSink = [[SLFileLoggerSink alloc] initWithPath:eventLogPath];
+            if (eventLogSink) {
+                _sinks = [_sinks arrayByAddingObject:eventLogSink];
+
+                // When an event log is being written, messages and debug messages are written only to the event log,
+                // to spare the round trips to UIAutomation. Test status, warnings, and errors are still output
+                // to UIAutomation, because the Automation instrument's results determine the outcome of the run
+                // and because UIAutomation takes screenshots when warnings and errors are logged.
+                uiaLoggerSink.minimumLevel = SLLogLevelWarning;
+            } else {
+                NSLog(@"Subliminal could not open the event log at \"%@\": %s", eventLogPath, strerror(errno));
+            }
+        }
     }
     return self;
 }
@@ -97,48 +275,244 @@ void SLLogAsync(NSString *format, ...) {
     return dispatch_get_specific(kLoggingQueueIdentifier) != NULL;
 }
 
-- (void)logDebug:(NSString *)debug {
-    if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logDebug:debug];
-        });
-        return;
+#pragma mark - Sinks
+
+- (NSArray *)sinks {
+    @synchronized(self) {
+        return _sinks;
     }
+}
+
+- (void)addSink:(id<SLLoggerSink>)sink {
+    NSParameterAssert(sink);
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logDebug('%@');", [debug slStringByEscapingForJavaScriptLiteral]];
+    // deliver the records buffered before the sink was added to the existing sinks only
+    [self flush];
+    @synchronized(self) {
+        if (![_sinks containsObject:sink]) _sinks = [_sinks arrayByAddingObject:sink];
+    }
 }
 
-- (void)logMessage:(NSString *)message {
+- (void)removeSink:(id<SLLoggerSink>)sink {
+    // deliver the records buffered before the sink was removed to the sink
+    [self flush];
+    @synchronized(self) {
+        NSMutableArray *sinks = [_sinks mutableCopy];
+        [sinks removeObject:sink];
+        _sinks = [sinks copy];
+    }
+}
+
+- (BOOL)isLoggingLevel:(SLLogLevel)level {
+    for (id<SLLoggerSink> sink in [self sinks]) {
+        if (level >= sink.minimumLevel) return YES;
+    }
+    return NO;
+}
+
+#pragma mark - Buffering
+
+// Records are delivered to the sinks in batches, because some sinks, like the `SLUIALoggerSink`,
+// incur substantial overhead per delivery. Records logged with `flush` set to `YES`
+// (test status events and failures) are output, along with any records buffered before them,
+// before this method returns, so that their order relative to the actions taken by the tests is preserved.
+- (void)logRecord:(SLLogRecord *)record flush:(BOOL)flush {
     if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logMessage:message];
-        });
+        // only wait for the record to be logged if it is to be flushed
+        if (flush) {
+            dispatch_sync(_loggingQueue, ^{
+                [self logRecord:record flush:flush];
+            });
+        } else {
+            dispatch_async(_loggingQueue, ^{
+                [self logRecord:record flush:flush];
+            });
+        }
         return;
     }
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logMessage('%@');", [message slStringByEscapingForJavaScriptLiteral]];
+    // the repetitions of messages logged once are counted per test case (or set-up or tear-down)
+    if (record.testStatus) [self logRepetitionsOfOnceRecords];
+
+    [self synchronizeTestStateWithRecord:record];
+    [_bufferedRecords addObject:record];
+
+    const BOOL bufferIsFull = ([_bufferedRecords count] >= kMaxBufferedRecordCount);
+    const BOOL bufferIsStale = (([SLLogRecord currentTimestamp] - [_bufferedRecords[0] timestamp]) >= kMaxBufferInterval);
+    if (flush || bufferIsFull || bufferIsStale) {
+        [self flushBufferedRecords];
+    } else if ([_bufferedRecords count] == 1) {
+        // make sure that this record is output even if no more records are logged
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kMaxBufferInterval * NSEC_PER_SEC)), _loggingQueue, ^{
+            [self flushBufferedRecords];
+        });
+    }
 }
 
-- (void)logWarning:(NSString *)warning {
+- (void)flushBufferedRecords {
+    NSAssert([self currentQueueIsLoggingQueue], @"%@ must be called on the logging queue.", NSStringFromSelector(_cmd));
+
+    if (![_bufferedRecords count]) return;
+
+    NSArray *records = [_bufferedRecords copy];
+    [_bufferedRecords removeAllObjects];
+
+    // Deliver the records to the sinks in the order in which the sinks were added,
+    // so that the `SLUIALoggerSink` receives them first and screenshots are taken promptly.
+    for (id<SLLoggerSink> sink in [self sinks]) {
+        const SLLogLevel minimumLevel = sink.minimumLevel;
+        NSIndexSet *indexesOfRecordsToDeliver = [records indexesOfObjectsPassingTest:^BOOL(SLLogRecord *record, NSUInteger idx, BOOL *stop) {
+            return (record.level >= minimumLevel) || record.testStatus;
+        }];
+        if ([indexesOfRecordsToDeliver count] == [records count]) {
+            [sink logRecords:records];
+        } else if ([indexesOfRecordsToDeliver count]) {
+            [sink logRecords:[records objectsAtIndexes:indexesOfRecordsToDeliver]];
+        }
+    }
+}
+
+- (void)flush {
     if (![self currentQueueIsLoggingQueue]) {
         dispatch_sync(_loggingQueue, ^{
-            [self logWarning:warning];
+            [self flush];
         });
         return;
     }
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logWarning('%@');", [warning slStringByEscapingForJavaScriptLiteral]];
+    [self flushBufferedRecords];
 }
 
-- (void)logError:(NSString *)error {
+#pragma mark - Test State
+
+// The logger tracks the test and test case that are running so that it may
+// attribute records to them and measure the duration of each test (case).
+- (void)synchronizeTestStateWithRecord:(SLLogRecord *)record {
+    NSAssert([self currentQueueIsLoggingQueue], @"%@ must be called on the logging queue.", NSStringFromSelector(_cmd));
+
+    NSString *type = record.type;
+    if ([type isEqualToString:kEventTypeTestingStarted]) {
+        _testingStartTime = record.timestamp;
+    } else if ([type isEqualToString:kEventTypeTestStarted]) {
+        _currentTest = record.info[@"test"];
+        _currentTestCase = nil;
+        _testStartTime = record.timestamp;
+    } else if ([type isEqualToString:kEventTypeTestCaseStarted]) {
+        _currentTestCase = record.info[@"testCase"];
+        _testCaseStartTime = record.timestamp;
+    }
+
+    if (_currentTest && !record.info[@"test"]) record.mutableInfo[@"test"] = _currentTest;
+    if (_currentTestCase && !record.info[@"testCase"]) record.mutableInfo[@"testCase"] = _currentTestCase;
+
+    if ([type isEqualToString:kEventTypeTestCasePassed] ||
+        [type isEqualToString:kEventTypeTestCaseFlakyPassed] ||
+        [type isEqualToString:kEventTypeTestCaseFailed] ||
+        [type isEqualToString:kEventTypeTestCaseFailedUnexpectedly]) {
+        record.mutableInfo[@"duration"] = @(record.timestamp - _testCaseStartTime);
+        _currentTestCase = nil;
+    } else if ([type isEqualToString:kEventTypeTestFinished] ||
+               [type isEqualToString:kEventTypeTestTerminatedAbnormally]) {
+        record.mutableInfo[@"duration"] = @(record.timestamp - _testStartTime);
+        _currentTest = nil;
+        _currentTestCase = nil;
+    } else if ([type isEqualToString:kEventTypeTestingFinished]) {
+        record.mutableInfo[@"duration"] = @(record.timestamp - _testingStartTime);
+    }
+}
+
+#pragma mark - Logging Once
+
++ (NSString *)typeForLevel:(SLLogLevel)level {
+    switch (level) {
+        case SLLogLevelDebug:
+            return kEventTypeDebug;
+        case SLLogLevelMessage:
+            return kEventTypeMessage;
+        case SLLogLevelWarning:
+            return kEventTypeWarning;
+        case SLLogLevelError:
+            return kEventTypeError;
+    }
+}
+
+// Messages are deduplicated on the logging queue so that repetitions cost the caller
+// no more than a dispatch, and cost the sinks nothing until they are summarized.
+- (void)logOnce:(NSString *)message level:(SLLogLevel)level {
+    if (![self isLoggingLevel:level]) return;
+
     if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logError:error];
+        dispatch_async(_loggingQueue, ^{
+            [self logOnce:message level:level];
         });
         return;
     }
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logError('%@');", [error slStringByEscapingForJavaScriptLiteral]];
+    NSString *key = [NSString stringWithFormat:@"%ld:%@", (long)level, message];
+    const BOOL isFirstOccurrence = ([_onceRecordOccurrences countForObject:key] == 0);
+    [_onceRecordOccurrences addObject:key];
+    if (!isFirstOccurrence) return;
+
+    SLLogRecord *record = [SLLogRecord recordWithLevel:level type:[[self class] typeForLevel:level] message:message];
+    [_onceRecordKeys addObject:key];
+    _onceRecordsByKey[key] = record;
+    [self logRecord:record flush:(level >= SLLogLevelWarning)];
+}
+
+- (void)logRepetitionsOfOnceRecords {
+    NSAssert([self currentQueueIsLoggingQueue], @"%@ must be called on the logging queue.", NSStringFromSelector(_cmd));
+
+    if (![_onceRecordKeys count]) return;
+
+    if ([self isLoggingLevel:SLLogLevelMessage]) {
+        for (NSString *key in _onceRecordKeys) {
+            NSUInteger occurrenceCount = [_onceRecordOccurrences countForObject:key];
+            if (occurrenceCount < 2) continue;
+
+            SLLogRecord *onceRecord = _onceRecordsByKey[key];
+            NSString *message = [NSString stringWithFormat:@"The following %@ was logged %lu times: %@",
+                                 onceRecord.type, (unsigned long)occurrenceCount, onceRecord.message];
+            SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelMessage type:kEventTypeMessage message:message];
+            record.mutableInfo[@"occurrenceCount"] = @(occurrenceCount);
+            [self synchronizeTestStateWithRecord:record];
+            [_bufferedRecords addObject:record];
+        }
+    }
+
+    [_onceRecordKeys removeAllObjects];
+    [_onceRecordsByKey removeAllObjects];
+    [_onceRecordOccurrences removeAllObjects];
+}
+
+#pragma mark - Logging
+
+- (void)logDebug:(NSString *)debug {
+    if (![self isLoggingLevel:SLLogLevelDebug]) return;
+    [self logRecord:[SLLogRecord recordWithLevel:SLLogLevelDebug type:kEventTypeDebug message:debug] flush:NO];
+}
+
+- (void)logMessage:(NSString *)message {
+    if (![self isLoggingLevel:SLLogLevelMessage]) return;
+    [self logRecord:[SLLogRecord recordWithLevel:SLLogLevelMessage type:kEventTypeMessage message:message] flush:NO];
+}
+
+// Warnings and errors are flushed immediately because UIAutomation takes a screenshot
+// when they are output, which should reflect the state of the application when they were logged.
+- (void)logWarning:(NSString *)warning {
+    if (![self isLoggingLevel:SLLogLevelWarning]) return;
+    [self logRecord:[SLLogRecord recordWithLevel:SLLogLevelWarning type:kEventTypeWarning message:warning] flush:YES];
+}
+
+- (void)logError:(NSString *)error {
+    SLLogRecord *record;
+    NSDictionary *exceptionInfo = [[NSThread currentThread] threadDictionary][kLoggedExceptionInfoKey];
+    if (exceptionInfo) {
+        record = [SLLogRecord recordWithLevel:SLLogLevelError type:exceptionInfo[@"type"] message:error];
+        [record.mutableInfo addEntriesFromDictionary:exceptionInfo[@"info"]];
+    } else {
+        record = [SLLogRecord recordWithLevel:SLLogLevelError type:kEventTypeError message:error];
+    }
+    [self logRecord:record flush:YES];
 }
 
 @end
@@ -146,32 +520,50 @@ void SLLogAsync(NSString *format, ...) {
 
 @implementation SLLogger (SLTestController)
 
+// Test status messages are flushed immediately so that the progress of the tests
+// can be followed, and because messages logged before testing finishes
+// must be output before the terminal shuts down.
+- (void)logTestStatus:(NSString *)status type:(NSString *)type info:(NSDictionary *)info {
+    SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelMessage type:type message:status];
+    [record.mutableInfo addEntriesFromDictionary:info];
+    [self logRecord:record flush:YES];
+}
+
 - (void)logTestingStart {
-    [self logMessage:@"Testing started."];
+    [self logTestStatus:@"Testing started." type:kEventTypeTestingStarted info:nil];
 }
 
 - (void)logTestStart:(NSString *)test {
-    [self logMessage:[NSString stringWithFormat:@"Test \"%@\" started.", test]];
+    [self logTestStatus:[NSString stringWithFormat:@"Test \"%@\" started.", test]
+                   type:kEventTypeTestStarted info:@{ @"test": test }];
 }
 
 - (void)logTestFinish:(NSString *)test
  withNumCasesExecuted:(NSUInteger)numCasesExecuted
        numCasesFailed:(NSUInteger)numCasesFailed
        numCasesFailedUnexpectedly:(NSUInteger)numCasesFailedUnexpectedly {
-    [self logMessage:[NSString stringWithFormat:@"Test \"%@\" finished: executed %lu case%@, with %lu failure%@ (%lu unexpected).",
-                                                test, (unsigned long)numCasesExecuted, (numCasesExecuted == 1 ? @"" : @"s"),
-                                                      (unsigned long)numCasesFailed, (numCasesFailed == 1 ? @"" : @"s"), (unsigned long)numCasesFailedUnexpectedly]];
+    [self logTestStatus:[NSString stringWithFormat:@"Test \"%@\" finished: executed %lu case%@, with %lu failure%@ (%lu unexpected).",
+                                                   test, (unsigned long)numCasesExecuted, (numCasesExecuted == 1 ? @"" : @"s"),
+                                                         (unsigned long)numCasesFailed, (numCasesFailed == 1 ? @"" : @"s"), (unsigned long)numCasesFailedUnexpectedly]
+                   type:kEventTypeTestFinished
+                   info:@{ @"test": test,
+                           @"numCasesExecuted": @(numCasesExecuted),
+                           @"numCasesFailed": @(numCasesFailed),
+                           @"numCasesFailedUnexpectedly": @(numCasesFailedUnexpectedly) }];
 }
 
 - (void)logTestAbort:(NSString *)test {
-    [self logMessage:[NSString stringWithFormat:@"Test \"%@\" terminated abnormally.", test]];
+    [self logTestStatus:[NSString stringWithFormat:@"Test \"%@\" terminated abnormally.", test]
+                   type:kEventTypeTestTerminatedAbnormally info:@{ @"test": test }];
 }
 
 - (void)logTestingFinishWithNumTestsExecuted:(NSUInteger)numTestsExecuted
                               numTestsFailed:(NSUInteger)numTestsFailed {
-    [self logMessage:[NSString stringWithFormat:@"Testing finished: executed %lu test%@, with %lu failure%@.",
-                                                (unsigned long)numTestsExecuted, (numTestsExecuted == 1 ? @"" : @"s"),
-                                                (unsigned long)numTestsFailed, (numTestsFailed == 1 ? @"" : @"s")]];
+    [self logTestStatus:[NSString stringWithFormat:@"Testing finished: executed %lu test%@, with %lu failure%@.",
+                                                   (unsigned long)numTestsExecuted, (numTestsExecuted == 1 ? @"" : @"s"),
+                                                   (unsigned long)numTestsFailed, (numTestsFailed == 1 ? @"" : @"s")]
+                   type:kEventTypeTestingFinished
+                   info:@{ @"numTestsExecuted": @(numTestsExecuted), @"numTestsFailed": @(numTestsFailed) }];
 }
 
 - (void)logUncaughtException:(NSException *)exception {
@@ -182,15 +574,17 @@ void SLLogAsync(NSString *format, ...) {
         [exceptionMessage appendFormat:@" for reason: %@", exceptionReason];
     }
 
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    threadDictionary[kLoggedExceptionInfoKey] = @{ @"type": kEventTypeException, @"info": @{} };
     [self logError:exceptionMessage];
+    [threadDictionary removeObjectForKey:kLoggedExceptionInfoKey];
 }
 
 @end
 
 
-@implementation SLLogger (SLTest)
-
-- (void)logException:(NSException *)exception expected:(BOOL)expected {
+// describes an exception, with its call site, for `-logException:expected:` and `-logRetriedException:expected:`
+static NSString *SLLoggerDescriptionOfException(NSException *exception, BOOL expected) {
     NSString *callSite;
     NSString *fileName = [exception userInfo][SLLoggerExceptionFilenameKey];
     NSNumber *lineNumber = [exception userInfo][SLLoggerExceptionLineNumberKey];
@@ -208,45 +602,70 @@ void SLLogAsync(NSString *format, ...) {
                                 [exception name], [exception reason]];
     }
 
-    NSString *message = [NSString stringWithFormat:@"%@: %@", callSite, exceptionDescription];
-    [[SLLogger sharedLogger] logError:message];
+    return [NSString stringWithFormat:@"%@: %@", callSite, exceptionDescription];
 }
 
-- (void)logTest:(NSString *)test caseStart:(NSString *)testCase {
-    if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logTest:test caseStart:testCase];
-        });
-        return;
-    }
+@implementation SLLogger (SLTest)
+
+- (void)logException:(NSException *)exception expected:(BOOL)expected {
+    NSString *message = SLLoggerDescriptionOfException(exception, expected);
+    NSString *fileName = [exception userInfo][SLLoggerExceptionFilenameKey];
+    NSNumber *lineNumber = [exception userInfo][SLLoggerExceptionLineNumberKey];
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logStart('Test case \"-[%@ %@]\" started.');", test, testCase];
+    // The exception is logged using `-logError:`, like any other error,
+    // but is described to the event log as a failure or an exception.
+    NSDictionary *info = (fileName && lineNumber) ? @{ @"fileName": fileName, @"lineNumber": @([lineNumber intValue]) } : @{};
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    threadDictionary[kLoggedExceptionInfoKey] = @{ @"type": (expected ? kEventTypeFailure : kEventTypeException), @"info": info };
+    [self logError:message];
+    [threadDictionary removeObjectForKey:kLoggedExceptionInfoKey];
 }
 
-- (void)logTest:(NSString *)test caseFail:(NSString *)testCase expected:(BOOL)expected {
-    if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logTest:test caseFail:testCase expected:expected];
-        });
-        return;
-    }
+- (void)logRetriedException:(NSException *)exception expected:(BOOL)expected {
+    [self logWarning:SLLoggerDescriptionOfException(exception, expected)];
+}
+
+- (void)logTest:(NSString *)test caseStart:(NSString *)testCase {
+    NSString *message = [NSString stringWithFormat:@"Test case \"-[%@ %@]\" started.", test, testCase];
+    SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelMessage type:kEventTypeTestCaseStarted message:message];
+    [record.mutableInfo addEntriesFromDictionary:@{ @"test": test, @"testCase": testCase }];
+    [self logRecord:record flush:YES];
+}
 
+- (void)logTest:(NSString *)test caseFail:(NSString *)testCase expected:(BOOL)expected {
+    SLLogRecord *record;
     if (expected) {
-        [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logFail('Test case \"-[%@ %@]\" failed.');", test, testCase];
+        record = [SLLogRecord recordWithLevel:SLLogLevelError type:kEventTypeTestCaseFailed
+                                      message:[NSString stringWithFormat:@"Test case \"-[%@ %@]\" failed.", test, testCase]];
     } else {
-        [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logIssue('Test case \"-[%@ %@]\" failed unexpectedly.');", test, testCase];
+        record = [SLLogRecord recordWithLevel:SLLogLevelError type:kEventTypeTestCaseFailedUnexpectedly
+                                      message:[NSString stringWithFormat:@"Test case \"-[%@ %@]\" failed unexpectedly.", test, testCase]];
     }
+    [record.mutableInfo addEntriesFromDictionary:@{ @"test": test, @"testCase": testCase }];
+    [self logRecord:record flush:YES];
 }
 
 - (void)logTest:(NSString *)test casePass:(NSString *)testCase {
-    if (![self currentQueueIsLoggingQueue]) {
-        dispatch_sync(_loggingQueue, ^{
-            [self logTest:test casePass:testCase];
-        });
-        return;
-    }
+    NSString *message = [NSString stringWithFormat:@"Test case \"-[%@ %@]\" passed.", test, testCase];
+    SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelMessage type:kEventTypeTestCasePassed message:message];
+    [record.mutableInfo addEntriesFromDictionary:@{ @"test": test, @"testCase": testCase }];
+    [self logRecord:record flush:YES];
+}
+
+- (void)logTest:(NSString *)test caseRetry:(NSString *)testCase afterAttempt:(NSUInteger)attempt {
+    NSString *message = [NSString stringWithFormat:@"Test case \"-[%@ %@]\" failed on attempt %lu, and will be retried.",
+                         test, testCase, (unsigned long)attempt];
+    SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelWarning type:kEventTypeTestCaseRetried message:message];
+    [record.mutableInfo addEntriesFromDictionary:@{ @"test": test, @"testCase": testCase, @"attempt": @(attempt) }];
+    [self logRecord:record flush:YES];
+}
 
-    [[SLTerminal sharedTerminal] evalWithFormat:@"UIALogger.logPass('Test case \"-[%@ %@]\" passed.');", test, testCase];
+- (void)logTest:(NSString *)test caseFlakyPass:(NSString *)testCase numAttempts:(NSUInteger)numAttempts {
+    NSString *message = [NSString stringWithFormat:@"Test case \"-[%@ %@]\" passed on attempt %lu, and may be flaky.",
+                         test, testCase, (unsigned long)numAttempts];
+    SLLogRecord *record = [SLLogRecord recordWithLevel:SLLogLevelWarning type:kEventTypeTestCaseFlakyPassed message:message];
+    [record.mutableInfo addEntriesFromDictionary:@{ @"test": test, @"testCase": testCase, @"numAttempts": @(numAttempts) }];
+    [self logRecord:record flush:YES];
 }
 
 @end
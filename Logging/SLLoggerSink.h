@@ -0,0 +1,121 @@
+//
+//  SLLoggerSink.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ The severity levels at which messages may be logged, in increasing order of severity.
+ */
+typedef NS_ENUM(NSInteger, SLLogLevel) {
+    /// The level of messages logged using `-[SLLogger logDebug:]`.
+    SLLogLevelDebug,
+    /// The level of messages logged using `-[SLLogger logMessage:]` and `SLLog`.
+    SLLogLevelMessage,
+    /// The level of messages logged using `-[SLLogger logWarning:]`.
+    SLLogLevelWarning,
+    /// The level of messages logged using `-[SLLogger logError:]`, and of test failures.
+    SLLogLevelError
+};
+
+
+/**
+ An `SLLogRecord` describes a single event logged by an `SLLogger`,
+ as delivered to the logger's sinks.
+ */
+@interface SLLogRecord : NSObject
+
+/// The time at which the event was logged, in seconds, by a monotonic clock.
+@property (nonatomic, readonly) NSTimeInterval timestamp;
+
+/// The severity of the event.
+@property (nonatomic, readonly) SLLogLevel level;
+
+/**
+ The type of the event.
+
+ This is one of the types listed in the discussion of the event log in `SLLogger`'s
+ class documentation, e.g. `message`, `failure`, or `testCaseStarted`.
+ */
+@property (nonatomic, readonly) NSString *type;
+
+/// The message logged, if any.
+@property (nonatomic, readonly) NSString *message;
+
+/**
+ Additional information about the event, e.g. the test and test case during which
+ it occurred. The keys are the fields described in the discussion of the event log
+ in `SLLogger`'s class documentation.
+ */
+@property (nonatomic, readonly) NSDictionary *info;
+
+/**
+ Returns the current time by the clock used to timestamp records.
+
+ @return The current time, in seconds, by a monotonic clock.
+ */
++ (NSTimeInterval)currentTimestamp;
+
+/**
+ Whether the event describes the progress of the test run, e.g. a test case starting or passing.
+
+ Such events are delivered to every sink regardless of the sink's `minimumLevel`.
+ */
+@property (nonatomic, readonly, getter = isTestStatus) BOOL testStatus;
+
+@end
+
+
+/**
+ The `SLLoggerSink` protocol is adopted by objects to which an `SLLogger`
+ delivers the events that it logs.
+
+ Sinks are [added to](-[SLLogger addSink:]) a logger. The logger buffers the events
+ it logs and delivers them to its sinks in batches, on its
+ [logging queue](-[SLLogger loggingQueue]), in the order in which they were logged.
+ 
+ Subliminal provides sinks which output events to the Automation instrument
+ (`SLUIALoggerSink`), to a file (`SLFileLoggerSink`), to a buffer in memory
+ (`SLRingBufferLoggerSink`), and to `stdout` (`SLStandardOutputLoggerSink`).
+ */
+@protocol SLLoggerSink <NSObject>
+
+/**
+ The minimum level of the events to be delivered to the receiver.
+
+ Events describing the [progress of the test run](-[SLLogRecord isTestStatus])
+ are delivered regardless of this threshold.
+
+ The logger will not format messages of levels lower than the thresholds of all
+ of its sinks; and this threshold may be changed at any time.
+ */
+@property (atomic) SLLogLevel minimumLevel;
+
+/**
+ Outputs the specified events.
+
+ This method is called on the logger's [logging queue](-[SLLogger loggingQueue]).
+
+ @param records An array of `SLLogRecord` objects, in the order in which they were logged.
+ */
+- (void)logRecords:(NSArray *)records;
+
+@end
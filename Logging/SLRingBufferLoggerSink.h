@@ -0,0 +1,69 @@
+//
+//  SLRingBufferLoggerSink.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLLoggerSink.h"
+
+/**
+ An `SLRingBufferLoggerSink` retains the most recent events delivered to it, in memory.
+
+ Such a sink can record detailed (e.g. debug-level) events cheaply, to be
+ examined or output only if necessary, e.g. when a test fails.
+ */
+@interface SLRingBufferLoggerSink : NSObject <SLLoggerSink>
+
+/**
+ Initializes and returns a newly allocated sink which retains up to the specified number of events.
+
+ This is the designated initializer.
+
+ @param capacity The maximum number of events to retain. Must be greater than 0.
+
+ @return An initialized sink.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/// The maximum number of events that the receiver retains.
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/**
+ The minimum level of the events to be retained.
+
+ Defaults to `SLLogLevelDebug`.
+ */
+@property (atomic) SLLogLevel minimumLevel;
+
+/**
+ The events retained by the receiver.
+
+ When more than `capacity` events have been delivered to the receiver,
+ the oldest events are discarded.
+
+ @return An array of `SLLogRecord` objects, in the order in which they were logged.
+ */
+- (NSArray *)records;
+
+/**
+ Discards the events retained by the receiver.
+ */
+- (void)removeAllRecords;
+
+@end
@@ -0,0 +1,77 @@
+//
+//  SLRingBufferLoggerSink.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLRingBufferLoggerSink.h"
+
+@implementation SLRingBufferLoggerSink {
+    // Records are stored in a circular buffer, the oldest record being at `_firstRecordIndex`
+    // once the buffer is full. Guarded by `self`, as the records may be retrieved from any queue.
+    NSMutableArray *_records;
+    NSUInteger _firstRecordIndex;
+}
+
+- (id)init {
+    NSAssert(NO, @"%@ must be initialized using -initWithCapacity:.", NSStringFromClass([self class]));
+    return nil;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    NSParameterAssert(capacity > 0);
+
+    self = [super init];
+    if (self) {
+        _capacity = capacity;
+        _minimumLevel = SLLogLevelDebug;
+        _records = [[NSMutableArray alloc] initWithCapacity:capacity];
+    }
+    return self;
+}
+
+- (void)logRecords:(NSArray *)records {
+    @synchronized(self) {
+        for (SLLogRecord *record in records) {
+            if ([_records count] < _capacity) {
+                [_records addObject:record];
+            } else {
+                _records[_firstRecordIndex] = record;
+                _firstRecordIndex = (_firstRecordIndex + 1) % _capacity;
+            }
+        }
+    }
+}
+
+- (NSArray *)records {
+    @synchronized(self) {
+        NSRange newerRecordsRange = NSMakeRange(_firstRecordIndex, [_records count] - _firstRecordIndex);
+        NSArray *records = [_records subarrayWithRange:newerRecordsRange];
+        return [records arrayByAddingObjectsFromArray:[_records subarrayWithRange:NSMakeRange(0, _firstRecordIndex)]];
+    }
+}
+
+- (void)removeAllRecords {
+    @synchronized(self) {
+        [_records removeAllObjects];
+        _firstRecordIndex = 0;
+    }
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  SLStandardOutputLoggerSink.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLLoggerSink.h"
+
+/**
+ An `SLStandardOutputLoggerSink` writes events to `stdout`, one per line.
+
+ Each line contains the event's timestamp, its level, and its message,
+ e.g. "`  1234.567 Warning: be careful!`". When the application is run from Xcode,
+ the events may thus be viewed in Xcode's console.
+ */
+@interface SLStandardOutputLoggerSink : NSObject <SLLoggerSink>
+
+/**
+ The minimum level of the events to be written to `stdout`.
+
+ Defaults to `SLLogLevelDebug`.
+ */
+@property (atomic) SLLogLevel minimumLevel;
+
+@end
@@ -0,0 +1,57 @@
+//
+//  SLStandardOutputLoggerSink.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLStandardOutputLoggerSink.h"
+
+@implementation SLStandardOutputLoggerSink
+
+- (id)init {
+    self = [super init];
+    if (self) {
+        _minimumLevel = SLLogLevelDebug;
+    }
+    return self;
+}
+
++ (NSString *)nameOfLevel:(SLLogLevel)level {
+    switch (level) {
+        case SLLogLevelDebug:
+            return @"Debug";
+        case SLLogLevelMessage:
+            return @"Default";
+        case SLLogLevelWarning:
+            return @"Warning";
+        case SLLogLevelError:
+            return @"Error";
+    }
+}
+
+- (void)logRecords:(NSArray *)records {
+    for (SLLogRecord *record in records) {
+        NSString *line = [NSString stringWithFormat:@"%10.3f %@: %@\n", record.timestamp,
+                                                    [[self class] nameOfLevel:record.level], record.message];
+        fputs([line UTF8String], stdout);
+    }
+    fflush(stdout);
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  SLUIALoggerSink.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLLoggerSink.h"
+
+/**
+ An `SLUIALoggerSink` outputs events to the Automation instrument, using `UIALogger`.
+
+ The [shared logger](+[SLLogger sharedLogger]) delivers events to such a sink by default.
+ Each batch of events is output using a single evaluation by the `SLTerminal`,
+ so that the sink incurs one round trip to UIAutomation per batch.
+ */
+@interface SLUIALoggerSink : NSObject <SLLoggerSink>
+
+/**
+ The minimum level of the events to be output to the Automation instrument.
+
+ Defaults to `SLLogLevelDebug`.
+ */
+@property (atomic) SLLogLevel minimumLevel;
+
+@end
@@ -0,0 +1,83 @@
+//
+//  SLUIALoggerSink.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLUIALoggerSink.h"
+
+#import "SLTerminal.h"
+#import "SLStringUtilities.h"
+
+@implementation SLUIALoggerSink
+
+- (id)init {
+    self = [super init];
+    if (self) {
+        _minimumLevel = SLLogLevelDebug;
+    }
+    return self;
+}
+
+// Test status events are output using the `UIALogger` functions that
+// delimit test results in the Automation instrument's log.
++ (NSString *)functionForRecord:(SLLogRecord *)record {
+    static NSDictionary *__testStatusFunctions = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        __testStatusFunctions = @{
+            @"testCaseStarted":             @"logStart",
+            @"testCasePassed":              @"logPass",
+            @"testCaseFlakyPassed":         @"logPass",
+            @"testCaseFailed":              @"logFail",
+            @"testCaseFailedUnexpectedly":  @"logIssue"
+        };
+    });
+
+    NSString *function = __testStatusFunctions[record.type];
+    if (!function) {
+        switch (record.level) {
+            case SLLogLevelDebug:
+                function = @"logDebug";
+                break;
+            case SLLogLevelMessage:
+                function = @"logMessage";
+                break;
+            case SLLogLevelWarning:
+                function = @"logWarning";
+                break;
+            case SLLogLevelError:
+                function = @"logError";
+                break;
+        }
+    }
+    return function;
+}
+
+- (void)logRecords:(NSArray *)records {
+    NSMutableString *script = [[NSMutableString alloc] init];
+    for (SLLogRecord *record in records) {
+        [script appendFormat:@"UIALogger.%@('%@');", [[self class] functionForRecord:record],
+                                                     [record.message slStringByEscapingForJavaScriptLiteral]];
+    }
+    // the messages must be output even if the test that logged them has timed out
+    [[SLTerminal sharedTerminal] evalWithoutInterruption:script];
+}
+
+@end
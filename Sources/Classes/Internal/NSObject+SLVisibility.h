@@ -21,6 +21,7 @@
 //
 
 #import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
 
 /**
  The methods in the `NSObject (SLVisibility)` category allow Subliminal 
@@ -39,4 +40,39 @@
  */
 - (BOOL)slAccessibilityIsVisible;
 
+/**
+ Determines if each of the specified objects is visible on the screen.
+
+ This method is equivalent to sending `-slAccessibilityIsVisible` to each object,
+ but renders the view hierarchy (if rendering is necessary) as few times as possible
+ to evaluate all the objects.
+
+ @bug This method always returns `NO` for each object if the device is in a non-portrait
+ orientation: https://github.com/inkling/Subliminal/issues/135 .
+
+ @param objects The objects whose visibility to determine.
+ @return An array of `NSNumber` objects wrapping `BOOL` values, in the order of _objects_,
+ each of which is `YES` if the corresponding object is visible within the accessibility hierarchy,
+ `NO` otherwise.
+ */
++ (NSArray *)slAccessibilityVisibilityOfObjects:(NSArray *)objects;
+
+/**
+ Determines the fraction of the specified object's frame that is visible on the screen.
+
+ Whereas `-slAccessibilityIsVisible` samples the visibility of the object at a few points,
+ this method renders the view hierarchy over the object's entire frame (`accessibilityFrame`).
+ Parts of the frame that lie outside the object's window are considered not to be visible.
+ The frame of a `UIAccessibilityElement` is first clipped to that of the view which contains it.
+
+ @bug This method always returns `0.0` if the device is in a non-portrait
+ orientation: https://github.com/inkling/Subliminal/issues/135 .
+
+ @return The fraction of the receiver's frame which is visible, from `0.0` to `1.0`.
+ `0.0` if the receiver would not be considered visible by `-slAccessibilityIsVisible`
+ because it is hidden, its center lies outside its window, or it is a
+ `UIAccessibilityElement` whose center is covered by a sibling element.
+ */
+- (CGFloat)slAccessibilityVisibleFraction;
+
 @end
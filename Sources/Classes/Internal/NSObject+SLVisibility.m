@@ -22,6 +22,9 @@
 
 #import "NSObject+SLVisibility.h"
 #import "SLLogger.h"
+#import "SLOcclusion.h"
+#import "SLAccessibilityContainerIndex.h"
+#import "SLCoverage.h"
 
 #import <UIKit/UIKit.h>
 #import <QuartzCore/QuartzCore.h>
@@ -30,32 +33,337 @@
 const CGFloat kMinVisibleAlphaFloat = 0.01;
 const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitmap buffers use integer color components.
 
+/// When determining the visible fraction of a view, no more than this many pixels are sampled.
+static const size_t kMaxVisibleFractionSampledPixelCount = 1 << 16;
+
+/**
+ Returns the area in which a view may draw, in its own coordinate system.
+
+ This is the view's bounds, outset to include the view's shadow (if any).
+ */
+static CGRect SLDrawingBoundsOfView(UIView *view) {
+    CALayer *layer = view.layer;
+    CGRect drawingBounds = view.bounds;
+    if ((layer.shadowOpacity > 0.0) && layer.shadowColor) {
+        const CGFloat shadowOutset = (3.0 * layer.shadowRadius) + MAX(fabs(layer.shadowOffset.width), fabs(layer.shadowOffset.height));
+        drawingBounds = CGRectInset(drawingBounds, -shadowOutset, -shadowOutset);
+    }
+    return drawingBounds;
+}
+
+/**
+ Returns the transform which maps points in a view's coordinate system
+ to the coordinate system of a base view, usually the view's window.
+
+ Both the occlusion engine and the renderer position views using this transform,
+ so that they agree as to where each view lies.
+ */
+static CGAffineTransform SLTransformFromViewToBaseView(UIView *view, UIView *baseView) {
+    const CGPoint origin = [view convertPoint:CGPointZero toView:baseView];
+    const CGPoint unitX = [view convertPoint:CGPointMake(1.0, 0.0) toView:baseView];
+    const CGPoint unitY = [view convertPoint:CGPointMake(0.0, 1.0) toView:baseView];
+    return CGAffineTransformMake(unitX.x - origin.x, unitX.y - origin.y,
+                                 unitY.x - origin.x, unitY.y - origin.y,
+                                 origin.x, origin.y);
+}
+
+/**
+ Returns YES if a view draws custom content, i.e. content which cannot be determined
+ from the properties of its layer.
+
+ Views which draw custom content may not yet have set their layers' contents.
+ */
+static BOOL SLViewDrawsCustomContent(UIView *view) {
+    static IMP baseDrawRectImp, baseDrawInContextImp;
+    static NSArray *contentLayerClasses;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        baseDrawRectImp = [UIView instanceMethodForSelector:@selector(drawRect:)];
+        baseDrawInContextImp = [CALayer instanceMethodForSelector:@selector(drawInContext:)];
+        contentLayerClasses = @[ [CAShapeLayer class], [CAGradientLayer class], [CATextLayer class],
+                                 [CAReplicatorLayer class], [CAEmitterLayer class], [CATiledLayer class] ];
+    });
+
+    CALayer *layer = view.layer;
+    if (([[view class] instanceMethodForSelector:@selector(drawRect:)] != baseDrawRectImp) ||
+        ([[layer class] instanceMethodForSelector:@selector(drawInContext:)] != baseDrawInContextImp)) {
+        return YES;
+    }
+    for (Class contentLayerClass in contentLayerClasses) {
+        if ([layer isKindOfClass:contentLayerClass]) return YES;
+    }
+    return NO;
+}
+
+/**
+ Transforms a context from the coordinate system of a layer's superlayer
+ so that the origin is the top left corner of the layer, where
+ `-[CALayer renderInContext:]` renders the layer.
+ */
+static void SLConcatTransformOfSublayer(CGContextRef context, CALayer *sublayer) {
+    const CGRect bounds = sublayer.bounds;
+    const CGPoint anchorPoint = sublayer.anchorPoint;
+    CGContextTranslateCTM(context, sublayer.position.x, sublayer.position.y);
+    CGContextConcatCTM(context, CATransform3DGetAffineTransform(sublayer.transform));
+    CGContextTranslateCTM(context, -(anchorPoint.x * CGRectGetWidth(bounds)), -(anchorPoint.y * CGRectGetHeight(bounds)));
+}
+
+static void SLReleaseMaskData(void *info, const void *data, size_t size) {
+    free((void *)data);
+}
+
+/**
+ Clips a context, in the coordinate system of a layer, to the layer's mask.
+
+ The mask is rendered into a bitmap whose alpha values are then used, as gray levels,
+ to clip the context.
+ */
+static void SLClipContextToMaskOfLayer(CGContextRef context, CALayer *layer) {
+    const CGRect bounds = layer.bounds;
+    const size_t width = (size_t)ceil(CGRectGetWidth(bounds));
+    const size_t height = (size_t)ceil(CGRectGetHeight(bounds));
+    if (!width || !height) {
+        CGContextClipToRect(context, CGRectZero);
+        return;
+    }
+
+    // Render the mask, flipped as is the context, so that rows of pixels are stored top-to-bottom.
+    unsigned char *alphas = (unsigned char *)calloc(width * height, 1);
+    CGContextRef maskContext = CGBitmapContextCreate(alphas, width, height, 8, width, NULL, (CGBitmapInfo)kCGImageAlphaOnly);
+    CGContextTranslateCTM(maskContext, 0.0, height);
+    CGContextScaleCTM(maskContext, 1.0, -1.0);
+    CGContextTranslateCTM(maskContext, -CGRectGetMinX(bounds), -CGRectGetMinY(bounds));
+    SLConcatTransformOfSublayer(maskContext, layer.mask);
+    [layer.mask renderInContext:maskContext];
+    CGContextRelease(maskContext);
+
+    // `CGContextClipToMask` requires a gray image without alpha; the data is freed when the image is.
+    CGColorSpaceRef grayColorSpace = CGColorSpaceCreateDeviceGray();
+    CGDataProviderRef maskDataProvider = CGDataProviderCreateWithData(NULL, alphas, width * height, SLReleaseMaskData);
+    CGImageRef maskImage = CGImageCreate(width, height, 8, 8, width, grayColorSpace, (CGBitmapInfo)kCGImageAlphaNone,
+                                         maskDataProvider, NULL, false, kCGRenderingIntentDefault);
+    CGDataProviderRelease(maskDataProvider);
+    CGColorSpaceRelease(grayColorSpace);
+
+    // Images are drawn upside-down in flipped contexts, so flip the context about the bounds while clipping.
+    const CGFloat flipOffset = CGRectGetMinY(bounds) + CGRectGetMaxY(bounds);
+    CGContextTranslateCTM(context, 0.0, flipOffset);
+    CGContextScaleCTM(context, 1.0, -1.0);
+    CGContextClipToMask(context, CGRectMake(CGRectGetMinX(bounds), CGRectGetMinY(bounds), width, height), maskImage);
+    CGContextScaleCTM(context, 1.0, -1.0);
+    CGContextTranslateCTM(context, 0.0, -flipOffset);
+    CGImageRelease(maskImage);
+}
+
+/**
+ Renders a view's layer into a context without rendering the layers of the view's subviews.
+
+ `-[CALayer renderInContext:]` renders a layer's entire tree. So as not to modify
+ the live layer tree, the view's own content is rendered by a detached layer
+ which copies the background, border, shadow, and contents of the view's layer.
+ Custom content which the view has yet to display is drawn using `-[CALayer drawInContext:]`.
+ Sublayers which do not belong to subviews are then rendered in place,
+ and the whole is clipped to the layer's mask, if any.
+
+ @param view the view to render
+ @param context the drawing context in which to render view, whose origin
+ is the top left corner of view
+ */
+static void SLRenderLayerOfViewExcludingSubviews(UIView *view, CGContextRef context) {
+    CALayer *layer = view.layer;
+    if (![[view subviews] count]) {
+        [layer renderInContext:context];
+        return;
+    }
+
+    // Work in the coordinate system of the layer.
+    CGContextSaveGState(context);
+    const CGRect bounds = layer.bounds;
+    CGContextTranslateCTM(context, -CGRectGetMinX(bounds), -CGRectGetMinY(bounds));
+    if (layer.mask) {
+        SLClipContextToMaskOfLayer(context, layer);
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    CALayer *contentLayer = [[CALayer alloc] init];
+    contentLayer.bounds = bounds;
+    contentLayer.opacity = layer.opacity;
+    contentLayer.backgroundColor = layer.backgroundColor;
+    contentLayer.contents = layer.contents;
+    contentLayer.contentsRect = layer.contentsRect;
+    contentLayer.contentsCenter = layer.contentsCenter;
+    contentLayer.contentsGravity = layer.contentsGravity;
+    contentLayer.contentsScale = layer.contentsScale;
+    contentLayer.masksToBounds = layer.masksToBounds;
+    contentLayer.cornerRadius = layer.cornerRadius;
+    contentLayer.borderWidth = layer.borderWidth;
+    contentLayer.borderColor = layer.borderColor;
+    contentLayer.shadowColor = layer.shadowColor;
+    contentLayer.shadowOpacity = layer.shadowOpacity;
+    contentLayer.shadowOffset = layer.shadowOffset;
+    contentLayer.shadowRadius = layer.shadowRadius;
+    contentLayer.shadowPath = layer.shadowPath;
+    [CATransaction commit];
+    CGContextSaveGState(context);
+    CGContextTranslateCTM(context, CGRectGetMinX(bounds), CGRectGetMinY(bounds));
+    [contentLayer renderInContext:context];
+    CGContextRestoreGState(context);
+
+    if (!layer.contents && SLViewDrawsCustomContent(view)) {
+        CGContextSaveGState(context);
+        if (layer.masksToBounds) {
+            CGContextAddPath(context, [[UIBezierPath bezierPathWithRoundedRect:bounds cornerRadius:layer.cornerRadius] CGPath]);
+            CGContextClip(context);
+        }
+        [layer drawInContext:context];
+        CGContextRestoreGState(context);
+    }
+
+    for (CALayer *sublayer in [layer sublayers]) {
+        if (sublayer.hidden || [[sublayer delegate] isKindOfClass:[UIView class]]) continue;
+
+        CGContextSaveGState(context);
+        SLConcatTransformOfSublayer(context, sublayer);
+        [sublayer renderInContext:context];
+        CGContextRestoreGState(context);
+    }
+
+    CGContextRestoreGState(context);
+}
+
+/**
+ Classifies a view for the purposes of the occlusion engine (see `SLOcclusion.h`).
+
+ A view is transparent if it draws nothing, and opaque if it fills its bounds
+ with an opaque background color. Views which draw content (e.g. images or text),
+ decorate their bounds (e.g. with borders, rounded corners, or shadows), or are translucent
+ cannot be described geometrically and are indeterminate.
+
+ @param view a view which is not in the target view's hierarchy
+ @param alpha the view's effective opacity, i.e. the product of its own and its ancestors' opacity
+ @param drawingBounds on input, the bounds of the view; on output, the area in which
+ the view may draw, which may exceed the view's bounds if the view has a shadow
+
+ @return the kind of node with which to describe view.
+ */
+static SLOcclusionNodeKind SLOcclusionKindOfView(UIView *view, CGFloat alpha, CGRect *drawingBounds) {
+    CALayer *layer = view.layer;
+
+    if ((layer.shadowOpacity > 0.0) && layer.shadowColor) {
+        *drawingBounds = SLDrawingBoundsOfView(view);
+        return SLOcclusionNodeKindIndeterminate;
+    }
+
+    if (layer.contents || layer.mask ||
+        (layer.borderWidth > 0.0) || (layer.cornerRadius > 0.0) ||
+        !CATransform3DIsAffine(layer.transform) || !CATransform3DIsIdentity(layer.sublayerTransform) ||
+        layer.compositingFilter || [layer.filters count] || [layer.backgroundFilters count]) {
+        return SLOcclusionNodeKindIndeterminate;
+    }
+
+    if (SLViewDrawsCustomContent(view)) return SLOcclusionNodeKindIndeterminate;
+
+    // sublayers which do not belong to subviews may draw content
+    for (CALayer *sublayer in [layer sublayers]) {
+        if (![[sublayer delegate] isKindOfClass:[UIView class]]) return SLOcclusionNodeKindIndeterminate;
+    }
+
+    const CGFloat backgroundAlpha = (layer.backgroundColor ? CGColorGetAlpha(layer.backgroundColor) : 0.0);
+    alpha *= backgroundAlpha;
+
+    if (alpha < kMinVisibleAlphaFloat) {
+        return SLOcclusionNodeKindTransparent;
+    } else if (alpha >= 1.0) {
+        return SLOcclusionNodeKindOpaque;
+    } else {
+        return SLOcclusionNodeKindIndeterminate;
+    }
+}
+
+
 @interface UIView (SLVisibility)
 
 /**
  Renders the input view and that views hierarchy using compositing options that
- cause the target view and all of its subviews to be drawn as black rectangles,
- while every view not in the hierarchy of the target renders with kCGBlendModeDestinationOut.
- The result is a rendering with black or gray pixels everywhere that the target view is visible.
- Pixels will be black where the target view is not occluded at all, and gray where the target view
+ cause each target view and all of its subviews to be drawn as rectangles of that target's color,
+ while every view not in the hierarchy of a target renders with kCGBlendModeDestinationOut.
+ The result is a rendering with colored pixels everywhere that a target view is visible.
+ Pixels will be opaque where the target view is not occluded at all, and translucent where the target view
  is occluded by views that are not fully opaque.
 
+ Each view's own content is drawn exactly once. Views which cannot draw within
+ testRect are not drawn, and subtrees clipped to bounds outside testRect are skipped.
+
  @param view the view to be rendered
  @param context the drawing context in which to render view
- @param target the view whose hierarchy should be drawn as black rectangles
+ @param targetColors the colors with which to draw the target views,
+ keyed by `+[NSValue valueWithNonretainedObject:]` values wrapping the target views
  @param baseView the view which provides the base coordinate system for the rendering, usually target's window.
+ @param testRect the area of interest, in the coordinate system of baseView
+ @param targetColor the color of the target of which view is a descendant, or nil if view is not a descendant of a target
  */
-- (void)renderViewRecursively:(UIView *)view inContext:(CGContextRef)context withTargetView:(UIView *)target baseView:(UIView *)baseView;
+- (void)renderViewRecursively:(UIView *)view inContext:(CGContextRef)context withTargetColors:(NSDictionary *)targetColors
+                     baseView:(UIView *)baseView testRect:(CGRect)testRect targetColor:(UIColor *)targetColor;
 
 /**
- Returns the number of points from a set of test points for which the receiver is visible onscreen.
+ Flattens the input view's hierarchy into an array of `SLOcclusionNode`s, in drawing order,
+ for use by the occlusion engine.
+
+ Subtrees which are clipped to bounds that do not intersect _testRect_ are omitted,
+ as are views which draw nothing and do not clip their descendants.
+
+ @param view the view whose hierarchy should be flattened
+ @param target the view whose hierarchy should be described by target nodes
+ @param baseView the view which provides the base coordinate system, usually target's window
+ @param testRect the area within which visibility will be tested, in the coordinate system of baseView
+ @param clipIndex the index of the nearest node which clips view, or -1 if there is none
+ @param isInTarget YES if view is a descendant of target, NO otherwise
+ @param inheritedAlpha the product of the opacity of view's ancestors
+ @param nodes the array to which nodes should be appended
+ */
+- (void)appendOcclusionNodesForView:(UIView *)view withTargetView:(UIView *)target baseView:(UIView *)baseView
+                           testRect:(CGRect)testRect clipIndex:(long)clipIndex isInTarget:(BOOL)isInTarget
+                     inheritedAlpha:(CGFloat)inheritedAlpha toNodes:(NSMutableData *)nodes;
+
+/**
+ Determines, for each of a set of test points, whether the receiver is visible onscreen
+ as determined from the geometry of the view hierarchy.
+
+ @param visibilities a C array of length numPoints which, on return, will contain
+ the visibility of the receiver at each point. The visibility will be
+ `SLOcclusionVisibilityIndeterminate` if a view which may cover the point has
+ non-trivial content or is translucent.
+ @param testPointsInWindow a C array of points to test for visibility
+ @param numPoints the number of elements in testPointsInWindow
+ */
+- (void)getGeometricVisibilities:(SLOcclusionVisibility *)visibilities ofPoints:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints;
+
+/**
+ Returns the number of points from a set of test points for which the receiver is visible onscreen,
+ as determined by rendering the view hierarchy.
 
  @param testPointsInWindow a C array of points to test for visibility
  @param numPoints the number of elements in testPointsInWindow
 
  @return the number of points from testPointsInWindow at which the receiver is visible.
  */
-- (NSUInteger)numberOfVisiblePointsFromSet:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints;
+- (NSUInteger)numberOfRenderedVisiblePointsFromSet:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints;
+
+/**
+ Computes the points at which to test the visibility of the receiver within the specified rect,
+ if the receiver could be visible within that rect.
+
+ @param testPointsInWindow a C array of length 5 which, on return, will contain the center
+ of rect followed by its top-left, top-right, bottom-left, and bottom-right corners,
+ in the coordinate system of the receiver's window.
+ @param rect The area in which to determine if the receiver is visible. This value should
+ be provided in screen coordinates.
+
+ @return NO if the receiver cannot be visible within rect, e.g. because it is hidden
+ or because the center of rect is not within its window; YES otherwise.
+ */
+- (BOOL)getVisibilityTestPoints:(CGPoint *)testPointsInWindow forRect:(CGRect)rect;
 
 /**
  Determines if the section of the object located within the specified rect is visible
@@ -69,19 +377,452 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
  */
 - (BOOL)slAccessibilityRectIsVisible:(CGRect)rect;
 
+/**
+ Determines the fraction of the specified rect in which the receiver is visible on the screen.
+
+ @param rect The area in which to determine the visibility of the receiver. This value should
+ be provided in screen coordinates.
+
+ @return The fraction of rect in which the receiver is visible, from 0.0 to 1.0.
+ */
+- (CGFloat)slAccessibilityVisibleFractionOfRect:(CGRect)rect;
+
 @end
 
 
+@interface NSObject (SLVisibilityTarget)
+
+/**
+ Locates the view within which the visibility of the receiver should be determined.
+
+ @param rect on return, the area of the view in which to determine the visibility
+ of the receiver, in screen coordinates.
+
+ @return the view in which to determine the visibility of the receiver,
+ or nil if the receiver cannot be visible (or cannot be located).
+ */
+- (UIView *)slAccessibilityVisibilityTargetViewWithRect:(CGRect *)rect;
+
+@end
+
+
+#pragma mark - Determining visibility
+
+/// The number of points at which the visibility of a rect is tested: its center, followed by its four corners.
+/// (Declared as an enumerator so that it may size the arrays of `SLVisibilityTest`.)
+enum { kNumVisibilityTestPoints = 5 };
+
+/// When rendering multiple targets at once, the target visible at a pixel is identified
+/// by the pixel's color, which can only be reliably decoded from pixels at least this opaque.
+static const unsigned char kMinDecodableAlphaInt = 64;
+
+/// Describes the test of an object's visibility within a rect of a view.
+typedef struct {
+    __unsafe_unretained UIView *view;
+    CGPoint testPointsInWindow[kNumVisibilityTestPoints];
+    SLOcclusionVisibility visibilities[kNumVisibilityTestPoints];
+    BOOL isDetermined;
+    BOOL isVisible;
+} SLVisibilityTest;
+
+/**
+ Attempts to determine the visibility of a test from the visibilities of its test points.
+
+ Subliminal's visibility rules are:
+ 1.  If the center is visible then the view is visible.
+ 2.  If the center is not visible *and* at least one corner is not visible then the view is not visible.
+ 3.  If the center is not visible but *all four* corners are visible (strange as that would be) the view is visible.
+
+ @return YES if the visibility of test was determined, NO otherwise.
+ */
+static BOOL SLVisibilityTestResolve(SLVisibilityTest *test) {
+    if (test->isDetermined) return YES;
+
+    switch (test->visibilities[0]) {
+        case SLOcclusionVisibilityVisible:
+            test->isVisible = YES;
+            break;
+        case SLOcclusionVisibilityOccluded: {
+            // View with a covered center is visible only if all four corners are visible.
+            BOOL allCornersAreVisible = YES;
+            for (NSUInteger j = 1; j < kNumVisibilityTestPoints; j++) {
+                switch (test->visibilities[j]) {
+                    case SLOcclusionVisibilityVisible:
+                        break;
+                    case SLOcclusionVisibilityOccluded:
+                        allCornersAreVisible = NO;
+                        break;
+                    case SLOcclusionVisibilityIndeterminate:
+                        // we can't determine visibility if we don't know whether the other corners are visible
+                        if (allCornersAreVisible) return NO;
+                        break;
+                }
+            }
+            test->isVisible = allCornersAreVisible;
+            break;
+        }
+        case SLOcclusionVisibilityIndeterminate:
+            return NO;
+    }
+    test->isDetermined = YES;
+    return YES;
+}
+
+/**
+ Returns the color in which to render the target with the specified index.
+
+ Each color component encodes 5 bits of the index, in the center of an 8-unit band,
+ so that the index may be recovered from pixels which have been partially erased.
+ */
+static UIColor *SLColorForTargetIndex(NSUInteger targetIndex) {
+    NSCParameterAssert(targetIndex < (1 << 15) - 1);
+    // reserve 0 for pixels at which no target is visible
+    const NSUInteger targetID = targetIndex + 1;
+    return [UIColor colorWithRed:((((targetID >> 10) & 0x1F) * 8) + 4) / 255.0
+                           green:((((targetID >> 5) & 0x1F) * 8) + 4) / 255.0
+                            blue:(((targetID & 0x1F) * 8) + 4) / 255.0
+                           alpha:1.0];
+}
+
+/**
+ Returns the index of the target visible at the specified pixel, per `SLColorForTargetIndex`.
+
+ @param pixel a premultiplied RGBA pixel
+ @return the index of the target visible at the pixel, or NSNotFound if no target is visible.
+ */
+static NSUInteger SLTargetIndexForPixel(const unsigned char *pixel) {
+    const unsigned char alpha = pixel[3];
+    if (alpha < kMinVisibleAlphaInt) return NSNotFound;
+
+    NSUInteger targetID = 0;
+    for (NSUInteger component = 0; component < 3; component++) {
+        const double unpremultipliedValue = ((double)pixel[component] * 255.0) / alpha;
+        targetID = (targetID << 5) | (MIN((NSUInteger)(unpremultipliedValue / 8.0), (NSUInteger)0x1F));
+    }
+    return ((targetID > 0) ? targetID - 1 : NSNotFound);
+}
+
+/**
+ Renders the lowest target window and the windows above it into a newly allocated bitmap.
+
+ @param targetViews the views to render as rectangles of the colors returned by `SLColorForTargetIndex`
+ @param testRect the area to render, in the coordinate system of the targets' windows.
+ The origin and size of this rect must be integral.
+ @param clipRects a C array of rects, in the coordinate system of the targets' windows,
+ to which to restrict the rendering. Pixels outside these rects will be transparent.
+ @param numClipRects the number of elements in clipRects
+
+ @return a buffer of `4 * width * height` bytes, where `width` and `height` are
+ the dimensions of testRect, containing the rendering as premultiplied RGBA pixels,
+ top row first. The caller is responsible for freeing this buffer.
+ */
+static unsigned char *SLCreateRenderingOfTargetViews(NSArray *targetViews, CGRect testRect,
+                                                     const CGRect *clipRects, size_t numClipRects) {
+    static CGColorSpaceRef rgbColorSpace;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        rgbColorSpace = CGColorSpaceCreateDeviceRGB();
+    });
+
+    NSCParameterAssert(CGRectEqualToRect(testRect, CGRectIntegral(testRect)));
+
+    const size_t columns = CGRectGetWidth(testRect);
+    const size_t rows = CGRectGetHeight(testRect);
+    unsigned char *pixels = (unsigned char *)calloc(columns * rows * 4, 1);
+    CGContextRef context = CGBitmapContextCreate(pixels, columns, rows, 8, 4 * columns, rgbColorSpace, kCGBitmapAlphaInfoMask & kCGImageAlphaPremultipliedLast);
+    // Flip the context, as UIKit does, so that rows of pixels are stored top-to-bottom.
+    CGContextTranslateCTM(context, 0.0, rows);
+    CGContextScaleCTM(context, 1.0, -1.0);
+    CGContextTranslateCTM(context, -CGRectGetMinX(testRect), -CGRectGetMinY(testRect));
+    CGContextClipToRects(context, clipRects, numClipRects);
+
+    // Render the lowest target window and the windows above it:
+    // a target view's rendered opacity will be reduced
+    // if the contents of a window above the target window occlude the target view.
+    NSArray *windows = [[UIApplication sharedApplication] windows];
+    NSUInteger lowestTargetWindowIndex = NSNotFound;
+    NSMutableDictionary *targetColors = [[NSMutableDictionary alloc] initWithCapacity:[targetViews count]];
+    [targetViews enumerateObjectsUsingBlock:^(UIView *targetView, NSUInteger targetIndex, BOOL *stop) {
+        targetColors[[NSValue valueWithNonretainedObject:targetView]] = SLColorForTargetIndex(targetIndex);
+    }];
+    for (UIView *targetView in targetViews) {
+        UIWindow *targetWindow = targetView.window;
+        NSCAssert(targetWindow, @"%@ has not been added to a window.", targetView);
+        NSUInteger targetWindowIndex = [windows indexOfObject:targetWindow];
+        NSCAssert(targetWindowIndex != NSNotFound, @"`The window of %@ has never been made key and visible.", targetView);
+        lowestTargetWindowIndex = MIN(lowestTargetWindowIndex, targetWindowIndex);
+    }
+    for (NSUInteger windowIndex = lowestTargetWindowIndex; windowIndex < [windows count]; windowIndex++) {
+        UIWindow *window = windows[windowIndex];
+        [window renderViewRecursively:window inContext:context withTargetColors:targetColors
+                             baseView:window testRect:testRect targetColor:nil];
+    }
+
+    CGContextRelease(context);
+    return pixels;
+}
+
+/**
+ Renders the target window and the windows above it once, to determine the visibility
+ of several target views at several points.
+
+ @param targetViews the views whose visibility is to be determined
+ @param visibilities a C array of length numPoints which, on return, will contain the visibility
+ of the corresponding target at each point. The visibility will be `SLOcclusionVisibilityIndeterminate`
+ if the pixel at the point could not be reliably decoded, which is only possible if there is more than one target.
+ @param testPointsInWindow a C array of points to test for visibility
+ @param targetIndexes a C array of length numPoints identifying the target (within targetViews)
+ whose visibility is to be tested at each point
+ @param numPoints the number of elements in testPointsInWindow
+ */
+static void SLRenderTargetViews(NSArray *targetViews, SLOcclusionVisibility *visibilities,
+                                const CGPoint *testPointsInWindow, const NSUInteger *targetIndexes, NSUInteger numPoints) {
+    NSCParameterAssert(numPoints > 0);
+    NSCParameterAssert(testPointsInWindow != NULL);
+
+    // Allocate a buffer sufficiently large to store a rendering that could possibly cover all the test points.
+    int x = rintf(testPointsInWindow[0].x);
+    int y = rintf(testPointsInWindow[0].y);
+    int minX = x;
+    int maxX = x;
+    int minY = y;
+    int maxY = y;
+    for (NSUInteger j = 1; j < numPoints; j++) {
+        x = rintf(testPointsInWindow[j].x);
+        y = rintf(testPointsInWindow[j].y);
+        minX = MIN(minX, x);
+        maxX = MAX(maxX, x);
+        minY = MIN(minY, y);
+        maxY = MAX(maxY, y);
+    }
+    NSCAssert(maxX >= minX, @"maxX (%d) should be greater than or equal to minX (%d)", maxX, minX);
+    NSCAssert(maxY >= minY, @"maxY (%d) should be greater than or equal to minY (%d)", maxY, minY);
+    size_t columns = maxX - minX + 1;
+    size_t rows = maxY - minY + 1;
+
+    // Only the pixels at the test points need be rendered.
+    CGRect *testPixelRects = (CGRect *)malloc(numPoints * sizeof(CGRect));
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        testPixelRects[j] = CGRectMake(rintf(testPointsInWindow[j].x), rintf(testPointsInWindow[j].y), 1.0, 1.0);
+    }
+    unsigned char *pixels = SLCreateRenderingOfTargetViews(targetViews, CGRectMake(minX, minY, columns, rows),
+                                                           testPixelRects, numPoints);
+    free(testPixelRects);
+
+    const BOOL mustDecodeTargets = ([targetViews count] > 1);
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        int x = rintf(testPointsInWindow[j].x);
+        int y = rintf(testPointsInWindow[j].y);
+        NSCAssert(x >= minX, @"Invalid x encountered, %d, but min is %d", x, minX);
+        NSCAssert(y >= minY, @"Invalid y encountered, %d, but min is %d", y, minY);
+        NSUInteger col = x - minX;
+        NSUInteger row = y - minY;
+        NSUInteger pixelIndex = row * columns + col;
+        NSCAssert(pixelIndex < columns * rows, @"Encountered invalid pixel index: %lu", (unsigned long)pixelIndex);
+        const unsigned char *pixel = &pixels[4 * pixelIndex];
+        if (pixel[3] < kMinVisibleAlphaInt) {
+            visibilities[j] = SLOcclusionVisibilityOccluded;
+        } else if (!mustDecodeTargets) {
+            visibilities[j] = SLOcclusionVisibilityVisible;
+        } else if (pixel[3] < kMinDecodableAlphaInt) {
+            visibilities[j] = SLOcclusionVisibilityIndeterminate;
+        } else {
+            visibilities[j] = ((SLTargetIndexForPixel(pixel) == targetIndexes[j]) ? SLOcclusionVisibilityVisible
+                                                                                 : SLOcclusionVisibilityOccluded);
+        }
+    }
+
+    free(pixels);
+}
+
+/**
+ Returns the area of a view and its visible descendants, in the coordinate system of its window.
+ */
+static CGRect SLRectOfViewHierarchyInWindow(UIView *view, UIWindow *window) {
+    CGRect rect = [window convertRect:view.bounds fromView:view];
+    for (UIView *subview in [view subviews]) {
+        if (subview.hidden || subview.alpha < kMinVisibleAlphaFloat) continue;
+        rect = CGRectUnion(rect, SLRectOfViewHierarchyInWindow(subview, window));
+    }
+    return rect;
+}
+
+/**
+ Determines whether rendering targets together could change the visibility of either.
+
+ When targets are rendered separately, each draws over the other only as much as its content does.
+ When targets are rendered together, each fills its area with its color. So targets may only be
+ rendered together if neither contains the other, and if neither target's area contains
+ the other target's test points.
+ */
+static BOOL SLVisibilityTestsConflict(const SLVisibilityTest *test1, CGRect hierarchyRect1,
+                                      const SLVisibilityTest *test2, CGRect hierarchyRect2) {
+    if (test1->view == test2->view) return NO;
+    if ([test1->view isDescendantOfView:test2->view] || [test2->view isDescendantOfView:test1->view]) return YES;
+
+    for (NSUInteger j = 0; j < kNumVisibilityTestPoints; j++) {
+        if ((test1->visibilities[j] == SLOcclusionVisibilityIndeterminate) &&
+            CGRectContainsPoint(hierarchyRect2, test1->testPointsInWindow[j])) return YES;
+        if ((test2->visibilities[j] == SLOcclusionVisibilityIndeterminate) &&
+            CGRectContainsPoint(hierarchyRect1, test2->testPointsInWindow[j])) return YES;
+    }
+    return NO;
+}
+
+/**
+ Determines the visibility of each of the specified tests.
+
+ Visibility is determined from the geometry of the view hierarchy if possible.
+ The remaining tests are determined by rendering the view hierarchy, as few times as possible:
+ once, unless the tests' targets conflict (see `SLVisibilityTestsConflict`).
+ */
+static void SLDetermineVisibility(SLVisibilityTest *tests, NSUInteger numTests) {
+    NSMutableArray *pendingTestIndexes = [[NSMutableArray alloc] init];
+    for (NSUInteger testIndex = 0; testIndex < numTests; testIndex++) {
+        SLVisibilityTest *test = &tests[testIndex];
+        if (test->isDetermined) continue;
+
+        [test->view getGeometricVisibilities:test->visibilities ofPoints:test->testPointsInWindow count:kNumVisibilityTestPoints];
+        if (!SLVisibilityTestResolve(test)) [pendingTestIndexes addObject:@(testIndex)];
+    }
+
+    while ([pendingTestIndexes count]) {
+        // Select the tests to render in this pass.
+        NSMutableArray *passTestIndexes = [[NSMutableArray alloc] init];
+        NSMutableArray *deferredTestIndexes = [[NSMutableArray alloc] init];
+        CGRect *hierarchyRects = (CGRect *)malloc([pendingTestIndexes count] * sizeof(CGRect));
+        for (NSNumber *testIndexNumber in pendingTestIndexes) {
+            const NSUInteger testIndex = [testIndexNumber unsignedIntegerValue];
+            const SLVisibilityTest *test = &tests[testIndex];
+            const CGRect hierarchyRect = SLRectOfViewHierarchyInWindow(test->view, test->view.window);
+
+            BOOL conflicts = NO;
+            for (NSUInteger passIndex = 0; passIndex < [passTestIndexes count]; passIndex++) {
+                const SLVisibilityTest *passTest = &tests[[passTestIndexes[passIndex] unsignedIntegerValue]];
+                if (SLVisibilityTestsConflict(test, hierarchyRect, passTest, hierarchyRects[passIndex])) {
+                    conflicts = YES;
+                    break;
+                }
+            }
+            if (conflicts) {
+                [deferredTestIndexes addObject:testIndexNumber];
+            } else {
+                hierarchyRects[[passTestIndexes count]] = hierarchyRect;
+                [passTestIndexes addObject:testIndexNumber];
+            }
+        }
+        free(hierarchyRects);
+
+        // Collect the indeterminate points of the tests in this pass, and their targets.
+        NSMutableArray *targetViews = [[NSMutableArray alloc] init];
+        const NSUInteger maxNumPoints = [passTestIndexes count] * kNumVisibilityTestPoints;
+        CGPoint *points = (CGPoint *)malloc(maxNumPoints * sizeof(CGPoint));
+        NSUInteger *targetIndexes = (NSUInteger *)malloc(maxNumPoints * sizeof(NSUInteger));
+        SLOcclusionVisibility *visibilities = (SLOcclusionVisibility *)malloc(maxNumPoints * sizeof(SLOcclusionVisibility));
+        NSUInteger numPoints = 0;
+        for (NSNumber *testIndexNumber in passTestIndexes) {
+            const SLVisibilityTest *test = &tests[[testIndexNumber unsignedIntegerValue]];
+            NSUInteger targetIndex = [targetViews indexOfObjectIdenticalTo:test->view];
+            if (targetIndex == NSNotFound) {
+                targetIndex = [targetViews count];
+                [targetViews addObject:test->view];
+            }
+            for (NSUInteger j = 0; j < kNumVisibilityTestPoints; j++) {
+                if (test->visibilities[j] != SLOcclusionVisibilityIndeterminate) continue;
+                points[numPoints] = test->testPointsInWindow[j];
+                targetIndexes[numPoints] = targetIndex;
+                numPoints++;
+            }
+        }
+
+        SLRenderTargetViews(targetViews, visibilities, points, targetIndexes, numPoints);
+
+        // Distribute the results. Tests whose pixels could not be decoded are rendered again, alone.
+        numPoints = 0;
+        for (NSNumber *testIndexNumber in passTestIndexes) {
+            SLVisibilityTest *test = &tests[[testIndexNumber unsignedIntegerValue]];
+            BOOL isAmbiguous = NO;
+            for (NSUInteger j = 0; j < kNumVisibilityTestPoints; j++) {
+                if (test->visibilities[j] != SLOcclusionVisibilityIndeterminate) continue;
+                if (visibilities[numPoints] == SLOcclusionVisibilityIndeterminate) {
+                    isAmbiguous = YES;
+                } else {
+                    test->visibilities[j] = visibilities[numPoints];
+                }
+                numPoints++;
+            }
+            if (!SLVisibilityTestResolve(test)) {
+                NSCAssert(isAmbiguous, @"The visibility of %@ should have been determined by rendering.", test->view);
+                [deferredTestIndexes addObject:testIndexNumber];
+            }
+        }
+
+        free(points);
+        free(targetIndexes);
+        free(visibilities);
+
+        pendingTestIndexes = deferredTestIndexes;
+    }
+}
+
+
 @implementation NSObject (SLVisibility)
 
+- (BOOL)slAccessibilityIsVisible {
+    CGRect rect;
+    UIView *view = [self slAccessibilityVisibilityTargetViewWithRect:&rect];
+    return (view && [view slAccessibilityRectIsVisible:rect]);
+}
+
+- (CGFloat)slAccessibilityVisibleFraction {
+    CGRect rect;
+    UIView *view = [self slAccessibilityVisibilityTargetViewWithRect:&rect];
+    return (view ? [view slAccessibilityVisibleFractionOfRect:rect] : 0.0);
+}
+
++ (NSArray *)slAccessibilityVisibilityOfObjects:(NSArray *)objects {
+    const NSUInteger numTests = [objects count];
+    SLVisibilityTest *tests = (SLVisibilityTest *)calloc(MAX(numTests, (NSUInteger)1), sizeof(SLVisibilityTest));
+
+    // retain the target views for the duration of the tests
+    NSMutableArray *targetViews = [[NSMutableArray alloc] initWithCapacity:numTests];
+    for (NSUInteger testIndex = 0; testIndex < numTests; testIndex++) {
+        SLVisibilityTest *test = &tests[testIndex];
+        CGRect rect;
+        UIView *view = [objects[testIndex] slAccessibilityVisibilityTargetViewWithRect:&rect];
+        if (view && [view getVisibilityTestPoints:test->testPointsInWindow forRect:rect]) {
+            [targetViews addObject:view];
+            test->view = view;
+        } else {
+            test->isDetermined = YES;
+            test->isVisible = NO;
+        }
+    }
+
+    SLDetermineVisibility(tests, numTests);
+
+    NSMutableArray *visibilities = [[NSMutableArray alloc] initWithCapacity:numTests];
+    for (NSUInteger testIndex = 0; testIndex < numTests; testIndex++) {
+        [visibilities addObject:@(tests[testIndex].isVisible)];
+    }
+    free(tests);
+
+    return visibilities;
+}
+
+@end
+
+
+@implementation NSObject (SLVisibilityTarget)
+
 // There are objects in the accessibility hierarchy which are neither UIAccessibilityElements
 // nor UIViews, e.g. the elements vended by UIWebBrowserViews. For these objects we cannot
 // determine whether or not they are visible directly, instead we determine whether the area
 // they occupy is visible within their first UIView accessibility ancestor.
-- (BOOL)slAccessibilityIsVisible {
+- (UIView *)slAccessibilityVisibilityTargetViewWithRect:(CGRect *)rect {
     if (![self respondsToSelector:@selector(accessibilityContainer)]) {
-        SLLogAsync(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
-        return NO;
+        SLLogOnce(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
+        return nil;
     }
 
     id container = [self performSelector:@selector(accessibilityContainer)];
@@ -93,24 +834,24 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
         // it's not a requirement that accessibility containers vend UIAccessibilityElements,
         // so it might not be possible to traverse the hierarchy upwards
         if (![container respondsToSelector:@selector(accessibilityContainer)]) {
-            SLLogAsync(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
-            return NO;
+            SLLogOnce(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
+            return nil;
         }
         container = [container accessibilityContainer];
     }
 
     NSAssert([container isKindOfClass:[UIView class]],
              @"Every accessibility hierarchy should be rooted in a view.");
-    UIView *viewContainer = (UIView *)container;
-    return [viewContainer slAccessibilityRectIsVisible:self.accessibilityFrame];
+    *rect = self.accessibilityFrame;
+    return (UIView *)container;
 }
 
 @end
 
 
-@implementation UIAccessibilityElement (SLVisibility)
+@implementation UIAccessibilityElement (SLVisibilityTarget)
 
-- (BOOL)slAccessibilityIsVisible {
+- (UIView *)slAccessibilityVisibilityTargetViewWithRect:(CGRect *)rect {
     CGPoint testPoint = CGPointMake(CGRectGetMidX(self.accessibilityFrame),
                                     CGRectGetMidY(self.accessibilityFrame));
 
@@ -120,17 +861,22 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
     while (container) {
         // UIAutomation ignores accessibilityElementsHidden, so we do too
 
-        NSInteger elementCount = [container accessibilityElementCount];
-        NSAssert(((elementCount != NSNotFound) && (elementCount > 0)),
-                 @"%@'s accessibility container should implement the UIAccessibilityContainer protocol.", self);
-        for (NSInteger idx = 0; idx < elementCount; idx++) {
-            id element = [container accessibilityElementAtIndex:idx];
-            if (element == parentOrSelf) break;
-
-            // if another element comes before us/our parent in the array
-            // (thus is z-ordered before us/our parent)
-            // and contains our hitpoint, it covers us
-            if (CGRectContainsPoint([element accessibilityFrame], testPoint)) return NO;
+        // if another element comes before us/our parent in the array
+        // (thus is z-ordered before us/our parent)
+        // and contains our hitpoint, it covers us
+        SLAccessibilityContainerIndex *containerIndex = [SLAccessibilityContainerIndex indexForContainer:container];
+        if (containerIndex) {
+            if ([containerIndex elementBeforeElement:parentOrSelf containsPoint:testPoint]) return nil;
+        } else {
+            NSInteger elementCount = [container accessibilityElementCount];
+            NSAssert(((elementCount != NSNotFound) && (elementCount > 0)),
+                     @"%@'s accessibility container should implement the UIAccessibilityContainer protocol.", self);
+            for (NSInteger idx = 0; idx < elementCount; idx++) {
+                id element = [container accessibilityElementAtIndex:idx];
+                if (element == parentOrSelf) break;
+
+                if (CGRectContainsPoint([element accessibilityFrame], testPoint)) return nil;
+            }
         }
 
         // we should eventually reach a container that is a view
@@ -141,8 +887,8 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
         // it's not a requirement that accessibility containers vend UIAccessibilityElements,
         // so it might not be possible to traverse the hierarchy upwards
         if (![container respondsToSelector:@selector(accessibilityContainer)]) {
-            SLLogAsync(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
-            return NO;
+            SLLogOnce(@"Cannot locate %@ in the accessibility hierarchy. Returning -NO from -slAccessibilityIsVisible.", self);
+            return nil;
         }
         parentOrSelf = container;
         container = [container accessibilityContainer];
@@ -151,7 +897,34 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
     NSAssert([container isKindOfClass:[UIView class]],
              @"Every accessibility hierarchy should be rooted in a view.");
     UIView *viewContainer = (UIView *)container;
-    return [viewContainer slAccessibilityIsVisible];
+    *rect = viewContainer.accessibilityFrame;
+    return viewContainer;
+}
+
+@end
+
+
+@implementation UIAccessibilityElement (SLVisibility)
+
+- (CGFloat)slAccessibilityVisibleFraction {
+    // `-slAccessibilityIsVisible` tests the area of our container, having determined
+    // that we are foremost within it, but the fraction should be measured over our own area
+    CGRect containerRect;
+    UIView *view = [self slAccessibilityVisibilityTargetViewWithRect:&containerRect];
+    if (!view) return 0.0;
+
+    CGRect rect = CGRectIntersection(self.accessibilityFrame, containerRect);
+    return (CGRectIsEmpty(rect) ? 0.0 : [view slAccessibilityVisibleFractionOfRect:rect]);
+}
+
+@end
+
+
+@implementation UIView (SLVisibilityTarget)
+
+- (UIView *)slAccessibilityVisibilityTargetViewWithRect:(CGRect *)rect {
+    *rect = self.accessibilityFrame;
+    return self;
 }
 
 @end
@@ -159,124 +932,167 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
 
 @implementation UIView (SLVisibility)
 
-- (void)renderViewRecursively:(UIView *)view inContext:(CGContextRef)context withTargetView:(UIView *)target baseView:(UIView *)baseView {
+- (void)renderViewRecursively:(UIView *)view inContext:(CGContextRef)context withTargetColors:(NSDictionary *)targetColors
+                     baseView:(UIView *)baseView testRect:(CGRect)testRect targetColor:(UIColor *)targetColor {
     // Skip any views that are hidden or have alpha < kMinVisibleAlphaFloat.
     if (view.hidden || view.alpha < kMinVisibleAlphaFloat) {
         return;
     }
 
+    if (!targetColor) {
+        targetColor = targetColors[[NSValue valueWithNonretainedObject:view]];
+    }
+
+    // If the view clips its subviews to bounds outside the test rect,
+    // neither it nor its subviews can affect the rendering.
+    const CGAffineTransform localToBase = SLTransformFromViewToBaseView(view, baseView);
+    const CGRect viewRectInBase = CGRectApplyAffineTransform(view.bounds, localToBase);
+    const BOOL clipsToBounds = [view clipsToBounds];
+    if (clipsToBounds && !CGRectIntersectsRect(viewRectInBase, testRect)) {
+        return;
+    }
+
     // Push the drawing state to save the clip mask.
     CGContextSaveGState(context);
-    if ([view clipsToBounds]) {
-        CGContextClipToRect(context, [baseView convertRect:view.bounds fromView:view]);
+    if (clipsToBounds) {
+        CGContextClipToRect(context, viewRectInBase);
     }
 
-    // Push the drawing state to save the CTM.
-    CGContextSaveGState(context);
+    // Only render the view if it may draw within the test rect.
+    const CGRect drawingRectInBase = (targetColor ? viewRectInBase
+                                                  : CGRectApplyAffineTransform(SLDrawingBoundsOfView(view), localToBase));
+    if (CGRectIntersectsRect(drawingRectInBase, testRect)) {
+        // Push the drawing state to save the CTM.
+        CGContextSaveGState(context);
 
-    // Apply a transform that takes the origin to view's top left corner.
-    const CGPoint viewOrigin = [baseView convertPoint:view.bounds.origin fromView:view];
-    CGContextTranslateCTM(context, viewOrigin.x, viewOrigin.y);
-
-    // If this is *not* in our target view's hierarchy then use the destination
-    // out blend mode to reduce the visibility of any already painted pixels by
-    // the alpha of the current view.
-    //
-    // If this is in our target view's hierarchy then just draw a black rectangle
-    // covering the whole thing.
-    if (![view isDescendantOfView:target]) {
-        CGContextSetBlendMode(context, kCGBlendModeDestinationOut);
-        // Draw the view.  I haven't found anything better than this, unfortunately.
-        // renderInContext is pretty inefficient for our purpose because it renders
-        // the whole tree under view instead of *only* rendering view.
-        [view.layer renderInContext:context];
-    } else {
-        CGContextSetFillColor(context, (CGFloat[2]){0.0, 1.0});
-        CGContextSetBlendMode(context, kCGBlendModeCopy);
-        CGContextFillRect(context, view.bounds);
-    }
+        // Apply a transform that takes the origin to view's top left corner.
+        const CGPoint viewOrigin = CGPointApplyAffineTransform(view.bounds.origin, localToBase);
+        CGContextTranslateCTM(context, viewOrigin.x, viewOrigin.y);
 
-    // Restore the CTM.
-    CGContextRestoreGState(context);
+        // If this is *not* in a target view's hierarchy then use the destination
+        // out blend mode to reduce the visibility of any already painted pixels by
+        // the alpha of the current view.
+        //
+        // If this is in a target view's hierarchy then just draw a rectangle
+        // of the target's color covering the whole thing.
+        if (!targetColor) {
+            CGContextSetBlendMode(context, kCGBlendModeDestinationOut);
+            // Draw only the view's own content: its subviews are drawn by the recursion below.
+            SLRenderLayerOfViewExcludingSubviews(view, context);
+        } else {
+            CGContextSetFillColorWithColor(context, [targetColor CGColor]);
+            CGContextSetBlendMode(context, kCGBlendModeCopy);
+            CGContextFillRect(context, view.bounds);
+        }
+
+        // Restore the CTM.
+        CGContextRestoreGState(context);
+    }
 
     // Recurse for subviews
     for (UIView *subview in [view subviews]) {
-        [self renderViewRecursively:subview inContext:context withTargetView:target baseView:baseView];
+        [self renderViewRecursively:subview inContext:context withTargetColors:targetColors
+                           baseView:baseView testRect:testRect targetColor:targetColor];
     }
 
     // Restore the clip mask.
     CGContextRestoreGState(context);
 }
 
-- (NSUInteger)numberOfVisiblePointsFromSet:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints {
-    static CGColorSpaceRef rgbColorSpace;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        rgbColorSpace = CGColorSpaceCreateDeviceRGB();
-    });
+- (void)appendOcclusionNodesForView:(UIView *)view withTargetView:(UIView *)target baseView:(UIView *)baseView
+                           testRect:(CGRect)testRect clipIndex:(long)clipIndex isInTarget:(BOOL)isInTarget
+                     inheritedAlpha:(CGFloat)inheritedAlpha toNodes:(NSMutableData *)nodes {
+    // Skip any views that are hidden or have alpha < kMinVisibleAlphaFloat, as does `-renderViewRecursively:...`.
+    if (view.hidden || view.alpha < kMinVisibleAlphaFloat) {
+        return;
+    }
+
+    isInTarget = isInTarget || (view == target);
+
+    // The view's effective opacity is the product of its own and its ancestors' opacity.
+    const CGFloat alpha = inheritedAlpha * view.alpha;
+
+    CGRect drawingBounds = view.bounds;
+    const SLOcclusionNodeKind kind = (isInTarget ? SLOcclusionNodeKindTarget
+                                                 : SLOcclusionKindOfView(view, alpha, &drawingBounds));
+
+    const CGAffineTransform localToBase = SLTransformFromViewToBaseView(view, baseView);
+    const BOOL intersectsTestRect = CGRectIntersectsRect(CGRectApplyAffineTransform(drawingBounds, localToBase), testRect);
+
+    // If view clips its descendants to bounds outside the test rect, neither it nor they can affect visibility.
+    const BOOL clipsToBounds = [view clipsToBounds];
+    if (clipsToBounds && !intersectsTestRect) return;
+
+    long subviewClipIndex = clipIndex;
+    if ((intersectsTestRect && (kind != SLOcclusionNodeKindTransparent)) || clipsToBounds) {
+        const SLOcclusionNode node = SLOcclusionNodeMake((SLOcclusionTransform){
+                                                            localToBase.a, localToBase.b, localToBase.c,
+                                                            localToBase.d, localToBase.tx, localToBase.ty },
+                                                         (SLOcclusionRect){
+                                                            drawingBounds.origin.x, drawingBounds.origin.y,
+                                                            drawingBounds.size.width, drawingBounds.size.height },
+                                                         clipIndex, kind);
+        if (clipsToBounds) subviewClipIndex = (long)([nodes length] / sizeof(SLOcclusionNode));
+        [nodes appendBytes:&node length:sizeof(node)];
+    }
+
+    for (UIView *subview in [view subviews]) {
+        [self appendOcclusionNodesForView:subview withTargetView:target baseView:baseView
+                                 testRect:testRect clipIndex:subviewClipIndex isInTarget:isInTarget
+                           inheritedAlpha:alpha toNodes:nodes];
+    }
+}
 
+- (void)getGeometricVisibilities:(SLOcclusionVisibility *)visibilities ofPoints:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints {
     NSParameterAssert(numPoints > 0);
     NSParameterAssert(testPointsInWindow != NULL);
 
-    // Allocate a buffer sufficiently large to store a rendering that could possibly cover all the test points.
-    int x = rintf(testPointsInWindow[0].x);
-    int y = rintf(testPointsInWindow[0].y);
-    int minX = x;
-    int maxX = x;
-    int minY = y;
-    int maxY = y;
-    for (NSUInteger j = 1; j < numPoints; j++) {
-        x = rintf(testPointsInWindow[j].x);
-        y = rintf(testPointsInWindow[j].y);
-        minX = MIN(minX, x);
-        maxX = MAX(maxX, x);
-        minY = MIN(minY, y);
-        maxY = MAX(maxY, y);
+    // Test the centers of the pixels which `-numberOfRenderedVisiblePointsFromSet:count:` would examine.
+    SLOcclusionPoint *testPoints = (SLOcclusionPoint *)malloc(numPoints * sizeof(SLOcclusionPoint));
+    CGRect testRect = CGRectNull;
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        testPoints[j] = (SLOcclusionPoint){ rintf(testPointsInWindow[j].x) + 0.5, rintf(testPointsInWindow[j].y) + 0.5 };
+        testRect = CGRectUnion(testRect, CGRectMake(testPoints[j].x - 0.5, testPoints[j].y - 0.5, 1.0, 1.0));
     }
-    NSAssert(maxX >= minX, @"maxX (%d) should be greater than or equal to minX (%d)", maxX, minX);
-    NSAssert(maxY >= minY, @"maxY (%d) should be greater than or equal to minY (%d)", maxY, minY);
-    size_t columns = maxX - minX + 1;
-    size_t rows = maxY - minY + 1;
-    unsigned char *pixels = (unsigned char *)calloc(columns * rows * 4, 1);
-    CGContextRef context = CGBitmapContextCreate(pixels, columns, rows, 8, 4 * columns, rgbColorSpace, kCGBitmapAlphaInfoMask & kCGImageAlphaPremultipliedLast);
-    CGContextTranslateCTM(context, -minX, -minY);
 
     UIWindow *targetWindow = self.window;
     NSAssert(targetWindow, @"%@ has not been added to a window.", self);
-    
-    // Render the target window and the windows above it:
-    // the target view's rendered opacity will be reduced
-    // if the contents of a window above the target window occlude the target view.
+
+    // Describe the target window and the windows above it, in the coordinate system of the target window.
+    NSMutableData *nodes = [[NSMutableData alloc] init];
     NSArray *windows = [[UIApplication sharedApplication] windows];
     NSUInteger targetWindowIndex = [windows indexOfObject:targetWindow];
     NSAssert(targetWindowIndex != NSNotFound, @"`The window of %@ has never been made key and visible.", self);
     for (NSUInteger windowIndex = targetWindowIndex; windowIndex < [windows count]; windowIndex++) {
         UIWindow *window = windows[windowIndex];
-        [self renderViewRecursively:window inContext:context withTargetView:self baseView:window];
+        [self appendOcclusionNodesForView:window withTargetView:self baseView:targetWindow
+                                 testRect:testRect clipIndex:-1 isInTarget:NO
+                           inheritedAlpha:1.0 toNodes:nodes];
     }
-    
-    NSUInteger count = 0;
+
+    const size_t nodeCount = [nodes length] / sizeof(SLOcclusionNode);
     for (NSUInteger j = 0; j < numPoints; j++) {
-        int x = rintf(testPointsInWindow[j].x);
-        int y = rintf(testPointsInWindow[j].y);
-        NSAssert(x >= minX, @"Invalid x encountered, %d, but min is %d", x, minX);
-        NSAssert(y >= minY, @"Invalid y encountered, %d, but min is %d", y, minY);
-        NSUInteger col = x - minX;
-        NSUInteger row = y - minY;
-        NSUInteger pixelIndex = row * columns + col;
-        NSAssert(pixelIndex < columns * rows, @"Encountered invalid pixel index: %lu", (unsigned long)pixelIndex);
-        if (pixels[4 * pixelIndex + 3] >= kMinVisibleAlphaInt) {
-            count++;
-        }
+        visibilities[j] = SLOcclusionVisibilityOfPoint([nodes bytes], nodeCount, testPoints[j]);
     }
+    free(testPoints);
+}
 
-    CGContextRelease(context);
-    free(pixels);
+- (NSUInteger)numberOfRenderedVisiblePointsFromSet:(const CGPoint *)testPointsInWindow count:(const NSUInteger)numPoints {
+    SLOcclusionVisibility *visibilities = (SLOcclusionVisibility *)malloc(numPoints * sizeof(SLOcclusionVisibility));
+    NSUInteger *targetIndexes = (NSUInteger *)calloc(numPoints, sizeof(NSUInteger));
+    SLRenderTargetViews(@[ self ], visibilities, testPointsInWindow, targetIndexes, numPoints);
+
+    NSUInteger count = 0;
+    for (NSUInteger j = 0; j < numPoints; j++) {
+        if (visibilities[j] == SLOcclusionVisibilityVisible) count++;
+    }
+    free(visibilities);
+    free(targetIndexes);
 
     return count;
 }
 
-- (BOOL)slAccessibilityRectIsVisible:(CGRect)rect {
+- (BOOL)getVisibilityTestPoints:(CGPoint *)testPointsInWindow forRect:(CGRect)rect {
     // View is not visible if it's hidden or has very low alpha.
     if (self.hidden || self.alpha < kMinVisibleAlphaFloat) {
         return NO;
@@ -302,31 +1118,50 @@ const unsigned char kMinVisibleAlphaInt = 3; // 255 * 0.01 = 2.55, but our bitma
         parent = [parent superview];
     }
 
-    // Subliminal's visibility rules are:
-    // 1.  If the center is visible then the view is visible.
-    // 2.  If the center is not visible *and* at least one corner is not visible then the view is not visible.
-    // 3.  If the center is not visible but *all four* corners are visible (strange as that would be) the view is visible.
-    if ([self numberOfVisiblePointsFromSet:&centerInWindow count:1] == 0) {
-        // Center is covered, so check the status of the corners.
-        const CGPoint topLeftInScreenCoordinates = CGPointMake(CGRectGetMinX(rect), CGRectGetMinY(rect));
-        const CGPoint topRightInScreenCoordinates = CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMinY(rect));
-        const CGPoint bottomLeftInScreenCoordinates = CGPointMake(CGRectGetMinX(rect), CGRectGetMaxY(rect) - 1.0);
-        const CGPoint bottomRightInScreenCoordinates = CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMaxY(rect) - 1.0);
-        const CGPoint topLeftInWindow = [window convertPoint:topLeftInScreenCoordinates fromWindow:nil];
-        const CGPoint topRightInWindow = [window convertPoint:topRightInScreenCoordinates fromWindow:nil];
-        const CGPoint bottomLeftInWindow = [window convertPoint:bottomLeftInScreenCoordinates fromWindow:nil];
-        const CGPoint bottomRightInWindow = [window convertPoint:bottomRightInScreenCoordinates fromWindow:nil];
-        NSUInteger numberOfVisiblePoints = [self numberOfVisiblePointsFromSet:(CGPoint[4]){topLeftInWindow, topRightInWindow, bottomLeftInWindow, bottomRightInWindow} count:4];
-        // View with a covered center is visible only if all four corners are visible.
-        return (numberOfVisiblePoints == 4);
-    } else {
-        // Center is not covered, so consider the view visible no matter what else is going on.
-        return YES;
+    const CGPoint topLeftInScreenCoordinates = CGPointMake(CGRectGetMinX(rect), CGRectGetMinY(rect));
+    const CGPoint topRightInScreenCoordinates = CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMinY(rect));
+    const CGPoint bottomLeftInScreenCoordinates = CGPointMake(CGRectGetMinX(rect), CGRectGetMaxY(rect) - 1.0);
+    const CGPoint bottomRightInScreenCoordinates = CGPointMake(CGRectGetMaxX(rect) - 1.0, CGRectGetMaxY(rect) - 1.0);
+    testPointsInWindow[0] = centerInWindow;
+    testPointsInWindow[1] = [window convertPoint:topLeftInScreenCoordinates fromWindow:nil];
+    testPointsInWindow[2] = [window convertPoint:topRightInScreenCoordinates fromWindow:nil];
+    testPointsInWindow[3] = [window convertPoint:bottomLeftInScreenCoordinates fromWindow:nil];
+    testPointsInWindow[4] = [window convertPoint:bottomRightInScreenCoordinates fromWindow:nil];
+    return YES;
+}
+
+- (BOOL)slAccessibilityRectIsVisible:(CGRect)rect {
+    SLVisibilityTest test = { .view = self };
+    if (![self getVisibilityTestPoints:test.testPointsInWindow forRect:rect]) {
+        return NO;
     }
+    SLDetermineVisibility(&test, 1);
+    return test.isVisible;
 }
 
-- (BOOL)slAccessibilityIsVisible {
-    return [self slAccessibilityRectIsVisible:self.accessibilityFrame];
+- (CGFloat)slAccessibilityVisibleFractionOfRect:(CGRect)rect {
+    CGPoint testPointsInWindow[kNumVisibilityTestPoints];
+    if (![self getVisibilityTestPoints:testPointsInWindow forRect:rect]) {
+        return 0.0;
+    }
+
+    UIWindow *window = self.window;
+    const CGRect rectInWindow = CGRectIntegral([window convertRect:rect fromWindow:nil]);
+    if (CGRectIsEmpty(rectInWindow)) {
+        return 0.0;
+    }
+
+    // Parts of rect outside the window are left transparent, and so are not counted as visible.
+    const CGRect renderedRect = CGRectIntersection(rectInWindow, [window bounds]);
+    unsigned char *pixels = SLCreateRenderingOfTargetViews(@[ self ], rectInWindow, &renderedRect, 1);
+
+    const size_t columns = CGRectGetWidth(rectInWindow);
+    const size_t rows = CGRectGetHeight(rectInWindow);
+    const size_t stride = SLCoverageStrideForMaxSampledPixelCount(columns, rows, kMaxVisibleFractionSampledPixelCount);
+    const SLCoverage coverage = SLCoverageOfPixels(pixels, columns, rows, 4 * columns, stride, kMinVisibleAlphaInt);
+    free(pixels);
+
+    return (CGFloat)SLCoverageFraction(coverage);
 }
 
 @end
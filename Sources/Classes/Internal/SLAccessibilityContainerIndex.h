@@ -0,0 +1,74 @@
+//
+//  SLAccessibilityContainerIndex.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <UIKit/UIKit.h>
+
+/**
+ An `SLAccessibilityContainerIndex` indexes the frames of the elements vended
+ by an accessibility container, so that Subliminal may quickly determine whether
+ an element is covered by one of its siblings.
+
+ An element is considered covered at a point if an element which comes before it
+ in its container (and thus is z-ordered before it) contains that point.
+ For a container vending `n` elements, this requires `O(n)` time to evaluate
+ directly. An index evaluates this in time proportional to the number of elements
+ which overlap the point.
+
+ Indexes are built lazily and cached per container, so that repeated queries
+ do not pay to rebuild them. An index is rebuilt when the number of elements vended
+ by its container changes, when the container's first or last element changes
+ or moves (as when the container reloads or scrolls), and when the element being queried,
+ or an element found to cover it, has moved since it was indexed. (A middle element
+ that moves over the element being queried, without any of those changes,
+ is not detected until the index is next rebuilt.) Small containers
+ are not indexed, because it would be faster to evaluate them directly than
+ to build their indexes.
+
+ Indexes may only be used on the main thread.
+ */
+@interface SLAccessibilityContainerIndex : NSObject
+
+/**
+ Returns an index of the specified container's elements.
+
+ @param container An object which implements the `UIAccessibilityContainer` protocol.
+ @return An index of the elements of _container_, or `nil` if _container_
+ vends too few elements to be worth indexing.
+
+ @exception NSInternalInconsistencyException Thrown if this method is not called
+ from the main thread.
+ */
++ (instancetype)indexForContainer:(id)container;
+
+/**
+ Determines whether an element that comes before the specified element 
+ in the receiver's container contains the specified point.
+
+ @param element An element of the receiver's container. If _element_ is not an element 
+ of the container, all of the container's elements are considered.
+ @param point A point in screen coordinates.
+ @return `YES` if an element that precedes _element_ in the receiver's container
+ contains _point_, `NO` otherwise.
+ */
+- (BOOL)elementBeforeElement:(id)element containsPoint:(CGPoint)point;
+
+@end
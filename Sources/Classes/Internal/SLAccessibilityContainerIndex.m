@@ -0,0 +1,247 @@
+//
+//  SLAccessibilityContainerIndex.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLAccessibilityContainerIndex.h"
+
+#import <objc/runtime.h>
+
+
+/// Containers vending fewer elements than this are not indexed.
+static const NSInteger kMinIndexedElementCount = 32;
+
+/// The maximum number of rows and of columns of an index's grid.
+static const NSUInteger kMaxGridDimension = 64;
+
+/// Returns the frame of the specified element as indexed: `CGRectNull`
+/// if the element is `nil` or its frame is empty.
+static CGRect SLIndexedFrameOfElement(id element) {
+    CGRect frame = element ? [element accessibilityFrame] : CGRectNull;
+    return CGRectIsEmpty(frame) ? CGRectNull : frame;
+}
+
+
+@implementation SLAccessibilityContainerIndex {
+    // The container owns the index (see `+indexForContainer:`), so outlives it.
+    __unsafe_unretained id _container;
+    NSInteger _elementCount;
+
+    // The container's elements, retained so that they may be identified
+    // by pointer in `_elementIndexes`.
+    NSArray *_elements;
+    CFMutableDictionaryRef _elementIndexes;
+    CGRect *_frames;
+
+    // The elements are bucketed by the cells of a uniform grid covering `_bounds`.
+    // The indexes of the elements overlapping cell `c` are stored, in ascending order,
+    // in `_cellElementIndexes[_cellOffsets[c]]` through `_cellElementIndexes[_cellOffsets[c + 1] - 1]`.
+    CGRect _bounds;
+    NSUInteger _columns, _rows;
+    NSUInteger *_cellOffsets;
+    NSUInteger *_cellElementIndexes;
+}
+
++ (instancetype)indexForContainer:(id)container {
+    NSAssert([NSThread isMainThread], @"%@ must be called from the main thread.", NSStringFromSelector(_cmd));
+
+    static const void *const kIndexKey = &kIndexKey;
+
+    NSInteger elementCount = [container accessibilityElementCount];
+    if ((elementCount == NSNotFound) || (elementCount < kMinIndexedElementCount)) {
+        objc_setAssociatedObject(container, kIndexKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        return nil;
+    }
+
+    SLAccessibilityContainerIndex *index = objc_getAssociatedObject(container, kIndexKey);
+    if (!index || ![index isCurrentWithElementCount:elementCount]) {
+        index = [[self alloc] initWithContainer:container];
+        objc_setAssociatedObject(container, kIndexKey, index, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return index;
+}
+
+- (instancetype)initWithContainer:(id)container {
+    self = [super init];
+    if (self) {
+        _container = container;
+        _elementIndexes = CFDictionaryCreateMutable(NULL, 0, NULL, NULL);
+        [self indexElements];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CFRelease(_elementIndexes);
+    free(_frames);
+    free(_cellOffsets);
+    free(_cellElementIndexes);
+}
+
+// Checks, in constant time, that the container has not changed since it was indexed:
+// that it vends the same number of elements, and that its first and last elements
+// are the same and have the same frames--those change if the container reloads,
+// scrolls, or is laid out anew. Changes to the other elements are detected
+// as they are queried, in `-elementBeforeElement:containsPoint:`.
+- (BOOL)isCurrentWithElementCount:(NSInteger)elementCount {
+    if (elementCount != _elementCount) return NO;
+
+    const NSInteger boundaryIndexes[] = { 0, _elementCount - 1 };
+    for (NSUInteger i = 0; i < (sizeof(boundaryIndexes) / sizeof(boundaryIndexes[0])); i++) {
+        const NSInteger idx = boundaryIndexes[i];
+        id element = [_container accessibilityElementAtIndex:idx];
+        if ((element ?: [NSNull null]) != _elements[idx]) return NO;
+        if (!CGRectEqualToRect(SLIndexedFrameOfElement(element), _frames[idx])) return NO;
+    }
+    return YES;
+}
+
+- (void)indexElements {
+    _elementCount = [_container accessibilityElementCount];
+
+    NSMutableArray *elements = [[NSMutableArray alloc] initWithCapacity:_elementCount];
+    CFDictionaryRemoveAllValues(_elementIndexes);
+    _frames = (CGRect *)realloc(_frames, _elementCount * sizeof(CGRect));
+    _bounds = CGRectNull;
+    for (NSInteger idx = 0; idx < _elementCount; idx++) {
+        // containers may vend nil elements; they can't cover anything
+        id element = [_container accessibilityElementAtIndex:idx];
+        [elements addObject:(element ?: [NSNull null])];
+        if (element && !CFDictionaryContainsKey(_elementIndexes, (__bridge const void *)element)) {
+            CFDictionarySetValue(_elementIndexes, (__bridge const void *)element, (const void *)idx);
+        }
+
+        CGRect frame = SLIndexedFrameOfElement(element);
+        _frames[idx] = frame;
+        _bounds = CGRectUnion(_bounds, frame);
+    }
+    _elements = elements;
+
+    [self buildGrid];
+}
+
+- (void)buildGrid {
+    // A grid of about as many cells as there are elements bounds the number of elements per cell,
+    // if the elements are evenly distributed.
+    NSUInteger dimension = MAX((NSUInteger)1, MIN((NSUInteger)ceil(sqrt(_elementCount)), kMaxGridDimension));
+    _columns = CGRectIsNull(_bounds) ? 1 : dimension;
+    _rows = CGRectIsNull(_bounds) ? 1 : dimension;
+    const NSUInteger cellCount = _columns * _rows;
+
+    // Count the elements overlapping each cell, then convert the counts to offsets.
+    free(_cellOffsets);
+    _cellOffsets = (NSUInteger *)calloc(cellCount + 1, sizeof(NSUInteger));
+    for (NSInteger idx = 0; idx < _elementCount; idx++) {
+        NSUInteger minColumn, maxColumn, minRow, maxRow;
+        if (![self getCellsOfFrame:_frames[idx] minColumn:&minColumn maxColumn:&maxColumn minRow:&minRow maxRow:&maxRow]) continue;
+        for (NSUInteger row = minRow; row <= maxRow; row++) {
+            for (NSUInteger column = minColumn; column <= maxColumn; column++) {
+                _cellOffsets[(row * _columns) + column + 1]++;
+            }
+        }
+    }
+    for (NSUInteger cell = 0; cell < cellCount; cell++) {
+        _cellOffsets[cell + 1] += _cellOffsets[cell];
+    }
+
+    // Fill the cells. Elements are visited in order, so each cell's indexes are sorted.
+    free(_cellElementIndexes);
+    _cellElementIndexes = (NSUInteger *)malloc(MAX(_cellOffsets[cellCount], (NSUInteger)1) * sizeof(NSUInteger));
+    NSUInteger *cellFillCounts = (NSUInteger *)calloc(cellCount, sizeof(NSUInteger));
+    for (NSInteger idx = 0; idx < _elementCount; idx++) {
+        NSUInteger minColumn, maxColumn, minRow, maxRow;
+        if (![self getCellsOfFrame:_frames[idx] minColumn:&minColumn maxColumn:&maxColumn minRow:&minRow maxRow:&maxRow]) continue;
+        for (NSUInteger row = minRow; row <= maxRow; row++) {
+            for (NSUInteger column = minColumn; column <= maxColumn; column++) {
+                const NSUInteger cell = (row * _columns) + column;
+                _cellElementIndexes[_cellOffsets[cell] + cellFillCounts[cell]++] = idx;
+            }
+        }
+    }
+    free(cellFillCounts);
+}
+
+- (NSUInteger)columnOfX:(CGFloat)x {
+    const CGFloat cellWidth = CGRectGetWidth(_bounds) / _columns;
+    const CGFloat column = floor((x - CGRectGetMinX(_bounds)) / cellWidth);
+    return (NSUInteger)MAX((CGFloat)0.0, MIN(column, (CGFloat)(_columns - 1)));
+}
+
+- (NSUInteger)rowOfY:(CGFloat)y {
+    const CGFloat cellHeight = CGRectGetHeight(_bounds) / _rows;
+    const CGFloat row = floor((y - CGRectGetMinY(_bounds)) / cellHeight);
+    return (NSUInteger)MAX((CGFloat)0.0, MIN(row, (CGFloat)(_rows - 1)));
+}
+
+- (BOOL)getCellsOfFrame:(CGRect)frame minColumn:(NSUInteger *)minColumn maxColumn:(NSUInteger *)maxColumn
+                 minRow:(NSUInteger *)minRow maxRow:(NSUInteger *)maxRow {
+    if (CGRectIsNull(frame)) return NO;
+
+    *minColumn = [self columnOfX:CGRectGetMinX(frame)];
+    *maxColumn = [self columnOfX:CGRectGetMaxX(frame)];
+    *minRow = [self rowOfY:CGRectGetMinY(frame)];
+    *maxRow = [self rowOfY:CGRectGetMaxY(frame)];
+    return YES;
+}
+
+- (BOOL)elementBeforeElement:(id)element containsPoint:(CGPoint)point {
+    NSAssert([NSThread isMainThread], @"%@ must be called from the main thread.", NSStringFromSelector(_cmd));
+
+    // the element's frame changes if it, or its container, moves
+    NSUInteger limit = [self limitOfElementsBeforeElement:element];
+    if ((limit != (NSUInteger)_elementCount) &&
+        !CGRectEqualToRect(SLIndexedFrameOfElement(element), _frames[limit])) {
+        [self indexElements];
+        limit = [self limitOfElementsBeforeElement:element];
+    }
+
+    NSUInteger coveringElementIndex = [self indexOfElementBeforeIndex:limit containingPoint:point];
+    if (coveringElementIndex == NSNotFound) return NO;
+
+    // confirm that the covering element is still where it was indexed,
+    // reindexing if it has moved since
+    const CGRect coveringElementFrame = SLIndexedFrameOfElement(_elements[coveringElementIndex]);
+    if (CGRectEqualToRect(coveringElementFrame, _frames[coveringElementIndex])) return YES;
+
+    [self indexElements];
+    limit = [self limitOfElementsBeforeElement:element];
+    return ([self indexOfElementBeforeIndex:limit containingPoint:point] != NSNotFound);
+}
+
+// returns the index of the specified element, or the number of elements if it is not indexed
+- (NSUInteger)limitOfElementsBeforeElement:(id)element {
+    const void *elementIndex = NULL;
+    return (CFDictionaryGetValueIfPresent(_elementIndexes, (__bridge const void *)element, &elementIndex) ?
+            (NSUInteger)elementIndex : (NSUInteger)_elementCount);
+}
+
+- (NSUInteger)indexOfElementBeforeIndex:(NSUInteger)limit containingPoint:(CGPoint)point {
+    if (!CGRectContainsPoint(_bounds, point)) return NSNotFound;
+
+    const NSUInteger cell = ([self rowOfY:point.y] * _columns) + [self columnOfX:point.x];
+    for (NSUInteger offset = _cellOffsets[cell]; offset < _cellOffsets[cell + 1]; offset++) {
+        const NSUInteger idx = _cellElementIndexes[offset];
+        if (idx >= limit) break;
+        if (CGRectContainsPoint(_frames[idx], point)) return idx;
+    }
+    return NSNotFound;
+}
+
+@end
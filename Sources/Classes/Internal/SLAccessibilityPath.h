@@ -101,7 +101,7 @@
  way as to make the names (`UIAElement.name()`) of their corresponding `UIAElement`
  instances unique. With the modifications in place, the block provided is then
  evaluated, on the calling thread, with the receiver. The modifications are then
- reset.
+ reset (see `-unbindPath`).
 
  @param block A block which takes the bound receiver as an argument and returns
  `void`.
@@ -137,4 +137,54 @@
  */
 - (NSString *)UIARepresentation;
 
+#pragma mark - Using the Path on the Main Thread
+/// ----------------------------------------
+/// @name Using the Path on the Main Thread
+/// ----------------------------------------
+
+/**
+ Returns the last path component of the receiver.
+
+ Unlike `-examineLastPathComponent:`, this method does not dispatch to the main
+ queue. It allows a client who is already executing on the main thread (e.g.
+ a client which has just constructed the receiver there) to examine the receiver's
+ destination without waiting for the main queue a second time.
+
+ This may only be called from the main thread.
+
+ @return The last path component of the receiver, or `nil` if the last path 
+ component has dropped out of scope.
+ */
+- (NSObject *)lastPathComponent;
+
+/**
+ Binds the components of the receiver and returns the receiver's representation 
+ as understood by UIAutomation.
+
+ This method binds the receiver as `-bindPath:` does, and serializes the receiver 
+ as `-UIARepresentation` does, but in a single pass over the receiver's components
+ and without dispatching to the main queue. It allows a client to resolve, bind, 
+ and serialize a path in one trip to the main thread.
+
+ The receiver remains bound until it is sent `-unbindPath`. Until then, 
+ `-UIARepresentation` will return the value returned by this method 
+ without dispatching to the main queue.
+
+ This may only be called from the main thread.
+
+ @return A JavaScript expression that represents the absolute path to the `UIAElement`
+ corresponding to the last component of the receiver.
+ */
+- (NSString *)bindPathAndReturnUIARepresentation;
+
+/**
+ Resets the modifications made to the receiver's components
+ by `-bindPathAndReturnUIARepresentation`.
+
+ This may be called from any thread. When called from a background thread, 
+ the components are unbound synchronously on the main queue, so that they 
+ have been unbound by the time this method returns.
+ */
+- (void)unbindPath;
+
 @end
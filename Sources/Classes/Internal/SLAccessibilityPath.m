@@ -25,6 +25,7 @@
 #import "SLElement.h"
 #import "SLUIAElement+Subclassing.h"
 #import "SLMainThreadRef.h"
+#import "SLTimeProfile.h"
 
 #import <objc/runtime.h>
 
@@ -312,6 +313,7 @@ static const void *const kUseSLReplacementIdentifierKey = &kUseSLReplacementIden
 @implementation SLAccessibilityPath {
     NSArray *_accessibilityElementPath;
     SLMainThreadRef *_destinationRef;
+    NSString *_boundUIARepresentation;
 }
 
 + (NSArray *)filterRawAccessibilityElementPath:(NSArray *)accessibilityElementPath
@@ -428,50 +430,89 @@ static const void *const kUseSLReplacementIdentifierKey = &kUseSLReplacementIden
     return self;
 }
 
+- (NSObject *)lastPathComponent {
+    return [_destinationRef target];
+}
+
 - (void)examineLastPathComponent:(void (^)(NSObject *lastPathComponent))block {
-    dispatch_sync(dispatch_get_main_queue(), ^{
-        block([_destinationRef target]);
+    SLTimeProfileDispatchSyncToMainQueue(^{
+        block([self lastPathComponent]);
     });
 }
 
 - (void)bindPath:(void (^)(SLAccessibilityPath *boundPath))block {
+    SLTimeProfileDispatchSyncToMainQueue(^{
+        // the representation is cached for use by `-UIARepresentation`
+        (void)[self bindPathAndReturnUIARepresentation];
+    });
+
+    block(self);
+
+    [self unbindPath];
+}
+
+- (NSString *)bindPathAndReturnUIARepresentation {
+    NSAssert([NSThread isMainThread], @"%@ must be called from the main thread.", NSStringFromSelector(_cmd));
+
     // To bind the path to a unique destination, each object in the mock view path
     // is caused to return a unique replacement identifier. This is done by swizzling
     // -accessibilityIdentifier because some objects' identifiers cannot be set directly
     // (e.g. UISegmentedControl, some mock views).
     //
+    // Each object is serialized as soon as it is bound,
+    // so that each reference's target need only be retrieved once.
+    //
     // @warning This implementation assumes that there's only one SLAccessibilityPath
     // binding/bound at a time. It also assumes that it's unlikely that clients
     // other than UIAccessibility will try to read the elements' identifiers
     // while bound.
-    dispatch_sync(dispatch_get_main_queue(), ^{
-        for (SLMainThreadRef *objRef in _accessibilityElementPath) {
-            NSObject *obj = [objRef target];
+    NSMutableString *uiaRepresentation = [@"UIATarget.localTarget().frontMostApp()" mutableCopy];
+    for (SLMainThreadRef *objRef in _accessibilityElementPath) {
+        NSObject *obj = [objRef target];
 
-            // see note on +mapPathToBackgroundThread:;
-            // we only throw a fatal exception if there *are* objects in the path
-            // that differ from our assumptions
-            NSAssert(!obj || [obj respondsToSelector:@selector(accessibilityIdentifier)],
-                     @"elements in the view path must conform to UIAccessibilityIdentification");
+        // see note on +mapPathToBackgroundThread:;
+        // we only throw a fatal exception if there *are* objects in the path
+        // that differ from our assumptions
+        NSAssert(!obj || [obj respondsToSelector:@selector(accessibilityIdentifier)],
+                 @"elements in the view path must conform to UIAccessibilityIdentification");
 
-            obj.useSLReplacementAccessibilityIdentifier = YES;
-        }
-    });
+        obj.useSLReplacementAccessibilityIdentifier = YES;
 
-    block(self);
+        NSString *identifier = [obj performSelector:@selector(accessibilityIdentifier)];
+        [uiaRepresentation appendFormat:@".elements()['%@']", [identifier slStringByEscapingForJavaScriptLiteral]];
+    }
+
+    _boundUIARepresentation = [uiaRepresentation copy];
+    return _boundUIARepresentation;
+}
+
+- (void)unbindPath {
+    _boundUIARepresentation = nil;
 
     // Set the objects to use the original -accessibilityIdentifier again.
-    dispatch_sync(dispatch_get_main_queue(), ^{
+    void (^unbind)(void) = ^{
         for (SLMainThreadRef *objRef in _accessibilityElementPath) {
             NSObject *obj = [objRef target];
             obj.useSLReplacementAccessibilityIdentifier = NO;
         }
-    });
+    };
+
+    // Wait for the path to be unbound, as `-bindPath:` waits for it to be bound,
+    // so that its components' identifiers are restored by the time this returns.
+    if ([NSThread isMainThread]) {
+        unbind();
+    } else {
+        SLTimeProfileDispatchSyncToMainQueue(unbind);
+    }
 }
 
 - (NSString *)UIARepresentation {
+    // if the path is bound, it was serialized while being bound
+    NSString *boundUIARepresentation = _boundUIARepresentation;
+    if (boundUIARepresentation) return boundUIARepresentation;
+
     __block NSMutableString *uiaRepresentation = [@"UIATarget.localTarget().frontMostApp()" mutableCopy];
-    dispatch_sync(dispatch_get_main_queue(), ^{
+    SLTimeProfileDispatchSyncToMainQueue(^{
         for (SLMainThreadRef *objRef in _accessibilityElementPath) {
             NSObject *obj = [objRef target];
 
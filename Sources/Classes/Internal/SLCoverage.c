@@ -0,0 +1,104 @@
+//
+//  SLCoverage.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "SLCoverage.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+/// Counts the pixels of a row at which the target is visible, examining every pixel.
+static size_t SLCoverageCountVisiblePixelsInRow(const unsigned char *row, size_t width, unsigned char minAlpha) {
+    size_t count = 0;
+    size_t x = 0;
+
+#if defined(__SSE2__)
+    // Shift each pixel's alpha into the low byte of its lane, compare it against the threshold,
+    // and subtract the result (-1 where visible) from the lane's count.
+    const __m128i threshold = _mm_set1_epi32((int)minAlpha - 1);
+    __m128i counts = _mm_setzero_si128();
+    for (; x + 4 <= width; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(row + (4 * x)));
+        const __m128i alphas = _mm_srli_epi32(pixels, 24);
+        counts = _mm_sub_epi32(counts, _mm_cmpgt_epi32(alphas, threshold));
+    }
+    uint32_t laneCounts[4];
+    _mm_storeu_si128((__m128i *)laneCounts, counts);
+    count += (size_t)laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3];
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const uint32x4_t threshold = vdupq_n_u32(minAlpha);
+    uint32x4_t counts = vdupq_n_u32(0);
+    for (; x + 4 <= width; x += 4) {
+        const uint32x4_t pixels = vreinterpretq_u32_u8(vld1q_u8(row + (4 * x)));
+        const uint32x4_t alphas = vshrq_n_u32(pixels, 24);
+        counts = vsubq_u32(counts, vcgeq_u32(alphas, threshold));
+    }
+    count += (size_t)vgetq_lane_u32(counts, 0) + vgetq_lane_u32(counts, 1) + vgetq_lane_u32(counts, 2) + vgetq_lane_u32(counts, 3);
+#endif
+
+    for (; x < width; x++) {
+        count += (row[(4 * x) + 3] >= minAlpha);
+    }
+    return count;
+}
+
+SLCoverage SLCoverageOfPixels(const unsigned char *pixels, size_t width, size_t height, size_t bytesPerRow,
+                              size_t stride, unsigned char minAlpha) {
+    SLCoverage coverage = { 0, 0 };
+    if (stride < 1) stride = 1;
+
+    const size_t sampledColumnCount = (width + stride - 1) / stride;
+    for (size_t y = 0; y < height; y += stride) {
+        const unsigned char *row = pixels + (y * bytesPerRow);
+        if (stride == 1) {
+            coverage.visiblePixelCount += SLCoverageCountVisiblePixelsInRow(row, width, minAlpha);
+        } else {
+            // samples are not contiguous, so are not worth gathering into vectors
+            for (size_t x = 0; x < width; x += stride) {
+                coverage.visiblePixelCount += (row[(4 * x) + 3] >= minAlpha);
+            }
+        }
+        coverage.sampledPixelCount += sampledColumnCount;
+    }
+    return coverage;
+}
+
+double SLCoverageFraction(SLCoverage coverage) {
+    if (!coverage.sampledPixelCount) return 0.0;
+    return (double)coverage.visiblePixelCount / (double)coverage.sampledPixelCount;
+}
+
+size_t SLCoverageStrideForMaxSampledPixelCount(size_t width, size_t height, size_t maxSampledPixelCount) {
+    if (maxSampledPixelCount < 1) maxSampledPixelCount = 1;
+
+    size_t stride = 1;
+    while ((((width + stride - 1) / stride) * ((height + stride - 1) / stride)) > maxSampledPixelCount) {
+        stride++;
+    }
+    return stride;
+}
@@ -0,0 +1,85 @@
+//
+//  SLCoverage.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Subliminal_SLCoverage_h
+#define Subliminal_SLCoverage_h
+
+#include <stddef.h>
+
+/*
+ The coverage kernel counts the pixels of a rendering at which a target view is visible,
+ that is, the pixels whose alpha is at least some minimum value.
+
+ The pixels are expected to be 32-bit, with alpha in the last (most significant) byte,
+ as rendered by a bitmap context using `kCGImageAlphaPremultipliedLast` on a little-endian
+ platform. The kernel uses SSE2 or NEON to examine several pixels at once where available.
+
+ The kernel is written in portable C, without dependencies on UIKit or CoreGraphics,
+ so that it may be tested and benchmarked on any platform.
+ */
+
+/// The result of measuring the coverage of a rendering.
+typedef struct {
+    /// The number of pixels sampled.
+    size_t sampledPixelCount;
+    /// The number of pixels sampled at which the target is visible.
+    size_t visiblePixelCount;
+} SLCoverage;
+
+/**
+ Measures the coverage of a rendering.
+
+ @param pixels The pixels of the rendering.
+ @param width The width of the rendering, in pixels.
+ @param height The height of the rendering, in pixels.
+ @param bytesPerRow The number of bytes between the starts of consecutive rows of _pixels_.
+ @param stride The distance, in pixels, between the samples in each dimension:
+ `1` to sample every pixel, `2` to sample every other pixel of every other row, etc.
+ Values less than `1` are treated as `1`.
+ @param minAlpha The minimum alpha of a pixel at which the target is visible.
+ @return The coverage of the rendering.
+ */
+SLCoverage SLCoverageOfPixels(const unsigned char *pixels, size_t width, size_t height, size_t bytesPerRow,
+                              size_t stride, unsigned char minAlpha);
+
+/**
+ Returns the fraction of the sampled pixels at which the target is visible.
+
+ @param coverage The coverage of a rendering.
+ @return The fraction of the pixels sampled by _coverage_ which were visible,
+ or `0.0` if no pixels were sampled.
+ */
+double SLCoverageFraction(SLCoverage coverage);
+
+/**
+ Returns the smallest stride at which a rendering may be sampled
+ without exceeding a maximum number of samples.
+
+ @param width The width of the rendering, in pixels.
+ @param height The height of the rendering, in pixels.
+ @param maxSampledPixelCount The maximum number of pixels to sample.
+ @return The smallest stride at which no more than _maxSampledPixelCount_ pixels
+ of the rendering will be sampled.
+ */
+size_t SLCoverageStrideForMaxSampledPixelCount(size_t width, size_t height, size_t maxSampledPixelCount);
+
+#endif
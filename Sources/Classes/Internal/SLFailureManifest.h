@@ -0,0 +1,149 @@
+//
+//  SLFailureManifest.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ An `SLFailureManifest` records the tests and test cases which failed during
+ a run, in the order in which they failed, along with the seed of the run,
+ so that the failures may be run again (see `-[SLTestController rerunManifestPath]`).
+
+ Manifests are persisted as a JSON file of the form
+
+    {
+        "version": 1,
+        "seed": <seed>,
+        "failures": [
+            { "test": "<test>", "testCase": "<test case>" },
+            { "test": "<test>" },
+            ...
+        ]
+    }
+
+ where a failure without a test case signifies that the test failed
+ in set-up or tear-down, so that all of its test cases must be run again.
+ Tests and test cases are identified by their unfocused names.
+
+ Instances of `SLFailureManifest` are not thread-safe.
+ */
+@interface SLFailureManifest : NSObject
+
+/**
+ Initializes and returns a newly allocated, empty manifest.
+
+ @param seed The seed of the run whose failures the manifest will record.
+ @return An initialized manifest.
+ */
+- (instancetype)initWithSeed:(unsigned int)seed;
+
+/**
+ Initializes and returns a newly allocated manifest with the failures
+ recorded in the specified file.
+
+ @param path The absolute path of a manifest file.
+ @param error If the file cannot be read or parsed and this is non-`NULL`,
+ upon return this will be set to an error describing the failure.
+ @return An initialized manifest, or `nil` if the file could not be read or parsed.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+/**
+ The seed of the run whose failures the receiver records.
+ */
+@property (nonatomic, readonly) unsigned int seed;
+
+/**
+ Descriptions of the failures recorded by the receiver, in the order in which
+ they were recorded: "<test>.<test case>", or "<test>" for a test which
+ failed in set-up or tear-down.
+ */
+@property (nonatomic, readonly) NSArray *failureDescriptions;
+
+/**
+ Returns the descriptions of the failures of the specified tests.
+
+ @param tests A collection of tests.
+ @return Those of the receiver's `failureDescriptions` which describe failures
+ of tests in `tests`, in the order in which they were recorded.
+ */
+- (NSArray *)failureDescriptionsOfTests:(id<NSFastEnumeration>)tests;
+
+/**
+ Records the failure of a test case.
+
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordFailureOfTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records the failure of a test in set-up or tear-down.
+
+ @param test The test that failed.
+ */
+- (void)recordFailureOfTest:(Class)test;
+
+/**
+ Returns those of the specified tests which have recorded failures,
+ in the order in which the tests first failed.
+
+ @param tests A collection of tests.
+ @return The tests in `tests` which have recorded failures, in order of failure.
+ */
+- (NSArray *)testsWithFailuresFromTests:(id<NSFastEnumeration>)tests;
+
+/**
+ Returns those of the specified test cases which must be run again
+ to reproduce the recorded failures of a test.
+
+ @param testCases The test cases of `test` which would otherwise run.
+ @param test A test.
+ @return All of `testCases` if the test failed in set-up or tear-down,
+ otherwise those of `testCases` which failed.
+ */
+- (NSSet *)testCasesWithFailuresFromTestCases:(NSSet *)testCases ofTest:(Class)test;
+
+/**
+ Returns whether a failure recorded by the receiver was reproduced
+ by the failures recorded in another manifest.
+
+ A failure of a test in set-up or tear-down is reproduced by any failure
+ of that test.
+
+ @param failureDescription One of the receiver's `failureDescriptions`.
+ @param manifest The manifest of a run which ran the failure again.
+ @return `YES` if `manifest` records a failure reproducing the specified failure,
+ otherwise `NO`.
+ */
+- (BOOL)failure:(NSString *)failureDescription wasReproducedByManifest:(SLFailureManifest *)manifest;
+
+/**
+ Writes the receiver to the specified file, replacing the file's contents.
+
+ @param path The absolute path of the file to write.
+ @param error If the file cannot be written and this is non-`NULL`,
+ upon return this will be set to an error describing the failure.
+ @return `YES` if the file was written, otherwise `NO`.
+ */
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+@end
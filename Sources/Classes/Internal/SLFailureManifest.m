@@ -0,0 +1,182 @@
+//
+//  SLFailureManifest.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLFailureManifest.h"
+
+#import "SLTest+Internal.h"
+
+/// The version of the manifest file format written by `SLFailureManifest`.
+static const NSUInteger kSLFailureManifestVersion = 1;
+
+/// Returns a description of a failure of the specified test case (or test, if `testCase` is `nil`).
+static NSString *SLDescriptionOfFailure(NSString *test, NSString *testCase) {
+    return (testCase ? [NSString stringWithFormat:@"%@.%@", test, testCase] : test);
+}
+
+@implementation SLFailureManifest {
+    // failures as dictionaries with "test" and (optionally) "testCase" keys, in order
+    NSMutableArray *_failures;
+    NSMutableArray *_failureDescriptions;
+    // the names of the tests which failed in set-up or tear-down
+    NSMutableSet *_testsThatFailed;
+    // the names of the test cases which failed, keyed by test name
+    NSMutableDictionary *_testCasesThatFailed;
+}
+
+- (instancetype)initWithSeed:(unsigned int)seed {
+    self = [super init];
+    if (self) {
+        _seed = seed;
+        _failures = [[NSMutableArray alloc] init];
+        _failureDescriptions = [[NSMutableArray alloc] init];
+        _testsThatFailed = [[NSMutableSet alloc] init];
+        _testCasesThatFailed = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    NSData *data = [NSData dataWithContentsOfFile:path options:0 error:error];
+    if (!data) return nil;
+
+    NSDictionary *file = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!file) return nil;
+
+    if (![file isKindOfClass:[NSDictionary class]] ||
+        ([file[@"version"] unsignedIntegerValue] != kSLFailureManifestVersion) ||
+        ![file[@"seed"] isKindOfClass:[NSNumber class]] ||
+        ![file[@"failures"] isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError
+                                     userInfo:@{ NSFilePathErrorKey: path,
+                                                 NSLocalizedDescriptionKey: @"The file is not a failure manifest." }];
+        }
+        return nil;
+    }
+
+    self = [self initWithSeed:[file[@"seed"] unsignedIntValue]];
+    if (self) {
+        for (NSDictionary *failure in file[@"failures"]) {
+            if (![failure isKindOfClass:[NSDictionary class]] || ![failure[@"test"] isKindOfClass:[NSString class]]) continue;
+            NSString *testCase = ([failure[@"testCase"] isKindOfClass:[NSString class]] ? failure[@"testCase"] : nil);
+            [self recordFailureOfTestCase:testCase inTestNamed:failure[@"test"]];
+        }
+    }
+    return self;
+}
+
+- (NSArray *)failureDescriptions {
+    return [_failureDescriptions copy];
+}
+
+- (NSArray *)failureDescriptionsOfTests:(id<NSFastEnumeration>)tests {
+    NSMutableSet *testNames = [[NSMutableSet alloc] init];
+    for (Class test in tests) {
+        [testNames addObject:[test unfocusedName]];
+    }
+
+    NSMutableArray *failureDescriptions = [[NSMutableArray alloc] init];
+    [_failures enumerateObjectsUsingBlock:^(NSDictionary *failure, NSUInteger idx, BOOL *stop) {
+        if ([testNames containsObject:failure[@"test"]]) [failureDescriptions addObject:_failureDescriptions[idx]];
+    }];
+    return [failureDescriptions copy];
+}
+
+- (void)recordFailureOfTestCase:(NSString *)testCase inTestNamed:(NSString *)test {
+    NSString *failureDescription = SLDescriptionOfFailure(test, testCase);
+    if ([_failureDescriptions containsObject:failureDescription]) return;
+
+    if (testCase) {
+        NSMutableSet *testCases = _testCasesThatFailed[test];
+        if (!testCases) {
+            testCases = [[NSMutableSet alloc] init];
+            _testCasesThatFailed[test] = testCases;
+        }
+        [testCases addObject:testCase];
+        [_failures addObject:@{ @"test": test, @"testCase": testCase }];
+    } else {
+        [_testsThatFailed addObject:test];
+        [_failures addObject:@{ @"test": test }];
+    }
+    [_failureDescriptions addObject:failureDescription];
+}
+
+- (void)recordFailureOfTestCase:(NSString *)testCase inTest:(Class)test {
+    [self recordFailureOfTestCase:[test unfocusedTestCaseName:testCase] inTestNamed:[test unfocusedName]];
+}
+
+- (void)recordFailureOfTest:(Class)test {
+    [self recordFailureOfTestCase:nil inTestNamed:[test unfocusedName]];
+}
+
+- (NSArray *)testsWithFailuresFromTests:(id<NSFastEnumeration>)tests {
+    NSMutableDictionary *testsByName = [[NSMutableDictionary alloc] init];
+    for (Class test in tests) {
+        testsByName[[test unfocusedName]] = test;
+    }
+
+    NSMutableArray *testsWithFailures = [[NSMutableArray alloc] init];
+    for (NSDictionary *failure in _failures) {
+        Class test = testsByName[failure[@"test"]];
+        if (test && ![testsWithFailures containsObject:test]) [testsWithFailures addObject:test];
+    }
+    return [testsWithFailures copy];
+}
+
+- (NSSet *)testCasesWithFailuresFromTestCases:(NSSet *)testCases ofTest:(Class)test {
+    NSString *testName = [test unfocusedName];
+    if ([_testsThatFailed containsObject:testName]) return testCases;
+
+    NSSet *testCasesThatFailed = _testCasesThatFailed[testName];
+    return [testCases objectsPassingTest:^BOOL(NSString *testCase, BOOL *stop) {
+        return [testCasesThatFailed containsObject:[test unfocusedTestCaseName:testCase]];
+    }];
+}
+
+- (BOOL)failure:(NSString *)failureDescription wasReproducedByManifest:(SLFailureManifest *)manifest {
+    NSUInteger failureIndex = [_failureDescriptions indexOfObject:failureDescription];
+    if (failureIndex == NSNotFound) return NO;
+
+    NSDictionary *failure = _failures[failureIndex];
+    NSString *test = failure[@"test"], *testCase = failure[@"testCase"];
+    if ([manifest->_testsThatFailed containsObject:test]) return YES;
+    if (testCase) {
+        return [manifest->_testCasesThatFailed[test] containsObject:testCase];
+    } else {
+        return ([manifest->_testCasesThatFailed[test] count] > 0);
+    }
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    NSDictionary *file = @{ @"version": @(kSLFailureManifestVersion), @"seed": @(_seed), @"failures": _failures };
+    NSData *data = [NSJSONSerialization dataWithJSONObject:file options:NSJSONWritingPrettyPrinted error:error];
+    return (data && [data writeToFile:path options:NSDataWritingAtomic error:error]);
+}
+
+@end
@@ -0,0 +1,144 @@
+//
+//  SLImageDiff.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "SLImageDiff.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+/// The sums accumulated while comparing the changed tiles of a rendering.
+typedef struct {
+    size_t differingPixelCount;
+    uint64_t difference;
+} SLImageDiffSums;
+
+/// Accumulates the difference of a pixel given the absolute differences of its channels,
+/// if any of the differences exceeds the tolerance.
+static inline void SLImageDiffAccumulatePixel(const unsigned char *channelDifferences, unsigned char channelTolerance,
+                                              unsigned char *maskPixel, SLImageDiffSums *sums) {
+    const unsigned char red = channelDifferences[0], green = channelDifferences[1];
+    const unsigned char blue = channelDifferences[2], alpha = channelDifferences[3];
+    if ((red <= channelTolerance) && (green <= channelTolerance) &&
+        (blue <= channelTolerance) && (alpha <= channelTolerance)) return;
+
+    // weight the channels by their contribution to luminance (per Rec. 601), in 8-bit fixed point
+    const unsigned luminance = ((77 * red) + (150 * green) + (29 * blue) + 128) >> 8;
+    sums->difference += (luminance > alpha) ? luminance : alpha;
+    sums->differingPixelCount++;
+    if (maskPixel) *maskPixel = 255;
+}
+
+/// Compares a row of a tile, pixel by pixel.
+static void SLImageDiffCompareRow(const unsigned char *row, const unsigned char *referenceRow, size_t width,
+                                  unsigned char channelTolerance, unsigned char *maskRow, SLImageDiffSums *sums) {
+    size_t x = 0;
+    unsigned char channelDifferences[16];
+
+#if defined(__SSE2__)
+    // The absolute difference of unsigned bytes is the larger of their saturating differences;
+    // a pixel is within the tolerance if all of its channels are zero after subtracting the tolerance.
+    const __m128i tolerance = _mm_set1_epi8((char)channelTolerance);
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= width; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(row + (4 * x)));
+        const __m128i referencePixels = _mm_loadu_si128((const __m128i *)(referenceRow + (4 * x)));
+        const __m128i differences = _mm_or_si128(_mm_subs_epu8(pixels, referencePixels),
+                                                 _mm_subs_epu8(referencePixels, pixels));
+        const __m128i withinTolerance = _mm_cmpeq_epi32(_mm_subs_epu8(differences, tolerance), zero);
+        if (_mm_movemask_epi8(withinTolerance) == 0xFFFF) continue;
+
+        _mm_storeu_si128((__m128i *)channelDifferences, differences);
+        for (size_t lane = 0; lane < 4; lane++) {
+            SLImageDiffAccumulatePixel(channelDifferences + (4 * lane), channelTolerance,
+                                       (maskRow ? maskRow + x + lane : NULL), sums);
+        }
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const uint8x16_t tolerance = vdupq_n_u8(channelTolerance);
+    for (; x + 4 <= width; x += 4) {
+        const uint8x16_t differences = vabdq_u8(vld1q_u8(row + (4 * x)), vld1q_u8(referenceRow + (4 * x)));
+        const uint8x16_t excess = vqsubq_u8(differences, tolerance);
+        const uint64x2_t excessHalves = vreinterpretq_u64_u8(excess);
+        if (!(vgetq_lane_u64(excessHalves, 0) | vgetq_lane_u64(excessHalves, 1))) continue;
+
+        vst1q_u8(channelDifferences, differences);
+        for (size_t lane = 0; lane < 4; lane++) {
+            SLImageDiffAccumulatePixel(channelDifferences + (4 * lane), channelTolerance,
+                                       (maskRow ? maskRow + x + lane : NULL), sums);
+        }
+    }
+#endif
+
+    for (; x < width; x++) {
+        for (size_t channel = 0; channel < 4; channel++) {
+            const unsigned char value = row[(4 * x) + channel], referenceValue = referenceRow[(4 * x) + channel];
+            channelDifferences[channel] = (value > referenceValue) ? (value - referenceValue) : (referenceValue - value);
+        }
+        SLImageDiffAccumulatePixel(channelDifferences, channelTolerance, (maskRow ? maskRow + x : NULL), sums);
+    }
+}
+
+SLImageDiff SLImageDiffOfPixels(const unsigned char *pixels, size_t bytesPerRow,
+                                const unsigned char *referencePixels, size_t referenceBytesPerRow,
+                                size_t width, size_t height, unsigned char channelTolerance,
+                                unsigned char *mask, size_t maskBytesPerRow) {
+    SLImageDiff diff = { width * height, 0, 0, 0, 0.0 };
+    SLImageDiffSums sums = { 0, 0 };
+
+    for (size_t tileY = 0; tileY < height; tileY += kSLImageDiffTileSize) {
+        const size_t tileHeight = ((height - tileY) < kSLImageDiffTileSize) ? (height - tileY) : kSLImageDiffTileSize;
+
+        for (size_t tileX = 0; tileX < width; tileX += kSLImageDiffTileSize) {
+            const size_t tileWidth = ((width - tileX) < kSLImageDiffTileSize) ? (width - tileX) : kSLImageDiffTileSize;
+            diff.tileCount++;
+
+            // skip the tile if it's identical, as most tiles of a matching rendering will be
+            size_t y = tileY;
+            for (; y < tileY + tileHeight; y++) {
+                if (memcmp(pixels + (y * bytesPerRow) + (4 * tileX),
+                           referencePixels + (y * referenceBytesPerRow) + (4 * tileX),
+                           4 * tileWidth) != 0) break;
+            }
+            if (y == tileY + tileHeight) continue;
+            diff.changedTileCount++;
+
+            // the rows above the first differing row were identical
+            for (; y < tileY + tileHeight; y++) {
+                SLImageDiffCompareRow(pixels + (y * bytesPerRow) + (4 * tileX),
+                                      referencePixels + (y * referenceBytesPerRow) + (4 * tileX),
+                                      tileWidth, channelTolerance,
+                                      (mask ? mask + (y * maskBytesPerRow) + tileX : NULL), &sums);
+            }
+        }
+    }
+
+    diff.differingPixelCount = sums.differingPixelCount;
+    if (diff.pixelCount) diff.score = (double)sums.difference / (255.0 * (double)diff.pixelCount);
+    return diff;
+}
@@ -0,0 +1,89 @@
+//
+//  SLImageDiff.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Subliminal_SLImageDiff_h
+#define Subliminal_SLImageDiff_h
+
+#include <stddef.h>
+
+/*
+ The image diff kernel compares a rendering to a reference rendering of the same size,
+ producing a score of how different the renderings appear and, optionally, a mask
+ of the pixels that differ.
+
+ The pixels are expected to be 32-bit, with the red, green, blue, and alpha channels
+ in that order in memory, as rendered by a bitmap context using
+ `kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big`.
+
+ The renderings are compared in square tiles. A tile whose pixels are byte-for-byte
+ identical in both renderings is skipped as soon as that has been established;
+ the pixels of other tiles are compared using SSE2 or NEON, where available,
+ several pixels at a time. A pixel differs if any of its channels differs by more
+ than a tolerance, which absorbs the noise of anti-aliasing and color conversion.
+
+ The kernel is written in portable C, without dependencies on UIKit or CoreGraphics,
+ so that it may be tested and benchmarked on any platform.
+ */
+
+/// The width and height of the tiles in which renderings are compared, in pixels.
+enum { kSLImageDiffTileSize = 16 };
+
+/// The result of comparing a rendering to a reference rendering.
+typedef struct {
+    /// The number of pixels compared.
+    size_t pixelCount;
+    /// The number of pixels which differ.
+    size_t differingPixelCount;
+    /// The number of tiles compared.
+    size_t tileCount;
+    /// The number of tiles which were not identical.
+    size_t changedTileCount;
+    /// How different the renderings appear, from `0.0` (identical) to `1.0`
+    /// (e.g. opaque black vs. opaque white): the mean over all pixels of the
+    /// difference in each differing pixel's luminance or alpha, whichever is greater.
+    double score;
+} SLImageDiff;
+
+/**
+ Compares a rendering to a reference rendering.
+
+ @param pixels The pixels of the rendering.
+ @param bytesPerRow The number of bytes between the starts of consecutive rows of _pixels_.
+ @param referencePixels The pixels of the reference rendering.
+ @param referenceBytesPerRow The number of bytes between the starts of consecutive rows
+ of _referencePixels_.
+ @param width The width of the renderings, in pixels.
+ @param height The height of the renderings, in pixels.
+ @param channelTolerance The largest difference in any channel of a pixel
+ at which the pixel will not be considered to differ.
+ @param mask If not `NULL`, a buffer of one byte per pixel in which the kernel will set
+ the bytes corresponding to differing pixels to `255`. The kernel does not write
+ the bytes corresponding to other pixels, so the buffer should be zeroed beforehand.
+ @param maskBytesPerRow The number of bytes between the starts of consecutive rows of _mask_.
+ @return The result of the comparison.
+ */
+SLImageDiff SLImageDiffOfPixels(const unsigned char *pixels, size_t bytesPerRow,
+                                const unsigned char *referencePixels, size_t referenceBytesPerRow,
+                                size_t width, size_t height, unsigned char channelTolerance,
+                                unsigned char *mask, size_t maskBytesPerRow);
+
+#endif
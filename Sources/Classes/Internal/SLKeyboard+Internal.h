@@ -0,0 +1,61 @@
+//
+//  SLKeyboard+Internal.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Subliminal/Subliminal.h>
+
+/**
+ The methods in the `SLKeyboard (Internal)` category are to be used only
+ within Subliminal.
+ */
+@interface SLKeyboard (Internal)
+
+#pragma mark - Internal Methods
+/// ----------------------------------------
+/// @name Internal Methods
+/// ----------------------------------------
+
+/**
+ Replaces the text of the specified element by entering the specified string
+ using the specified strategy.
+
+ This method is equivalent to tapping _element_ if it does not have keyboard focus,
+ sending it the `setValue('')` JavaScript message to clear its current text,
+ and then (by default) invoking `-typeString:withSetValueFallbackUsingElement:`
+ with _string_ and _element_. But where each of those steps would resolve _element_
+ (or the receiver) anew and require its own round trip to UIAutomation, this method
+ resolves _element_ once, and then performs all of the steps in a single JavaScript program.
+
+ Exceptions are raised as they would be by the individual steps: if _element_
+ is invalid or is not tappable, or if UIAutomation fails to tap or clear _element_.
+ If the receiver fails to type _string_, for whatever reason, this method falls back on setting
+ the value of _element_, as does `-typeString:withSetValueFallbackUsingElement:`,
+ and logs a warning. If the value of _element_ does not match _string_ once it has been entered,
+ this method logs a warning and, unless _strategy_ is `SLTextEntryStrategyPerCharacter`,
+ also falls back on setting the value of _element_.
+
+ @param element The element whose text to replace.
+ @param string The string to be entered.
+ @param strategy The strategy by which to enter _string_.
+ */
+- (void)replaceTextOfElement:(SLUIAElement *)element withString:(NSString *)string strategy:(SLTextEntryStrategy)strategy;
+
+@end
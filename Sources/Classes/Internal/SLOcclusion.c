@@ -0,0 +1,123 @@
+//
+//  SLOcclusion.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "SLOcclusion.h"
+
+#include <math.h>
+
+
+SLOcclusionNode SLOcclusionNodeMake(SLOcclusionTransform localToBase, SLOcclusionRect bounds,
+                                    long clipIndex, SLOcclusionNodeKind kind) {
+    SLOcclusionNode node;
+    node.bounds = bounds;
+    node.clipIndex = clipIndex;
+    node.kind = kind;
+
+    const double determinant = (localToBase.a * localToBase.d) - (localToBase.b * localToBase.c);
+    node.isInvertible = (fabs(determinant) > 1e-12);
+    if (node.isInvertible) {
+        const SLOcclusionTransform t = localToBase;
+        node.baseToLocal.a = t.d / determinant;
+        node.baseToLocal.b = -t.b / determinant;
+        node.baseToLocal.c = -t.c / determinant;
+        node.baseToLocal.d = t.a / determinant;
+        node.baseToLocal.tx = ((t.c * t.ty) - (t.d * t.tx)) / determinant;
+        node.baseToLocal.ty = ((t.b * t.tx) - (t.a * t.ty)) / determinant;
+    } else {
+        node.baseToLocal = (SLOcclusionTransform){ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    }
+    return node;
+}
+
+static int SLOcclusionNodeBoundsContainPoint(const SLOcclusionNode *node, SLOcclusionPoint point) {
+    if (!node->isInvertible) return 0;
+
+    const SLOcclusionTransform t = node->baseToLocal;
+    const double x = (t.a * point.x) + (t.c * point.y) + t.tx;
+    const double y = (t.b * point.x) + (t.d * point.y) + t.ty;
+
+    // like `CGRectContainsPoint`, the rect contains its minimum edges but not its maximum edges
+    const SLOcclusionRect r = node->bounds;
+    return ((x >= r.x) && (x < r.x + r.width) &&
+            (y >= r.y) && (y < r.y + r.height));
+}
+
+int SLOcclusionNodeCoversPoint(const SLOcclusionNode *nodes, size_t index, SLOcclusionPoint point) {
+    const SLOcclusionNode *node = &nodes[index];
+    if (!SLOcclusionNodeBoundsContainPoint(node, point)) return 0;
+
+    long clipIndex = node->clipIndex;
+    while (clipIndex >= 0) {
+        const SLOcclusionNode *clipNode = &nodes[clipIndex];
+        if (!SLOcclusionNodeBoundsContainPoint(clipNode, point)) return 0;
+        clipIndex = clipNode->clipIndex;
+    }
+    return 1;
+}
+
+SLOcclusionVisibility SLOcclusionVisibilityOfPoint(const SLOcclusionNode *nodes, size_t nodeCount,
+                                                   SLOcclusionPoint point) {
+    // Emulates the rendering performed by `NSObject (SLVisibility)`:
+    // target nodes fill the point, and later nodes erase it to the extent that they are opaque.
+    int isVisible = 0;
+    for (size_t index = 0; index < nodeCount; index++) {
+        const SLOcclusionNodeKind kind = nodes[index].kind;
+
+        // a node can only affect the point's visibility if it is a target node,
+        // or if the point is currently visible
+        if ((kind == SLOcclusionNodeKindTransparent) ||
+            (!isVisible && (kind != SLOcclusionNodeKindTarget))) continue;
+
+        if (!SLOcclusionNodeCoversPoint(nodes, index, point)) continue;
+
+        switch (kind) {
+            case SLOcclusionNodeKindTarget:
+                isVisible = 1;
+                break;
+            case SLOcclusionNodeKindOpaque:
+                isVisible = 0;
+                break;
+            case SLOcclusionNodeKindIndeterminate:
+                return SLOcclusionVisibilityIndeterminate;
+            case SLOcclusionNodeKindTransparent:
+                break;
+        }
+    }
+    return (isVisible ? SLOcclusionVisibilityVisible : SLOcclusionVisibilityOccluded);
+}
+
+long SLOcclusionNumberOfVisiblePoints(const SLOcclusionNode *nodes, size_t nodeCount,
+                                      const SLOcclusionPoint *points, size_t pointCount) {
+    long count = 0;
+    for (size_t pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+        switch (SLOcclusionVisibilityOfPoint(nodes, nodeCount, points[pointIndex])) {
+            case SLOcclusionVisibilityVisible:
+                count++;
+                break;
+            case SLOcclusionVisibilityOccluded:
+                break;
+            case SLOcclusionVisibilityIndeterminate:
+                return -1;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,140 @@
+//
+//  SLOcclusion.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Subliminal_SLOcclusion_h
+#define Subliminal_SLOcclusion_h
+
+#include <stddef.h>
+
+/*
+ The occlusion engine determines whether points within a target view are visible,
+ given a description of the view hierarchy flattened into an array of "nodes"
+ in the order in which the views would be drawn.
+
+ The engine is written in portable C, without dependencies on UIKit or CoreGraphics,
+ so that it may be exercised using synthetic view hierarchies.
+ `NSObject (SLVisibility)` is responsible for flattening real view hierarchies.
+
+ A point is visible if the last node to cover the point that is a target node
+ is not followed by any node covering the point that is opaque. If the point
+ is covered by an indeterminate node after it is covered by a target node,
+ the engine cannot determine the visibility of the point, and the client must
+ fall back to rendering the hierarchy.
+ */
+
+#pragma mark - Geometry
+
+typedef struct {
+    double x, y;
+} SLOcclusionPoint;
+
+typedef struct {
+    double x, y, width, height;
+} SLOcclusionRect;
+
+/// An affine transform with the same form as a `CGAffineTransform`:
+/// `x' = a * x + c * y + tx`, `y' = b * x + d * y + ty`.
+typedef struct {
+    double a, b, c, d, tx, ty;
+} SLOcclusionTransform;
+
+#pragma mark - Describing the View Hierarchy
+
+typedef enum {
+    /// The node draws nothing. Such nodes need only be included in the hierarchy
+    /// if they clip their descendants.
+    SLOcclusionNodeKindTransparent,
+    /// The node draws a completely opaque fill throughout its bounds.
+    SLOcclusionNodeKindOpaque,
+    /// The node is the target, or a descendant of the target.
+    SLOcclusionNodeKindTarget,
+    /// The node may draw content, or may be translucent, within its bounds.
+    SLOcclusionNodeKindIndeterminate
+} SLOcclusionNodeKind;
+
+typedef struct {
+    SLOcclusionTransform baseToLocal;
+    SLOcclusionRect bounds;
+    long clipIndex;
+    SLOcclusionNodeKind kind;
+    int isInvertible;
+} SLOcclusionNode;
+
+/**
+ Creates a node.
+
+ @param localToBase The transform which maps points in the node's coordinate system
+ to the base coordinate system (that of the points to be tested).
+ @param bounds The area in which the node draws, in its own coordinate system.
+ @param clipIndex The index of the node's nearest ancestor which clips its descendants
+ to its bounds, or `-1` if no ancestor does so. The ancestor must precede the node
+ in the array of nodes.
+ @param kind The kind of node.
+ @return A node. If _localToBase_ is not invertible (e.g. if it scales to zero),
+ the node covers no points.
+ */
+SLOcclusionNode SLOcclusionNodeMake(SLOcclusionTransform localToBase, SLOcclusionRect bounds,
+                                    long clipIndex, SLOcclusionNodeKind kind);
+
+/**
+ Returns whether a node covers a point, taking into account its ancestors' clipping.
+
+ @param nodes The array of nodes in which _index_ is located.
+ @param index The index of the node to test.
+ @param point A point in the base coordinate system.
+ @return Non-zero if the node covers _point_, `0` otherwise.
+ */
+int SLOcclusionNodeCoversPoint(const SLOcclusionNode *nodes, size_t index, SLOcclusionPoint point);
+
+#pragma mark - Testing Visibility
+
+typedef enum {
+    SLOcclusionVisibilityOccluded,
+    SLOcclusionVisibilityVisible,
+    SLOcclusionVisibilityIndeterminate
+} SLOcclusionVisibility;
+
+/**
+ Determines whether the target is visible at a point.
+
+ @param nodes The nodes describing the view hierarchy, in drawing order.
+ @param nodeCount The number of elements in _nodes_.
+ @param point A point in the base coordinate system.
+ @return The visibility of the target at _point_.
+ */
+SLOcclusionVisibility SLOcclusionVisibilityOfPoint(const SLOcclusionNode *nodes, size_t nodeCount,
+                                                   SLOcclusionPoint point);
+
+/**
+ Counts the number of points at which the target is visible.
+
+ @param nodes The nodes describing the view hierarchy, in drawing order.
+ @param nodeCount The number of elements in _nodes_.
+ @param points The points to test, in the base coordinate system.
+ @param pointCount The number of elements in _points_.
+ @return The number of points at which the target is visible, or `-1` if
+ the visibility of any point is indeterminate.
+ */
+long SLOcclusionNumberOfVisiblePoints(const SLOcclusionNode *nodes, size_t nodeCount,
+                                      const SLOcclusionPoint *points, size_t pointCount);
+
+#endif
@@ -0,0 +1,238 @@
+//
+//  SLRunCheckpoint.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ An `SLRunCheckpoint` records the progress of a test run to a file as the run
+ proceeds, so that if the application crashes, the run may be resumed
+ where it left off when the application is relaunched.
+
+ The file is a sequence of JSON records, one per line:
+
+    { "version": 1, "seed": <seed>, "tests": [ "<test>", ... ] }
+    { "fixture": "<class>", "setUp": "<selector>" }
+    { "fixture": "<class>", "setUp": "<selector>", "completed": true }
+    { "test": "<test>" }
+    { "test": "<test>", "testCase": "<test case>" }
+    { "test": "<test>", "testCase": "<test case>", "completed": true, "failed": <bool> }
+    { "test": "<test>", "completed": true, "failed": <bool>, "aborted": <bool> }
+    ...
+    { "completed": true }
+
+ The first record describes the run: the seed with which it was ordered,
+ and the tests to run, in order. A test or test case is recorded when it starts,
+ and again when it completes, as is the set-up of a fixture shared by several tests
+ (see `+[SLTest setUpRunGroup]` and `+[SLTest setUpSuite]`). The last record
+ marks the completion of the run.
+ Tests and test cases are identified by their names as they run.
+
+ Each record is appended to the file before the run proceeds, so that
+ if the application crashes, the file identifies the test case (or test)
+ that was running.
+
+ Instances of `SLRunCheckpoint` are not thread-safe.
+ */
+@interface SLRunCheckpoint : NSObject
+
+/**
+ Initializes and returns a newly allocated checkpoint for a new run.
+
+ @param seed The seed with which the run was ordered.
+ @param tests The tests to run, in order.
+ @return An initialized checkpoint.
+ */
+- (instancetype)initWithSeed:(unsigned int)seed tests:(NSArray *)tests;
+
+/**
+ Initializes and returns a newly allocated checkpoint with the progress
+ recorded in the specified file.
+
+ A record which cannot be parsed, e.g. because the application crashed
+ while writing it, is ignored.
+
+ @param path The absolute path of a checkpoint file.
+ @param error If the file cannot be read or does not begin by describing a run,
+ and this is non-`NULL`, upon return this will be set to an error describing the failure.
+ @return A checkpoint initialized with the progress recorded in the file,
+ or `nil` if the file could not be read.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+/// The seed with which the run was ordered.
+@property (nonatomic, readonly) unsigned int seed;
+
+/// The names of the tests to run, in order.
+@property (nonatomic, readonly) NSArray *testNames;
+
+/// Whether the run was completed, in which case it should not be resumed.
+@property (nonatomic, readonly) BOOL runWasCompleted;
+
+/// The number of tests completed, including those which aborted.
+@property (nonatomic, readonly) NSUInteger numTestsCompleted;
+
+/// The number of tests completed that failed or aborted.
+@property (nonatomic, readonly) NSUInteger numTestsFailed;
+
+/**
+ The failures recorded, in the order in which they occurred.
+
+ Each failure is a dictionary with a "test" key and, if a test case failed
+ (rather than the test aborting), a "testCase" key.
+ */
+@property (nonatomic, readonly) NSArray *failures;
+
+/**
+ Returns those of the specified tests which remain to be run,
+ in the order in which the run was to run them.
+
+ @param tests The tests that may be run.
+ @return Those of `tests` that the receiver's run was to run, but that have not completed.
+ */
+- (NSArray *)testsToResumeFromTests:(id<NSFastEnumeration>)tests;
+
+/**
+ Returns whether the specified test was running, but not running a test case,
+ when the run was interrupted--i.e. whether the application crashed while the test
+ was being set up or torn down.
+
+ @param test A test.
+ @return `YES` if the test started but did not complete, and none of its
+ test cases was running, otherwise `NO`.
+ */
+- (BOOL)testWasInterruptedOutsideOfTestCase:(Class)test;
+
+/**
+ Returns whether the application crashed while the specified fixture was being set up.
+
+ @param setUpSelector The class method which sets up the fixture, e.g. `setUpRunGroup`.
+ @param fixtureClass The class which implements `setUpSelector`.
+ @return `YES` if the fixture's set-up started but did not complete, otherwise `NO`.
+ */
+- (BOOL)fixtureSetUpWasInterrupted:(SEL)setUpSelector inClass:(Class)fixtureClass;
+
+/**
+ Returns the test case of the specified test which was running when the run
+ was interrupted, if any.
+
+ @param test A test.
+ @return The name of the test case which started but did not complete, or `nil`.
+ */
+- (NSString *)interruptedTestCaseOfTest:(Class)test;
+
+/**
+ Returns those of the specified test cases which remain to be run.
+
+ @param testCases The test cases of `test` that may be run, as strings.
+ @param test The test to which the test cases belong.
+ @return Those of `testCases` which neither completed nor were interrupted.
+ */
+- (NSSet *)testCasesToResumeFromTestCases:(NSSet *)testCases ofTest:(Class)test;
+
+/**
+ Returns the number of test cases of the specified test which completed,
+ and how many of them failed, before the run was interrupted.
+
+ A resumed test adds these counts to those of the test cases that it runs,
+ so that the test is reported as if it had run without interruption.
+ The test case which was interrupted (if any) is not counted.
+
+ @param test A test.
+ @param numTestCasesFailed If this is non-`NULL`, upon return this will be set
+ to the number of test cases which failed.
+ @param numTestCasesFailedUnexpectedly If this is non-`NULL`, upon return this will be set
+ to the number of test cases which failed unexpectedly.
+ @return The number of test cases which completed.
+ */
+- (NSUInteger)numTestCasesCompletedInTest:(Class)test
+                                   failed:(NSUInteger *)numTestCasesFailed
+                       failedUnexpectedly:(NSUInteger *)numTestCasesFailedUnexpectedly;
+
+/**
+ Opens the specified file in order to record the progress of the run.
+
+ If the receiver describes a new run, the file is replaced by a description of the run.
+ Otherwise, the receiver's records are appended to the file.
+
+ @param path The absolute path of the checkpoint file.
+ @param error If the file cannot be opened and this is non-`NULL`,
+ upon return this will be set to an error describing the failure.
+ @return `YES` if the file was opened, otherwise `NO`.
+ */
+- (BOOL)openFileAtPath:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+/**
+ Records that the specified fixture is being set up.
+
+ @param setUpSelector The class method which sets up the fixture.
+ @param fixtureClass The class which implements `setUpSelector`.
+ */
+- (void)recordStartOfFixtureSetUp:(SEL)setUpSelector inClass:(Class)fixtureClass;
+
+/**
+ Records that the specified fixture has been set up, whether or not successfully.
+
+ @param setUpSelector The class method which set up the fixture.
+ @param fixtureClass The class which implements `setUpSelector`.
+ */
+- (void)recordCompletionOfFixtureSetUp:(SEL)setUpSelector inClass:(Class)fixtureClass;
+
+/**
+ Records that the specified test is starting.
+
+ @param test The test that is starting.
+ */
+- (void)recordStartOfTest:(Class)test;
+
+/**
+ Records that the specified test case is starting.
+
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordStartOfTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records that the specified test case has completed.
+
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ @param failed Whether the test case failed.
+ @param unexpectedly Whether the test case failed unexpectedly. Ignored if _failed_ is `NO`.
+ */
+- (void)recordCompletionOfTestCase:(NSString *)testCase inTest:(Class)test failed:(BOOL)failed unexpectedly:(BOOL)unexpectedly;
+
+/**
+ Records that the specified test has completed.
+
+ @param test The test that completed.
+ @param aborted Whether the test aborted, having failed in set-up or tear-down.
+ @param failed Whether the test aborted or any of its test cases failed.
+ */
+- (void)recordCompletionOfTest:(Class)test aborted:(BOOL)aborted failed:(BOOL)failed;
+
+/**
+ Records that the run has completed, and closes the file.
+ */
+- (void)recordCompletionOfRun;
+
+@end
@@ -0,0 +1,310 @@
+//
+//  SLRunCheckpoint.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLRunCheckpoint.h"
+#import "SLLogger.h"
+
+/// The version of the checkpoint file format written by `SLRunCheckpoint`.
+static const NSUInteger kSLRunCheckpointVersion = 1;
+
+@implementation SLRunCheckpoint {
+    BOOL _describesNewRun, _fileEndsWithNewline;
+    NSFileHandle *_fileHandle;
+
+    // the names of the tests which started, and which completed
+    NSMutableSet *_startedTests, *_completedTests;
+    // the names of the test cases which completed, keyed by test name
+    NSMutableDictionary *_completedTestCases;
+    // the names of the tests whose test cases failed, each counted once per failed test case
+    NSCountedSet *_testsWithFailedTestCases, *_testsWithUnexpectedlyFailedTestCases;
+    // the name of the test case which started but has not completed, keyed by test name
+    NSMutableDictionary *_runningTestCases;
+    // the fixtures which started but have not completed being set up, as "+[<class> <selector>]"
+    NSMutableSet *_fixturesBeingSetUp;
+    NSMutableArray *_failures;
+}
+
+- (instancetype)initWithSeed:(unsigned int)seed testNames:(NSArray *)testNames {
+    self = [super init];
+    if (self) {
+        _seed = seed;
+        _testNames = [testNames copy];
+        _startedTests = [[NSMutableSet alloc] init];
+        _completedTests = [[NSMutableSet alloc] init];
+        _completedTestCases = [[NSMutableDictionary alloc] init];
+        _testsWithFailedTestCases = [[NSCountedSet alloc] init];
+        _testsWithUnexpectedlyFailedTestCases = [[NSCountedSet alloc] init];
+        _runningTestCases = [[NSMutableDictionary alloc] init];
+        _fixturesBeingSetUp = [[NSMutableSet alloc] init];
+        _failures = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (instancetype)initWithSeed:(unsigned int)seed tests:(NSArray *)tests {
+    NSMutableArray *testNames = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    for (Class test in tests) {
+        [testNames addObject:NSStringFromClass(test)];
+    }
+    self = [self initWithSeed:seed testNames:testNames];
+    if (self) {
+        _describesNewRun = YES;
+    }
+    return self;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    NSData *data = [NSData dataWithContentsOfFile:path options:0 error:error];
+    if (!data) return nil;
+
+    NSString *contents = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    NSMutableArray *records = [[NSMutableArray alloc] init];
+    for (NSString *line in [contents componentsSeparatedByString:@"\n"]) {
+        if (![line length]) continue;
+        id record = [NSJSONSerialization JSONObjectWithData:[line dataUsingEncoding:NSUTF8StringEncoding] options:0 error:NULL];
+        if ([record isKindOfClass:[NSDictionary class]]) [records addObject:record];
+    }
+
+    NSDictionary *run = [records count] ? records[0] : nil;
+    if (([run[@"version"] unsignedIntegerValue] != kSLRunCheckpointVersion) ||
+        ![run[@"seed"] isKindOfClass:[NSNumber class]] ||
+        ![run[@"tests"] isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError
+                                     userInfo:@{ NSFilePathErrorKey: path,
+                                                 NSLocalizedDescriptionKey: @"The file is not a checkpoint." }];
+        }
+        return nil;
+    }
+
+    self = [self initWithSeed:[run[@"seed"] unsignedIntValue] testNames:run[@"tests"]];
+    if (self) {
+        _fileEndsWithNewline = [contents hasSuffix:@"\n"];
+        for (NSDictionary *record in [records subarrayWithRange:NSMakeRange(1, [records count] - 1)]) {
+            [self applyRecord:record];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_fileHandle closeFile];
+}
+
+- (void)applyRecord:(NSDictionary *)record {
+    NSString *test = ([record[@"test"] isKindOfClass:[NSString class]] ? record[@"test"] : nil);
+    NSString *testCase = ([record[@"testCase"] isKindOfClass:[NSString class]] ? record[@"testCase"] : nil);
+    BOOL completed = [record[@"completed"] boolValue], failed = [record[@"failed"] boolValue];
+
+    NSString *fixture = ([record[@"fixture"] isKindOfClass:[NSString class]] ? record[@"fixture"] : nil);
+    if (fixture) {
+        NSString *setUp = ([record[@"setUp"] isKindOfClass:[NSString class]] ? record[@"setUp"] : @"");
+        NSString *fixtureSetUp = [NSString stringWithFormat:@"+[%@ %@]", fixture, setUp];
+        if (completed) {
+            [_fixturesBeingSetUp removeObject:fixtureSetUp];
+        } else {
+            [_fixturesBeingSetUp addObject:fixtureSetUp];
+        }
+    } else if (!test) {
+        if (completed) _runWasCompleted = YES;
+    } else if (testCase) {
+        if (completed) {
+            [_runningTestCases removeObjectForKey:test];
+            NSMutableSet *completedTestCases = _completedTestCases[test];
+            if (!completedTestCases) {
+                completedTestCases = [[NSMutableSet alloc] init];
+                _completedTestCases[test] = completedTestCases;
+            }
+            if ([completedTestCases containsObject:testCase]) return;
+            [completedTestCases addObject:testCase];
+            if (failed) {
+                [_failures addObject:@{ @"test": test, @"testCase": testCase }];
+                [_testsWithFailedTestCases addObject:test];
+                if ([record[@"unexpected"] boolValue]) [_testsWithUnexpectedlyFailedTestCases addObject:test];
+            }
+        } else {
+            _runningTestCases[test] = testCase;
+        }
+    } else {
+        if (completed) {
+            if ([_completedTests containsObject:test]) return;
+            [_completedTests addObject:test];
+            [_runningTestCases removeObjectForKey:test];
+            _numTestsCompleted++;
+            if (failed) _numTestsFailed++;
+            if ([record[@"aborted"] boolValue]) [_failures addObject:@{ @"test": test }];
+        } else {
+            [_startedTests addObject:test];
+        }
+    }
+}
+
+- (NSArray *)failures {
+    return [_failures copy];
+}
+
+- (NSArray *)testsToResumeFromTests:(id<NSFastEnumeration>)tests {
+    NSMutableDictionary *testsByName = [[NSMutableDictionary alloc] init];
+    for (Class test in tests) {
+        testsByName[NSStringFromClass(test)] = test;
+    }
+
+    NSMutableArray *testsToResume = [[NSMutableArray alloc] init];
+    for (NSString *testName in _testNames) {
+        Class test = testsByName[testName];
+        if (test && ![_completedTests containsObject:testName]) [testsToResume addObject:test];
+    }
+    return [testsToResume copy];
+}
+
+- (BOOL)testWasInterruptedOutsideOfTestCase:(Class)test {
+    NSString *testName = NSStringFromClass(test);
+    return ([_startedTests containsObject:testName] &&
+            ![_completedTests containsObject:testName] &&
+            !_runningTestCases[testName]);
+}
+
+- (BOOL)fixtureSetUpWasInterrupted:(SEL)setUpSelector inClass:(Class)fixtureClass {
+    NSString *fixtureSetUp = [NSString stringWithFormat:@"+[%@ %@]", NSStringFromClass(fixtureClass), NSStringFromSelector(setUpSelector)];
+    return [_fixturesBeingSetUp containsObject:fixtureSetUp];
+}
+
+- (NSString *)interruptedTestCaseOfTest:(Class)test {
+    return _runningTestCases[NSStringFromClass(test)];
+}
+
+- (NSSet *)testCasesToResumeFromTestCases:(NSSet *)testCases ofTest:(Class)test {
+    NSString *testName = NSStringFromClass(test);
+    NSSet *completedTestCases = _completedTestCases[testName];
+    NSString *interruptedTestCase = _runningTestCases[testName];
+    if (![completedTestCases count] && !interruptedTestCase) return testCases;
+
+    return [testCases objectsPassingTest:^BOOL(NSString *testCase, BOOL *stop) {
+        return (![completedTestCases containsObject:testCase] && ![testCase isEqualToString:interruptedTestCase]);
+    }];
+}
+
+- (NSUInteger)numTestCasesCompletedInTest:(Class)test
+                                   failed:(NSUInteger *)numTestCasesFailed
+                       failedUnexpectedly:(NSUInteger *)numTestCasesFailedUnexpectedly {
+    NSString *testName = NSStringFromClass(test);
+    if (numTestCasesFailed) *numTestCasesFailed = [_testsWithFailedTestCases countForObject:testName];
+    if (numTestCasesFailedUnexpectedly) *numTestCasesFailedUnexpectedly = [_testsWithUnexpectedlyFailedTestCases countForObject:testName];
+    return [_completedTestCases[testName] count];
+}
+
+- (BOOL)openFileAtPath:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    [_fileHandle closeFile];
+    _fileHandle = nil;
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if (_describesNewRun || ![fileManager fileExistsAtPath:path]) {
+        [fileManager createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+               withIntermediateDirectories:YES attributes:nil error:NULL];
+
+        NSDictionary *run = @{ @"version": @(kSLRunCheckpointVersion), @"seed": @(_seed), @"tests": _testNames };
+        NSMutableData *data = [[NSJSONSerialization dataWithJSONObject:run options:0 error:error] mutableCopy];
+        if (!data) return NO;
+        [data appendData:[@"\n" dataUsingEncoding:NSUTF8StringEncoding]];
+        if (![data writeToFile:path options:NSDataWritingAtomic error:error]) return NO;
+        _fileEndsWithNewline = YES;
+    }
+
+    _fileHandle = [NSFileHandle fileHandleForWritingAtPath:path];
+    if (!_fileHandle) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError
+                                     userInfo:@{ NSFilePathErrorKey: path }];
+        }
+        return NO;
+    }
+    [_fileHandle seekToEndOfFile];
+
+    // terminate a record that was only partially written when the application crashed
+    if (!_fileEndsWithNewline) {
+        [self appendData:[@"\n" dataUsingEncoding:NSUTF8StringEncoding]];
+        _fileEndsWithNewline = YES;
+    }
+    return YES;
+}
+
+- (void)appendData:(NSData *)data {
+    // The data is written to the file immediately (the file handle is unbuffered),
+    // so it will survive the application crashing. We don't synchronize the file
+    // to disk because that would slow the run without guarding against anything
+    // but the system itself crashing.
+    @try {
+        [_fileHandle writeData:data];
+    }
+    @catch (NSException *exception) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The progress of the run could not be recorded, so the run may not be resumed if the application crashes: %@",
+                                             [exception reason]]];
+        [_fileHandle closeFile];
+        _fileHandle = nil;
+    }
+}
+
+- (void)appendRecord:(NSDictionary *)record {
+    [self applyRecord:record];
+    if (!_fileHandle) return;
+
+    NSMutableData *data = [[NSJSONSerialization dataWithJSONObject:record options:0 error:NULL] mutableCopy];
+    [data appendData:[@"\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    [self appendData:data];
+}
+
+- (void)recordStartOfFixtureSetUp:(SEL)setUpSelector inClass:(Class)fixtureClass {
+    [self appendRecord:@{ @"fixture": NSStringFromClass(fixtureClass), @"setUp": NSStringFromSelector(setUpSelector) }];
+}
+
+- (void)recordCompletionOfFixtureSetUp:(SEL)setUpSelector inClass:(Class)fixtureClass {
+    [self appendRecord:@{ @"fixture": NSStringFromClass(fixtureClass), @"setUp": NSStringFromSelector(setUpSelector), @"completed": @YES }];
+}
+
+- (void)recordStartOfTest:(Class)test {
+    [self appendRecord:@{ @"test": NSStringFromClass(test) }];
+}
+
+- (void)recordStartOfTestCase:(NSString *)testCase inTest:(Class)test {
+    [self appendRecord:@{ @"test": NSStringFromClass(test), @"testCase": testCase }];
+}
+
+- (void)recordCompletionOfTestCase:(NSString *)testCase inTest:(Class)test failed:(BOOL)failed unexpectedly:(BOOL)unexpectedly {
+    [self appendRecord:@{ @"test": NSStringFromClass(test), @"testCase": testCase, @"completed": @YES,
+                          @"failed": @(failed), @"unexpected": @(failed && unexpectedly) }];
+}
+
+- (void)recordCompletionOfTest:(Class)test aborted:(BOOL)aborted failed:(BOOL)failed {
+    [self appendRecord:@{ @"test": NSStringFromClass(test), @"completed": @YES, @"failed": @(failed), @"aborted": @(aborted) }];
+}
+
+- (void)recordCompletionOfRun {
+    [self appendRecord:@{ @"completed": @YES }];
+    [_fileHandle closeFile];
+    _fileHandle = nil;
+}
+
+@end
@@ -0,0 +1,94 @@
+//
+//  SLScreenshotWriter.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ Renders views into a graphics context as they are positioned on-screen.
+
+ @param views The views to render, from back to front. They are expected to be windows,
+ or otherwise to be positioned in the coordinate system of the screen.
+ @param context The context into which to render the views, whose current
+ transformation matrix maps the coordinate system of the screen to that of the context.
+ */
+void SLRenderViewsInContext(NSArray *views, CGContextRef context);
+
+/**
+ An `SLScreenshotWriter` captures screenshots within the application, rather than
+ through UIAutomation, and writes them to a directory as PNGs.
+
+ Capturing a screenshot renders the specified views into a bitmap drawn from a small
+ pool of buffers, on the main thread. The bitmap is then encoded and written
+ on a background queue, so capture returns as soon as the views have been rendered.
+ A screenshot that is byte-for-byte identical to the previous screenshot
+ (e.g. because a failure handler captured the same screen several times)
+ is not written.
+ */
+@interface SLScreenshotWriter : NSObject
+
+/**
+ Initializes and returns a newly allocated writer which writes screenshots
+ to the specified directory.
+
+ The directory (and any intermediate directories) will be created if necessary.
+
+ @param directory The absolute path of the directory to which to write screenshots.
+ @return An initialized writer.
+ */
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+/**
+ The directory to which the receiver writes screenshots.
+ */
+@property (nonatomic, readonly) NSString *directory;
+
+/**
+ Captures a screenshot of the specified views.
+
+ The views are rendered as they are positioned on a screen of the specified size
+ (i.e. as windows are positioned on the main screen). The screenshot will be
+ written to a file named by _filename_ and the ".png" extension; if the receiver
+ has already written a screenshot with that name, an integer will be appended
+ to the name to prevent overwriting the previous screenshot.
+
+ This method must be called on the main thread. It returns after the views
+ have been rendered, before the screenshot has been written.
+
+ @param views The views to render, from back to front.
+ @param screenSize The size of the screen on which the views are positioned, in points.
+ @param scale The scale factor of the screen.
+ @param rect The rect of the screen to capture, or `CGRectNull` to capture the entire screen.
+ @param filename The name for the resultant image file.
+
+ @exception NSInternalInconsistencyException Thrown if this method is called
+ off the main thread.
+ */
+- (void)captureViews:(NSArray *)views onScreenOfSize:(CGSize)screenSize scale:(CGFloat)scale
+              inRect:(CGRect)rect withFilename:(NSString *)filename;
+
+/**
+ Waits until all screenshots previously captured by the receiver have been written.
+ */
+- (void)waitUntilScreenshotsAreWritten;
+
+@end
@@ -0,0 +1,213 @@
+//
+//  SLScreenshotWriter.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLScreenshotWriter.h"
+#import "SLLogger.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+
+/// The number of buffers in a writer's pool: one retaining the previous screenshot
+/// (for comparison) and the remainder for screenshots being rendered and encoded.
+/// Capture blocks if the encoder falls this far behind, bounding the writer's memory use.
+static const long kSLScreenshotWriterBufferCount = 3;
+
+static const size_t kSLScreenshotBytesPerPixel = 4;
+
+static const CGBitmapInfo kSLScreenshotBitmapInfo = (kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+
+
+void SLRenderViewsInContext(NSArray *views, CGContextRef context) {
+    // position each view as it is on-screen, per Technical Q&A QA1703
+    for (UIView *view in views) {
+        CGContextSaveGState(context);
+        CGContextTranslateCTM(context, view.center.x, view.center.y);
+        CGContextConcatCTM(context, view.transform);
+        CGContextTranslateCTM(context,
+                              -view.bounds.size.width * view.layer.anchorPoint.x,
+                              -view.bounds.size.height * view.layer.anchorPoint.y);
+        [view.layer renderInContext:context];
+        CGContextRestoreGState(context);
+    }
+}
+
+
+@implementation SLScreenshotWriter {
+    dispatch_queue_t _writeQueue;
+    dispatch_semaphore_t _bufferSemaphore;
+    NSMutableArray *_freeBuffers;
+
+    // accessed only on the write queue
+    NSMutableData *_previousBuffer;
+    size_t _previousWidth;
+    CGRect _previousRect;
+    NSCountedSet *_writtenFilenames;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+    NSParameterAssert(directory);
+
+    self = [super init];
+    if (self) {
+        _directory = [directory copy];
+        _writeQueue = dispatch_queue_create("com.inkling.subliminal.SLScreenshotWriter.writeQueue", DISPATCH_QUEUE_SERIAL);
+        _bufferSemaphore = dispatch_semaphore_create(kSLScreenshotWriterBufferCount);
+        _freeBuffers = [[NSMutableArray alloc] initWithCapacity:kSLScreenshotWriterBufferCount];
+        _writtenFilenames = [[NSCountedSet alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+#if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
+    dispatch_release(_writeQueue);
+    dispatch_release(_bufferSemaphore);
+#endif
+}
+
+#pragma mark - Buffer Pool
+
+- (NSMutableData *)dequeueBufferOfLength:(NSUInteger)length {
+    dispatch_semaphore_wait(_bufferSemaphore, DISPATCH_TIME_FOREVER);
+
+    NSMutableData *buffer;
+    @synchronized(_freeBuffers) {
+        buffer = [_freeBuffers lastObject];
+        if (buffer) [_freeBuffers removeLastObject];
+    }
+
+    // reuse the buffer's storage if possible (it will only change size if the screen does)
+    // but clear its contents, because the views may not be opaque
+    if ([buffer length] == length) {
+        memset([buffer mutableBytes], 0, length);
+    } else {
+        buffer = [[NSMutableData alloc] initWithLength:length];
+    }
+    return buffer;
+}
+
+- (void)enqueueBuffer:(NSMutableData *)buffer {
+    @synchronized(_freeBuffers) {
+        [_freeBuffers addObject:buffer];
+    }
+    dispatch_semaphore_signal(_bufferSemaphore);
+}
+
+#pragma mark - Capturing Screenshots
+
+- (void)captureViews:(NSArray *)views onScreenOfSize:(CGSize)screenSize scale:(CGFloat)scale
+              inRect:(CGRect)rect withFilename:(NSString *)filename {
+    NSAssert([NSThread isMainThread], @"%@ must be called on the main thread.", NSStringFromSelector(_cmd));
+
+    const size_t width = (size_t)(screenSize.width * scale), height = (size_t)(screenSize.height * scale);
+    const size_t bytesPerRow = width * kSLScreenshotBytesPerPixel;
+    if (!(width && height)) return;
+
+    NSMutableData *buffer = [self dequeueBufferOfLength:(bytesPerRow * height)];
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate([buffer mutableBytes], width, height, 8, bytesPerRow,
+                                                 colorSpace, kSLScreenshotBitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+
+    // flip the context to match UIKit's coordinate system
+    CGContextTranslateCTM(context, 0.0, height);
+    CGContextScaleCTM(context, scale, -scale);
+
+    SLRenderViewsInContext(views, context);
+    CGContextRelease(context);
+
+    // convert the rect to the bitmap's coordinates now, while we know the scale
+    CGRect pixelRect = CGRectNull;
+    if (!CGRectIsNull(rect)) {
+        pixelRect = CGRectIntegral(CGRectApplyAffineTransform(rect, CGAffineTransformMakeScale(scale, scale)));
+        pixelRect = CGRectIntersection(pixelRect, CGRectMake(0.0, 0.0, width, height));
+    }
+
+    filename = [filename copy];
+    dispatch_async(_writeQueue, ^{
+        [self writeBuffer:buffer width:width height:height rect:pixelRect filename:filename];
+    });
+}
+
+- (void)writeBuffer:(NSMutableData *)buffer width:(size_t)width height:(size_t)height
+               rect:(CGRect)rect filename:(NSString *)filename {
+    // skip screenshots identical to the previous screenshot
+    // (comparing the widths too in case the screen has rotated)
+    if ((width == _previousWidth) && CGRectEqualToRect(rect, _previousRect) &&
+        [buffer isEqualToData:_previousBuffer]) {
+        [self enqueueBuffer:buffer];
+        SLLogDebug(@"Did not write screenshot \"%@\": it is identical to the previous screenshot.", filename);
+        return;
+    }
+
+    @autoreleasepool {
+        CGDataProviderRef dataProvider = CGDataProviderCreateWithCFData((__bridge CFDataRef)buffer);
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGImageRef image = CGImageCreate(width, height, 8, (8 * kSLScreenshotBytesPerPixel), (width * kSLScreenshotBytesPerPixel),
+                                         colorSpace, kSLScreenshotBitmapInfo, dataProvider, NULL, false, kCGRenderingIntentDefault);
+        CGColorSpaceRelease(colorSpace);
+        CGDataProviderRelease(dataProvider);
+
+        if (!CGRectIsNull(rect)) {
+            CGImageRef croppedImage = CGImageCreateWithImageInRect(image, rect);
+            CGImageRelease(image);
+            image = croppedImage;
+        }
+
+        NSData *pngData = (image ? UIImagePNGRepresentation([UIImage imageWithCGImage:image]) : nil);
+        CGImageRelease(image);
+
+        NSString *path = [self pathForScreenshotWithFilename:filename];
+        NSError *error;
+        if (!(pngData && [pngData writeToFile:path options:NSDataWritingAtomic error:&error])) {
+            [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"Could not write screenshot to %@: %@",
+                                                 path, ([error localizedDescription] ?: @"the image could not be encoded.")]];
+        }
+    }
+
+    if (_previousBuffer) [self enqueueBuffer:_previousBuffer];
+    _previousBuffer = buffer;
+    _previousWidth = width;
+    _previousRect = rect;
+}
+
+- (NSString *)pathForScreenshotWithFilename:(NSString *)filename {
+    NSFileManager *fileManager = [[NSFileManager alloc] init];
+    if (![_writtenFilenames count]) {
+        (void)[fileManager createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:NULL];
+    }
+
+    // like UIAutomation, append an integer to screenshots with the same name to prevent overwriting
+    NSUInteger previousCount = [_writtenFilenames countForObject:filename];
+    [_writtenFilenames addObject:filename];
+    if (previousCount) {
+        filename = [NSString stringWithFormat:@"%@ %lu", filename, (unsigned long)previousCount];
+    }
+    return [[_directory stringByAppendingPathComponent:filename] stringByAppendingPathExtension:@"png"];
+}
+
+- (void)waitUntilScreenshotsAreWritten {
+    dispatch_sync(_writeQueue, ^{});
+}
+
+@end
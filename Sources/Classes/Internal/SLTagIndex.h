@@ -0,0 +1,69 @@
+//
+//  SLTagIndex.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ An `SLTagIndex` evaluates whether tests and test cases are described by
+ a set of [tags](+[SLTest tags]), as used by `+[SLTest testsWithTags:]`
+ and the `SL_TAGS` environment variable.
+
+ The index interns the tags it was initialized with to integer IDs, and
+ represents the tags of each test and test case as a bitset of those IDs,
+ so that inclusion and exclusion may be evaluated with bitwise operations.
+ A test's tags are read once per index and cached, as are the tags of
+ test cases whose tests override `+[SLTest tagsForTestCaseWithSelector:]`.
+
+ Instances of `SLTagIndex` are not thread-safe.
+ */
+@interface SLTagIndex : NSObject
+
+/**
+ Initializes and returns a newly allocated tag index.
+
+ @param tags A set of tags, which may optionally be prefixed with '-',
+ as described by `+[SLTest testsWithTags:]`. If this is `nil` or empty,
+ the index will match all tests and test cases.
+ @return An initialized tag index.
+ */
+- (instancetype)initWithTags:(NSSet *)tags;
+
+/**
+ Returns whether the specified test is [tagged](+[SLTest tags]) with
+ one or more of the receiver's tags, and not with any of its '-'-prefixed tags.
+
+ @param test A test.
+ @return `YES` if the test matches the receiver's tags, otherwise `NO`.
+ */
+- (BOOL)matchesTest:(Class)test;
+
+/**
+ Returns whether the specified test case is [tagged](+[SLTest tagsForTestCaseWithSelector:])
+ with one or more of the receiver's tags, and not with any of its '-'-prefixed tags.
+
+ @param testCaseSelector The unfocused selector of a test case.
+ @param test The test to which the test case belongs.
+ @return `YES` if the test case matches the receiver's tags, otherwise `NO`.
+ */
+- (BOOL)matchesTestCaseWithSelector:(SEL)testCaseSelector ofTest:(Class)test;
+
+@end
@@ -0,0 +1,158 @@
+//
+//  SLTagIndex.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLTagIndex.h"
+
+#import "SLTest+Internal.h"
+
+#import <objc/runtime.h>
+
+/// The type of the words of the bitsets used by `SLTagIndex`.
+typedef uint64_t SLTagBitsetWord;
+static const NSUInteger kSLTagBitsetWordBits = sizeof(SLTagBitsetWord) * CHAR_BIT;
+
+@implementation SLTagIndex {
+    // the IDs of the tags with which the index was initialized, keyed by tag
+    NSDictionary *_tagIDs;
+    NSUInteger _wordCount;
+
+    // bitsets of the inclusion and exclusion tags
+    NSData *_inclusionBitset, *_exclusionBitset;
+    BOOL _hasInclusionTags, _hasExclusionTags;
+
+    // bitsets of tests' tags, keyed by test
+    NSMutableDictionary *_testBitsets;
+    // bitsets of test cases' tags, keyed by test and then by test case name;
+    // only used for tests that override `+tagsForTestCaseWithSelector:`
+    NSMutableDictionary *_testCaseBitsets;
+}
+
+- (instancetype)initWithTags:(NSSet *)tags {
+    self = [super init];
+    if (self) {
+        NSMutableDictionary *tagIDs = [[NSMutableDictionary alloc] initWithCapacity:[tags count]];
+        NSMutableSet *inclusionTags = [[NSMutableSet alloc] initWithCapacity:[tags count]];
+        NSMutableSet *exclusionTags = [[NSMutableSet alloc] initWithCapacity:[tags count]];
+        for (NSString *tag in tags) {
+            NSString *unprefixedTag = tag;
+            if ([tag hasPrefix:@"-"]) {
+                unprefixedTag = [tag substringFromIndex:1];
+                [exclusionTags addObject:unprefixedTag];
+            } else {
+                [inclusionTags addObject:unprefixedTag];
+            }
+            if (!tagIDs[unprefixedTag]) tagIDs[unprefixedTag] = @([tagIDs count]);
+        }
+        _tagIDs = [tagIDs copy];
+        _wordCount = MAX(([_tagIDs count] + kSLTagBitsetWordBits - 1) / kSLTagBitsetWordBits, (NSUInteger)1);
+
+        _inclusionBitset = [self bitsetOfTags:inclusionTags];
+        _exclusionBitset = [self bitsetOfTags:exclusionTags];
+        _hasInclusionTags = ([inclusionTags count] > 0);
+        _hasExclusionTags = ([exclusionTags count] > 0);
+
+        _testBitsets = [[NSMutableDictionary alloc] init];
+        _testCaseBitsets = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (NSMutableData *)bitsetOfTags:(NSSet *)tags {
+    NSMutableData *bitset = [[NSMutableData alloc] initWithLength:(_wordCount * sizeof(SLTagBitsetWord))];
+    SLTagBitsetWord *words = [bitset mutableBytes];
+    for (NSString *tag in tags) {
+        // tags with which the index was not initialized cannot affect whether it matches
+        NSNumber *tagID = _tagIDs[tag];
+        if (!tagID) continue;
+
+        NSUInteger bit = [tagID unsignedIntegerValue];
+        words[bit / kSLTagBitsetWordBits] |= ((SLTagBitsetWord)1 << (bit % kSLTagBitsetWordBits));
+    }
+    return bitset;
+}
+
+// returns whether a bitset, to which the tag identified by _additionalTagID_ (if any) is added,
+// contains one or more of the inclusion tags (if any) and none of the exclusion tags
+- (BOOL)matchesBitset:(NSData *)bitset withTagID:(NSNumber *)additionalTagID {
+    const SLTagBitsetWord *words = [bitset bytes];
+    const SLTagBitsetWord *inclusionWords = [_inclusionBitset bytes], *exclusionWords = [_exclusionBitset bytes];
+
+    BOOL isIncluded = !_hasInclusionTags, isExcluded = NO;
+    if (additionalTagID) {
+        NSUInteger bit = [additionalTagID unsignedIntegerValue];
+        SLTagBitsetWord mask = ((SLTagBitsetWord)1 << (bit % kSLTagBitsetWordBits));
+        if (inclusionWords[bit / kSLTagBitsetWordBits] & mask) isIncluded = YES;
+        if (exclusionWords[bit / kSLTagBitsetWordBits] & mask) isExcluded = YES;
+    }
+    for (NSUInteger i = 0; (i < _wordCount) && !isExcluded; i++) {
+        if (words[i] & inclusionWords[i]) isIncluded = YES;
+        if (words[i] & exclusionWords[i]) isExcluded = YES;
+    }
+    return isIncluded && !isExcluded;
+}
+
+- (NSData *)bitsetOfTest:(Class)test {
+    NSData *bitset = _testBitsets[test];
+    if (!bitset) {
+        bitset = [self bitsetOfTags:[test tags]];
+        _testBitsets[(id<NSCopying>)test] = bitset;
+    }
+    return bitset;
+}
+
+- (BOOL)matchesTest:(Class)test {
+    if (!_hasInclusionTags && !_hasExclusionTags) return YES;
+
+    return [self matchesBitset:[self bitsetOfTest:test] withTagID:nil];
+}
+
+- (BOOL)matchesTestCaseWithSelector:(SEL)testCaseSelector ofTest:(Class)test {
+    if (!_hasInclusionTags && !_hasExclusionTags) return YES;
+
+    NSString *testCaseName = NSStringFromSelector(testCaseSelector);
+
+    static IMP defaultTagsForTestCaseIMP = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        defaultTagsForTestCaseIMP = method_getImplementation(class_getClassMethod([SLTest class], @selector(tagsForTestCaseWithSelector:)));
+    });
+    if (method_getImplementation(class_getClassMethod(test, @selector(tagsForTestCaseWithSelector:))) == defaultTagsForTestCaseIMP) {
+        // by default, a test case is tagged with its test's tags plus its own unfocused name,
+        // so we need only consider the test case's name alongside the test's bitset
+        NSNumber *testCaseTagID = _tagIDs[[test unfocusedTestCaseName:testCaseName]];
+        return [self matchesBitset:[self bitsetOfTest:test] withTagID:testCaseTagID];
+    } else {
+        NSMutableDictionary *testCaseBitsets = _testCaseBitsets[test];
+        if (!testCaseBitsets) {
+            testCaseBitsets = [[NSMutableDictionary alloc] init];
+            _testCaseBitsets[(id<NSCopying>)test] = testCaseBitsets;
+        }
+        NSData *bitset = testCaseBitsets[testCaseName];
+        if (!bitset) {
+            bitset = [self bitsetOfTags:[test tagsForTestCaseWithSelector:testCaseSelector]];
+            testCaseBitsets[testCaseName] = bitset;
+        }
+        return [self matchesBitset:bitset withTagID:nil];
+    }
+}
+
+@end
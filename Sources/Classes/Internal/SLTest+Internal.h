@@ -33,6 +33,29 @@
 /// @name Internal Methods
 /// ----------------------------------------
 
+/**
+ Returns the tests registered in the specified section of the `__DATA` segment
+ of each image loaded into the current process.
+
+ `SLRegisterTest` registers tests in the section named by `SLTestRegistrationSectionName`.
+
+ @param sectionName The name of the section in which tests were registered.
+ @return The tests registered in the specified section.
+ */
++ (NSSet *)testsRegisteredInSection:(const char *)sectionName;
+
+/**
+ Returns the concrete tests linked against the current target which are not
+ among the specified registered tests.
+
+ This method scans the Objective-C runtime. `+allTests` uses it, in `DEBUG` builds,
+ to warn about tests which will not be run because they were not registered.
+
+ @param registeredTests The tests registered using `SLRegisterTest`.
+ @return The tests which are not [abstract](+isAbstract) and are not members of _registeredTests_.
+ */
++ (NSSet *)unregisteredTestsGivenRegisteredTests:(NSSet *)registeredTests;
+
 /**
  All test cases defined on this test.
 
@@ -65,6 +88,24 @@
  */
 + (NSSet *)testCasesToRun;
 
+/**
+ Returns the name of the specified test case without the focus prefix.
+
+ @param testCase The name of a test case, which may be focused.
+ @return The name of the test case, stripped of `SLTestFocusPrefix` if present.
+ */
++ (NSString *)unfocusedTestCaseName:(NSString *)testCase;
+
+/**
+ Returns the name of this test without the focus prefix.
+
+ Tests are identified by their unfocused names wherever they must be recognized
+ regardless of focus, e.g. in the files which record their durations and failures.
+
+ @return The name of this test, stripped of `SLTestFocusPrefix` if present.
+ */
++ (NSString *)unfocusedName;
+
 /**
  Runs all test cases defined on the receiver's class,
  and reports statistics about their execution.
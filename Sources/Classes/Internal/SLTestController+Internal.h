@@ -22,6 +22,8 @@
 
 #import <Subliminal/Subliminal.h>
 
+@class SLTestTimings, SLTimeProfile, SLFailureManifest, SLRunCheckpoint;
+
 /**
  The methods in the `SLTestController (Internal)` category are to be used only 
  within Subliminal.
@@ -64,4 +66,101 @@
  */
 + (NSArray *)testsToRun:(NSSet *)tests usingSeed:(inout unsigned int *)seed withFocus:(BOOL *)withFocus;
 
+/**
+ Given an array of tests to run, returns them ordered longest-first
+ within each [group](+[SLTest runGroup]).
+
+ Tests of equal duration retain their relative order in `tests`.
+
+ @param tests An array of tests, as returned by `+testsToRun:usingSeed:withFocus:`.
+ @param durations The estimated durations of `tests`, as `NSNumber` objects
+ keyed by test name.
+
+ @return `tests`, ordered by group and then by descending duration.
+ */
++ (NSArray *)testsOrderedByDuration:(NSArray *)tests withDurations:(NSDictionary *)durations;
+
+/**
+ Given an array of tests to run, returns the subset belonging to the specified shard.
+
+ The tests are assigned to shards longest-first (by duration, then by
+ [group](+[SLTest runGroup]), then by name), each test being assigned to
+ the shard whose tests have the least total duration so far--or, of shards
+ with equal durations, the fewest tests. If `durations` is `nil`, the tests
+ are thus dealt to the shards in turn, so that each shard receives a similar number
+ of tests from each group. Because this assignment does not depend on the order of `tests`,
+ shards whose tests were ordered using different seeds will still execute each test exactly once.
+ The tests of the shard are returned in the order in which they appear in `tests`.
+
+ @param shardIndex The zero-based index of the shard. Must be less than `shardCount`.
+ @param shardCount The number of shards. Must be greater than `0`.
+ @param tests An array of tests, as returned by `+testsToRun:usingSeed:withFocus:`.
+ @param durations The estimated durations of `tests`, as `NSNumber` objects
+ keyed by test name, or `nil` if no durations have been recorded.
+
+ @return The subset of `tests` which belongs to the specified shard.
+ */
++ (NSArray *)testsInShard:(NSUInteger)shardIndex ofCount:(NSUInteger)shardCount
+                fromTests:(NSArray *)tests withDurations:(NSDictionary *)durations;
+
+/**
+ The timings in which the durations of tests and test cases are being recorded,
+ while tests are running with a `timingsPath` set; otherwise `nil`.
+ */
+@property (nonatomic, readonly) SLTestTimings *timings;
+
+/**
+ The profile in which the time spent by tests and test cases is being recorded,
+ while tests are running; otherwise `nil`.
+ */
+@property (nonatomic, readonly) SLTimeProfile *timeProfile;
+
+/**
+ The manifest in which the failures of tests and test cases are being recorded,
+ while tests are running; otherwise `nil`.
+ */
+@property (nonatomic, readonly) SLFailureManifest *failureManifest;
+
+/**
+ The manifest whose failures are being run again, while tests are running
+ with a `rerunManifestPath` set; otherwise `nil`.
+ */
+@property (nonatomic, readonly) SLFailureManifest *rerunManifest;
+
+/**
+ The checkpoint recording the progress of the run, while tests are running
+ with a `checkpointPath` set; otherwise `nil`.
+
+ If the run was resumed, the checkpoint identifies the tests and test cases
+ which completed, or were interrupted, before the application crashed.
+ */
+@property (nonatomic, readonly) SLRunCheckpoint *checkpoint;
+
+/**
+ Records that a test case passed only when [retried](+[SLTest numberOfRetriesForTestCaseWithSelector:]),
+ so that the test controller may summarize such test cases when testing finishes.
+
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordFlakyPassOfTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Returns the object returned by the implementation of `+[SLTest setUpRunGroup]`
+ inherited by the specified test, while the test's run group is running.
+
+ @param test A test.
+ @return The test's run group fixture, or `nil` if none was set up.
+ */
+- (id)runGroupFixtureForTest:(Class)test;
+
+/**
+ Returns the object returned by the implementation of `+[SLTest setUpSuite]`
+ inherited by the specified test, while tests are running.
+
+ @param test A test.
+ @return The test's suite fixture, or `nil` if none was set up.
+ */
+- (id)suiteFixtureForTest:(Class)test;
+
 @end
@@ -0,0 +1,115 @@
+//
+//  SLTestTimings.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ An `SLTestTimings` object records the durations of tests and test cases
+ as they run, and estimates, from the durations recorded on previous runs,
+ how long tests will take to run.
+
+ Timings are persisted as a JSON file of the form
+
+    {
+        "version": 1,
+        "tests": {
+            "<test>": { "duration": <seconds>, "testCases": { "<test case>": <seconds>, ... } },
+            ...
+        }
+    }
+
+ where each test's duration is that of running all of its test cases,
+ including the test's set-up and tear-down. Tests and test cases are identified
+ by their unfocused names, so that their timings persist regardless of focus.
+
+ Instances of `SLTestTimings` are not thread-safe.
+ */
+@interface SLTestTimings : NSObject
+
+/**
+ Initializes and returns a newly allocated timings object
+ with the durations recorded in the specified file.
+
+ If the file does not exist or cannot be parsed, the timings will be empty.
+
+ @param path The absolute path of a timings file.
+ @return An initialized timings object.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path;
+
+/**
+ Whether the receiver has durations recorded on previous runs.
+ */
+@property (nonatomic, readonly) BOOL hasRecordedDurations;
+
+/**
+ Estimates how long the specified test will take to run, from the durations
+ recorded on previous runs.
+
+ The estimate accounts for the test running only [some of its test cases](+[SLTest testCasesToRun])
+ (e.g. because others are not focused, or do not support the current environment).
+ Test cases for which no duration was recorded are estimated to take
+ as long as the test's other cases on average.
+
+ @param test The test whose duration to estimate.
+ @return The estimated duration of the test in seconds, or a negative value
+ if no duration was recorded for the test on a previous run.
+ */
+- (NSTimeInterval)estimatedDurationOfTest:(Class)test;
+
+/**
+ Records the duration of a test case which has just run.
+
+ @param duration The duration of the test case, including its set-up and tear-down.
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records the duration of a test which has just run.
+
+ The test's test cases must have been recorded before the test itself.
+
+ @param duration The duration of the test, including its set-up and tear-down.
+ @param test The test that ran.
+ */
+- (void)recordDuration:(NSTimeInterval)duration ofTest:(Class)test;
+
+/**
+ Merges the durations recorded by the receiver into the specified timings file.
+
+ The file is read again before being written, while holding a lock,
+ so that runs (or the shards of a run) which share a file do not overwrite
+ each other's durations. If the file does not exist, it is created from the durations
+ that the receiver read (see `-[SLTestController timingsOutputPath]`).
+ The durations of tests which did not run are preserved. The durations of test cases
+ which no longer exist are discarded.
+
+ @param path The absolute path of the timings file to update.
+ @param error If the file cannot be written and this is non-`NULL`,
+ upon return this will be set to an error describing the failure.
+ @return `YES` if the file was written, otherwise `NO`.
+ */
+- (BOOL)mergeRecordedDurationsIntoFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+@end
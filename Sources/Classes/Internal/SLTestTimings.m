@@ -0,0 +1,174 @@
+//
+//  SLTestTimings.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLTestTimings.h"
+
+#import "SLTest+Internal.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+
+/// The version of the timings file format written by `SLTestTimings`.
+static const NSUInteger kSLTestTimingsVersion = 1;
+
+@implementation SLTestTimings {
+    // the timings read from the file, keyed by unfocused test name
+    NSDictionary *_timings;
+
+    // the timings recorded during this run, keyed by unfocused test name
+    NSMutableDictionary *_recordedTests, *_recordedTestCaseDurations, *_recordedSetUpAndTearDownDurations;
+}
+
++ (NSDictionary *)timingsFromFile:(NSString *)path {
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if (!data) return @{};
+
+    NSDictionary *file = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    if (![file isKindOfClass:[NSDictionary class]] ||
+        ([file[@"version"] unsignedIntegerValue] != kSLTestTimingsVersion) ||
+        ![file[@"tests"] isKindOfClass:[NSDictionary class]]) {
+        return @{};
+    }
+    return file[@"tests"];
+}
+
++ (NSDictionary *)testCaseDurationsFromTiming:(NSDictionary *)timing {
+    if (![timing isKindOfClass:[NSDictionary class]] ||
+        ![timing[@"testCases"] isKindOfClass:[NSDictionary class]]) {
+        return @{};
+    }
+    return timing[@"testCases"];
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path {
+    NSParameterAssert([path isAbsolutePath]);
+
+    self = [super init];
+    if (self) {
+        _timings = [[self class] timingsFromFile:path];
+        _recordedTests = [[NSMutableDictionary alloc] init];
+        _recordedTestCaseDurations = [[NSMutableDictionary alloc] init];
+        _recordedSetUpAndTearDownDurations = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (BOOL)hasRecordedDurations {
+    return ([_timings count] > 0);
+}
+
+- (NSTimeInterval)estimatedDurationOfTest:(Class)test {
+    NSDictionary *timing = _timings[[test unfocusedName]];
+    if (![timing isKindOfClass:[NSDictionary class]] || !timing[@"duration"]) return -1.0;
+
+    NSDictionary *testCaseDurations = [[self class] testCaseDurationsFromTiming:timing];
+    NSTimeInterval totalTestCaseDuration = 0.0;
+    for (NSNumber *testCaseDuration in [testCaseDurations allValues]) {
+        totalTestCaseDuration += [testCaseDuration doubleValue];
+    }
+    NSTimeInterval meanTestCaseDuration = ([testCaseDurations count] ? (totalTestCaseDuration / [testCaseDurations count]) : 0.0);
+
+    // start with the time spent in test set-up and tear-down, then add the cases that will run
+    NSTimeInterval duration = MAX([timing[@"duration"] doubleValue] - totalTestCaseDuration, 0.0);
+    for (NSString *testCase in [test testCasesToRun]) {
+        NSNumber *testCaseDuration = testCaseDurations[[test unfocusedTestCaseName:testCase]];
+        duration += (testCaseDuration ? [testCaseDuration doubleValue] : meanTestCaseDuration);
+    }
+    return duration;
+}
+
+- (void)recordDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test {
+    NSString *testName = [test unfocusedName];
+    NSMutableDictionary *testCaseDurations = _recordedTestCaseDurations[testName];
+    if (!testCaseDurations) {
+        testCaseDurations = [[NSMutableDictionary alloc] init];
+        _recordedTestCaseDurations[testName] = testCaseDurations;
+    }
+    testCaseDurations[[test unfocusedTestCaseName:testCase]] = @(duration);
+}
+
+- (void)recordDuration:(NSTimeInterval)duration ofTest:(Class)test {
+    NSString *testName = [test unfocusedName];
+    NSTimeInterval totalTestCaseDuration = 0.0;
+    for (NSNumber *testCaseDuration in [_recordedTestCaseDurations[testName] allValues]) {
+        totalTestCaseDuration += [testCaseDuration doubleValue];
+    }
+
+    // record set-up and tear-down separately so that the test's full duration
+    // may be computed even if only some of its test cases ran
+    _recordedTests[testName] = test;
+    _recordedSetUpAndTearDownDurations[testName] = @(MAX(duration - totalTestCaseDuration, 0.0));
+}
+
+- (BOOL)mergeRecordedDurationsIntoFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    if (![_recordedTests count]) return YES;
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    // lock a separate file, because the timings file is replaced when it is written
+    NSString *lockPath = [path stringByAppendingString:@".lock"];
+    int lockFileDescriptor = open([lockPath fileSystemRepresentation], O_RDONLY | O_CREAT, 0644);
+    if (lockFileDescriptor >= 0) flock(lockFileDescriptor, LOCK_EX);
+
+    // if the file does not exist (e.g. it's a run's output file, separate from its timings file),
+    // create it from the durations that the receiver read
+    NSMutableDictionary *timings = ([[NSFileManager defaultManager] fileExistsAtPath:path] ?
+                                    [[[self class] timingsFromFile:path] mutableCopy] : [_timings mutableCopy]);
+    for (NSString *testName in _recordedTests) {
+        Class test = _recordedTests[testName];
+
+        NSMutableDictionary *testCaseDurations = [[[self class] testCaseDurationsFromTiming:timings[testName]] mutableCopy];
+        [testCaseDurations addEntriesFromDictionary:_recordedTestCaseDurations[testName]];
+
+        NSMutableSet *testCases = [[NSMutableSet alloc] init];
+        for (NSString *testCase in [test testCases]) {
+            [testCases addObject:[test unfocusedTestCaseName:testCase]];
+        }
+
+        NSTimeInterval duration = [_recordedSetUpAndTearDownDurations[testName] doubleValue];
+        for (NSString *testCase in [testCaseDurations allKeys]) {
+            if ([testCases containsObject:testCase]) {
+                duration += [testCaseDurations[testCase] doubleValue];
+            } else {
+                [testCaseDurations removeObjectForKey:testCase];
+            }
+        }
+
+        timings[testName] = @{ @"duration": @(duration), @"testCases": testCaseDurations };
+    }
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"version": @(kSLTestTimingsVersion), @"tests": timings }
+                                                   options:NSJSONWritingPrettyPrinted error:error];
+    BOOL didWrite = (data && [data writeToFile:path options:NSDataWritingAtomic error:error]);
+
+    if (lockFileDescriptor >= 0) {
+        flock(lockFileDescriptor, LOCK_UN);
+        close(lockFileDescriptor);
+    }
+
+    return didWrite;
+}
+
+@end
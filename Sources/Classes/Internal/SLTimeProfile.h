@@ -0,0 +1,233 @@
+//
+//  SLTimeProfile.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+@class SLTestTimings;
+
+/**
+ The activities in which Subliminal spends time on behalf of tests,
+ which `SLTimeProfile` breaks down within each test case.
+
+ Activities are recorded where Subliminal waits, per thread. The activities
+ of any one thread do not overlap.
+ */
+typedef NS_ENUM(NSUInteger, SLTimeProfileActivity) {
+    /// Waiting for UIAutomation to evaluate a script (see `-[SLTerminal eval:]`).
+    SLTimeProfileActivityTerminalEval,
+    /// Waiting for the main thread, to examine the application's state.
+    SLTimeProfileActivityMainThread,
+    /// Waiting to retry resolving an element that does not (yet) exist.
+    SLTimeProfileActivityElementResolutionRetry,
+    /// Sleeping for fixed intervals, e.g. within `-[SLTest wait:]`, between
+    /// evaluations of `SLIsTrueWithTimeout`, and while the UI settles.
+    SLTimeProfileActivitySleep,
+    /// Waiting for the application to register a target for an app hook
+    /// (see `SLTestController (AppHooks)`).
+    SLTimeProfileActivityAppHookLookup,
+
+    /// The number of activities.
+    SLTimeProfileActivityCount
+};
+
+/**
+ The cumulative time spent in each activity.
+ */
+typedef struct {
+    NSTimeInterval durations[SLTimeProfileActivityCount];
+} SLTimeProfileActivityDurations;
+
+/**
+ Records that the current thread spent time in the specified activity.
+
+ This function is thread-safe: each thread's activities are recorded separately.
+
+ @param activity The activity in which time was spent.
+ @param startTime The time at which the activity started,
+ as returned by `+[SLLogRecord currentTimestamp]`.
+ */
+extern void SLTimeProfileRecordActivity(SLTimeProfileActivity activity, NSTimeInterval startTime);
+
+/**
+ Returns the time that the current thread has spent in each activity
+ since the thread started.
+
+ Time spent by other threads, e.g. by the logger evaluating scripts
+ in the background, is not included.
+
+ Clients may determine the time spent in each activity over an interval
+ by subtracting the durations returned at the start of the interval
+ from those returned at its end, on the same thread.
+ */
+extern SLTimeProfileActivityDurations SLTimeProfileGetActivityDurations(void);
+
+/**
+ Sleeps for the specified interval, recording the time slept
+ as `SLTimeProfileActivitySleep`.
+
+ @param interval The interval for which to sleep.
+ */
+extern void SLTimeProfileSleep(NSTimeInterval interval);
+
+/**
+ Synchronously performs the specified block on the main queue, recording the time
+ spent waiting for the block to be performed as `SLTimeProfileActivityMainThread`.
+
+ @param block The block to perform. Must not be `nil`.
+ */
+extern void SLTimeProfileDispatchSyncToMainQueue(dispatch_block_t block);
+
+/**
+ An `SLTimeProfile` object records where the time of a run goes: the durations
+ of tests and test cases and of their set-up and tear-down and, within each
+ test case, the time that Subliminal spent in each `SLTimeProfileActivity`.
+
+ The profile may be summarized at the end of the run, and written
+ as a JSON file of the form
+
+    {
+        "version": 1,
+        "duration": <seconds>,
+        "activities": { "<activity>": <seconds>, ... },
+        "tests": [
+            {
+                "test": "<test>", "duration": <seconds>, "setUp": <seconds>, "tearDown": <seconds>,
+                "testCases": [
+                    {
+                        "testCase": "<test case>", "duration": <seconds>, "setUp": <seconds>, "tearDown": <seconds>,
+                        "activities": { "<activity>": <seconds>, ... }
+                    },
+                    ...
+                ]
+            },
+            ...
+        ]
+    }
+
+ where tests and test cases are listed in the order in which they ran. A test's
+ duration includes that of its set-up and tear-down and test cases. A test case's
+ duration includes that of its set-up and tear-down, across all attempts
+ (see `+[SLTest numberOfRetries]`), as does the time spent in activities.
+ The top-level duration and activities are the totals of those of the tests
+ and test cases. Activities are identified as `terminalEval`, `mainThread`,
+ `elementResolutionRetry`, `sleep`, and `appHookLookup`.
+
+ Instances of `SLTimeProfile` are not thread-safe.
+ */
+@interface SLTimeProfile : NSObject
+
+/**
+ Timings to which to forward the durations of tests and test cases
+ recorded by the receiver, if any.
+
+ This lets the test controller record the durations of tests once,
+ for both the profile and the timings used to schedule subsequent runs.
+ */
+@property (nonatomic, strong) SLTestTimings *timings;
+
+/**
+ Records the duration of the set-up of a test which is running.
+
+ @param duration The duration of `-[SLTest setUpTest]`.
+ @param test The test that was set up.
+ */
+- (void)recordSetUpDuration:(NSTimeInterval)duration ofTest:(Class)test;
+
+/**
+ Records the duration of the tear-down of a test which is running.
+
+ @param duration The duration of `-[SLTest tearDownTest]`.
+ @param test The test that was torn down.
+ */
+- (void)recordTearDownDuration:(NSTimeInterval)duration ofTest:(Class)test;
+
+/**
+ Records the duration of the set-up of a test case which is running.
+
+ If the test case is retried, the durations of each attempt's set-up are summed.
+
+ @param duration The duration of `-[SLTest setUpTestCaseWithSelector:]`.
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordSetUpDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records the duration of the tear-down of a test case which is running.
+
+ If the test case is retried, the durations of each attempt's tear-down are summed.
+
+ @param duration The duration of `-[SLTest tearDownTestCaseWithSelector:]`.
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordTearDownDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records the duration of a test case which has just run,
+ and the time spent in each activity while it ran.
+
+ The duration is also recorded to the receiver's `timings`, if any.
+
+ @param duration The duration of the test case, including its set-up and tear-down.
+ @param activityDurations The time spent in each activity while the test case ran.
+ @param testCase The name of the test case.
+ @param test The test to which the test case belongs.
+ */
+- (void)recordDuration:(NSTimeInterval)duration activityDurations:(SLTimeProfileActivityDurations)activityDurations
+            ofTestCase:(NSString *)testCase inTest:(Class)test;
+
+/**
+ Records the duration of a test which has just run.
+
+ The duration is also recorded to the receiver's `timings`, if any.
+
+ @param duration The duration of the test, including its set-up and tear-down.
+ @param test The test that ran.
+ */
+- (void)recordDuration:(NSTimeInterval)duration ofTest:(Class)test;
+
+/**
+ Whether the receiver has recorded the duration of any test.
+ */
+@property (nonatomic, readonly) BOOL hasRecordedDurations;
+
+/**
+ Summarizes the time spent by the tests recorded by the receiver.
+
+ @return Lines describing the time spent running tests, in their set-up and
+ tear-down, and in each activity, and the test cases which took longest to run.
+ */
+- (NSArray *)summary;
+
+/**
+ Writes the durations recorded by the receiver to the specified file,
+ replacing its contents.
+
+ @param path The absolute path of the file to write.
+ @param error If the file cannot be written and this is non-`NULL`,
+ upon return this will be set to an error describing the failure.
+ @return `YES` if the file was written, otherwise `NO`.
+ */
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+@end
@@ -0,0 +1,287 @@
+//
+//  SLTimeProfile.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLTimeProfile.h"
+
+#import "SLLogger.h"
+#import "SLTestTimings.h"
+
+#include <pthread.h>
+
+/// The version of the file format written by `SLTimeProfile`.
+static const NSUInteger kSLTimeProfileVersion = 1;
+
+/// The number of test cases that `-[SLTimeProfile summary]` lists as slowest.
+static const NSUInteger kSLTimeProfileNumSlowestTestCases = 5;
+
+// the time that each thread has spent in each activity, stored in thread-local storage
+// so that time spent by one thread (e.g. the logger's) is not charged to another (the test's)
+static pthread_key_t __activityDurationsKey;
+
+static SLTimeProfileActivityDurations *SLTimeProfileCurrentThreadActivityDurations(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pthread_key_create(&__activityDurationsKey, free);
+    });
+
+    SLTimeProfileActivityDurations *activityDurations = pthread_getspecific(__activityDurationsKey);
+    if (!activityDurations) {
+        activityDurations = (SLTimeProfileActivityDurations *)calloc(1, sizeof(SLTimeProfileActivityDurations));
+        pthread_setspecific(__activityDurationsKey, activityDurations);
+    }
+    return activityDurations;
+}
+
+void SLTimeProfileRecordActivity(SLTimeProfileActivity activity, NSTimeInterval startTime) {
+    NSCParameterAssert(activity < SLTimeProfileActivityCount);
+
+    NSTimeInterval duration = [SLLogRecord currentTimestamp] - startTime;
+    SLTimeProfileCurrentThreadActivityDurations()->durations[activity] += duration;
+}
+
+SLTimeProfileActivityDurations SLTimeProfileGetActivityDurations(void) {
+    return *SLTimeProfileCurrentThreadActivityDurations();
+}
+
+void SLTimeProfileSleep(NSTimeInterval interval) {
+    NSTimeInterval startTime = [SLLogRecord currentTimestamp];
+    [NSThread sleepForTimeInterval:interval];
+    SLTimeProfileRecordActivity(SLTimeProfileActivitySleep, startTime);
+}
+
+void SLTimeProfileDispatchSyncToMainQueue(dispatch_block_t block) {
+    NSCParameterAssert(block);
+
+    NSTimeInterval startTime = [SLLogRecord currentTimestamp];
+    dispatch_sync(dispatch_get_main_queue(), block);
+    SLTimeProfileRecordActivity(SLTimeProfileActivityMainThread, startTime);
+}
+
+// the names by which activities are identified in the profile file
+static NSString *SLTimeProfileActivityName(SLTimeProfileActivity activity) {
+    static NSString *const kActivityNames[SLTimeProfileActivityCount] = {
+        [SLTimeProfileActivityTerminalEval]             = @"terminalEval",
+        [SLTimeProfileActivityMainThread]               = @"mainThread",
+        [SLTimeProfileActivityElementResolutionRetry]   = @"elementResolutionRetry",
+        [SLTimeProfileActivitySleep]                    = @"sleep",
+        [SLTimeProfileActivityAppHookLookup]            = @"appHookLookup"
+    };
+    return kActivityNames[activity];
+}
+
+// the descriptions of activities used by the summary
+static NSString *SLTimeProfileActivityDescription(SLTimeProfileActivity activity) {
+    static NSString *const kActivityDescriptions[SLTimeProfileActivityCount] = {
+        [SLTimeProfileActivityTerminalEval]             = @"evaluating UIAutomation scripts",
+        [SLTimeProfileActivityMainThread]               = @"waiting on the main thread",
+        [SLTimeProfileActivityElementResolutionRetry]   = @"retrying element resolution",
+        [SLTimeProfileActivitySleep]                    = @"sleeping",
+        [SLTimeProfileActivityAppHookLookup]            = @"looking up app hook targets"
+    };
+    return kActivityDescriptions[activity];
+}
+
+static NSDictionary *SLTimeProfileActivityDictionary(const NSTimeInterval *durations) {
+    NSMutableDictionary *activities = [[NSMutableDictionary alloc] initWithCapacity:SLTimeProfileActivityCount];
+    for (NSUInteger activity = 0; activity < SLTimeProfileActivityCount; activity++) {
+        activities[SLTimeProfileActivityName(activity)] = @(durations[activity]);
+    }
+    return activities;
+}
+
+@implementation SLTimeProfile {
+    // the tests recorded, in the order in which they ran, and keyed by name
+    NSMutableArray *_tests;
+    NSMutableDictionary *_testsByName;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _tests = [[NSMutableArray alloc] init];
+        _testsByName = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (NSMutableDictionary *)entryForTest:(Class)test {
+    NSString *testName = NSStringFromClass(test);
+    NSMutableDictionary *entry = _testsByName[testName];
+    if (!entry) {
+        entry = [@{ @"test": testName, @"setUp": @0.0, @"tearDown": @0.0,
+                    @"testCases": [[NSMutableArray alloc] init] } mutableCopy];
+        [_tests addObject:entry];
+        _testsByName[testName] = entry;
+    }
+    return entry;
+}
+
+// a test case's entry is created when the test case's set-up is first recorded,
+// and completed when the test case's duration is recorded
+- (NSMutableDictionary *)entryForTestCase:(NSString *)testCase inTest:(Class)test {
+    NSMutableArray *testCases = [self entryForTest:test][@"testCases"];
+    NSMutableDictionary *entry = [testCases lastObject];
+    if (![entry[@"testCase"] isEqualToString:testCase] || entry[@"duration"]) {
+        entry = [@{ @"testCase": testCase, @"setUp": @0.0, @"tearDown": @0.0 } mutableCopy];
+        [testCases addObject:entry];
+    }
+    return entry;
+}
+
+- (void)recordSetUpDuration:(NSTimeInterval)duration ofTest:(Class)test {
+    NSMutableDictionary *entry = [self entryForTest:test];
+    entry[@"setUp"] = @([entry[@"setUp"] doubleValue] + duration);
+}
+
+- (void)recordTearDownDuration:(NSTimeInterval)duration ofTest:(Class)test {
+    NSMutableDictionary *entry = [self entryForTest:test];
+    entry[@"tearDown"] = @([entry[@"tearDown"] doubleValue] + duration);
+}
+
+- (void)recordSetUpDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test {
+    NSMutableDictionary *entry = [self entryForTestCase:testCase inTest:test];
+    entry[@"setUp"] = @([entry[@"setUp"] doubleValue] + duration);
+}
+
+- (void)recordTearDownDuration:(NSTimeInterval)duration ofTestCase:(NSString *)testCase inTest:(Class)test {
+    NSMutableDictionary *entry = [self entryForTestCase:testCase inTest:test];
+    entry[@"tearDown"] = @([entry[@"tearDown"] doubleValue] + duration);
+}
+
+- (void)recordDuration:(NSTimeInterval)duration activityDurations:(SLTimeProfileActivityDurations)activityDurations
+            ofTestCase:(NSString *)testCase inTest:(Class)test {
+    NSMutableDictionary *entry = [self entryForTestCase:testCase inTest:test];
+    entry[@"duration"] = @(duration);
+    entry[@"activities"] = SLTimeProfileActivityDictionary(activityDurations.durations);
+    [_timings recordDuration:duration ofTestCase:testCase inTest:test];
+}
+
+- (void)recordDuration:(NSTimeInterval)duration ofTest:(Class)test {
+    [self entryForTest:test][@"duration"] = @(duration);
+    [_timings recordDuration:duration ofTest:test];
+}
+
+- (BOOL)hasRecordedDurations {
+    for (NSDictionary *test in _tests) {
+        if (test[@"duration"]) return YES;
+    }
+    return NO;
+}
+
+// tests are only reported once they have completed
+- (NSArray *)completedTests {
+    return [_tests filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"duration != nil"]];
+}
+
+- (NSArray *)completedTestCasesOfTest:(NSDictionary *)test {
+    return [test[@"testCases"] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"duration != nil"]];
+}
+
+- (void)getTotalDuration:(NSTimeInterval *)totalDuration activityDurations:(NSTimeInterval *)activityDurations {
+    *totalDuration = 0.0;
+    for (NSUInteger activity = 0; activity < SLTimeProfileActivityCount; activity++) activityDurations[activity] = 0.0;
+
+    for (NSDictionary *test in [self completedTests]) {
+        *totalDuration += [test[@"duration"] doubleValue];
+        for (NSDictionary *testCase in [self completedTestCasesOfTest:test]) {
+            for (NSUInteger activity = 0; activity < SLTimeProfileActivityCount; activity++) {
+                activityDurations[activity] += [testCase[@"activities"][SLTimeProfileActivityName(activity)] doubleValue];
+            }
+        }
+    }
+}
+
+- (NSArray *)summary {
+    NSTimeInterval totalDuration, activityDurations[SLTimeProfileActivityCount];
+    [self getTotalDuration:&totalDuration activityDurations:activityDurations];
+
+    NSTimeInterval testSetUpAndTearDownDuration = 0.0, testCasesDuration = 0.0, testCaseSetUpAndTearDownDuration = 0.0;
+    NSMutableArray *testCases = [[NSMutableArray alloc] init];
+    NSArray *tests = [self completedTests];
+    for (NSDictionary *test in tests) {
+        testSetUpAndTearDownDuration += [test[@"setUp"] doubleValue] + [test[@"tearDown"] doubleValue];
+        for (NSDictionary *testCase in [self completedTestCasesOfTest:test]) {
+            testCasesDuration += [testCase[@"duration"] doubleValue];
+            testCaseSetUpAndTearDownDuration += [testCase[@"setUp"] doubleValue] + [testCase[@"tearDown"] doubleValue];
+            [testCases addObject:@{ @"name": [NSString stringWithFormat:@"-[%@ %@]", test[@"test"], testCase[@"testCase"]],
+                                    @"duration": testCase[@"duration"] }];
+        }
+    }
+
+    NSMutableArray *summary = [[NSMutableArray alloc] init];
+    [summary addObject:[NSString stringWithFormat:@"%lu test%@ took %.1fs to run, of which %.1fs was spent setting up and tearing down tests.",
+                        (unsigned long)[tests count], ([tests count] == 1 ? @"" : @"s"), totalDuration, testSetUpAndTearDownDuration]];
+
+    if ([testCases count]) {
+        NSMutableArray *activityDescriptions = [[NSMutableArray alloc] initWithCapacity:SLTimeProfileActivityCount + 1];
+        NSTimeInterval remainingDuration = testCasesDuration;
+        for (NSUInteger activity = 0; activity < SLTimeProfileActivityCount; activity++) {
+            [activityDescriptions addObject:[NSString stringWithFormat:@"%.1fs (%.0f%%) %@", activityDurations[activity],
+                                             (testCasesDuration > 0.0 ? (activityDurations[activity] / testCasesDuration * 100.0) : 0.0),
+                                             SLTimeProfileActivityDescription(activity)]];
+            remainingDuration -= activityDurations[activity];
+        }
+        remainingDuration = MAX(remainingDuration, 0.0);
+        [activityDescriptions addObject:[NSString stringWithFormat:@"and %.1fs (%.0f%%) elsewhere", remainingDuration,
+                                         (testCasesDuration > 0.0 ? (remainingDuration / testCasesDuration * 100.0) : 0.0)]];
+        [summary addObject:[NSString stringWithFormat:@"Of the %.1fs spent running test cases (%.1fs of it setting up and tearing down test cases): %@.",
+                            testCasesDuration, testCaseSetUpAndTearDownDuration, [activityDescriptions componentsJoinedByString:@", "]]];
+
+        NSArray *slowestTestCases = [testCases sortedArrayUsingDescriptors:@[ [NSSortDescriptor sortDescriptorWithKey:@"duration" ascending:NO] ]];
+        slowestTestCases = [slowestTestCases subarrayWithRange:NSMakeRange(0, MIN([slowestTestCases count], kSLTimeProfileNumSlowestTestCases))];
+        NSMutableArray *slowestTestCaseDescriptions = [[NSMutableArray alloc] initWithCapacity:[slowestTestCases count]];
+        for (NSDictionary *testCase in slowestTestCases) {
+            [slowestTestCaseDescriptions addObject:[NSString stringWithFormat:@"%@ (%.1fs)", testCase[@"name"], [testCase[@"duration"] doubleValue]]];
+        }
+        [summary addObject:[NSString stringWithFormat:@"Slowest test cases: %@.", [slowestTestCaseDescriptions componentsJoinedByString:@", "]]];
+    }
+
+    return [summary copy];
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    NSParameterAssert([path isAbsolutePath]);
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    NSTimeInterval totalDuration, activityDurations[SLTimeProfileActivityCount];
+    [self getTotalDuration:&totalDuration activityDurations:activityDurations];
+
+    NSMutableArray *tests = [[NSMutableArray alloc] init];
+    for (NSDictionary *test in [self completedTests]) {
+        NSMutableDictionary *testEntry = [test mutableCopy];
+        testEntry[@"testCases"] = [self completedTestCasesOfTest:test];
+        [tests addObject:testEntry];
+    }
+
+    NSDictionary *file = @{
+        @"version": @(kSLTimeProfileVersion),
+        @"duration": @(totalDuration),
+        @"activities": SLTimeProfileActivityDictionary(activityDurations),
+        @"tests": tests
+    };
+    NSData *data = [NSJSONSerialization dataWithJSONObject:file options:NSJSONWritingPrettyPrinted error:error];
+    return (data && [data writeToFile:path options:NSDataWritingAtomic error:error]);
+}
+
+@end
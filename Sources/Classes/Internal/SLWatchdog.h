@@ -0,0 +1,105 @@
+//
+//  SLWatchdog.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ An `SLWatchdog` limits the time that a test, or a test case, may take to run.
+
+ A watchdog's clock starts when it is initialized. While the watchdog is
+ [guarding](-guardBlock:) a block, code that waits on the application or on UIAutomation
+ (`SLTerminal`, `-[SLTest wait:]`, `SLIsTrueWithTimeout`, and app hooks) periodically
+ calls `+interruptIfExpired`: once the time limit of any watchdog guarding
+ the calling thread has elapsed, that method throws an `SLTestTimeoutException`,
+ unblocking the test at its next interruption point.
+
+ A watchdog only interrupts the thread on which it is guarding a block. Other threads
+ that wait on UIAutomation while the test runs, e.g. the logger's, are not interrupted.
+ Code that waits on another thread's behalf, like `SLTerminal`'s evaluation queue,
+ should call `+interruptIfExpiredOnBehalfOfThread:` instead.
+ */
+@interface SLWatchdog : NSObject
+
+/**
+ Initializes and returns a newly allocated watchdog, whose clock starts immediately.
+
+ @param timeLimit The time that the guarded code may take to run, in seconds.
+ @param name A description of the code being guarded, e.g. the name of a test case,
+ to be used in the warning logged when the time limit elapses and in the timeout
+ exception's reason.
+ @return An initialized watchdog.
+ */
+- (instancetype)initWithTimeLimit:(NSTimeInterval)timeLimit name:(NSString *)name;
+
+/// The time that the guarded code may take to run, in seconds.
+@property (nonatomic, readonly) NSTimeInterval timeLimit;
+
+/// A description of the code being guarded.
+@property (nonatomic, readonly) NSString *name;
+
+/// Whether the receiver's time limit has elapsed.
+@property (nonatomic, readonly) BOOL hasExpired;
+
+/**
+ Executes the specified block, interrupting it if the receiver's time limit
+ elapses while it executes.
+
+ Calls to this method may be nested, in which case the block will be interrupted
+ if any of the guarding watchdogs expire. The block executes on the calling thread,
+ which only that thread's interruption points will interrupt. Exceptions thrown by the block
+ are rethrown.
+
+ If the receiver's time limit elapses while the block is executing, the receiver
+ will log a warning; the block will be interrupted at its next call to
+ `+interruptIfExpired`.
+
+ @param block The block to execute.
+ */
+- (void)guardBlock:(void (^)(void))block;
+
+/**
+ Throws an `SLTestTimeoutException` if any of the watchdogs currently
+ guarding the calling thread has expired.
+
+ This is an interruption point: code that may wait indefinitely on the test's behalf
+ should call this method while waiting.
+
+ @exception SLTestTimeoutException If any of the watchdogs currently guarding
+ the calling thread has expired.
+ */
++ (void)interruptIfExpired;
+
+/**
+ Throws an `SLTestTimeoutException` if any of the watchdogs currently
+ guarding the specified thread has expired.
+
+ This is an interruption point for code that waits on another thread's behalf,
+ e.g. on a queue to which that thread has synchronously dispatched.
+
+ @param thread The thread on whose behalf the caller is waiting.
+
+ @exception SLTestTimeoutException If any of the watchdogs currently guarding
+ `thread` has expired.
+ */
++ (void)interruptIfExpiredOnBehalfOfThread:(NSThread *)thread;
+
+@end
@@ -0,0 +1,137 @@
+//
+//  SLWatchdog.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLWatchdog.h"
+#import "SLTest.h"
+#import "SLLogger.h"
+
+
+// the watchdogs currently guarding a block, innermost last;
+// accessed only while synchronized on the `SLWatchdog` class
+static NSMutableArray *__guardingWatchdogs = nil;
+
+@implementation SLWatchdog {
+    NSTimeInterval _deadline;
+    dispatch_source_t _expirationTimer;
+
+    // the thread on which the receiver is guarding a block, if any;
+    // accessed only while synchronized on the `SLWatchdog` class
+    NSThread *_guardedThread;
+}
+
+- (instancetype)initWithTimeLimit:(NSTimeInterval)timeLimit name:(NSString *)name {
+    NSParameterAssert(timeLimit > 0.0);
+    NSParameterAssert(name);
+
+    self = [super init];
+    if (self) {
+        _timeLimit = timeLimit;
+        _name = [name copy];
+        _deadline = [SLLogRecord currentTimestamp] + timeLimit;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self cancelExpirationTimer];
+}
+
+- (BOOL)hasExpired {
+    return ([SLLogRecord currentTimestamp] >= _deadline);
+}
+
+- (void)guardBlock:(void (^)(void))block {
+    NSParameterAssert(block);
+
+    @synchronized([SLWatchdog class]) {
+        NSAssert(!_guardedThread, @"A watchdog may only guard one block at a time.");
+        if (!__guardingWatchdogs) __guardingWatchdogs = [[NSMutableArray alloc] init];
+        [__guardingWatchdogs addObject:self];
+        _guardedThread = [NSThread currentThread];
+    }
+    [self startExpirationTimer];
+
+    @try {
+        block();
+    }
+    @finally {
+        [self cancelExpirationTimer];
+        @synchronized([SLWatchdog class]) {
+            [__guardingWatchdogs removeObjectIdenticalTo:self];
+            _guardedThread = nil;
+        }
+    }
+}
+
+// warns when the time limit elapses, because the test may not reach
+// an interruption point for some time (or at all, if the main thread is blocked)
+- (void)startExpirationTimer {
+    if (_expirationTimer) return;
+
+    NSTimeInterval timeRemaining = MAX(_deadline - [SLLogRecord currentTimestamp], 0.0);
+    _expirationTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+                                              dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0));
+    dispatch_source_set_timer(_expirationTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeRemaining * NSEC_PER_SEC)),
+                              DISPATCH_TIME_FOREVER, (uint64_t)(0.1 * NSEC_PER_SEC));
+    NSString *name = _name;
+    NSTimeInterval timeLimit = _timeLimit;
+    dispatch_source_set_event_handler(_expirationTimer, ^{
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"\"%@\" has exceeded its time limit of %g seconds, and will be interrupted.",
+                                             name, timeLimit]];
+    });
+    dispatch_resume(_expirationTimer);
+}
+
+- (void)cancelExpirationTimer {
+    if (!_expirationTimer) return;
+
+    dispatch_source_cancel(_expirationTimer);
+    dispatch_release(_expirationTimer);
+    _expirationTimer = NULL;
+}
+
++ (void)interruptIfExpired {
+    [self interruptIfExpiredOnBehalfOfThread:[NSThread currentThread]];
+}
+
++ (void)interruptIfExpiredOnBehalfOfThread:(NSThread *)thread {
+    NSParameterAssert(thread);
+
+    SLWatchdog *expiredWatchdog = nil;
+    @synchronized([SLWatchdog class]) {
+        // report the outermost watchdog to expire, as its expiration is the more severe
+        for (SLWatchdog *watchdog in __guardingWatchdogs) {
+            // don't interrupt other threads (e.g. the logger's) that happen to
+            // wait on the application or UIAutomation while the test is running
+            if ((watchdog->_guardedThread == thread) && [watchdog hasExpired]) {
+                expiredWatchdog = watchdog;
+                break;
+            }
+        }
+    }
+    if (expiredWatchdog) {
+        [NSException raise:SLTestTimeoutException
+                    format:@"\"%@\" exceeded its time limit of %g seconds.", [expiredWatchdog name], [expiredWatchdog timeLimit]];
+    }
+}
+
+@end
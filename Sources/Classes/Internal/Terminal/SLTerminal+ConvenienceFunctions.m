@@ -59,9 +59,9 @@
 - (BOOL)functionWithNameIsLoaded:(NSString *)name {
     if (![self currentQueueIsEvalQueue]) {
         __block BOOL functionIsLoaded;
-        dispatch_sync(self.evalQueue, ^{
+        [self performSyncOnEvalQueue:^{
             functionIsLoaded = [self functionWithNameIsLoaded:name];
-        });
+        }];
         return functionIsLoaded;
     }
     
@@ -71,14 +71,14 @@
 - (void)loadFunctionWithName:(NSString *)name params:(NSArray *)params body:(NSString *)body {
     if (![self currentQueueIsEvalQueue]) {
         NSException *__block loadException;
-        dispatch_sync(self.evalQueue, ^{
+        [self performSyncOnEvalQueue:^{
             @try {
                 [self loadFunctionWithName:name params:params body:body];
             }
             @catch (NSException *exception) {
                 loadException = exception;
             }
-        });
+        }];
         if (loadException) @throw loadException;
         return;
     }
@@ -100,14 +100,14 @@
     if (![self currentQueueIsEvalQueue]) {
         NSString *__block result;
         NSException *__block evalException;
-        dispatch_sync(self.evalQueue, ^{
+        [self performSyncOnEvalQueue:^{
             @try {
                 result = [self evalFunctionWithName:name withArgs:args];
             }
             @catch (NSException *exception) {
                 evalException = exception;
             }
-        });
+        }];
         if (evalException) @throw evalException;
         return result;
     }
@@ -124,14 +124,14 @@
     if (![self currentQueueIsEvalQueue]) {
         NSString *__block result;
         NSException *__block evalException;
-        dispatch_sync(self.evalQueue, ^{
+        [self performSyncOnEvalQueue:^{
             @try {
                 result = [self evalFunctionWithName:name params:params body:body withArgs:args];
             }
             @catch (NSException *exception) {
                 evalException = exception;
             }
-        });
+        }];
         if (evalException) @throw evalException;
         return result;
     }
@@ -153,6 +153,33 @@
  */
 - (BOOL)currentQueueIsEvalQueue;
 
+/**
+ Synchronously executes the specified block on the `evalQueue`
+ on behalf of the calling thread.
+
+ Scripts evaluated by the block will be interrupted if any watchdog guarding
+ the calling thread expires (see `SLWatchdog`), but not if a watchdog guarding
+ some other thread expires.
+
+ This method must not be called from the `evalQueue`.
+
+ @param block The block to execute.
+ */
+- (void)performSyncOnEvalQueue:(void (^)(void))block;
+
+/**
+ Evaluates the specified script like `-eval:`, but without being interrupted
+ should any watchdog guarding the calling thread expire.
+
+ This method is used by the logger: the messages it delivers must be output
+ even after a test times out, and the logger may deliver them on the test's thread.
+
+ @param script The script to evaluate.
+ @return The result of evaluating the script.
+ @exception SLTerminalJavaScriptException If the script threw an exception.
+ */
+- (id)evalWithoutInterruption:(NSString *)script;
+
 /**
  Causes `SLTerminal.js` to finish evaluating commands.
 
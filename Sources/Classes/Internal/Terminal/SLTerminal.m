@@ -21,6 +21,9 @@
 //
 
 #import "SLTerminal.h"
+#import "SLWatchdog.h"
+#import "SLTimeProfile.h"
+#import "SLLogger.h"
 
 
 NSString *const SLTerminalJavaScriptException = @"SLTerminalJavaScriptException";
@@ -58,6 +61,10 @@ static const void *const kEvalQueueIdentifier = &kEvalQueueIdentifier;
     dispatch_queue_t _evalQueue;
     NSUInteger _scriptIndex;
     BOOL _scriptLoggingEnabled;
+
+    // the thread on whose behalf the `evalQueue` is executing, if any;
+    // accessed only on the `evalQueue`
+    NSThread *_clientThread;
 }
 
 + (void)initialize {
@@ -114,6 +121,30 @@ static SLTerminal *__sharedTerminal = nil;
     return dispatch_get_specific(kEvalQueueIdentifier) != NULL;
 }
 
+- (void)performSyncOnEvalQueue:(void (^)(void))block {
+    NSParameterAssert(block);
+    NSAssert(![self currentQueueIsEvalQueue], @"-performSyncOnEvalQueue: must not be called from the evalQueue.");
+
+    // the time spent waiting for the queue is recorded on the calling thread,
+    // so that it is attributed to the test (if any) that the thread is running
+    NSTimeInterval evalStartTime = [SLLogRecord currentTimestamp];
+    NSThread *clientThread = [NSThread currentThread];
+    @try {
+        dispatch_sync(_evalQueue, ^{
+            _clientThread = clientThread;
+            @try {
+                block();
+            }
+            @finally {
+                _clientThread = nil;
+            }
+        });
+    }
+    @finally {
+        SLTimeProfileRecordActivity(SLTimeProfileActivityTerminalEval, evalStartTime);
+    }
+}
+
 #if TARGET_IPHONE_SIMULATOR
 // in the simulator, UIAutomation uses a target-specific plist in ~/Library/Application Support/iPhone Simulator/[system version]/Library/Preferences/[bundle ID].plist
 // _not_ the NSUserDefaults plist, in the sandboxed Library
@@ -167,6 +198,12 @@ static SLTerminal *__sharedTerminal = nil;
          "result": The output of eval(), may be empty
       "exception": The textual representation of a javascript exception, will be empty if no exceptions occurred.
 
+ If the evaluation of a script is interrupted because the test that requested it
+ timed out, `SLTerminal` abandons the script and moves on to the next index.
+ (Scripts evaluated on behalf of other threads, like the logger's, are not interrupted.) `SLTerminal.js` catches up to
+ the latest index if the abandoned script had not yet been read, and ignores it otherwise.
+ Because `SLTerminal.js` writes every key of the result, a result written late for
+ an abandoned script is overwritten by that of the next script.
  */
 - (id)eval:(NSString *)script {
     NSParameterAssert(script);
@@ -175,14 +212,14 @@ static SLTerminal *__sharedTerminal = nil;
     if (![self currentQueueIsEvalQueue]) {
         id __block result;
         NSException *__block evalException;
-        dispatch_sync(self.evalQueue, ^{
+        [self performSyncOnEvalQueue:^{
             @try {
                 result = [self eval:script];
             }
             @catch (NSException *exception) {
                 evalException = exception;
             }
-        });
+        }];
         if (evalException) @throw evalException;
         return result;
     }
@@ -219,10 +256,27 @@ static SLTerminal *__sharedTerminal = nil;
         resultPrefs = [defaults dictionaryRepresentation];
 #endif
 
-        if (resultPrefs[SLTerminalPreferencesKeyResultIndex]) {
-            NSAssert([resultPrefs[SLTerminalPreferencesKeyResultIndex] intValue] == _scriptIndex, @"Result index is out of sync with script index");
+        // ignore the result of a script whose evaluation was interrupted (see below),
+        // which `SLTerminal.js` may write after we've moved on to the next script
+        NSNumber *resultIndex = resultPrefs[SLTerminalPreferencesKeyResultIndex];
+        if (resultIndex && ([resultIndex unsignedIntegerValue] >= _scriptIndex)) {
+            NSAssert([resultIndex unsignedIntegerValue] == _scriptIndex, @"Result index is out of sync with script index");
             break;
         }
+
+        // if the test has timed out (e.g. because UIAutomation is blocked by an alert),
+        // abandon the script, moving on to the next index so that `SLTerminal.js`
+        // will evaluate the next script once it finishes evaluating this one
+        // (or skip this one, if it has not yet read it)
+        @try {
+            // (scripts evaluated on behalf of no thread, like the logger's,
+            // are not interrupted when the test times out)
+            if (_clientThread) [SLWatchdog interruptIfExpiredOnBehalfOfThread:_clientThread];
+        }
+        @catch (NSException *exception) {
+            _scriptIndex++;
+            @throw exception;
+        }
         [NSThread sleepForTimeInterval:SLTerminalReadRetryDelay];
     }
     _scriptIndex++;
@@ -231,13 +285,45 @@ static SLTerminal *__sharedTerminal = nil;
     NSString *exceptionMessage = resultPrefs[SLTerminalPreferencesKeyException];
     id result = resultPrefs[SLTerminalPreferencesKeyResult];
 
-    if (exceptionMessage) {
+    // (`SLTerminal.js` writes an empty message if no exception occurred)
+    if ([exceptionMessage length]) {
         @throw [NSException exceptionWithName:SLTerminalJavaScriptException reason:exceptionMessage userInfo:nil];
     } else {
         return result;
     }
 }
 
+- (id)evalWithoutInterruption:(NSString *)script {
+    NSParameterAssert(script);
+    NSAssert(![NSThread isMainThread], @"-evalWithoutInterruption: must not be called from the main thread.");
+
+    if (![self currentQueueIsEvalQueue]) {
+        NSTimeInterval evalStartTime = [SLLogRecord currentTimestamp];
+        id __block result;
+        NSException *__block evalException;
+        dispatch_sync(_evalQueue, ^{
+            @try {
+                result = [self evalWithoutInterruption:script];
+            }
+            @catch (NSException *exception) {
+                evalException = exception;
+            }
+        });
+        SLTimeProfileRecordActivity(SLTimeProfileActivityTerminalEval, evalStartTime);
+        if (evalException) @throw evalException;
+        return result;
+    }
+
+    NSThread *clientThread = _clientThread;
+    _clientThread = nil;
+    @try {
+        return [self eval:script];
+    }
+    @finally {
+        _clientThread = clientThread;
+    }
+}
+
 - (NSString *)evalWithFormat:(NSString *)script, ... {
     NSParameterAssert(script);
 
@@ -49,7 +49,13 @@
  tests may be conditionalized to run only in certain circumstances using APIs
  like `+isAbstract`, `+supportsCurrentPlatform`, `+supportsCurrentEnvironment`, and `+isFocused`.
 
- @return All tests (`SLTest` subclasses) linked against the current target.
+ By default, tests are discovered by scanning all classes known to the Objective-C
+ runtime, which may take a noticeable amount of time in applications that link
+ many frameworks. If any tests have been registered using `SLRegisterTest`,
+ this method returns only the registered tests, without scanning the runtime.
+
+ @return All tests (`SLTest` subclasses) linked against the current target,
+ or, if any tests have been registered using `SLRegisterTest`, the registered tests.
  */
 + (NSSet *)allTests;
 
@@ -364,6 +370,91 @@
  */
 + (NSUInteger)runGroup;
 
+#pragma mark - Sharing Fixtures Between Tests
+/// ------------------------------------------
+/// @name Sharing Fixtures Between Tests
+/// ------------------------------------------
+
+/**
+ Called once before any test of the receiver's [run group](+runGroup)
+ that inherits this implementation is run.
+
+ In this method, tests should establish state shared by several tests,
+ such as logging in, which would otherwise be re-established by each test
+ in its `-setUpTest`. Implement this method on an [abstract test](+isAbstract)
+ from which the tests sharing the state inherit.
+
+ `SLTestController` runs the tests of each run group contiguously
+ (tests are only randomized within their group). Before running a group,
+ the test controller invokes each distinct implementation of this method
+ inherited by the group's tests, once; after running the group, it invokes
+ the corresponding implementations of `+tearDownRunGroupWithFixture:`. Tests may access
+ the object returned by this method using `-runGroupFixture`.
+
+ In this method, tests can (and should) use test assertions to ensure
+ that set-up was successful.
+
+ @warning If set-up fails, the tests inheriting this implementation will be aborted.
+ However, `+tearDownRunGroupWithFixture:` will still be executed.
+
+ @return An object describing the state established, to be made available to
+ the tests of the group, or `nil`. The default implementation does nothing and returns `nil`.
+ */
++ (id)setUpRunGroup;
+
+/**
+ Called once after the tests of the receiver's [run group](+runGroup)
+ that inherit the corresponding implementation of `+setUpRunGroup` have run.
+
+ In this method, tests should clean up the state established by `+setUpRunGroup`.
+
+ @param fixture The object returned by `+setUpRunGroup`, or `nil`
+ if `+setUpRunGroup` returned `nil` or failed.
+ */
++ (void)tearDownRunGroupWithFixture:(id)fixture;
+
+/**
+ Called once before any test that inherits this implementation is run.
+
+ This method is like `+setUpRunGroup`, but it is invoked before the first test
+ of the run, rather than before each run group: it should establish state shared
+ by all the tests of the run, and should be implemented on an abstract test
+ from which all the tests inherit. Tests may access the object returned by
+ this method using `-suiteFixture`.
+
+ @warning If set-up fails, the tests inheriting this implementation will be aborted.
+ However, `+tearDownSuiteWithFixture:` will still be executed.
+
+ @return An object describing the state established, to be made available to
+ the tests of the run, or `nil`. The default implementation does nothing and returns `nil`.
+ */
++ (id)setUpSuite;
+
+/**
+ Called once after all the tests that inherit the corresponding implementation
+ of `+setUpSuite` have run.
+
+ @param fixture The object returned by `+setUpSuite`, or `nil`
+ if `+setUpSuite` returned `nil` or failed.
+ */
++ (void)tearDownSuiteWithFixture:(id)fixture;
+
+/**
+ The object returned by the implementation of `+setUpRunGroup` inherited by
+ the receiver's class, for the run group now running.
+
+ @return The receiver's run group fixture, or `nil` if none was set up.
+ */
+- (id)runGroupFixture;
+
+/**
+ The object returned by the implementation of `+setUpSuite` inherited by
+ the receiver's class.
+
+ @return The receiver's suite fixture, or `nil` if none was set up.
+ */
+- (id)suiteFixture;
+
 @end
 
 
@@ -469,6 +560,98 @@
 - (void)tearDownTestCaseWithSelector:(SEL)testCaseSelector;
 
 
+#pragma mark - Retrying Failed Test Cases
+/// ----------------------------------------
+/// @name Retrying Failed Test Cases
+/// ----------------------------------------
+
+/**
+ The number of times to retry a test case of this test when it fails.
+
+ Each attempt sets up, runs, and tears down the test case
+ (see `-setUpTestCaseWithSelector:` and `-tearDownTestCaseWithSelector:`).
+ A test case that passes on a retry is reported as having passed, with a warning
+ that it may be flaky (see `-[SLLogger logTest:caseFlakyPass:numAttempts:]`);
+ a test case that fails on every attempt is reported as having failed.
+
+ Retrying a flaky test case within the test is much faster than relaunching
+ the application to run it again, but it may mask real failures:
+ retries should be reserved for test cases known to be affected by factors
+ outside of the test's control.
+
+ Subclasses may override this method to retry all of their test cases.
+ The default implementation returns the value of the `SL_RETRY_COUNT`
+ environment variable, or `0` if that variable is not set.
+
+ @return The number of times to retry a test case of this test when it fails.
+
+ @see +numberOfRetriesForTestCaseWithSelector:
+ */
++ (NSUInteger)numberOfRetries;
+
+/**
+ The number of times to retry the specified test case when it fails.
+
+ Subclasses may override this method to retry particular test cases.
+ The default implementation returns `+numberOfRetries`.
+
+ @param testCaseSelector The selector identifying the test case.
+ @return The number of times to retry the test case when it fails.
+ */
++ (NSUInteger)numberOfRetriesForTestCaseWithSelector:(SEL)testCaseSelector;
+
+
+#pragma mark - Limiting Test Durations
+/// ----------------------------------------
+/// @name Limiting Test Durations
+/// ----------------------------------------
+
+/**
+ The time that this test may take to run, in seconds.
+
+ If this test's set-up and test cases take longer than this to run,
+ the test case then running fails with an `SLTestTimeoutException`,
+ and the test's remaining cases fail without being run. If the limit elapses while the test
+ is being set up, the test is aborted, as if set-up had failed.
+
+ A test is interrupted only at its next interruption point: while it waits
+ on UIAutomation, while it waits on an [app hook](-[SLTestController sendAction:])
+ to be registered, or while it waits using `-wait:` or `SLIsTrueWithTimeout`.
+ Tear-down is not interrupted, so that the test may restore the application's state,
+ but its duration counts against the test's time limit.
+
+ Limiting the time that a test may take prevents a single hung test
+ from consuming the time allotted to the entire run.
+
+ Subclasses may override this method to limit their duration.
+ The default implementation returns `-[SLTestController defaultTestTimeLimit]`.
+
+ @return The time that this test may take to run, in seconds, or `0` if the time
+ is unlimited.
+
+ @see +timeLimitForTestCaseWithSelector:
+ */
++ (NSTimeInterval)timeLimit;
+
+/**
+ The time that the specified test case may take to run, in seconds.
+
+ If the test case's set-up and the test case itself take longer than this to run,
+ the test case fails with an `SLTestTimeoutException` at its next interruption point
+ (see `+timeLimit`), its tear-down is performed, and the test moves on to its next case.
+ Each [attempt](+numberOfRetriesForTestCaseWithSelector:) to run the test case
+ may take this long.
+
+ Subclasses may override this method to limit the duration of particular test cases.
+ The default implementation returns `-[SLTestController defaultTestCaseTimeLimit]`.
+
+ @param testCaseSelector The selector identifying the test case.
+ @return The time that the test case may take to run, in seconds, or `0` if the time
+ is unlimited.
+ */
++ (NSTimeInterval)timeLimitForTestCaseWithSelector:(SEL)testCaseSelector;
+
+
 #pragma mark - Utilities
 
 /**
@@ -508,4 +691,66 @@
  */
 + (void)recordLastKnownFile:(const char *)filename line:(int)lineNumber;
 
+/**
+ Throws an `SLTestTimeoutException` if the test or test case being run
+ has exceeded its [time limit](+timeLimit).
+
+ Tests that wait in loops of their own may call this so that they
+ may be interrupted while waiting, as `SLIsTrueWithTimeout` is.
+ */
++ (void)interruptIfTimedOut;
+
+/**
+ Suspends test execution for the specified interval between evaluations
+ of a condition, after throwing an `SLTestTimeoutException` if the test or test case
+ being run has exceeded its [time limit](+timeLimit).
+
+ Used by `SLIsTrueWithTimeout` so that the time tests spend waiting
+ may be distinguished from the time they spend working.
+
+ @param retryDelay The interval for which to suspend execution.
+ */
++ (void)waitToRetry:(NSTimeInterval)retryDelay;
+
 @end
+
+
+#pragma mark - Constants
+
+/// The name of the exception thrown when a test or test case exceeds its [time limit](+[SLTest timeLimit]).
+extern NSString *const SLTestTimeoutException;
+
+
+#pragma mark - Registering Tests
+
+/// The name of the section (of the `__DATA` segment) in which `SLRegisterTest` records tests.
+#define SLTestRegistrationSectionName "__sl_tests"
+
+/**
+ Registers a test with Subliminal at compile time, so that `+[SLTest allTests]`
+ may find the test without scanning the Objective-C runtime.
+
+ Use this macro at file scope, alongside the test's `@implementation`:
+
+    @implementation MyTest
+    ...
+    @end
+
+    SLRegisterTest(MyTest)
+
+ Registration is opt-in: if no tests are registered, `+allTests` discovers tests
+ by scanning the runtime. But if any test is registered, `+allTests` will return
+ only the registered tests, so every test that is to be run must then be registered.
+ In `DEBUG` builds, `+allTests` warns, when first called, about tests which
+ have not been registered (and are not [abstract](+[SLTest isAbstract])).
+
+ @param testClass The name of a subclass of `SLTest`. The class must have been
+ declared before this macro is used.
+ */
+#define SLRegisterTest(testClass) _SLRegisterTestInSection(testClass, SLTestRegistrationSectionName)
+
+/// Registers a test in the specified section. Use `SLRegisterTest` rather than this macro.
+#define _SLRegisterTestInSection(testClass, sectionName) \
+    typedef testClass *_SLRegisteredTest_##testClass; \
+    __attribute__((used, section("__DATA," sectionName))) \
+    static const char *const _SLTestRegistration_##testClass = #testClass;
@@ -25,9 +25,18 @@
 
 #import "SLLogger.h"
 #import "SLElement.h"
+#import "SLTestController+Internal.h"
+#import "SLTestTimings.h"
+#import "SLTagIndex.h"
+#import "SLFailureManifest.h"
+#import "SLWatchdog.h"
+#import "SLRunCheckpoint.h"
+#import "SLTimeProfile.h"
 
 #import <objc/runtime.h>
 #import <objc/message.h>
+#import <mach-o/dyld.h>
+#import <mach-o/getsect.h>
 
 
 // All exceptions thrown by SLTest must have names beginning with this prefix
@@ -35,6 +44,11 @@
 // call site information to exceptions.
 static NSString *const SLTestExceptionNamePrefix       = @"SLTest";
 
+NSString *const SLTestTimeoutException = @"SLTestTimeoutException";
+
+// The longest that `-wait:` sleeps between checking whether the test has timed out.
+static const NSTimeInterval kWaitInterruptionInterval = 0.25;
+
 
 
 @implementation SLTest
@@ -53,7 +67,33 @@ static int __lastKnownLineNumber;
     return isBeingUnitTested;
 }
 
-+ (NSSet *)allTests {
++ (NSSet *)testsRegisteredInSection:(const char *)sectionName {
+    NSMutableSet *tests = [[NSMutableSet alloc] init];
+
+    uint32_t imageCount = _dyld_image_count();
+    for (uint32_t imageIndex = 0; imageIndex < imageCount; imageIndex++) {
+#ifdef __LP64__
+        const struct mach_header_64 *header = (const struct mach_header_64 *)_dyld_get_image_header(imageIndex);
+#else
+        const struct mach_header *header = _dyld_get_image_header(imageIndex);
+#endif
+        unsigned long sectionSize = 0;
+        const char *const *testNames = (const char *const *)getsectiondata(header, "__DATA", sectionName, &sectionSize);
+        if (!testNames) continue;
+
+        for (unsigned long testIndex = 0; testIndex < (sectionSize / sizeof(const char *)); testIndex++) {
+            Class test = objc_getClass(testNames[testIndex]);
+            NSAssert([test isSubclassOfClass:[SLTest class]],
+                     @"%s was registered as a test, but is not a subclass of SLTest.", testNames[testIndex]);
+            if ([test isSubclassOfClass:[SLTest class]]) [tests addObject:test];
+        }
+    }
+
+    return [tests copy];
+}
+
+// returns all subclasses of `SLTest` known to the Objective-C runtime
++ (NSSet *)testsLinkedAgainstRuntime {
     NSMutableSet *tests = [[NSMutableSet alloc] init];
     
     int numClasses = objc_getClassList(NULL, 0);
@@ -77,20 +117,42 @@ static int __lastKnownLineNumber;
     return [tests copy];
 }
 
-+ (NSSet *)testsWithTags:(NSSet *)tags {
-    NSMutableSet *inclusionTags = [tags mutableCopy];
-    NSMutableSet *exclusionTags = [[NSMutableSet alloc] initWithCapacity:[tags count]];
-    for (NSString *tag in tags) {
-        if ([tag hasPrefix:@"-"]) {
-            [inclusionTags removeObject:tag];
-            [exclusionTags addObject:[tag substringFromIndex:1]];
++ (NSSet *)unregisteredTestsGivenRegisteredTests:(NSSet *)registeredTests {
+    return [[self testsLinkedAgainstRuntime] objectsPassingTest:^BOOL(Class test, BOOL *stop) {
+        return ![test isAbstract] && ![registeredTests containsObject:test];
+    }];
+}
+
++ (NSSet *)allTests {
+    // registrations are fixed at compile time, so only need to be read once
+    static NSSet *registeredTests = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        registeredTests = [self testsRegisteredInSection:SLTestRegistrationSectionName];
+#if DEBUG
+        // once any test is registered, tests which are not registered will silently not run
+        if ([registeredTests count]) {
+            NSSet *unregisteredTests = [self unregisteredTestsGivenRegisteredTests:registeredTests];
+            if ([unregisteredTests count]) {
+                NSArray *unregisteredTestNames = [[[unregisteredTests valueForKey:@"description"] allObjects]
+                                                  sortedArrayUsingSelector:@selector(compare:)];
+                [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"Tests have been registered using `SLRegisterTest`, so only registered tests will be run. These tests were not registered, and will not be run: %@.",
+                                                     [unregisteredTestNames componentsJoinedByString:@", "]]];
+            }
         }
-    }
-    
-    NSMutableSet *tests = [[self allTests] mutableCopy];
-    if ([inclusionTags count]) [tests filterUsingPredicate:[NSPredicate predicateWithFormat:@"ANY SELF.tags in %@", inclusionTags]];
-    if ([exclusionTags count]) [tests filterUsingPredicate:[NSPredicate predicateWithFormat:@"NONE SELF.tags in %@", exclusionTags]];
-    return [tests copy];
+#endif
+    });
+    if ([registeredTests count]) return registeredTests;
+
+    // fall back to scanning the runtime
+    return [self testsLinkedAgainstRuntime];
+}
+
++ (NSSet *)testsWithTags:(NSSet *)tags {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:tags];
+    return [[self allTests] objectsPassingTest:^BOOL(Class test, BOOL *stop) {
+        return [tagIndex matchesTest:test];
+    }];
 }
 
 + (NSSet *)tags {
@@ -187,35 +249,54 @@ static int __lastKnownLineNumber;
     return NO;
 }
 
-+ (BOOL)testCaseWithSelectorSupportsCurrentEnvironment:(SEL)testCaseSelector {
-    // Cache the tags for performance, except when unit testing.
-    static NSSet *inclusionTags = nil, *exclusionTags = nil;
-    if ([self isBeingUnitTested] || !inclusionTags || !exclusionTags) {
-        NSSet *tags = [NSSet setWithArray:[[[NSProcessInfo processInfo] environment][@"SL_TAGS"] componentsSeparatedByString:@","]];
-        
-        NSMutableSet *iTags = [tags mutableCopy];
-        NSMutableSet *eTags = [[NSMutableSet alloc] initWithCapacity:[tags count]];
-        for (NSString *tag in tags) {
-            if ([tag hasPrefix:@"-"]) {
-                [iTags removeObject:tag];
-                [eTags addObject:[tag substringFromIndex:1]];
-            }
++ (SLTagIndex *)environmentTagIndex {
+    // Build the index once, except when unit testing (when `SL_TAGS` may change between tests).
+    static SLTagIndex *tagIndex = nil;
+    static NSString *tagIndexTags = nil;
+    if (!tagIndex || [self isBeingUnitTested]) {
+        NSString *tags = [[NSProcessInfo processInfo] environment][@"SL_TAGS"];
+        if (!tagIndex || ((tags != tagIndexTags) && ![tags isEqualToString:tagIndexTags])) {
+            tagIndex = [[SLTagIndex alloc] initWithTags:(tags ? [NSSet setWithArray:[tags componentsSeparatedByString:@","]] : nil)];
+            tagIndexTags = [tags copy];
         }
-
-        inclusionTags = [iTags copy], exclusionTags = [eTags copy];
     }
-    
-    NSSet *testCaseTags = [self tagsForTestCaseWithSelector:testCaseSelector];
-    if ([inclusionTags count] && ![testCaseTags intersectsSet:inclusionTags]) return NO;
-    if ([exclusionTags count] && [testCaseTags intersectsSet:exclusionTags]) return NO;
-    
-    return YES;
+    return tagIndex;
+}
+
++ (BOOL)testCaseWithSelectorSupportsCurrentEnvironment:(SEL)testCaseSelector {
+    return [[self environmentTagIndex] matchesTestCaseWithSelector:testCaseSelector ofTest:self];
 }
 
 + (NSUInteger)runGroup {
     return 1;
 }
 
++ (id)setUpRunGroup {
+    // nothing to do here
+    return nil;
+}
+
++ (void)tearDownRunGroupWithFixture:(id)fixture {
+    // nothing to do here
+}
+
++ (id)setUpSuite {
+    // nothing to do here
+    return nil;
+}
+
++ (void)tearDownSuiteWithFixture:(id)fixture {
+    // nothing to do here
+}
+
+- (id)runGroupFixture {
+    return [[SLTestController sharedTestController] runGroupFixtureForTest:[self class]];
+}
+
+- (id)suiteFixture {
+    return [[SLTestController sharedTestController] suiteFixtureForTest:[self class]];
+}
+
 - (void)setUpTest {
     // nothing to do here
 }
@@ -232,6 +313,28 @@ static int __lastKnownLineNumber;
     // nothing to do here
 }
 
++ (NSUInteger)numberOfRetries {
+    static NSUInteger numberOfRetries = 0;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *retryCount = [[NSProcessInfo processInfo] environment][@"SL_RETRY_COUNT"];
+        numberOfRetries = (NSUInteger)MAX([retryCount integerValue], 0);
+    });
+    return numberOfRetries;
+}
+
++ (NSUInteger)numberOfRetriesForTestCaseWithSelector:(SEL)testCaseSelector {
+    return [self numberOfRetries];
+}
+
++ (NSTimeInterval)timeLimit {
+    return [[SLTestController sharedTestController] defaultTestTimeLimit];
+}
+
++ (NSTimeInterval)timeLimitForTestCaseWithSelector:(SEL)testCaseSelector {
+    return [[SLTestController sharedTestController] defaultTestCaseTimeLimit];
+}
+
 + (NSSet *)testCases {
     static const void *const kTestCasesKey = &kTestCasesKey;
     NSSet *testCases = objc_getAssociatedObject(self, kTestCasesKey);
@@ -322,92 +425,246 @@ static int __lastKnownLineNumber;
     return testCase;
 }
 
++ (NSString *)unfocusedName {
+    // the focus prefix of a test is matched case-insensitively
+    NSString *name = NSStringFromClass(self);
+    if ([[name lowercaseString] hasPrefix:SLTestFocusPrefix]) {
+        name = [name substringFromIndex:[SLTestFocusPrefix length]];
+    }
+    return name;
+}
+
+// executes the block guarded by each of the watchdogs in turn (outermost first)
+static void SLGuardBlockWithWatchdogs(NSArray *watchdogs, void (^block)(void)) {
+    if (![watchdogs count]) {
+        block();
+        // the block may have swallowed a timeout exception, or not reached an interruption point
+        [SLWatchdog interruptIfExpired];
+        return;
+    }
+    [watchdogs[0] guardBlock:^{
+        SLGuardBlockWithWatchdogs([watchdogs subarrayWithRange:NSMakeRange(1, [watchdogs count] - 1)], block);
+    }];
+}
+
+// sets up, runs, and tears down a test case once, returning whether the test case failed
+// the exceptions thrown by the attempt are added to `exceptions` rather than logged,
+// so that the caller may log them according to whether the test case will be retried
+- (BOOL)runTestCase:(NSString *)testCaseName withUnfocusedSelector:(SEL)unfocusedTestCaseSelector
+       testWatchdog:(SLWatchdog *)testWatchdog exceptions:(NSMutableArray *)exceptions
+ failureWasExpected:(BOOL *)caseFailureWasExpected {
+    // clear call site information, so at the least it won't be reused between test cases
+    // (though we can't guarantee it won't be reused within a test case)
+    [SLTest clearLastKnownCallSite];
+
+    // limit the duration of set-up and the test case itself, but not that of tear-down,
+    // so that tear-down may restore the application's state after a timeout
+    NSMutableArray *watchdogs = [NSMutableArray arrayWithCapacity:2];
+    if (testWatchdog) [watchdogs addObject:testWatchdog];
+    NSTimeInterval caseTimeLimit = [[self class] timeLimitForTestCaseWithSelector:unfocusedTestCaseSelector];
+    if (caseTimeLimit > 0.0) {
+        NSString *caseName = [NSString stringWithFormat:@"-[%@ %@]", NSStringFromClass([self class]), testCaseName];
+        [watchdogs addObject:[[SLWatchdog alloc] initWithTimeLimit:caseTimeLimit name:caseName]];
+    }
+
+    SLTimeProfile *timeProfile = [[SLTestController sharedTestController] timeProfile];
+    BOOL caseFailed = NO, failureWasExpected = NO;
+    NSTimeInterval setUpStartTime = [SLLogRecord currentTimestamp];
+    @try {
+        SLGuardBlockWithWatchdogs(watchdogs, ^{
+            [self setUpTestCaseWithSelector:unfocusedTestCaseSelector];
+        });
+    }
+    @catch (NSException *exception) {
+        caseFailed = YES;
+        failureWasExpected = [[self class] exceptionWasExpected:exception];
+        [exceptions addObject:[self exceptionByAddingFileInfo:exception]];
+    }
+    [timeProfile recordSetUpDuration:([SLLogRecord currentTimestamp] - setUpStartTime) ofTestCase:testCaseName inTest:[self class]];
+
+    // Only execute the test case if set-up succeeded.
+    if (!caseFailed) {
+        @try {
+            SLGuardBlockWithWatchdogs(watchdogs, ^{
+                // We use objc_msgSend so that Clang won't complain about performSelector leaks
+                // Make sure to send the actual test case selector
+                ((void(*)(id, SEL))objc_msgSend)(self, NSSelectorFromString(testCaseName));
+            });
+        }
+        @catch (NSException *exception) {
+            caseFailed = YES;
+            failureWasExpected = [[self class] exceptionWasExpected:exception];
+            [exceptions addObject:[self exceptionByAddingFileInfo:exception]];
+        }
+    }
+
+    // Still perform tear-down even if set-up failed.
+    // If the app is in an inconsistent state, then tear-down should fail.
+    NSTimeInterval tearDownStartTime = [SLLogRecord currentTimestamp];
+    @try {
+        [self tearDownTestCaseWithSelector:unfocusedTestCaseSelector];
+    }
+    @catch (NSException *exception) {
+        BOOL caseHadFailed = caseFailed;
+        caseFailed = YES;
+        // don't override `failureWasExpected` if we had already failed
+        if (!caseHadFailed) failureWasExpected = [[self class] exceptionWasExpected:exception];
+        [exceptions addObject:[self exceptionByAddingFileInfo:exception]];
+    }
+    [timeProfile recordTearDownDuration:([SLLogRecord currentTimestamp] - tearDownStartTime) ofTestCase:testCaseName inTest:[self class]];
+
+    if (caseFailureWasExpected) *caseFailureWasExpected = failureWasExpected;
+    return caseFailed;
+}
+
 - (BOOL)runAndReportNumExecuted:(NSUInteger *)numCasesExecuted
                          failed:(NSUInteger *)numCasesFailed
              failedUnexpectedly:(NSUInteger *)numCasesFailedUnexpectedly {
     NSUInteger numberOfCasesExecuted = 0, numberOfCasesFailed = 0, numberOfCasesFailedUnexpectedly = 0;
+    NSString *test = NSStringFromClass([self class]);
+
+    // when resuming a run, count the test cases that completed before the application crashed
+    // (which will not be run again) so that the test is reported as if it had not been interrupted
+    SLRunCheckpoint *checkpoint = [[SLTestController sharedTestController] checkpoint];
+    if (checkpoint) {
+        numberOfCasesExecuted = [checkpoint numTestCasesCompletedInTest:[self class]
+                                                                 failed:&numberOfCasesFailed
+                                                     failedUnexpectedly:&numberOfCasesFailedUnexpectedly];
+    }
 
+    // if the application crashed while running one of this test's cases,
+    // report that test case as having failed rather than risk crashing again
+    NSString *interruptedTestCaseName = [checkpoint interruptedTestCaseOfTest:[self class]];
+    if (interruptedTestCaseName) {
+        [[SLLogger sharedLogger] logTest:test caseStart:interruptedTestCaseName];
+        [[SLLogger sharedLogger] logError:[NSString stringWithFormat:@"Test case \"-[%@ %@]\" crashed the application, and will not be run again.",
+                                           test, interruptedTestCaseName]];
+        [[SLLogger sharedLogger] logTest:test caseFail:interruptedTestCaseName expected:NO];
+        [[[SLTestController sharedTestController] failureManifest] recordFailureOfTestCase:interruptedTestCaseName inTest:[self class]];
+        [checkpoint recordCompletionOfTestCase:interruptedTestCaseName inTest:[self class] failed:YES unexpectedly:YES];
+        numberOfCasesExecuted++;
+        numberOfCasesFailed++;
+        numberOfCasesFailedUnexpectedly++;
+    }
+
+    // the test's time limit applies to its set-up and test cases
+    SLWatchdog *testWatchdog = nil;
+    NSTimeInterval testTimeLimit = [[self class] timeLimit];
+    if (testTimeLimit > 0.0) {
+        testWatchdog = [[SLWatchdog alloc] initWithTimeLimit:testTimeLimit name:test];
+    }
+
+    SLTimeProfile *timeProfile = [[SLTestController sharedTestController] timeProfile];
     BOOL testDidFailInSetUpOrTearDown = NO;
+    NSTimeInterval setUpStartTime = [SLLogRecord currentTimestamp];
     @try {
-        [self setUpTest];
+        SLGuardBlockWithWatchdogs((testWatchdog ? @[ testWatchdog ] : @[]), ^{
+            [self setUpTest];
+        });
     }
     @catch (NSException *exception) {
         [[SLLogger sharedLogger] logException:[self exceptionByAddingFileInfo:exception]
                                      expected:[[self class] exceptionWasExpected:exception]];
         testDidFailInSetUpOrTearDown = YES;
     }
+    [timeProfile recordSetUpDuration:([SLLogRecord currentTimestamp] - setUpStartTime) ofTest:[self class]];
 
     // if setUpTest failed, skip the test cases
     if (!testDidFailInSetUpOrTearDown) {
-        NSString *test = NSStringFromClass([self class]);
-        for (NSString *testCaseName in [[self class] testCasesToRun]) {
+        // when running failures again, only run the test cases that failed
+        NSSet *testCasesToRun = [[self class] testCasesToRun];
+        SLFailureManifest *rerunManifest = [[SLTestController sharedTestController] rerunManifest];
+        if (rerunManifest) testCasesToRun = [rerunManifest testCasesWithFailuresFromTestCases:testCasesToRun ofTest:[self class]];
+
+        // when resuming a run, skip the test cases that completed (or crashed) before the application crashed
+        if (checkpoint) testCasesToRun = [checkpoint testCasesToResumeFromTestCases:testCasesToRun ofTest:[self class]];
+
+        for (NSString *testCaseName in testCasesToRun) {
+            // once the test has exceeded its time limit, its remaining test cases fail without running
+            // (so that they are counted, and recorded to the failure manifest, like cases that time out)
+            if ([testWatchdog hasExpired]) {
+                [[SLLogger sharedLogger] logTest:test caseStart:testCaseName];
+                [[SLLogger sharedLogger] logError:[NSString stringWithFormat:@"Test case \"-[%@ %@]\" was not run because test \"%@\" exceeded its time limit of %g seconds.",
+                                                   test, testCaseName, test, testTimeLimit]];
+                [[SLLogger sharedLogger] logTest:test caseFail:testCaseName expected:NO];
+                [[[SLTestController sharedTestController] failureManifest] recordFailureOfTestCase:testCaseName inTest:[self class]];
+                [checkpoint recordCompletionOfTestCase:testCaseName inTest:[self class] failed:YES unexpectedly:YES];
+                numberOfCasesExecuted++;
+                numberOfCasesFailed++;
+                numberOfCasesFailedUnexpectedly++;
+                continue;
+            }
+
             @autoreleasepool {
                 // all logs below use the focused name, so that the logs are consistent
                 // with what's actually running
                 [[SLLogger sharedLogger] logTest:test caseStart:testCaseName];
+                [checkpoint recordStartOfTestCase:testCaseName inTest:[self class]];
+                NSTimeInterval testCaseStartTime = [SLLogRecord currentTimestamp];
+                SLTimeProfileActivityDurations activityDurationsAtStart = SLTimeProfileGetActivityDurations();
 
                 // but pass the unfocused selector to setUp/tearDown methods,
                 // because focus is temporary and shouldn't require modifying the test infrastructure
                 SEL unfocusedTestCaseSelector = NSSelectorFromString([[self class] unfocusedTestCaseName:testCaseName]);
 
-                // clear call site information, so at the least it won't be reused between test cases
-                // (though we can't guarantee it won't be reused within a test case)
-                [SLTest clearLastKnownCallSite];
-
+                // retry the test case as many times as the test specifies, while it fails
+                // (and while the test remains within its time limit)
+                NSUInteger numRetries = [[self class] numberOfRetriesForTestCaseWithSelector:unfocusedTestCaseSelector];
+                NSUInteger numAttempts = 0;
                 BOOL caseFailed = NO, failureWasExpected = NO;
-                @try {
-                    [self setUpTestCaseWithSelector:unfocusedTestCaseSelector];
-                }
-                @catch (NSException *exception) {
-                    caseFailed = YES;
-                    failureWasExpected = [[self class] exceptionWasExpected:exception];
-                    [[SLLogger sharedLogger] logException:[self exceptionByAddingFileInfo:exception]
-                                                 expected:failureWasExpected];
-                }
-
-                // Only execute the test case if set-up succeeded.
-                if (!caseFailed) {
-                    @try {
-                        // We use objc_msgSend so that Clang won't complain about performSelector leaks
-                        // Make sure to send the actual test case selector
-                        ((void(*)(id, SEL))objc_msgSend)(self, NSSelectorFromString(testCaseName));
+                BOOL willRetry = NO;
+                do {
+                    if (numAttempts > 0) {
+                        [[SLLogger sharedLogger] logTest:test caseRetry:testCaseName afterAttempt:numAttempts];
                     }
-                    @catch (NSException *exception) {
-                        caseFailed = YES;
-                        failureWasExpected = [[self class] exceptionWasExpected:exception];
-                        [[SLLogger sharedLogger] logException:[self exceptionByAddingFileInfo:exception]
-                                                     expected:failureWasExpected];
+                    NSMutableArray *exceptions = [NSMutableArray array];
+                    caseFailed = [self runTestCase:testCaseName withUnfocusedSelector:unfocusedTestCaseSelector
+                                      testWatchdog:testWatchdog exceptions:exceptions failureWasExpected:&failureWasExpected];
+                    numAttempts++;
+                    willRetry = caseFailed && (numAttempts <= numRetries) && ![testWatchdog hasExpired];
+
+                    // only the exceptions of the last attempt fail the test case, so only they are logged as errors
+                    for (NSException *exception in exceptions) {
+                        BOOL exceptionWasExpected = [[self class] exceptionWasExpected:exception];
+                        if (willRetry) {
+                            [[SLLogger sharedLogger] logRetriedException:exception expected:exceptionWasExpected];
+                        } else {
+                            [[SLLogger sharedLogger] logException:exception expected:exceptionWasExpected];
+                        }
                     }
-                }
+                } while (willRetry);
 
-                // Still perform tear-down even if set-up failed.
-                // If the app is in an inconsistent state, then tear-down should fail.
-                @try {
-                    [self tearDownTestCaseWithSelector:unfocusedTestCaseSelector];
-                }
-                @catch (NSException *exception) {
-                    BOOL caseHadFailed = caseFailed;
-                    caseFailed = YES;
-                    // don't override `failureWasExpected` if we had already failed
-                    BOOL exceptionWasExpected = [[self class] exceptionWasExpected:exception];
-                    if (!caseHadFailed) failureWasExpected = exceptionWasExpected;
-                    [[SLLogger sharedLogger] logException:[self exceptionByAddingFileInfo:exception]
-                                                 expected:exceptionWasExpected];
+                NSTimeInterval testCaseDuration = [SLLogRecord currentTimestamp] - testCaseStartTime;
+
+                // break down the time that Subliminal spent on behalf of the test case
+                // (the profile also records the test case's duration to the run's timings)
+                SLTimeProfileActivityDurations activityDurations = SLTimeProfileGetActivityDurations();
+                for (NSUInteger activity = 0; activity < SLTimeProfileActivityCount; activity++) {
+                    activityDurations.durations[activity] -= activityDurationsAtStart.durations[activity];
                 }
+                [timeProfile recordDuration:testCaseDuration activityDurations:activityDurations
+                                 ofTestCase:testCaseName inTest:[self class]];
 
                 if (caseFailed) {
                     [[SLLogger sharedLogger] logTest:test caseFail:testCaseName expected:failureWasExpected];
+                    [[[SLTestController sharedTestController] failureManifest] recordFailureOfTestCase:testCaseName inTest:[self class]];
                     numberOfCasesFailed++;
                     if (!failureWasExpected) numberOfCasesFailedUnexpectedly++;
+                } else if (numAttempts > 1) {
+                    [[SLLogger sharedLogger] logTest:test caseFlakyPass:testCaseName numAttempts:numAttempts];
+                    [[SLTestController sharedTestController] recordFlakyPassOfTestCase:testCaseName inTest:[self class]];
                 } else {
                     [[SLLogger sharedLogger] logTest:test casePass:testCaseName];
                 }
+                [checkpoint recordCompletionOfTestCase:testCaseName inTest:[self class]
+                                                failed:caseFailed unexpectedly:!failureWasExpected];
                 numberOfCasesExecuted++;
             }
         }
     }
 
     // still perform tearDownTest even if setUpTest failed
+    NSTimeInterval tearDownStartTime = [SLLogRecord currentTimestamp];
     @try {
         [self tearDownTest];
     }
@@ -416,6 +673,7 @@ static int __lastKnownLineNumber;
                                      expected:[[self class] exceptionWasExpected:exception]];
         testDidFailInSetUpOrTearDown = YES;
     }
+    [timeProfile recordTearDownDuration:([SLLogRecord currentTimestamp] - tearDownStartTime) ofTest:[self class]];
 
     if (numCasesExecuted) *numCasesExecuted = numberOfCasesExecuted;
     if (numCasesFailed) *numCasesFailed = numberOfCasesFailed;
@@ -425,7 +683,13 @@ static int __lastKnownLineNumber;
 }
 
 - (void)wait:(NSTimeInterval)interval {
-    [NSThread sleepForTimeInterval:interval];
+    // sleep in increments, so that the test may be interrupted if it times out
+    NSTimeInterval endTime = [SLLogRecord currentTimestamp] + interval;
+    NSTimeInterval timeRemaining;
+    while ((timeRemaining = endTime - [SLLogRecord currentTimestamp]) > 0.0) {
+        [SLWatchdog interruptIfExpired];
+        SLTimeProfileSleep(MIN(timeRemaining, kWaitInterruptionInterval));
+    }
 }
 
 + (void)recordLastKnownFile:(const char *)filename line:(int)lineNumber {
@@ -433,6 +697,15 @@ static int __lastKnownLineNumber;
     __lastKnownLineNumber = lineNumber;
 }
 
++ (void)interruptIfTimedOut {
+    [SLWatchdog interruptIfExpired];
+}
+
++ (void)waitToRetry:(NSTimeInterval)retryDelay {
+    [SLWatchdog interruptIfExpired];
+    SLTimeProfileSleep(retryDelay);
+}
+
 + (void)clearLastKnownCallSite {
     __lastKnownFilename = nil;
     __lastKnownLineNumber = 0;
@@ -159,7 +159,7 @@ NSString *reason = [NSString stringWithFormat:@"\"%@\" did not become true withi
 NSDate *_startDate = [NSDate date];\
 BOOL _expressionTrue = NO;\
 while (!(_expressionTrue = (expression)) && ([[NSDate date] timeIntervalSinceDate:_startDate] < timeout)) {\
-[NSThread sleepForTimeInterval:SLIsTrueRetryDelay];\
+[SLTest waitToRetry:SLIsTrueRetryDelay];\
 }\
 _expressionTrue;\
 })
@@ -283,3 +283,59 @@ NSString *__reason = [NSString stringWithFormat:@"\"%@\" should not have thrown
 @throw [NSException exceptionWithName:SLTestAssertionFailedException reason:__reason userInfo:nil]; \
 } \
 } while (0)
+
+/**
+ Fails the test case if less than the specified fraction of an element's frame
+ is visible on the screen.
+
+ This is useful when an element should be substantially, but not necessarily entirely,
+ visible, e.g. when a view is partially covered by a translucent toolbar.
+
+ @param element The `SLElement` to test.
+ @param minimumFraction The minimum fraction of the element's frame which should
+ be visible, from `0.0` to `1.0`.
+ @param failureDescription A format string specifying the error message
+ to be logged if the test fails. Can be `nil`.
+ @param ... (Optional) A comma-separated list of arguments to substitute into
+ `failureDescription`.
+
+ @see -[SLElement visibleFraction]
+ */
+#define SLAssertVisibleFraction(element, minimumFraction, failureDescription, ...) do { \
+[SLTest recordLastKnownFile:__FILE__ line:__LINE__]; \
+double __visibleFraction = [(element) visibleFraction]; \
+if (__visibleFraction < (minimumFraction)) { \
+NSString *__reason = [NSString stringWithFormat:@"\"%@\" should be at least %g%% visible, but is only %g%% visible.%@", \
+@(#element), (double)(minimumFraction) * 100.0, __visibleFraction * 100.0, SLComposeString(@" ", failureDescription, ##__VA_ARGS__)]; \
+@throw [NSException exceptionWithName:SLTestAssertionFailedException reason:__reason userInfo:nil]; \
+} \
+} while (0)
+
+/**
+ Fails the test case if a screenshot of an element does not match a reference screenshot.
+
+ The screenshot is captured within the application and compared to the reference
+ as described by `-[SLDevice screenshotInRect:matchesReferenceNamed:tolerance:failureReason:]`.
+ If the screenshot does not match, it is written out along with a mask of the pixels
+ which differ, and their paths are included in the failure message.
+
+ @param element The `SLUIAElement` to test.
+ @param referenceName The name of the reference screenshot, without the ".png" extension.
+ @param tolerance How different the screenshot may appear from the reference,
+ from `0.0` (identical) to `1.0`.
+ @param failureDescription A format string specifying the error message
+ to be logged if the test fails. Can be `nil`.
+ @param ... (Optional) A comma-separated list of arguments to substitute into
+ `failureDescription`.
+
+ @see -[SLUIAElement matchesReferenceScreenshotNamed:tolerance:failureReason:]
+ */
+#define SLAssertScreenshotMatches(element, referenceName, tolerance, failureDescription, ...) do { \
+[SLTest recordLastKnownFile:__FILE__ line:__LINE__]; \
+NSString *__failureReason = nil; \
+if (![(element) matchesReferenceScreenshotNamed:(referenceName) tolerance:(tolerance) failureReason:&__failureReason]) { \
+NSString *__reason = [NSString stringWithFormat:@"\"%@\" does not match the reference screenshot \"%@\": %@%@", \
+@(#element), (referenceName), __failureReason, SLComposeString(@" ", failureDescription, ##__VA_ARGS__)]; \
+@throw [NSException exceptionWithName:SLTestAssertionFailedException reason:__reason userInfo:nil]; \
+} \
+} while (0)
@@ -22,6 +22,8 @@
 
 #import "SLTestController+AppHooks.h"
 #import "SLMainThreadRef.h"
+#import "SLWatchdog.h"
+#import "SLTimeProfile.h"
 
 #import <objc/runtime.h>
 #import <objc/message.h>
@@ -195,7 +197,10 @@ NSString *const SLAppActionTargetDoesNotExistException = @"SLAppActionTargetDoes
             returnValue = [returnValue copyWithZone:NULL];
         });
         if (lookupDidSucceed) break;
+        [SLWatchdog interruptIfExpired];
+        NSTimeInterval retryDelayStartTime = [SLLogRecord currentTimestamp];
         [NSThread sleepForTimeInterval:kTargetLookupRetryDelay];
+        SLTimeProfileRecordActivity(SLTimeProfileActivityAppHookLookup, retryDelayStartTime);
     } while ([[NSDate date] timeIntervalSinceDate:startDate] <= [self targetLookupTimeout]);
     
     if (!lookupDidSucceed) {
@@ -243,7 +248,10 @@ NSString *const SLAppActionTargetDoesNotExistException = @"SLAppActionTargetDoes
             returnValue = [returnValue copyWithZone:NULL];
         });
         if (lookupDidSucceed) break;
+        [SLWatchdog interruptIfExpired];
+        NSTimeInterval retryDelayStartTime = [SLLogRecord currentTimestamp];
         [NSThread sleepForTimeInterval:kTargetLookupRetryDelay];
+        SLTimeProfileRecordActivity(SLTimeProfileActivityAppHookLookup, retryDelayStartTime);
     } while ([[NSDate date] timeIntervalSinceDate:startDate] <= [self targetLookupTimeout]);
 
     if (!lookupDidSucceed) {
@@ -86,6 +86,11 @@
  and support the current [environment](+[SLTest supportsCurrentEnvironment]).
  If any tests [are focused](+[SLTest isFocused]), only those tests will be run.
  
+ If durations have been recorded for the tests (see `timingsPath`), and no seed
+ is specified, tests instead run longest-first within each group, so long as
+ `ordersTestsByDuration` is `YES`. The test controller will then warn that the tests
+ were not randomized, and will not log a seed with which to reproduce the run order.
+
  When using a given seed, tests execute in the same relative order regardless of focus.
  That is, if a set of tests _| A, B, C, D |_ (all unfocused) 
  are run in order _[ B, A, C, D ]_ when using a certain seed,
@@ -102,6 +107,270 @@
  */
 - (void)runTests:(NSSet *)tests usingSeed:(unsigned int)seed withCompletionBlock:(void (^)())completionBlock;
 
+#pragma mark - Sharding Tests
+/// -------------------------------------------
+/// @name Sharding Tests
+/// -------------------------------------------
+
+/**
+ The number of shards into which the tests are to be divided.
+
+ A long-running suite may be divided among several instances of the application
+ (e.g. running in several simulators) which each run one shard of the tests.
+ Having filtered and ordered the tests to run as described in
+ `-runTests:usingSeed:withCompletionBlock:`, the test controller will run only
+ those tests that belong to the [current shard](-shardIndex).
+
+ Tests are assigned to shards deterministically, independent of the seed used
+ to order the tests, so that the shards of a run together execute each test
+ exactly once so long as each shard is passed the same set of tests. Within each shard,
+ tests still run in ascending order of [group](+[SLTest runGroup]).
+
+ If durations have been recorded for the tests (see `timingsPath`), the tests
+ are assigned to shards so as to balance the shards' durations, longest tests first.
+ Otherwise, the shards will run similar numbers of tests. The shards must read
+ the same timings to agree on the assignment, so shards record their durations
+ to `timingsOutputPath` rather than to `timingsPath`.
+
+ The reports of the individual shards may be combined using
+ `subliminal-instrument --merge-event-logs`.
+
+ Defaults to the value of the `SL_SHARD_COUNT` environment variable if set, otherwise `1`.
+ Must be greater than `0`.
+ */
+@property (nonatomic) NSUInteger shardCount;
+
+/**
+ The zero-based index of the shard of tests to run.
+
+ See `shardCount`.
+
+ Defaults to the value of the `SL_SHARD_INDEX` environment variable if set, otherwise `0`.
+ Must be less than `shardCount` when tests are run.
+ */
+@property (nonatomic) NSUInteger shardIndex;
+
+#pragma mark - Scheduling Tests by Duration
+/// -------------------------------------------
+/// @name Scheduling Tests by Duration
+/// -------------------------------------------
+
+/**
+ The path of a file in which to record the durations of tests and test cases.
+
+ If this is set, the test controller will record the duration of each test and
+ test case as it runs, and will merge those durations into this file when testing
+ finishes. On subsequent runs, the test controller will use the recorded durations
+ to run the longest tests first (see `ordersTestsByDuration`) and to balance
+ the [shards](-shardCount) of the run.
+
+ The durations of test cases that do not run (e.g. because they are not focused)
+ are preserved, so that a test's duration may be estimated however many of its
+ cases run.
+
+ Setting this path changes the order in which tests run: when durations have been
+ recorded, tests run longest-first rather than in a random order, unless
+ `ordersTestsByDuration` is `NO` or a seed is specified.
+
+ The [shards](-shardCount) of a run read the file but do not write to it,
+ so that each shard partitions the tests using the same durations
+ regardless of when the other shards finish. Shards record their durations
+ to `timingsOutputPath` instead.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory. Only applications running in the Simulator can access files outside
+ of their home directory.
+
+ Defaults to the value of the `SL_TIMINGS_PATH` environment variable, or `nil`
+ if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *timingsPath;
+
+/**
+ The path of a file into which to merge the durations recorded by this run,
+ if other than `timingsPath`.
+
+ If this is set, the test controller will read durations from `timingsPath` but
+ will merge the durations that it records into this file instead, leaving `timingsPath`
+ unchanged for the duration of the run. If this file does not exist when testing
+ finishes, it is created from the durations read from `timingsPath`.
+
+ The [shards](-shardCount) of a run may share this file: each shard's durations
+ are merged into it in turn. Once all of the shards have finished, the file may be
+ copied over `timingsPath` for use by the next run. Shards do not record their durations
+ unless this is set.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory.
+
+ Defaults to the value of the `SL_TIMINGS_OUTPUT_PATH` environment variable,
+ or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *timingsOutputPath;
+
+/**
+ Whether, when durations have been recorded for the tests, the tests run
+ longest-first within each [group](+[SLTest runGroup]).
+
+ Running the longest tests first shortens the run when it is [sharded](-shardCount),
+ because the shorter tests that run last even out the durations of the shards.
+ Tests are always run in a randomized order if a seed is specified
+ to `-runTests:usingSeed:withCompletionBlock:`, or if this is `NO`.
+ Set this to `NO` to have tests run in a random order, that may be reproduced
+ using a seed, even when durations have been recorded.
+
+ Defaults to the value of the `SL_ORDER_TESTS_BY_DURATION` environment variable
+ (e.g. `NO` or `0`) if set, otherwise `YES`.
+ */
+@property (nonatomic) BOOL ordersTestsByDuration;
+
+#pragma mark - Rerunning Failed Tests
+/// -------------------------------------------
+/// @name Rerunning Failed Tests
+/// -------------------------------------------
+
+/**
+ The path of a file to which to write a manifest of the test cases that failed.
+
+ If this is set, when testing finishes, the test controller will write
+ the tests and test cases that failed, in the order in which they failed,
+ and the seed of the run, to this file, replacing its contents. A manifest
+ is written even if no tests failed, so that a manifest from a previous run
+ is not mistaken for that of the current run.
+
+ The failures may then be run again by launching the application with
+ `rerunManifestPath` set to this path. Shards of a run should write
+ their manifests to different paths.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory. Only applications running in the Simulator can access files outside
+ of their home directory.
+
+ Defaults to the value of the `SL_FAILURE_MANIFEST_PATH` environment variable,
+ or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *failureManifestPath;
+
+/**
+ The path of a manifest, written to `failureManifestPath` by a previous run,
+ whose failures to run again.
+
+ If this is set, of the tests passed to `-runTests:usingSeed:withCompletionBlock:`,
+ the test controller will run only those which failed in the previous run,
+ in the order in which they failed, and of each test, only the test cases which failed
+ (or all of the test's cases, if the test failed in set-up or tear-down).
+
+ When testing finishes, the test controller will report which of the failures
+ were reproduced and which passed when run again, the latter of which may indicate
+ flaky tests. If `failureManifestPath` is also set, the failures that were reproduced
+ will be written to that path, so that they may be run again in turn.
+
+ If the manifest cannot be read, the test controller will log a warning and run
+ all tests as if this were not set.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory.
+
+ Defaults to the value of the `SL_RERUN_FAILED` environment variable,
+ or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *rerunManifestPath;
+
+#pragma mark - Resuming Interrupted Runs
+/// -------------------------------------------
+/// @name Resuming Interrupted Runs
+/// -------------------------------------------
+
+/**
+ The path of a file in which to record the progress of the run, so that
+ the run may be resumed if the application crashes.
+
+ If this is set, the test controller will record the seed of the run and
+ the order of its tests when testing starts, and will record each test and
+ test case as it starts and completes. If the application crashes, the test runner
+ may relaunch the application with this path set to the same file: the test controller
+ will then run the tests in the same order, resuming with the first test case
+ that did not complete. The test case that was running when the application crashed
+ is reported as having failed, and is not run again; if the application crashed
+ while a test was being set up or torn down, that test is reported as having aborted.
+ Likewise, if the application crashed while a fixture shared by several tests
+ (see `+[SLTest setUpRunGroup]`) was being set up, the fixture is not set up again,
+ and the tests which share it are reported as having aborted.
+
+ Tests that completed before the crash are counted, and their failures recorded
+ (see `failureManifestPath`), as if the run had not been interrupted. When the run
+ completes, the file records as much, so that the next launch starts a new run.
+ Shards of a run (see `shardCount`) must record their progress to different paths.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory. If the file cannot be read, the test controller will log
+ a warning and start a new run.
+
+ Defaults to the value of the `SL_CHECKPOINT_PATH` environment variable,
+ or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *checkpointPath;
+
+#pragma mark - Limiting Test Durations
+/// -------------------------------------------
+/// @name Limiting Test Durations
+/// -------------------------------------------
+
+/**
+ The time that a test may take to run, in seconds, unless the test
+ specifies otherwise (see `+[SLTest timeLimit]`).
+
+ `0` indicates that tests may take any time to run.
+
+ Defaults to the value of the `SL_TEST_TIME_LIMIT` environment variable,
+ or `0` if that variable is not set.
+ */
+@property (nonatomic) NSTimeInterval defaultTestTimeLimit;
+
+/**
+ The time that a test case may take to run, in seconds, unless the test
+ specifies otherwise (see `+[SLTest timeLimitForTestCaseWithSelector:]`).
+
+ A test case that exceeds this limit fails, and the test moves on to its next case,
+ so that a single hung test case does not consume the time allotted to the entire run.
+ `0` indicates that test cases may take any time to run.
+
+ Defaults to the value of the `SL_TEST_CASE_TIME_LIMIT` environment variable,
+ or `0` if that variable is not set.
+ */
+@property (nonatomic) NSTimeInterval defaultTestCaseTimeLimit;
+
+#pragma mark - Profiling Runs
+/// -------------------------------------------
+/// @name Profiling Runs
+/// -------------------------------------------
+
+/**
+ The path of a file to which to write a profile of the time spent by the run.
+
+ The test controller measures the duration of each test and test case, and of
+ their set-up and tear-down, and breaks down the time that Subliminal spent
+ within each test case: evaluating UIAutomation scripts, waiting on the main thread,
+ retrying the resolution of elements, sleeping (e.g. in `-[SLTest wait:]`
+ or between evaluations of `SLIsTrueWithTimeout`), and waiting for app hooks
+ to be registered. When testing finishes, the test controller logs a summary
+ of where the run's time went.
+
+ If this is set, the test controller will also write the profile to this file
+ as JSON, replacing its contents: the file lists the tests and test cases
+ in the order in which they ran, with their durations and, for each test case,
+ the time spent in each of the above activities. Shards of a run should write
+ their profiles to different paths.
+
+ If the path is relative, it will be resolved relative to the application's
+ home directory. Only applications running in the Simulator can access files outside
+ of their home directory.
+
+ Defaults to the value of the `SL_TIME_PROFILE_PATH` environment variable,
+ or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *timeProfilePath;
+
 @end
 
 
@@ -30,10 +30,15 @@
 #import "SLElement.h"
 #import "SLAlert.h"
 #import "SLDevice.h"
+#import "SLTestTimings.h"
+#import "SLTimeProfile.h"
+#import "SLFailureManifest.h"
+#import "SLRunCheckpoint.h"
 
 #import "SLStringUtilities.h"
 
 #import <objc/runtime.h>
+#import <objc/message.h>
 
 
 const unsigned int SLTestControllerRandomSeed = UINT_MAX;
@@ -74,8 +79,15 @@ static void SLUncaughtExceptionHandler(NSException *exception)
 @implementation SLTestController {
     dispatch_queue_t _runQueue;
     unsigned int _runSeed;
-    BOOL _runningWithFocus, _runningWithPredeterminedSeed;
+    BOOL _runningWithFocus, _runningWithPredeterminedSeed, _runningByDuration, _resumingFromCheckpoint;
     NSArray *_testsToRun;
+    SLTestTimings *_timings;
+    SLTimeProfile *_timeProfile;
+    SLFailureManifest *_failureManifest, *_rerunManifest;
+    SLRunCheckpoint *_checkpoint;
+    NSMutableArray *_flakyTestCases;
+    // fixtures keyed by the names of the classes that set them up (`NSNull` if `nil` was returned)
+    NSMutableDictionary *_suiteFixtures, *_runGroupFixtures;
     NSUInteger _numTestsExecuted, _numTestsFailed;
     void(^_completionBlock)(void);
 
@@ -141,6 +153,12 @@ u_int32_t random_uniform(u_int32_t upperBound) {
     return ( random() / ( RAND_MAX + 1.0 ) ) * upperBound;
 }
 
+/// Compares tests by name, stripping the focus prefix if present
+/// so that the relative order of tests is maintained regardless of focus.
+static NSComparisonResult SLCompareTestNames(Class test1, Class test2) {
+    return [[[test1 unfocusedName] lowercaseString] compare:[[test2 unfocusedName] lowercaseString]];
+}
+
 + (NSArray *)testsToRun:(NSSet *)tests usingSeed:(inout unsigned int *)seed withFocus:(BOOL *)withFocus {
     NSMutableArray *testsToRun = [[NSMutableArray alloc] initWithCapacity:[tests count]];
 
@@ -168,16 +186,7 @@ u_int32_t random_uniform(u_int32_t upperBound) {
 
         // sort the group to produce a consistent basis for randomization
         [group sortUsingComparator:^NSComparisonResult(Class test1, Class test2) {
-            // make sure to strip the focus prefix if present
-            NSString *test1Name = [NSStringFromClass(test1) lowercaseString];
-            if ([test1Name hasPrefix:SLTestFocusPrefix]) {
-                test1Name = [test1Name substringFromIndex:[SLTestFocusPrefix length]];
-            }
-            NSString *test2Name = [NSStringFromClass(test2) lowercaseString];
-            if ([test2Name hasPrefix:SLTestFocusPrefix]) {
-                test2Name = [test2Name substringFromIndex:[SLTestFocusPrefix length]];
-            }
-            return [test1Name compare:test2Name];
+            return SLCompareTestNames(test1, test2);
         }];
 
         // randomize the group
@@ -191,24 +200,83 @@ u_int32_t random_uniform(u_int32_t upperBound) {
     }
 
     // now filter the tests to run to those focused, if any...
-    NSMutableArray *focusedTests = [testsToRun mutableCopy];
-    [focusedTests filterUsingPredicate:[NSPredicate predicateWithFormat:@"isFocused == YES"]];
-    BOOL runningWithFocus = ([focusedTests count] > 0);
+    NSIndexSet *focusedTestIndexes = [testsToRun indexesOfObjectsPassingTest:^BOOL(Class test, NSUInteger idx, BOOL *stop) {
+        return [test isFocused];
+    }];
+    BOOL runningWithFocus = ([focusedTestIndexes count] > 0);
     if (runningWithFocus) {
-        testsToRun = focusedTests;
+        [testsToRun setArray:[testsToRun objectsAtIndexes:focusedTestIndexes]];
     }
     if (withFocus) *withFocus = runningWithFocus;
-    
-    [testsToRun filterUsingPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:@[
+
+    NSIndexSet *testIndexesToRun = [testsToRun indexesOfObjectsPassingTest:^BOOL(Class test, NSUInteger idx, BOOL *stop) {
         // ...then, only run tests that are concrete...
-        [NSPredicate predicateWithFormat:@"isAbstract == NO"],
-        // ...that support the current platform...
-        [NSPredicate predicateWithFormat:@"supportsCurrentPlatform == YES"],
-        // ...and that support the current environment.
-        [NSPredicate predicateWithFormat:@"supportsCurrentEnvironment == YES"]
-    ]]];
+        return (![test isAbstract] &&
+                // ...that support the current platform...
+                [test supportsCurrentPlatform] &&
+                // ...and that support the current environment.
+                [test supportsCurrentEnvironment]);
+    }];
+
+    return [testsToRun objectsAtIndexes:testIndexesToRun];
+}
 
-    return [testsToRun copy];
++ (NSArray *)testsOrderedByDuration:(NSArray *)tests withDurations:(NSDictionary *)durations {
+    return [tests sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(Class test1, Class test2) {
+        NSUInteger group1 = [test1 runGroup], group2 = [test2 runGroup];
+        if (group1 != group2) return (group1 < group2) ? NSOrderedAscending : NSOrderedDescending;
+        // longest first
+        return [durations[NSStringFromClass(test2)] compare:durations[NSStringFromClass(test1)]];
+    }];
+}
+
++ (NSArray *)testsInShard:(NSUInteger)shardIndex ofCount:(NSUInteger)shardCount
+                fromTests:(NSArray *)tests withDurations:(NSDictionary *)durations {
+    NSParameterAssert(shardIndex < shardCount);
+
+    if (shardCount == 1) return tests;
+
+    // assign the tests to the shards in an order independent of the seed
+    NSArray *sortedTests = [tests sortedArrayUsingComparator:^NSComparisonResult(Class test1, Class test2) {
+        // longest first (if durations are available)
+        NSNumber *duration1 = durations[NSStringFromClass(test1)], *duration2 = durations[NSStringFromClass(test2)];
+        if (duration1 && duration2) {
+            NSComparisonResult durationOrder = [duration2 compare:duration1];
+            if (durationOrder != NSOrderedSame) return durationOrder;
+        }
+        NSUInteger group1 = [test1 runGroup], group2 = [test2 runGroup];
+        if (group1 != group2) return (group1 < group2) ? NSOrderedAscending : NSOrderedDescending;
+        return SLCompareTestNames(test1, test2);
+    }];
+
+    // assign each test to the shard with the least work so far
+    // ("longest processing time" scheduling); without durations, each test counts the same
+    NSTimeInterval *shardDurations = calloc(shardCount, sizeof(NSTimeInterval));
+    NSUInteger *shardTestCounts = calloc(shardCount, sizeof(NSUInteger));
+    NSMutableSet *testsInShard = [[NSMutableSet alloc] initWithCapacity:([sortedTests count] / shardCount + 1)];
+    for (Class test in sortedTests) {
+        NSUInteger leastLoadedShardIndex = 0;
+        for (NSUInteger index = 1; index < shardCount; index++) {
+            if ((shardDurations[index] < shardDurations[leastLoadedShardIndex]) ||
+                ((shardDurations[index] == shardDurations[leastLoadedShardIndex]) &&
+                 (shardTestCounts[index] < shardTestCounts[leastLoadedShardIndex]))) {
+                leastLoadedShardIndex = index;
+            }
+        }
+
+        NSNumber *duration = durations[NSStringFromClass(test)];
+        shardDurations[leastLoadedShardIndex] += (duration ? [duration doubleValue] : 1.0);
+        shardTestCounts[leastLoadedShardIndex]++;
+        if (leastLoadedShardIndex == shardIndex) [testsInShard addObject:test];
+    }
+    free(shardDurations);
+    free(shardTestCounts);
+
+    // but run them in the order specified, to preserve the ordering of run groups
+    NSIndexSet *shardIndexes = [tests indexesOfObjectsPassingTest:^BOOL(id test, NSUInteger idx, BOOL *stop) {
+        return [testsInShard containsObject:test];
+    }];
+    return [tests objectsAtIndexes:shardIndexes];
 }
 
 - (id)init {
@@ -221,6 +289,21 @@ u_int32_t random_uniform(u_int32_t upperBound) {
         _runSeed = SLTestControllerRandomSeed;
         _defaultTimeout = kDefaultTimeout;
         _startTestingSemaphore = dispatch_semaphore_create(0);
+
+        NSDictionary *environment = [[NSProcessInfo processInfo] environment];
+        NSString *shardCount = environment[@"SL_SHARD_COUNT"], *shardIndex = environment[@"SL_SHARD_INDEX"];
+        _shardCount = shardCount ? (NSUInteger)MAX([shardCount integerValue], 1) : 1;
+        _shardIndex = shardIndex ? (NSUInteger)MAX([shardIndex integerValue], 0) : 0;
+        self.timingsPath = environment[@"SL_TIMINGS_PATH"];
+        self.timingsOutputPath = environment[@"SL_TIMINGS_OUTPUT_PATH"];
+        self.failureManifestPath = environment[@"SL_FAILURE_MANIFEST_PATH"];
+        self.rerunManifestPath = environment[@"SL_RERUN_FAILED"];
+        self.checkpointPath = environment[@"SL_CHECKPOINT_PATH"];
+        self.timeProfilePath = environment[@"SL_TIME_PROFILE_PATH"];
+        NSString *ordersTestsByDuration = environment[@"SL_ORDER_TESTS_BY_DURATION"];
+        _ordersTestsByDuration = ([ordersTestsByDuration length] ? [ordersTestsByDuration boolValue] : YES);
+        _defaultTestTimeLimit = MAX([environment[@"SL_TEST_TIME_LIMIT"] doubleValue], 0.0);
+        _defaultTestCaseTimeLimit = MAX([environment[@"SL_TEST_CASE_TIME_LIMIT"] doubleValue], 0.0);
     }
     return self;
 }
@@ -230,6 +313,184 @@ u_int32_t random_uniform(u_int32_t upperBound) {
     dispatch_release(_startTestingSemaphore);
 }
 
+// resolves relative paths against the application's home directory, and empty paths to `nil`
+static NSString *SLResolvedPath(NSString *path) {
+    if (![path length]) return nil;
+    return ([path isAbsolutePath] ? [path copy] : [NSHomeDirectory() stringByAppendingPathComponent:path]);
+}
+
+- (void)setTimingsPath:(NSString *)timingsPath {
+    _timingsPath = SLResolvedPath(timingsPath);
+}
+
+- (void)setTimingsOutputPath:(NSString *)timingsOutputPath {
+    _timingsOutputPath = SLResolvedPath(timingsOutputPath);
+}
+
+- (void)setFailureManifestPath:(NSString *)failureManifestPath {
+    _failureManifestPath = SLResolvedPath(failureManifestPath);
+}
+
+- (void)setRerunManifestPath:(NSString *)rerunManifestPath {
+    _rerunManifestPath = SLResolvedPath(rerunManifestPath);
+}
+
+- (void)setCheckpointPath:(NSString *)checkpointPath {
+    _checkpointPath = SLResolvedPath(checkpointPath);
+}
+
+- (void)setTimeProfilePath:(NSString *)timeProfilePath {
+    _timeProfilePath = SLResolvedPath(timeProfilePath);
+}
+
+- (SLTestTimings *)timings {
+    return _timings;
+}
+
+- (SLFailureManifest *)failureManifest {
+    return _failureManifest;
+}
+
+- (SLFailureManifest *)rerunManifest {
+    return _rerunManifest;
+}
+
+- (SLRunCheckpoint *)checkpoint {
+    return _checkpoint;
+}
+
+// returns the checkpoint of the run to resume, if the run recorded at `checkpointPath` did not complete
+- (SLRunCheckpoint *)checkpointToResume {
+    if (!_checkpointPath || ![[NSFileManager defaultManager] fileExistsAtPath:_checkpointPath]) return nil;
+
+    NSError *checkpointError = nil;
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:&checkpointError];
+    if (!checkpoint) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The progress of the previous run could not be read from \"%@\", so a new run will start: %@",
+                                             _checkpointPath, [checkpointError localizedDescription]]];
+    }
+    return ([checkpoint runWasCompleted] ? nil : checkpoint);
+}
+
+- (void)recordFlakyPassOfTestCase:(NSString *)testCase inTest:(Class)test {
+    if (!_flakyTestCases) _flakyTestCases = [[NSMutableArray alloc] init];
+    [_flakyTestCases addObject:[NSString stringWithFormat:@"-[%@ %@]", NSStringFromClass(test), testCase]];
+}
+
+// returns the class from which the specified test inherits its implementation of the specified class method
+static Class SLClassImplementingClassMethod(Class test, SEL selector) {
+    IMP implementation = method_getImplementation(class_getClassMethod(test, selector));
+    Class implementingClass = test;
+    while ([implementingClass superclass] &&
+           (method_getImplementation(class_getClassMethod([implementingClass superclass], selector)) == implementation)) {
+        implementingClass = [implementingClass superclass];
+    }
+    return implementingClass;
+}
+
+// returns the distinct classes from which the specified tests inherit implementations of the specified class method,
+// other than `SLTest`'s default implementation, in the order in which the tests will run
+static NSArray *SLClassesImplementingClassMethodForTests(SEL selector, NSArray *tests) {
+    NSMutableArray *implementingClasses = [[NSMutableArray alloc] init];
+    for (Class test in tests) {
+        Class implementingClass = SLClassImplementingClassMethod(test, selector);
+        if ((implementingClass != [SLTest class]) && ![implementingClasses containsObject:implementingClass]) {
+            [implementingClasses addObject:implementingClass];
+        }
+    }
+    return [implementingClasses copy];
+}
+
+// sets up the fixtures that the specified tests inherit, storing those that were set up successfully,
+// and returns the classes that set up the fixtures, whether or not they were set up successfully
+// (but not those which were not set up because they crashed the application on a previous attempt)
+- (NSArray *)setUpFixturesUsingSelector:(SEL)setUpSelector forTests:(NSArray *)tests storingInto:(NSMutableDictionary *)fixtures {
+    NSArray *implementingClasses = SLClassesImplementingClassMethodForTests(setUpSelector, tests);
+    NSMutableArray *classesSetUp = [[NSMutableArray alloc] initWithCapacity:[implementingClasses count]];
+    for (Class implementingClass in implementingClasses) {
+        // if the application crashed while the fixture was being set up,
+        // the tests which share the fixture will abort rather than risk crashing again
+        if ([_checkpoint fixtureSetUpWasInterrupted:setUpSelector inClass:implementingClass]) {
+            [[SLLogger sharedLogger] logError:[NSString stringWithFormat:@"+[%@ %@] crashed the application, and will not be run again.",
+                                               NSStringFromClass(implementingClass), NSStringFromSelector(setUpSelector)]];
+            continue;
+        }
+        [classesSetUp addObject:implementingClass];
+
+        [_checkpoint recordStartOfFixtureSetUp:setUpSelector inClass:implementingClass];
+        @try {
+            id fixture = ((id(*)(id, SEL))objc_msgSend)(implementingClass, setUpSelector);
+            fixtures[NSStringFromClass(implementingClass)] = (fixture ?: [NSNull null]);
+        }
+        @catch (NSException *exception) {
+            [[SLLogger sharedLogger] logException:exception expected:[[exception name] isEqualToString:SLTestAssertionFailedException]];
+        }
+        [_checkpoint recordCompletionOfFixtureSetUp:setUpSelector inClass:implementingClass];
+    }
+    return [classesSetUp copy];
+}
+
+// tears down the fixtures set up by the specified classes, in the reverse of the order in which they were set up
+// (as with test set-up, tear-down is performed even if set-up failed)
+- (void)tearDownFixturesUsingSelector:(SEL)tearDownSelector ofClasses:(NSArray *)implementingClasses storedIn:(NSMutableDictionary *)fixtures {
+    for (Class implementingClass in [implementingClasses reverseObjectEnumerator]) {
+        id fixture = fixtures[NSStringFromClass(implementingClass)];
+        if (fixture == [NSNull null]) fixture = nil;
+        @try {
+            ((void(*)(id, SEL, id))objc_msgSend)(implementingClass, tearDownSelector, fixture);
+        }
+        @catch (NSException *exception) {
+            [[SLLogger sharedLogger] logException:exception expected:[[exception name] isEqualToString:SLTestAssertionFailedException]];
+        }
+    }
+    [fixtures removeAllObjects];
+}
+
+// returns whether the set-up of a fixture that the specified test inherits failed
+- (BOOL)fixtureOfTestFailedToSetUp:(Class)test {
+    Class suiteFixtureClass = SLClassImplementingClassMethod(test, @selector(setUpSuite));
+    if ((suiteFixtureClass != [SLTest class]) && !_suiteFixtures[NSStringFromClass(suiteFixtureClass)]) return YES;
+
+    Class runGroupFixtureClass = SLClassImplementingClassMethod(test, @selector(setUpRunGroup));
+    return ((runGroupFixtureClass != [SLTest class]) && !_runGroupFixtures[NSStringFromClass(runGroupFixtureClass)]);
+}
+
+- (id)runGroupFixtureForTest:(Class)test {
+    id fixture = _runGroupFixtures[NSStringFromClass(SLClassImplementingClassMethod(test, @selector(setUpRunGroup)))];
+    return ((fixture == [NSNull null]) ? nil : fixture);
+}
+
+- (id)suiteFixtureForTest:(Class)test {
+    id fixture = _suiteFixtures[NSStringFromClass(SLClassImplementingClassMethod(test, @selector(setUpSuite)))];
+    return ((fixture == [NSNull null]) ? nil : fixture);
+}
+
+- (NSDictionary *)estimatedDurationsOfTests:(NSArray *)tests {
+    if (![_timings hasRecordedDurations]) return nil;
+
+    NSMutableDictionary *durations = [[NSMutableDictionary alloc] initWithCapacity:[tests count]];
+    NSMutableArray *testsWithoutDurations = [[NSMutableArray alloc] init];
+    NSTimeInterval totalDuration = 0.0;
+    for (Class test in tests) {
+        NSTimeInterval duration = [_timings estimatedDurationOfTest:test];
+        if (duration >= 0.0) {
+            durations[NSStringFromClass(test)] = @(duration);
+            totalDuration += duration;
+        } else {
+            [testsWithoutDurations addObject:test];
+        }
+    }
+
+    // estimate that tests which have not run before (e.g. new tests)
+    // take as long as the other tests on average
+    NSUInteger numTestsWithDurations = [durations count];
+    NSNumber *meanDuration = @(numTestsWithDurations ? (totalDuration / numTestsWithDurations) : 0.0);
+    for (Class test in testsWithoutDurations) {
+        durations[NSStringFromClass(test)] = meanDuration;
+    }
+    return [durations copy];
+}
+
 - (BOOL)shouldWaitToStartTesting {
     return _shouldWaitToStartTesting;
 }
@@ -333,6 +594,23 @@ u_int32_t random_uniform(u_int32_t upperBound) {
     if (_runningWithFocus) {
         SLLog(@"Focusing on test cases in specific tests: %@.", [_testsToRun componentsJoinedByString:@","]);
     }
+    if (_resumingFromCheckpoint) {
+        SLLog(@"Resuming the run with seed %u, recorded at \"%@\": %lu of %lu test%@ remain%@.", _runSeed, _checkpointPath,
+              (unsigned long)[_testsToRun count], (unsigned long)[[_checkpoint testNames] count],
+              ([[_checkpoint testNames] count] == 1 ? @"" : @"s"), ([_testsToRun count] == 1 ? @"s" : @""));
+    }
+    if (_rerunManifest) {
+        NSUInteger numFailures = [[_rerunManifest failureDescriptionsOfTests:_testsToRun] count];
+        SLLog(@"Running again %lu failure%@ of the run with seed %u, recorded at \"%@\".",
+              (unsigned long)numFailures, (numFailures == 1 ? @"" : @"s"), [_rerunManifest seed], _rerunManifestPath);
+    }
+    if (_runningByDuration) {
+        SLLog(@"Running tests longest-first within each run group, by the durations recorded at \"%@\".", _timingsPath);
+    }
+    if (_shardCount > 1) {
+        SLLog(@"Running %lu test%@ in shard %lu of %lu.", (unsigned long)[_testsToRun count], ([_testsToRun count] == 1 ? @"" : @"s"),
+              (unsigned long)_shardIndex + 1, (unsigned long)_shardCount);
+    }
     NSString *tags = [[[[NSProcessInfo processInfo] environment][@"SL_TAGS"] componentsSeparatedByString:@","] componentsJoinedByString:@", "];
     if (tags) {
         SLLog(@"Running test cases described by tags: %@.", tags);
@@ -350,16 +628,82 @@ u_int32_t random_uniform(u_int32_t upperBound) {
 - (void)runTests:(NSSet *)tests usingSeed:(unsigned int)seed withCompletionBlock:(void (^)())completionBlock {
     // have to check this outside of the block below, wherein it will be used
     static const char *const kMethodDescription = __PRETTY_FUNCTION__;
+    NSAssert(_shardIndex < _shardCount, @"The shard index (%lu) must be less than the shard count (%lu).",
+             (unsigned long)_shardIndex, (unsigned long)_shardCount);
     
     dispatch_async(_runQueue, ^{
         _completionBlock = completionBlock;
 
         _runningWithPredeterminedSeed = (seed != SLTestControllerRandomSeed);
         _runSeed = seed;
-        _testsToRun = [[self class] testsToRun:tests usingSeed:&_runSeed withFocus:&_runningWithFocus];
-        if (![_testsToRun count]) {
+
+        // if the application crashed during the previous run, resume that run, using its seed
+        // so that tests are filtered (e.g. by focus) as they were
+        SLRunCheckpoint *checkpointToResume = [self checkpointToResume];
+        _resumingFromCheckpoint = (checkpointToResume != nil);
+        if (_resumingFromCheckpoint) _runSeed = [checkpointToResume seed];
+
+        NSArray *testsToRun = [[self class] testsToRun:tests usingSeed:&_runSeed withFocus:&_runningWithFocus];
+        _failureManifest = [[SLFailureManifest alloc] initWithSeed:_runSeed];
+
+        if (_rerunManifestPath) {
+            NSError *rerunManifestError = nil;
+            _rerunManifest = [[SLFailureManifest alloc] initWithContentsOfFile:_rerunManifestPath error:&rerunManifestError];
+            if (_rerunManifest) {
+                // run the failures in the order in which they occurred
+                testsToRun = [_rerunManifest testsWithFailuresFromTests:testsToRun];
+            } else {
+                [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The failures recorded at \"%@\" could not be read, so all tests will run: %@",
+                                                     _rerunManifestPath, [rerunManifestError localizedDescription]]];
+            }
+        }
+
+        _timings = (_timingsPath ? [[SLTestTimings alloc] initWithContentsOfFile:_timingsPath] : nil);
+        _timeProfile = [[SLTimeProfile alloc] init];
+        _timeProfile.timings = _timings;
+        if (_resumingFromCheckpoint) {
+            // the checkpoint records the order in which the run's tests were to run,
+            // as determined by their durations and shard
+            _testsToRun = [checkpointToResume testsToResumeFromTests:testsToRun];
+            _checkpoint = checkpointToResume;
+            _numTestsExecuted = [_checkpoint numTestsCompleted];
+            _numTestsFailed = [_checkpoint numTestsFailed];
+            for (NSDictionary *failure in [_checkpoint failures]) {
+                Class test = NSClassFromString(failure[@"test"]);
+                if (!test) continue;
+                if (failure[@"testCase"]) {
+                    [_failureManifest recordFailureOfTestCase:failure[@"testCase"] inTest:test];
+                } else {
+                    [_failureManifest recordFailureOfTest:test];
+                }
+            }
+        } else {
+            NSDictionary *durations = [self estimatedDurationsOfTests:testsToRun];
+            _runningByDuration = (durations && _ordersTestsByDuration && !_runningWithPredeterminedSeed && !_rerunManifest);
+            if (_runningByDuration) {
+                testsToRun = [[self class] testsOrderedByDuration:testsToRun withDurations:durations];
+            }
+            _testsToRun = [[self class] testsInShard:_shardIndex ofCount:_shardCount fromTests:testsToRun withDurations:durations];
+            if (_checkpointPath) _checkpoint = [[SLRunCheckpoint alloc] initWithSeed:_runSeed tests:_testsToRun];
+        }
+
+        NSError *checkpointError = nil;
+        if (_checkpoint && ![_checkpoint openFileAtPath:_checkpointPath error:&checkpointError]) {
+            [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The progress of the run could not be recorded to \"%@\", so the run may not be resumed if the application crashes: %@",
+                                                 _checkpointPath, [checkpointError localizedDescription]]];
+        }
+
+        // (if resuming, the remaining tests may have completed before the crash)
+        if (![_testsToRun count] && !_resumingFromCheckpoint) {
             NSMutableString *noTestsToRunWarning = [@"There are no tests to run: " mutableCopy];
-            if ([tests count]) {
+            if (_rerunManifest && ![testsToRun count]) {
+                [noTestsToRunWarning appendFormat:@"none of the tests %@ failed in the run recorded at \"%@\".",
+                                                 (_runningWithFocus) ? @"focused" : @"passed", _rerunManifestPath];
+            } else if ([testsToRun count]) {
+                [noTestsToRunWarning appendFormat:@"none of the tests %@ fall within shard %lu of %lu.",
+                                                 (_runningWithFocus) ? @"focused" : @"passed",
+                                                 (unsigned long)_shardIndex + 1, (unsigned long)_shardCount];
+            } else if ([tests count]) {
                 [noTestsToRunWarning appendFormat:@"none of the tests %@ meet the criteria to be run. See `%@`'s documentation.",
                                                  (_runningWithFocus) ? @"focused" : @"passed", @(kMethodDescription)];
             } else {
@@ -372,18 +716,70 @@ u_int32_t random_uniform(u_int32_t upperBound) {
 
         [self _beginTesting];
 
-        for (Class testClass in _testsToRun) {
+        _suiteFixtures = [[NSMutableDictionary alloc] init];
+        _runGroupFixtures = [[NSMutableDictionary alloc] init];
+        NSArray *suiteFixtureClasses = [self setUpFixturesUsingSelector:@selector(setUpSuite) forTests:_testsToRun storingInto:_suiteFixtures];
+        NSArray *runGroupFixtureClasses = nil;
+
+        NSUInteger testCount = [_testsToRun count];
+        for (NSUInteger testIndex = 0; testIndex < testCount; testIndex++) {
+            Class testClass = _testsToRun[testIndex];
+
+            // set up the fixtures of a run group around each contiguous run of its tests
+            // (the tests of a group run together unless e.g. a rerun reorders them)
+            Class previousTestClass = ((testIndex > 0) ? _testsToRun[testIndex - 1] : Nil);
+            if (!previousTestClass || ([previousTestClass runGroup] != [testClass runGroup])) {
+                [self tearDownFixturesUsingSelector:@selector(tearDownRunGroupWithFixture:) ofClasses:runGroupFixtureClasses storedIn:_runGroupFixtures];
+
+                NSUInteger groupEndIndex = testIndex + 1;
+                while (groupEndIndex < testCount) {
+                    Class nextTestClass = _testsToRun[groupEndIndex];
+                    if ([nextTestClass runGroup] != [testClass runGroup]) break;
+                    groupEndIndex++;
+                }
+                NSArray *testsInGroup = [_testsToRun subarrayWithRange:NSMakeRange(testIndex, groupEndIndex - testIndex)];
+                runGroupFixtureClasses = [self setUpFixturesUsingSelector:@selector(setUpRunGroup) forTests:testsInGroup storingInto:_runGroupFixtures];
+            }
+
             @autoreleasepool {
                 SLTest *test = (SLTest *)[[testClass alloc] init];
 
                 NSString *testName = NSStringFromClass(testClass);
                 [[SLLogger sharedLogger] logTestStart:testName];
 
+                // the test relies on a fixture that failed to set up, so it cannot run
+                if ([self fixtureOfTestFailedToSetUp:testClass]) {
+                    [[SLLogger sharedLogger] logError:[NSString stringWithFormat:@"Test \"%@\" will not be run because a fixture that it shares failed to set up.", testName]];
+                    [[SLLogger sharedLogger] logTestAbort:testName];
+                    [_failureManifest recordFailureOfTest:testClass];
+                    [_checkpoint recordCompletionOfTest:testClass aborted:YES failed:YES];
+                    _numTestsFailed++;
+                    _numTestsExecuted++;
+                    continue;
+                }
+
+                // if the application crashed while the test was being set up or torn down,
+                // report the test as having aborted rather than risk crashing again
+                if ([_checkpoint testWasInterruptedOutsideOfTestCase:testClass]) {
+                    [[SLLogger sharedLogger] logError:[NSString stringWithFormat:@"Test \"%@\" crashed the application while being set up or torn down, and will not be run again.", testName]];
+                    [[SLLogger sharedLogger] logTestAbort:testName];
+                    [_failureManifest recordFailureOfTest:testClass];
+                    [_checkpoint recordCompletionOfTest:testClass aborted:YES failed:YES];
+                    _numTestsFailed++;
+                    _numTestsExecuted++;
+                    continue;
+                }
+                [_checkpoint recordStartOfTest:testClass];
+
                 NSUInteger numCasesExecuted = 0, numCasesFailed = 0, numCasesFailedUnexpectedly = 0;
 
+                NSTimeInterval testStartTime = [SLLogRecord currentTimestamp];
                 BOOL testDidFinish = [test runAndReportNumExecuted:&numCasesExecuted
                                                             failed:&numCasesFailed
                                                 failedUnexpectedly:&numCasesFailedUnexpectedly];
+                NSTimeInterval testDuration = [SLLogRecord currentTimestamp] - testStartTime;
+                [_timeProfile recordDuration:testDuration ofTest:testClass];
+                [_checkpoint recordCompletionOfTest:testClass aborted:!testDidFinish failed:(!testDidFinish || (numCasesFailed > 0))];
                 if (testDidFinish) {
                     [[SLLogger sharedLogger] logTestFinish:testName
                                       withNumCasesExecuted:numCasesExecuted
@@ -392,26 +788,102 @@ u_int32_t random_uniform(u_int32_t upperBound) {
                     if (numCasesFailed > 0) _numTestsFailed++;
                 } else {
                     [[SLLogger sharedLogger] logTestAbort:testName];
+                    [_failureManifest recordFailureOfTest:testClass];
                     _numTestsFailed++;
                 }
                 _numTestsExecuted++;
             }
         }
 
+        [self tearDownFixturesUsingSelector:@selector(tearDownRunGroupWithFixture:) ofClasses:runGroupFixtureClasses storedIn:_runGroupFixtures];
+        [self tearDownFixturesUsingSelector:@selector(tearDownSuiteWithFixture:) ofClasses:suiteFixtureClasses storedIn:_suiteFixtures];
+
         [self _finishTesting];
     });
 }
 
+- (void)reportRerunFailures {
+    NSMutableArray *reproducedFailures = [[NSMutableArray alloc] init];
+    NSMutableArray *passedFailures = [[NSMutableArray alloc] init];
+    for (NSString *failure in [_rerunManifest failureDescriptionsOfTests:_testsToRun]) {
+        if ([_rerunManifest failure:failure wasReproducedByManifest:_failureManifest]) {
+            [reproducedFailures addObject:failure];
+        } else {
+            [passedFailures addObject:failure];
+        }
+    }
+
+    if ([reproducedFailures count]) {
+        SLLog(@"%lu failure%@ reproduced: %@.", (unsigned long)[reproducedFailures count],
+              ([reproducedFailures count] == 1 ? @" was" : @"s were"), [reproducedFailures componentsJoinedByString:@", "]);
+    }
+    if ([passedFailures count]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"%lu failure%@ when run again, and may be flaky: %@.",
+                                             (unsigned long)[passedFailures count], ([passedFailures count] == 1 ? @" passed" : @"s passed"),
+                                             [passedFailures componentsJoinedByString:@", "]]];
+    }
+}
+
 - (void)_finishTesting {
+    // screenshots captured within the application are written in the background:
+    // finish writing them before the test runner might terminate the application
+    [[SLDevice currentDevice] waitUntilScreenshotsAreWritten];
+
+    // shards don't record their durations to the timings file, so that the shards of a run
+    // partition the tests using the same durations however far apart they launch
+    NSString *timingsOutputPath = (_timingsOutputPath ?: ((_shardCount == 1) ? _timingsPath : nil));
+    NSError *timingsError = nil;
+    if (_timings && timingsOutputPath && ![_timings mergeRecordedDurationsIntoFile:timingsOutputPath error:&timingsError]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The durations of the tests could not be recorded to \"%@\": %@",
+                                             timingsOutputPath, [timingsError localizedDescription]]];
+    } else if (_timings && !timingsOutputPath) {
+        SLLog(@"The durations of the tests were not recorded, because this run is sharded. Set `SL_TIMINGS_OUTPUT_PATH` to record them.");
+    }
+
+    NSError *timeProfileError = nil;
+    if (_timeProfilePath && _timeProfile && ![_timeProfile writeToFile:_timeProfilePath error:&timeProfileError]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The profile of the run could not be recorded to \"%@\": %@",
+                                             _timeProfilePath, [timeProfileError localizedDescription]]];
+    }
+
+    NSError *failureManifestError = nil;
+    if (_failureManifestPath && ![_failureManifest writeToFile:_failureManifestPath error:&failureManifestError]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"The failures of the tests could not be recorded to \"%@\": %@",
+                                             _failureManifestPath, [failureManifestError localizedDescription]]];
+    }
+
+    [_checkpoint recordCompletionOfRun];
+
     [[SLLogger sharedLogger] logTestingFinishWithNumTestsExecuted:_numTestsExecuted
                                                    numTestsFailed:_numTestsFailed];
 
     if (_numTestsFailed > 0) {
-        SLLog(@"The run order may be reproduced using seed %u.", _runSeed);
+        // specifying the seed would randomize the tests rather than ordering them by duration
+        if (_runningByDuration) {
+            SLLog(@"The run order was determined by the durations recorded at \"%@\", so may not be reproduced using a seed.", _timingsPath);
+        } else {
+            SLLog(@"The run order may be reproduced using seed %u.", _runSeed);
+        }
+    }
+    if ([_timeProfile hasRecordedDurations]) {
+        for (NSString *line in [_timeProfile summary]) {
+            SLLog(@"%@", line);
+        }
+    }
+    if ([_flakyTestCases count]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"%lu test case%@ only when retried, and may be flaky: %@.",
+                                             (unsigned long)[_flakyTestCases count], ([_flakyTestCases count] == 1 ? @" passed" : @"s passed"),
+                                             [_flakyTestCases componentsJoinedByString:@", "]]];
+    }
+    if (_rerunManifest) {
+        [self reportRerunFailures];
     }
     if (_runningWithPredeterminedSeed) {
         [[SLLogger sharedLogger] logWarning:@"Tests were run in a predetermined order."];
     }
+    if (_runningByDuration) {
+        [[SLLogger sharedLogger] logWarning:@"Tests were run longest-first rather than in a random order."];
+    }
     if (_runningWithFocus) {
         [[SLLogger sharedLogger] logWarning:@"This was a focused run. Fewer test cases may have run than normal."];
     }
@@ -420,6 +892,9 @@ u_int32_t random_uniform(u_int32_t upperBound) {
 
     if (_completionBlock) dispatch_sync(dispatch_get_main_queue(), _completionBlock);
 
+    // output any buffered messages before the terminal stops accepting scripts
+    [[SLLogger sharedLogger] flush];
+
     // NOTE: Everything below the next line will not execute when running
     // from the command line, because the UIAutomation script will terminate,
     // and then the app.
@@ -435,7 +910,17 @@ u_int32_t random_uniform(u_int32_t upperBound) {
     _runSeed = SLTestControllerRandomSeed;
     _runningWithFocus = NO;
     _runningWithPredeterminedSeed = NO;
+    _runningByDuration = NO;
+    _resumingFromCheckpoint = NO;
     _testsToRun = nil;
+    _timings = nil;
+    _failureManifest = nil;
+    _rerunManifest = nil;
+    _checkpoint = nil;
+    _flakyTestCases = nil;
+    _timeProfile = nil;
+    _suiteFixtures = nil;
+    _runGroupFixtures = nil;
     _completionBlock = nil;
 
     // deregister Subliminal's exception handler
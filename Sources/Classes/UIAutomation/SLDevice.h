@@ -83,6 +83,29 @@
 /// @name Screenshots
 /// ----------------------------------------
 
+/**
+ The directory to which screenshots are written when they are captured within the application.
+
+ By default, screenshots are captured by UIAutomation, as described in the documentation
+ for `-captureScreenshotWithFilename:`. If this property is set, screenshots will
+ instead be captured by the application and written as PNGs to this directory
+ (which will be created if necessary). This is much faster than capturing
+ screenshots using UIAutomation, because the screenshots are encoded and written
+ in the background; and a screenshot identical to the previous screenshot
+ (e.g. because a failure handler captured the same screen several times)
+ will not be written at all. However, screenshots captured within the application
+ are not viewable in Instruments, and will not include the status bar or any
+ alerts and other system UI.
+
+ If the directory is a relative path, it will be resolved relative to
+ the application's home directory. In the Simulator, the directory may refer
+ to a location on the host machine.
+
+ The default value of this property is the value of the `SL_SCREENSHOT_DIRECTORY`
+ environment variable, or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *screenshotDirectory;
+
 /**
  Takes a screenshot of the entire device screen.
  
@@ -90,6 +113,9 @@
  
  When running `subliminal-test` from the command line, the images are also saved
  as PNGs within the specified output directory.
+
+ If the `screenshotDirectory` is set, the screenshot will instead be captured
+ within the application and written to that directory.
  
  @param filename A string to use as the name for the resultant image file.
  */
@@ -103,6 +129,10 @@
  When running `subliminal-test` from the command line, the images are also saved
  as PNGs within the specified output directory.
  
+
+ If the `screenshotDirectory` is set, the screenshot will instead be captured
+ within the application and written to that directory.
+ 
  @param filename A string to use as the name for the resultant image file.
  @param rect The rect that defines the area of the screen to capture.
  
@@ -110,4 +140,67 @@
  */
 - (void)captureScreenshotWithFilename:(NSString *)filename inRect:(CGRect)rect;
 
+/**
+ Waits until all screenshots captured within the application have been written
+ to the `screenshotDirectory`.
+
+ Screenshots captured within the application are written in the background.
+ Subliminal waits for them to be written before it finishes testing.
+ This method returns immediately if the `screenshotDirectory` is not set.
+ */
+- (void)waitUntilScreenshotsAreWritten;
+
+#pragma mark - Comparing Screenshots
+/// ----------------------------------------
+/// @name Comparing Screenshots
+/// ----------------------------------------
+
+/**
+ The directory in which reference screenshots are found.
+
+ If this property is `nil`, reference screenshots are found among the resources
+ of the application's main bundle.
+
+ If the directory is a relative path, it will be resolved relative to
+ the application's home directory. In the Simulator, the directory may refer
+ to a location on the host machine.
+
+ The default value of this property is the value of the `SL_REFERENCE_SCREENSHOT_DIRECTORY`
+ environment variable, or `nil` if that variable is not set.
+ */
+@property (nonatomic, copy) NSString *referenceScreenshotDirectory;
+
+/**
+ Determines whether the specified rectangular portion of the device screen
+ matches a reference screenshot.
+
+ The screenshot is captured within the application, like those captured when
+ the `screenshotDirectory` is set, and so will not include the status bar
+ or any alerts and other system UI. It is compared, pixel for pixel,
+ to the PNG named _referenceName_ in the `referenceScreenshotDirectory`.
+ The reference must have been captured on a screen of the same scale.
+
+ The screenshot and the reference are scored by how different they appear,
+ from `0.0` (identical, disregarding slight differences in color due to
+ anti-aliasing and the like) to `1.0` (e.g. opaque black vs. opaque white):
+ the score is the mean, over all pixels, of the difference in each pixel's
+ luminance or alpha, whichever is greater.
+
+ If the screenshot does not match, it will be written to the `screenshotDirectory`
+ (or to a temporary directory if that is not set) along with a mask of the pixels
+ that differ. If the reference does not exist, the screenshot will be written
+ under _referenceName_ so that it may be used as a reference.
+
+ @param rect The rect that defines the area of the screen to compare.
+ @param referenceName The name of the reference screenshot, without the ".png" extension.
+ @param tolerance The greatest score at which the screenshot matches the reference.
+ @param failureReason If this method returns `NO`, and this parameter is not `NULL`,
+ on return, a description of why the screenshot does not match.
+ @return `YES` if the screenshot matches the reference, otherwise `NO`.
+
+ @exception NSInternalInconsistencyException if `rect` is `CGRectNull`.
+ */
+- (BOOL)screenshotInRect:(CGRect)rect matchesReferenceNamed:(NSString *)referenceName
+               tolerance:(double)tolerance failureReason:(NSString **)failureReason;
+
 @end
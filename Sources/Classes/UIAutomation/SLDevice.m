@@ -25,9 +25,17 @@
 #import "SLTerminal.h"
 #import "SLStringUtilities.h"
 #import "SLGeometry.h"
+#import "SLUIAElement.h"
+#import "SLUIQuiescence.h"
+#import "SLScreenshotWriter.h"
+#import "SLImageDiff.h"
+#import "SLTimeProfile.h"
 
 
-@implementation SLDevice
+@implementation SLDevice {
+    NSString *_screenshotDirectory, *_referenceScreenshotDirectory;
+    SLScreenshotWriter *_screenshotWriter;
+}
 
 + (SLDevice *)currentDevice {
     static SLDevice *device;
@@ -38,6 +46,16 @@
     return device;
 }
 
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        NSDictionary *environment = [[NSProcessInfo processInfo] environment];
+        self.screenshotDirectory = environment[@"SL_SCREENSHOT_DIRECTORY"];
+        self.referenceScreenshotDirectory = environment[@"SL_REFERENCE_SCREENSHOT_DIRECTORY"];
+    }
+    return self;
+}
+
 - (void)deactivateAppForDuration:(NSTimeInterval)duration {
     UIDeviceOrientation currentOrientation = [UIDevice currentDevice].orientation;
 
@@ -71,22 +89,247 @@ NSString * SLUIADeviceOrientationFromUIDeviceOrientation(UIDeviceOrientation dev
 - (void)setOrientation:(UIDeviceOrientation)deviceOrientation
 {
     [[SLTerminal sharedTerminal] evalWithFormat:@"UIATarget.localTarget().setDeviceOrientation(%@)", SLUIADeviceOrientationFromUIDeviceOrientation(deviceOrientation)];
-    // Delay to ensure that the rotation completes and UIDevice registers the new orientation
-    [NSThread sleepForTimeInterval:1.0];
+    // Wait for UIDevice to register the new orientation, and then for the rotation to complete
+    NSDate *startDate = [NSDate date];
+    __block BOOL deviceDidRotate = NO;
+    while (!deviceDidRotate && ([[NSDate date] timeIntervalSinceDate:startDate] < [SLUIAElement defaultTimeout])) {
+        SLTimeProfileDispatchSyncToMainQueue(^{
+            deviceDidRotate = ([[UIDevice currentDevice] orientation] == deviceOrientation);
+        });
+        if (!deviceDidRotate) SLTimeProfileSleep(SLUIQuiescenceRetryDelay);
+    }
+    NSTimeInterval remainingTimeout = [SLUIAElement defaultTimeout] - [[NSDate date] timeIntervalSinceDate:startDate];
+    (void)SLWaitForUIQuiescence(MAX(remainingTimeout, 0.0));
 }
 
 #pragma mark - Screenshots
 
+static void SLPerformOnMainThread(void (^block)(void)) {
+    if ([NSThread isMainThread]) {
+        block();
+    } else {
+        SLTimeProfileDispatchSyncToMainQueue(block);
+    }
+}
+
+/// Returns the visible windows of the application on the main screen, from back to front.
+/// Must be called on the main thread.
+static NSArray *SLWindowsOnMainScreen(void) {
+    UIScreen *mainScreen = [UIScreen mainScreen];
+    NSMutableArray *windows = [NSMutableArray array];
+    for (UIWindow *window in [[UIApplication sharedApplication] windows]) {
+        if (![window isHidden] && (window.screen == mainScreen)) [windows addObject:window];
+    }
+    return windows;
+}
+
+- (void)setScreenshotDirectory:(NSString *)screenshotDirectory {
+    SLScreenshotWriter *screenshotWriter = nil;
+    if ([screenshotDirectory length]) {
+        if (![screenshotDirectory isAbsolutePath]) {
+            screenshotDirectory = [NSHomeDirectory() stringByAppendingPathComponent:screenshotDirectory];
+        }
+        screenshotWriter = [[SLScreenshotWriter alloc] initWithDirectory:screenshotDirectory];
+    } else {
+        screenshotDirectory = nil;
+    }
+
+    SLScreenshotWriter *previousWriter;
+    @synchronized(self) {
+        _screenshotDirectory = [screenshotDirectory copy];
+        previousWriter = _screenshotWriter;
+        _screenshotWriter = screenshotWriter;
+    }
+    [previousWriter waitUntilScreenshotsAreWritten];
+}
+
+- (NSString *)screenshotDirectory {
+    @synchronized(self) {
+        return _screenshotDirectory;
+    }
+}
+
+- (void)setReferenceScreenshotDirectory:(NSString *)referenceScreenshotDirectory {
+    if ([referenceScreenshotDirectory length]) {
+        if (![referenceScreenshotDirectory isAbsolutePath]) {
+            referenceScreenshotDirectory = [NSHomeDirectory() stringByAppendingPathComponent:referenceScreenshotDirectory];
+        }
+    } else {
+        referenceScreenshotDirectory = nil;
+    }
+    @synchronized(self) {
+        _referenceScreenshotDirectory = [referenceScreenshotDirectory copy];
+    }
+}
+
+- (NSString *)referenceScreenshotDirectory {
+    @synchronized(self) {
+        return _referenceScreenshotDirectory;
+    }
+}
+
+- (SLScreenshotWriter *)screenshotWriter {
+    @synchronized(self) {
+        return _screenshotWriter;
+    }
+}
+
 - (void)captureScreenshotWithFilename:(NSString *)filename
 {
+    if ([self screenshotWriter]) {
+        [self captureScreenshotWithinApplicationWithFilename:filename inRect:CGRectNull];
+        return;
+    }
+
     [[SLTerminal sharedTerminal] evalWithFormat:@"UIATarget.localTarget().captureScreenWithName(\"%@\")",
                                                 [filename slStringByEscapingForJavaScriptLiteral]];
 }
 
 - (void)captureScreenshotWithFilename:(NSString *)filename inRect:(CGRect)rect
 {
+    if ([self screenshotWriter]) {
+        NSAssert(!CGRectIsNull(rect), @"The rect to capture must not be null.");
+        [self captureScreenshotWithinApplicationWithFilename:filename inRect:rect];
+        return;
+    }
+
     [[SLTerminal sharedTerminal] evalWithFormat:@"UIATarget.localTarget().captureRectWithName(%@,\"%@\")",
                                                 SLUIARectFromCGRect(rect),[filename slStringByEscapingForJavaScriptLiteral]];
 }
 
+- (void)captureScreenshotWithinApplicationWithFilename:(NSString *)filename inRect:(CGRect)rect {
+    SLScreenshotWriter *screenshotWriter = [self screenshotWriter];
+    if (!filename) filename = @"screenshot";
+    SLPerformOnMainThread(^{
+        UIScreen *mainScreen = [UIScreen mainScreen];
+        [screenshotWriter captureViews:SLWindowsOnMainScreen() onScreenOfSize:mainScreen.bounds.size scale:mainScreen.scale
+                                inRect:rect withFilename:filename];
+    });
+}
+
+#pragma mark - Comparing Screenshots
+
+/// The largest difference in any channel of a pixel at which the pixel is not considered
+/// to differ from the reference: this absorbs the noise of anti-aliasing and color conversion.
+static const unsigned char kSLScreenshotChannelTolerance = 3;
+
+static const CGBitmapInfo kSLScreenshotBitmapInfo = (kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+
+/// Writes pixels as a PNG: 32-bit RGBA pixels, if _grayscale_ is `NO`; otherwise 8-bit grayscale pixels.
+static BOOL SLWritePNGOfPixels(NSData *pixels, size_t width, size_t height, BOOL grayscale, NSString *path) {
+    const size_t bytesPerPixel = (grayscale ? 1 : 4);
+    CGDataProviderRef dataProvider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixels);
+    CGColorSpaceRef colorSpace = (grayscale ? CGColorSpaceCreateDeviceGray() : CGColorSpaceCreateDeviceRGB());
+    CGImageRef image = CGImageCreate(width, height, 8, (8 * bytesPerPixel), (width * bytesPerPixel), colorSpace,
+                                     (grayscale ? (CGBitmapInfo)kCGImageAlphaNone : kSLScreenshotBitmapInfo),
+                                     dataProvider, NULL, false, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(dataProvider);
+
+    NSData *pngData = (image ? UIImagePNGRepresentation([UIImage imageWithCGImage:image]) : nil);
+    CGImageRelease(image);
+    return [pngData writeToFile:path atomically:YES];
+}
+
+/// Returns the path of the reference screenshot with the specified name, or `nil` if there is none.
+- (NSString *)pathForReferenceScreenshotNamed:(NSString *)referenceName {
+    NSString *filename = [referenceName stringByAppendingPathExtension:@"png"];
+    NSString *referenceScreenshotDirectory = self.referenceScreenshotDirectory;
+    if (referenceScreenshotDirectory) {
+        NSString *path = [referenceScreenshotDirectory stringByAppendingPathComponent:filename];
+        return ([[NSFileManager defaultManager] fileExistsAtPath:path] ? path : nil);
+    } else {
+        return [[NSBundle mainBundle] pathForResource:referenceName ofType:@"png"];
+    }
+}
+
+- (BOOL)screenshotInRect:(CGRect)rect matchesReferenceNamed:(NSString *)referenceName
+               tolerance:(double)tolerance failureReason:(NSString *__autoreleasing *)failureReason {
+    NSParameterAssert(referenceName);
+    NSAssert(!CGRectIsNull(rect), @"The rect to compare must not be null.");
+
+    // render the rect as it appears on-screen, in pixels
+    __block size_t width, height;
+    NSMutableData *pixels = [NSMutableData data];
+    SLPerformOnMainThread(^{
+        const CGFloat scale = [[UIScreen mainScreen] scale];
+        CGRect pixelRect = CGRectIntegral(CGRectApplyAffineTransform(rect, CGAffineTransformMakeScale(scale, scale)));
+        width = (size_t)CGRectGetWidth(pixelRect);
+        height = (size_t)CGRectGetHeight(pixelRect);
+        [pixels setLength:(4 * width * height)];
+
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGContextRef context = CGBitmapContextCreate([pixels mutableBytes], width, height, 8, (4 * width),
+                                                     colorSpace, kSLScreenshotBitmapInfo);
+        CGColorSpaceRelease(colorSpace);
+        if (!context) return;
+
+        // flip the context to match UIKit's coordinate system, and move the rect to its origin
+        CGContextTranslateCTM(context, 0.0, height);
+        CGContextScaleCTM(context, scale, -scale);
+        CGContextTranslateCTM(context, -CGRectGetMinX(pixelRect) / scale, -CGRectGetMinY(pixelRect) / scale);
+        SLRenderViewsInContext(SLWindowsOnMainScreen(), context);
+        CGContextRelease(context);
+    });
+
+    // write the screenshot and any diff to the screenshot directory, or a temporary directory
+    NSString *outputDirectory = self.screenshotDirectory;
+    if (!outputDirectory) outputDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"SLScreenshotComparisons"];
+    (void)[[NSFileManager defaultManager] createDirectoryAtPath:outputDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    NSString *referencePath = [self pathForReferenceScreenshotNamed:referenceName];
+    UIImage *referenceImage = (referencePath ? [UIImage imageWithContentsOfFile:referencePath] : nil);
+    if (!referenceImage) {
+        NSString *screenshotPath = [[outputDirectory stringByAppendingPathComponent:referenceName] stringByAppendingPathExtension:@"png"];
+        (void)SLWritePNGOfPixels(pixels, width, height, NO, screenshotPath);
+        if (failureReason) {
+            *failureReason = [NSString stringWithFormat:@"No reference screenshot named \"%@\" could be found. "
+                              @"The screenshot was written to \"%@\" for use as a reference.", referenceName, screenshotPath];
+        }
+        return NO;
+    }
+
+    // draw the reference into the same format as the screenshot
+    CGImageRef referenceCGImage = [referenceImage CGImage];
+    const size_t referenceWidth = CGImageGetWidth(referenceCGImage), referenceHeight = CGImageGetHeight(referenceCGImage);
+    if ((referenceWidth != width) || (referenceHeight != height)) {
+        if (failureReason) {
+            *failureReason = [NSString stringWithFormat:@"The reference screenshot is %zu x %zu pixels, but the screenshot is %zu x %zu pixels.",
+                              referenceWidth, referenceHeight, width, height];
+        }
+        return NO;
+    }
+    NSMutableData *referencePixels = [NSMutableData dataWithLength:(4 * width * height)];
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef referenceContext = CGBitmapContextCreate([referencePixels mutableBytes], width, height, 8, (4 * width),
+                                                          colorSpace, kSLScreenshotBitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+    CGContextDrawImage(referenceContext, CGRectMake(0.0, 0.0, width, height), referenceCGImage);
+    CGContextRelease(referenceContext);
+
+    NSMutableData *mask = [NSMutableData dataWithLength:(width * height)];
+    SLImageDiff diff = SLImageDiffOfPixels([pixels bytes], (4 * width), [referencePixels bytes], (4 * width),
+                                           width, height, kSLScreenshotChannelTolerance, [mask mutableBytes], width);
+    if (diff.score <= tolerance) return YES;
+
+    NSString *basePath = [outputDirectory stringByAppendingPathComponent:referenceName];
+    NSString *screenshotPath = [basePath stringByAppendingString:@" (actual).png"];
+    NSString *maskPath = [basePath stringByAppendingString:@" (difference).png"];
+    (void)SLWritePNGOfPixels(pixels, width, height, NO, screenshotPath);
+    (void)SLWritePNGOfPixels(mask, width, height, YES, maskPath);
+    if (failureReason) {
+        *failureReason = [NSString stringWithFormat:@"The screenshot differs from the reference by %g (tolerance %g): "
+                          @"%lu of %lu pixels differ. The screenshot was written to \"%@\" and a mask of the differences to \"%@\".",
+                          diff.score, tolerance, (unsigned long)diff.differingPixelCount, (unsigned long)diff.pixelCount,
+                          screenshotPath, maskPath];
+    }
+    return NO;
+}
+
+#pragma mark -
+
+- (void)waitUntilScreenshotsAreWritten {
+    [[self screenshotWriter] waitUntilScreenshotsAreWritten];
+}
+
 @end
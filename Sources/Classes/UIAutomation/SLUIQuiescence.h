@@ -0,0 +1,85 @@
+//
+//  SLUIQuiescence.h
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+@class CALayer;
+
+#pragma mark - Waiting for the UI to Settle
+/// ----------------------------------------------------------------------
+/// @name Waiting for the UI to Settle
+/// ----------------------------------------------------------------------
+
+/**
+ Waits for the application's user interface to settle, returning as soon as it has.
+
+ The user interface is considered to have settled when, for two consecutive checks:
+
+ - no layer in the tree of the key window, or of any window above the key window
+ (such as the keyboard's window), has an animation in flight (see `SLLayerTreeIsQuiescent`);
+ - no such layer needs layout;
+ - no view controller presented in those windows has a transition coordinator
+ (on iOS 7 and above); and
+ - the application is not ignoring interaction events (as UIKit does
+ during certain transitions, e.g. rotation).
+
+ Use this function in place of a fixed delay to wait for an animation triggered by
+ the tests (e.g. the dismissal of a popover, or the rotation of the device) to complete.
+
+ This function must not be called from the main thread.
+
+ @param timeout The maximum duration for which to wait for the user interface to settle.
+ @return `YES` if the user interface settled before _timeout_ elapsed, `NO` otherwise.
+ */
+BOOL SLWaitForUIQuiescence(NSTimeInterval timeout);
+
+/**
+ Returns whether the application's user interface is currently settled,
+ as defined by `SLWaitForUIQuiescence`.
+
+ This function must be called from the main thread.
+
+ @return `YES` if no animations, layout, or transitions are pending, `NO` otherwise.
+ */
+BOOL SLUIIsQuiescent(void);
+
+/**
+ Returns whether the specified layer tree is settled.
+
+ A layer tree is settled when no layer in the tree needs layout or has an animation
+ in flight. Hidden layers, and their sublayers, are ignored. Animations which repeat
+ indefinitely (like that of an activity indicator) are ignored, as are animations
+ which have finished but which were not removed on completion.
+
+ This function must be called from the main thread.
+
+ @param layer The root of the layer tree to examine.
+ @return `YES` if no layer in the tree needs layout or has an animation in flight,
+ `NO` otherwise.
+ */
+BOOL SLLayerTreeIsQuiescent(CALayer *layer);
+
+
+#pragma mark - Constants
+
+/// `SLWaitForUIQuiescence` waits for this duration between checks of the user interface.
+extern const NSTimeInterval SLUIQuiescenceRetryDelay;
@@ -0,0 +1,133 @@
+//
+//  SLUIQuiescence.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SLUIQuiescence.h"
+#import "SLTimeProfile.h"
+
+#import <UIKit/UIKit.h>
+#import <QuartzCore/QuartzCore.h>
+
+const NSTimeInterval SLUIQuiescenceRetryDelay = 0.05;
+
+
+// Returns the time, in the time space of the animation's layer, at which the animation
+// finishes, or `HUGE_VAL` if it never will (e.g. that of an activity indicator).
+static CFTimeInterval SLEndTimeOfAnimation(CAAnimation *animation) {
+    if ((animation.repeatCount == HUGE_VALF) || (animation.repeatDuration == HUGE_VAL) ||
+        (animation.speed == 0.0)) {
+        return HUGE_VAL;
+    }
+
+    CFTimeInterval activeDuration;
+    if (animation.repeatDuration > 0.0) {
+        activeDuration = animation.repeatDuration;
+    } else {
+        activeDuration = animation.duration * (animation.repeatCount ?: 1.0f);
+        if (animation.autoreverses) activeDuration *= 2.0;
+    }
+    return animation.beginTime + (activeDuration / animation.speed);
+}
+
+BOOL SLLayerTreeIsQuiescent(CALayer *layer) {
+    // hidden layers are not displayed, so their animations are not of interest
+    if (layer.hidden) return YES;
+
+    if ([layer needsLayout]) return NO;
+
+    NSArray *animationKeys = [layer animationKeys];
+    if ([animationKeys count]) {
+        const CFTimeInterval currentTime = [layer convertTime:CACurrentMediaTime() fromLayer:nil];
+        for (NSString *animationKey in animationKeys) {
+            CAAnimation *animation = [layer animationForKey:animationKey];
+            // (an animation whose begin time is not yet set has yet to be committed)
+            if (animation.beginTime == 0.0) return NO;
+
+            // ignore animations which would never complete,
+            // and those which have completed but are not removed on completion
+            const CFTimeInterval endTime = SLEndTimeOfAnimation(animation);
+            if ((endTime != HUGE_VAL) && (endTime > currentTime)) return NO;
+        }
+    }
+
+    for (CALayer *sublayer in [layer sublayers]) {
+        if (!SLLayerTreeIsQuiescent(sublayer)) return NO;
+    }
+    return YES;
+}
+
+static BOOL SLViewControllerIsTransitioning(UIViewController *viewController) {
+    while (viewController) {
+        // `-transitionCoordinator` is only available on iOS 7 and above
+        if ([viewController respondsToSelector:@selector(transitionCoordinator)] &&
+            [viewController transitionCoordinator]) {
+            return YES;
+        }
+        viewController = [viewController presentedViewController];
+    }
+    return NO;
+}
+
+BOOL SLUIIsQuiescent(void) {
+    NSCAssert([NSThread isMainThread], @"%s must be called from the main thread.", __func__);
+
+    UIApplication *application = [UIApplication sharedApplication];
+    if ([application isIgnoringInteractionEvents]) return NO;
+
+    // Like `SLElement`, examine the key window and any windows above it
+    // (e.g. the text effects window), but not hidden windows below the key window.
+    NSArray *windows = [application windows];
+    UIWindow *keyWindow = [application keyWindow];
+    NSUInteger keyWindowIndex = [windows indexOfObject:keyWindow];
+    NSArray *windowsToExamine;
+    if (keyWindowIndex == NSNotFound) {
+        // When an alert window is on the screen, it will be the keyWindow, but doesn't appear within UIApplication's windows
+        windowsToExamine = (keyWindow ? @[ keyWindow ] : @[]);
+    } else {
+        windowsToExamine = [windows subarrayWithRange:NSMakeRange(keyWindowIndex, [windows count] - keyWindowIndex)];
+    }
+
+    for (UIWindow *window in windowsToExamine) {
+        if (SLViewControllerIsTransitioning(window.rootViewController)) return NO;
+        if (!SLLayerTreeIsQuiescent(window.layer)) return NO;
+    }
+    return YES;
+}
+
+BOOL SLWaitForUIQuiescence(NSTimeInterval timeout) {
+    NSCAssert(![NSThread isMainThread], @"%s must not be called from the main thread.", __func__);
+
+    // Require the UI to be quiescent for two consecutive checks,
+    // so as not to return in the gap between one animation completing and a chained animation starting.
+    NSUInteger consecutiveQuiescentChecks = 0;
+    NSDate *startDate = [NSDate date];
+    do {
+        __block BOOL isQuiescent = NO;
+        SLTimeProfileDispatchSyncToMainQueue(^{
+            isQuiescent = SLUIIsQuiescent();
+        });
+        consecutiveQuiescentChecks = (isQuiescent ? consecutiveQuiescentChecks + 1 : 0);
+        if (consecutiveQuiescentChecks >= 2) return YES;
+
+        SLTimeProfileSleep(SLUIQuiescenceRetryDelay);
+    } while ([[NSDate date] timeIntervalSinceDate:startDate] < timeout);
+    return NO;
+}
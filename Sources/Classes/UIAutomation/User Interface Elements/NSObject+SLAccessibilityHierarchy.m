@@ -112,7 +112,7 @@
                 if (!element) {
                     dispatch_async([[SLLogger sharedLogger] loggingQueue], ^{
                         NSString *message = [NSString stringWithFormat:@"accessibilityElementAtIndex: %ld is nil for %@", (long)i, self];
-                        [[SLLogger sharedLogger] logWarning:message];
+                        [[SLLogger sharedLogger] logOnce:message level:SLLogLevelWarning];
                     });
                     continue;
                 }
@@ -121,7 +121,7 @@
                     // Protect against tests entering an infinite loop,
                     // in case there's any scenario where the hierarchy might not stabilize.
                     if (haveReloadedChildren) {
-                        SLLogAsync(@"The accessibility hierarchy is unstable: the accessibility children of %@ are likely invalid.", self);
+                        SLLogOnce(@"The accessibility hierarchy is unstable: the accessibility children of %@ are likely invalid.", self);
                     } else {
                         shouldReloadChildren = YES, haveReloadedChildren = YES;
                         [children removeAllObjects];
@@ -133,6 +133,53 @@
  */
 + (instancetype)anyElement;
 
+#pragma mark - Determining Visibility
+/// ------------------------------------------
+/// @name Determining Visibility
+/// ------------------------------------------
+
+/**
+ Determines whether each of the specified elements is visible on the screen.
+
+ This method is equivalent to sending `[-isVisible](-[SLUIAElement isVisible])`
+ to each element, but is much faster when checking several elements at once:
+ it examines the view hierarchy in a single pass on the main thread, and renders
+ the view hierarchy (if rendering is necessary) as few times as possible
+ to evaluate all the elements.
+
+ Like `-isVisible`, this method evaluates the current state of the elements,
+ without waiting for them to become valid.
+
+ @param elements An array of `SLElement` objects.
+ @return An array of `NSNumber` objects wrapping `BOOL` values, in the order of _elements_,
+ each of which is `YES` if the corresponding element is visible, `NO` otherwise.
+
+ @exception SLUIAElementInvalidException Raised if any of the elements is not valid.
+ */
++ (NSArray *)visibilityOfElements:(NSArray *)elements;
+
+/**
+ Determines the fraction of the specified element's frame which is visible on the screen.
+
+ Whereas `[-isVisible](-[SLUIAElement isVisible])` samples the visibility of an element
+ at its center and corners, this method measures the visibility of the element across
+ its entire frame (`[-rect](-[SLUIAElement rect])`). Parts of the frame that lie offscreen
+ are considered not to be visible. Use `SLAssertVisibleFraction` to make assertions
+ about the result.
+
+ Like `-isVisible`, this method evaluates the current state of the element,
+ without waiting for it to become valid.
+
+ @bug This method always returns `0.0` if the device is in a non-portrait
+ orientation: https://github.com/inkling/Subliminal/issues/135 .
+
+ @return The fraction of the element's frame which is visible, from `0.0` to `1.0`.
+ `0.0` if the element is hidden or its center is offscreen.
+
+ @exception SLUIAElementInvalidException Raised if the element is not valid.
+ */
+- (CGFloat)visibleFraction;
+
 #pragma mark - Gestures and Actions
 /// ------------------------------------------
 /// @name Gestures and Actions
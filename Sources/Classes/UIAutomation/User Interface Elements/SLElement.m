@@ -27,6 +27,8 @@
 #import "NSObject+SLVisibility.h"
 #import "NSObject+SLAccessibilityDescription.h"
 #import "UIScrollView+SLProgrammaticScrolling.h"
+#import "SLUIQuiescence.h"
+#import "SLTimeProfile.h"
 
 
 // The real value (set in `+load`) is not a compile-time constant,
@@ -142,30 +144,30 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
     return [NSString stringWithFormat:@"<%@ description:\"%@\">", NSStringFromClass([self class]), _description];
 }
 
-- (BOOL)canDetermineTappabilityUsingAccessibilityPath:(SLAccessibilityPath *)path {
+- (BOOL)canDetermineTappabilityOfMatchingObject:(NSObject *)object {
+    NSAssert([NSThread isMainThread], @"%@ must be called from the main thread.", NSStringFromSelector(_cmd));
+
     BOOL canDetermineTappability = YES;
     if ((kCFCoreFoundationVersionNumber <= kCFCoreFoundationVersionNumber_iOS_5_1)
         && ([[UIDevice currentDevice] userInterfaceIdiom] == UIUserInterfaceIdiomPad)) {
-        __block BOOL matchingObjectIsScrollView = NO;
-        [path examineLastPathComponent:^(NSObject *lastPathComponent) {
-            matchingObjectIsScrollView = [lastPathComponent isKindOfClass:[UIScrollView class]];
-        }];
-        canDetermineTappability = !matchingObjectIsScrollView;
+        canDetermineTappability = ![object isKindOfClass:[UIScrollView class]];
     }
     return canDetermineTappability;
 }
 
 - (BOOL)canDetermineTappability {
-    BOOL canDetermineTappability = YES;
+    BOOL __block canDetermineTappability = YES;
     // incur the cost of a path lookup only if necessary
     if ((kCFCoreFoundationVersionNumber <= kCFCoreFoundationVersionNumber_iOS_5_1)
         && ([[UIDevice currentDevice] userInterfaceIdiom] == UIUserInterfaceIdiomPad)) {
         // like `-isTappable`, evaluate the current state, no waiting to resolve the element
-        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:0.0];
+        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:0.0
+                                                      thenPerformBlockOnMainThread:^(SLAccessibilityPath *path) {
+            canDetermineTappability = [self canDetermineTappabilityOfMatchingObject:[path lastPathComponent]];
+        }];
         if (!accessibilityPath) {
             [NSException raise:SLUIAElementInvalidException format:@"Element '%@' does not exist.", self];
         }
-        canDetermineTappability = [self canDetermineTappabilityUsingAccessibilityPath:accessibilityPath];
     }
     return canDetermineTappability;
 }
@@ -178,34 +180,53 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
     _shouldDoubleCheckValidity = shouldDoubleCheckValidity;
 }
 
+- (SLAccessibilityPath *)accessibilityPathOnMainThread {
+    NSAssert([NSThread isMainThread], @"%@ must be called from the main thread.", NSStringFromSelector(_cmd));
+
+    // We will search for the matching SLElement's accessibility path in any window on
+    // or above the keyWindow. The heuristic is to allow matching other windows such as
+    // the text effects window (UITextField's inputView), while not searching hidden
+    // windows below the keyWindow.
+    NSArray *windows = [[UIApplication sharedApplication] windows];
+    UIWindow *keyWindow = [[UIApplication sharedApplication] keyWindow];
+    NSUInteger keyWindowIndex = [windows indexOfObject:keyWindow];
+
+    SLAccessibilityPath *accessibilityPath = nil;
+    if (keyWindowIndex == NSNotFound) {
+        // When an alert window is on the screen, it will be the keyWindow, but doesn't appear within UIApplication's windows
+        accessibilityPath = [keyWindow slAccessibilityPathToElement:self];
+    } else {
+        for (NSUInteger windowIndex = keyWindowIndex; windowIndex < [windows count]; windowIndex++) {
+            UIWindow *window = windows[windowIndex];
+            accessibilityPath = [window slAccessibilityPathToElement:self];
+            if (accessibilityPath) break;
+        }
+    }
+    return accessibilityPath;
+}
+
 - (SLAccessibilityPath *)accessibilityPathWithTimeout:(NSTimeInterval)timeout {
+    return [self accessibilityPathWithTimeout:timeout thenPerformBlockOnMainThread:nil];
+}
+
+// Each attempt to resolve the path is a single dispatch to the main queue, within which
+// `block` (if any) is also performed, so that clients that need to use the path on the main thread
+// (to bind it, to examine its destination) need not wait on the main queue again.
+- (SLAccessibilityPath *)accessibilityPathWithTimeout:(NSTimeInterval)timeout
+                         thenPerformBlockOnMainThread:(void (^)(SLAccessibilityPath *accessibilityPath))block {
     __block SLAccessibilityPath *accessibilityPath = nil;
     NSDate *startDate = [NSDate date];
     // a timeout of 0 means check once--but then return immediately, no waiting
     do {
-        dispatch_sync(dispatch_get_main_queue(), ^{
-            // We will search for the matching SLElement's accessibility path in any window on
-            // or above the keyWindow. The heuristic is to allow matching other windows such as
-            // the text effects window (UITextField's inputView), while not searching hidden
-            // windows below the keyWindow.
-            NSArray *windows = [[UIApplication sharedApplication] windows];
-            UIWindow *keyWindow = [[UIApplication sharedApplication] keyWindow];
-            NSUInteger keyWindowIndex = [windows indexOfObject:keyWindow];
-
-            if (keyWindowIndex == NSNotFound) {
-                // When an alert window is on the screen, it will be the keyWindow, but doesn't appear within UIApplication's windows
-                accessibilityPath = [keyWindow slAccessibilityPathToElement:self];
-            } else {
-                for (NSUInteger windowIndex = keyWindowIndex; windowIndex < [windows count]; windowIndex++) {
-                    UIWindow *window = windows[windowIndex];
-                    accessibilityPath = [window slAccessibilityPathToElement:self];
-                    if (accessibilityPath) break;
-                }
-            }
+        SLTimeProfileDispatchSyncToMainQueue(^{
+            accessibilityPath = [self accessibilityPathOnMainThread];
+            if (accessibilityPath && block) block(accessibilityPath);
         });
         if (accessibilityPath || !timeout) break;
 
+        NSTimeInterval retryDelayStartTime = [SLLogRecord currentTimestamp];
         [NSThread sleepForTimeInterval:SLUIAElementWaitRetryDelay];
+        SLTimeProfileRecordActivity(SLTimeProfileActivityElementResolutionRetry, retryDelayStartTime);
     } while ([[NSDate date] timeIntervalSinceDate:startDate] < timeout);
     return accessibilityPath;
 }
@@ -218,9 +239,20 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
     NSException *__block actionException;
     do {
         actionException = nil;
-        
+
+        // Resolve, bind, and serialize the path--and evaluate `canDetermineTappability`
+        // using the path's destination, because we can't retrieve another path while this one
+        // is bound--all within a single dispatch to the main queue.
+        NSString *__block UIARepresentation = nil;
+        BOOL __block canDetermineTappability = YES;
         NSDate *resolutionStart = [NSDate date];
-        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:remainingTimeout];
+        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:remainingTimeout
+                                                      thenPerformBlockOnMainThread:^(SLAccessibilityPath *path) {
+            UIARepresentation = [path bindPathAndReturnUIARepresentation];
+            if (waitUntilTappable) {
+                canDetermineTappability = [self canDetermineTappabilityOfMatchingObject:[path lastPathComponent]];
+            }
+        }];
         NSTimeInterval resolutionDuration = [[NSDate date] timeIntervalSinceDate:resolutionStart];
         remainingTimeout -= resolutionDuration;
 
@@ -229,56 +261,60 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
         }
         
         // It's possible, if unlikely, that one or more path components could have dropped
-        // out of scope between the path's construction and its binding/serialization
+        // out of scope between the path's binding/serialization and its evaluation
         // here. If the representation is invalid, UIAutomation will throw an exception,
         // and it will be caught by Subliminal.
-        [accessibilityPath bindPath:^(SLAccessibilityPath *boundPath) {
-            // catch and rethrow exceptions so that we can unbind the path
-            @try {
-                NSString *UIARepresentation = [boundPath UIARepresentation];
-
-                if (self.shouldDoubleCheckValidity) {
-                    BOOL uiaIsValid = [[[SLTerminal sharedTerminal] evalWithFormat:@"%@.isValid()", UIARepresentation] boolValue];
-                    if (!uiaIsValid) {
-                        // Subliminal is not properly identifying the element to UIAutomation:
-                        // there is a bug in `SLAccessibilityPath` or `NSObject (SLAccessibilityHierarchy)`
-                        [NSException raise:SLUIAElementInvalidException format:@"Element '%@' does not exist at path '%@'.", self, UIARepresentation];
-                    }
+        //
+        // catch and rethrow exceptions so that we can unbind the path
+        @try {
+            if (self.shouldDoubleCheckValidity) {
+                BOOL uiaIsValid = [[[SLTerminal sharedTerminal] evalWithFormat:@"%@.isValid()", UIARepresentation] boolValue];
+                if (!uiaIsValid) {
+                    // Subliminal is not properly identifying the element to UIAutomation:
+                    // there is a bug in `SLAccessibilityPath` or `NSObject (SLAccessibilityHierarchy)`
+                    [NSException raise:SLUIAElementInvalidException format:@"Element '%@' does not exist at path '%@'.", self, UIARepresentation];
                 }
+            }
 
-                // evaluate canDetermineTappability using the current path
-                // because we can't retrieve another while the element is bound
-                if (waitUntilTappable && [self canDetermineTappabilityUsingAccessibilityPath:accessibilityPath]) {
-                    NSDate *tappabilityCheckStart = [NSDate date];
-                    BOOL isTappable = [[SLTerminal sharedTerminal] waitUntilFunctionWithNameIsTrue:[[self class]SLElementIsTappableFunctionName]
-                                                                             whenEvaluatedWithArgs:@[ UIARepresentation ]
-                                                                                        retryDelay:SLUIAElementWaitRetryDelay
-                                                                                           timeout:remainingTimeout];
-                    NSTimeInterval tappabilityCheckDuration = [[NSDate date] timeIntervalSinceDate:tappabilityCheckStart];
-                    remainingTimeout -= tappabilityCheckDuration;
-                    didCheckTappability = YES;
-
-                    if (!isTappable) [NSException raise:SLUIAElementNotTappableException format:@"Element '%@' is not tappable.", self];
-                }
-                block(UIARepresentation);
+            if (waitUntilTappable && canDetermineTappability) {
+                NSDate *tappabilityCheckStart = [NSDate date];
+                BOOL isTappable = [[SLTerminal sharedTerminal] waitUntilFunctionWithNameIsTrue:[[self class]SLElementIsTappableFunctionName]
+                                                                         whenEvaluatedWithArgs:@[ UIARepresentation ]
+                                                                                    retryDelay:SLUIAElementWaitRetryDelay
+                                                                                       timeout:remainingTimeout];
+                NSTimeInterval tappabilityCheckDuration = [[NSDate date] timeIntervalSinceDate:tappabilityCheckStart];
+                remainingTimeout -= tappabilityCheckDuration;
+                didCheckTappability = YES;
+
+                if (!isTappable) [NSException raise:SLUIAElementNotTappableException format:@"Element '%@' is not tappable.", self];
             }
-            @catch (NSException *exception) {
-                // rename JavaScript exceptions to make the context of the exception clear
-                if ([[exception name] isEqualToString:SLTerminalJavaScriptException]) {
-                    exception = [NSException exceptionWithName:SLUIAElementAutomationException
-                                                        reason:[exception reason] userInfo:[exception userInfo]];
-                }
-                actionException = exception;
+            block(UIARepresentation);
+        }
+        @catch (NSException *exception) {
+            // rename JavaScript exceptions to make the context of the exception clear
+            if ([[exception name] isEqualToString:SLTerminalJavaScriptException]) {
+                exception = [NSException exceptionWithName:SLUIAElementAutomationException
+                                                    reason:[exception reason] userInfo:[exception userInfo]];
             }
-        }];
+            actionException = exception;
+        }
+
+        // unbind the path before retrying, so that the retry resolves a fresh path
+        [accessibilityPath unbindPath];
 
         // In certain circumstances (e.g. during animations, when the view hierarchy is undergoing rapid modification)
         // it's possible for Subliminal to identify a valid and tappable element, only for that element to have
         // been replaced in the accessibility hierarchy by the time that UIAutomation goes to manipulate the element.
         // This results in UIAutomation raising an exception about the element not being tappable
-        // --despite Subliminal's tappability check having succeeded. If this occurs and time remains, we retry.
+        // --despite Subliminal's tappability check having succeeded. If this occurs and time remains,
+        // we wait for the UI to settle and then retry.
         automationRaisedTappabilityException =  [[actionException name] isEqualToString:SLUIAElementAutomationException] &&
                                                 [[actionException reason] hasSuffix:@"could not be tapped"];
+        if (didCheckTappability && automationRaisedTappabilityException && (remainingTimeout > 0)) {
+            NSDate *quiescenceWaitStart = [NSDate date];
+            (void)SLWaitForUIQuiescence(remainingTimeout);
+            remainingTimeout -= [[NSDate date] timeIntervalSinceDate:quiescenceWaitStart];
+        }
     } while (didCheckTappability && automationRaisedTappabilityException && (remainingTimeout > 0));
     if (actionException) @throw actionException;
 }
@@ -291,12 +327,22 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
     NSParameterAssert(block);
 
     __block NSTimeInterval remainingTimeout = timeout;
-    NSException *__block examinationException;
+    BOOL __block didExamineObject;
     do {
-        examinationException = nil;
+        didExamineObject = NO;
 
+        // resolve the path and examine its destination within a single dispatch to the main queue
         NSDate *resolutionStart = [NSDate date];
-        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:remainingTimeout];
+        SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:remainingTimeout
+                                                      thenPerformBlockOnMainThread:^(SLAccessibilityPath *path) {
+            // It's possible, if unlikely, that the matching object could have dropped
+            // out of scope between the path's construction and its examination here
+            NSObject *lastPathComponent = [path lastPathComponent];
+            if (lastPathComponent) {
+                block(lastPathComponent);
+                didExamineObject = YES;
+            }
+        }];
         NSTimeInterval resolutionDuration = [[NSDate date] timeIntervalSinceDate:resolutionStart];
         remainingTimeout -= resolutionDuration;
         
@@ -304,31 +350,29 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
             [NSException raise:SLUIAElementInvalidException format:@"Element '%@' does not exist.", self];
         }
 
-        [accessibilityPath examineLastPathComponent:^(NSObject *lastPathComponent) {
-            // It's possible, if unlikely, that the matching object could have dropped
-            // out of scope between the path's construction and its examination here
-            if (!lastPathComponent) {
-                examinationException = [NSException exceptionWithName:SLUIAElementInvalidException
-                                                               reason:[NSString stringWithFormat:@"Element %@ does not exist.", self] userInfo:nil];
-                return;
-            }
-            block(lastPathComponent);
-        }];
-
         // if the matching object dropped out of scope, retry while the timeout has not elapsed
-    } while (examinationException && (remainingTimeout > 0));
-    if (examinationException) @throw examinationException;
+    } while (!didExamineObject && (remainingTimeout > 0));
+    if (!didExamineObject) {
+        [NSException raise:SLUIAElementInvalidException format:@"Element %@ does not exist.", self];
+    }
 }
 
 - (BOOL)isValid {
     // isValid evaluates the current state, no waiting to resolve the element
-    SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:0.0];
-    __block BOOL isValid = (accessibilityPath != nil);
-    if (isValid && self.shouldDoubleCheckValidity) {
-        [accessibilityPath bindPath:^(SLAccessibilityPath *boundPath) {
-            NSString *UIARepresentation = [boundPath UIARepresentation];
+    BOOL shouldDoubleCheckValidity = self.shouldDoubleCheckValidity;
+    NSString *__block UIARepresentation = nil;
+    SLAccessibilityPath *accessibilityPath = [self accessibilityPathWithTimeout:0.0
+                                                  thenPerformBlockOnMainThread:^(SLAccessibilityPath *path) {
+        if (shouldDoubleCheckValidity) UIARepresentation = [path bindPathAndReturnUIARepresentation];
+    }];
+    BOOL isValid = (accessibilityPath != nil);
+    if (isValid && shouldDoubleCheckValidity) {
+        @try {
             isValid = [[[SLTerminal sharedTerminal] evalWithFormat:@"%@.isValid()", UIARepresentation] boolValue];
-        }];
+        }
+        @finally {
+            [accessibilityPath unbindPath];
+        }
     }
     return isValid;
 }
@@ -356,12 +400,88 @@ UIAccessibilityTraits SLUIAccessibilityTraitAny = 0;
     } timeout:0.0];
 
     if (isVisible && matchedObjectOfUnknownClass) {
-        isVisible = [super isVisible];
+        isVisible = [self isVisibleToUIAutomation];
     }
 
     return isVisible;
 }
 
+- (CGFloat)visibleFraction {
+    __block CGFloat visibleFraction = 0.0;
+    // like isVisible, visibleFraction evaluates the current state, no waiting to resolve the element
+    [self examineMatchingObject:^(NSObject *object) {
+        visibleFraction = [object slAccessibilityVisibleFraction];
+    } timeout:0.0];
+    return visibleFraction;
+}
+
+// Exposes the superclass' implementation of -isVisible to +visibilityOfElements:.
+- (BOOL)isVisibleToUIAutomation {
+    return [super isVisible];
+}
+
++ (NSArray *)visibilityOfElements:(NSArray *)elements {
+    // Temporarily use UIAutomation to check visibility if the device is in a non-portrait orientation
+    // to work around https://github.com/inkling/Subliminal/issues/135
+    BOOL mustEvaluateIndividually = ([UIDevice currentDevice].orientation != UIDeviceOrientationPortrait);
+
+    NSMutableArray *visibilities = [[NSMutableArray alloc] initWithCapacity:[elements count]];
+    NSMutableIndexSet *batchedIndexes = [[NSMutableIndexSet alloc] init];
+    NSMutableArray *batchedElements = [[NSMutableArray alloc] initWithCapacity:[elements count]];
+    IMP isVisibleIMP = [SLElement instanceMethodForSelector:@selector(isVisible)];
+    [elements enumerateObjectsUsingBlock:^(SLElement *element, NSUInteger idx, BOOL *stop) {
+        NSAssert([element isKindOfClass:[SLElement class]], @"%@ is not an instance of SLElement.", element);
+
+        // filled in below
+        [visibilities addObject:@NO];
+
+        // elements which evaluate their visibility differently must be evaluated individually
+        if (mustEvaluateIndividually || ([element methodForSelector:@selector(isVisible)] != isVisibleIMP)) {
+            visibilities[idx] = @([element isVisible]);
+        } else {
+            [batchedIndexes addIndex:idx];
+            [batchedElements addObject:element];
+        }
+    }];
+    if (![batchedElements count]) return visibilities;
+
+    // Locate the matching objects and determine their visibility within a single dispatch to the main queue.
+    __block SLElement *invalidElement = nil;
+    __block NSArray *batchedVisibilities = nil;
+    NSMutableIndexSet *unknownClassIndexes = [[NSMutableIndexSet alloc] init];
+    SLTimeProfileDispatchSyncToMainQueue(^{
+        NSMutableArray *objects = [[NSMutableArray alloc] initWithCapacity:[batchedElements count]];
+        for (SLElement *element in batchedElements) {
+            NSObject *object = [[element accessibilityPathOnMainThread] lastPathComponent];
+            if (!object) {
+                invalidElement = element;
+                return;
+            }
+            if (![object isKindOfClass:[UIView class]] && ![object isKindOfClass:[UIAccessibilityElement class]]) {
+                [unknownClassIndexes addIndex:[objects count]];
+            }
+            [objects addObject:object];
+        }
+        batchedVisibilities = [NSObject slAccessibilityVisibilityOfObjects:objects];
+    });
+
+    if (invalidElement) {
+        [NSException raise:SLUIAElementInvalidException format:@"Element '%@' does not exist.", invalidElement];
+    }
+
+    __block NSUInteger batchedIndex = 0;
+    [batchedIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        BOOL isVisible = [batchedVisibilities[batchedIndex] boolValue];
+        if (isVisible && [unknownClassIndexes containsIndex:batchedIndex]) {
+            isVisible = [batchedElements[batchedIndex] isVisibleToUIAutomation];
+        }
+        visibilities[idx] = @(isVisible);
+        batchedIndex++;
+    }];
+
+    return visibilities;
+}
+
 #pragma mark -
 
 - (void)tapAtActivationPoint {
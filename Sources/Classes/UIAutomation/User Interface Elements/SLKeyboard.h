@@ -23,6 +23,31 @@
 #import "SLStaticElement.h"
 #import "SLButton.h"
 
+/**
+ The strategies by which `SLTextField`, `SLTextView`, and related classes
+ may enter text using the standard keyboard (`SLKeyboard`).
+
+ Whatever the strategy, the element's value is verified once text has been entered.
+ If the value does not match the text (e.g. because the keyboard mistyped a character),
+ a warning is logged, and--unless the text was typed using `SLTextEntryStrategyPerCharacter`,
+ whose keystrokes are left as typed--the value is set directly, as by `SLTextEntryStrategySetValue`.
+ The values of secure text fields cannot be verified.
+ */
+typedef NS_ENUM(NSInteger, SLTextEntryStrategy) {
+    /// Text is typed one character at a time, to work around bugs in `UIAKeyboard.typeString`
+    /// which cause longer strings to be mistyped. This is the most reliable means of typing,
+    /// but takes about a tenth of a second per character.
+    SLTextEntryStrategyPerCharacter,
+    /// Text is typed several characters at a time, the element's value being checked
+    /// once all chunks have been typed. If the text was mistyped, it is cleared and typed again
+    /// one character at a time.
+    SLTextEntryStrategyChunked,
+    /// The element is focused, as if to type, but its value is then set directly
+    /// rather than typed. This is the fastest strategy, for use when the fidelity
+    /// of individual keystrokes does not matter, e.g. when entering bulk data.
+    SLTextEntryStrategySetValue
+};
+
 /**
  The `SLKeyboard` protocol declares a standard way to interact with your application's
  input views, such as the standard keyboard (the `SLKeyboard` class) as well as
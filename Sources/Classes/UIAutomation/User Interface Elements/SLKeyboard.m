@@ -22,6 +22,26 @@
 
 #import "SLKeyboard.h"
 #import "SLUIAElement+Subclassing.h"
+#import "SLKeyboard+Internal.h"
+
+/*
+ The following bugs prevent `UIAKeyboard.typeString` from working correctly:
+
+    *   in versions of iOS prior to 6.0, the function throws an exception
+        when asked to type strings longer than one character
+    *   on iOS 7, certain characters are mistyped--incorrectly capitalized, skipped entirely,
+        or reported as not tappable
+
+ We work around these by sending a separate `typeString` message
+ for each character of the string to be typed.
+ */
+static BOOL SLKeyboardShouldTypeCharacterByCharacter(void) {
+    return !((kCFCoreFoundationVersionNumber > kCFCoreFoundationVersionNumber_iOS_5_1) &&
+             (kCFCoreFoundationVersionNumber <= kCFCoreFoundationVersionNumber_iOS_6_1));
+}
+
+/// The number of characters typed at once by `SLTextEntryStrategyChunked`.
+static const NSUInteger kSLKeyboardChunkLength = 8;
 
 @implementation SLKeyboard
 
@@ -30,20 +50,8 @@
 }
 
 - (void)typeString:(NSString *)string {
-    /*
-     The following bugs prevent `UIAKeyboard.typeString` from working correctly:
-     
-        *   in versions of iOS prior to 6.0, the function throws an exception
-            when asked to type strings longer than one character
-        *   on iOS 7, certain characters are mistyped--incorrectly capitalized, skipped entirely,
-            or reported as not tappable
-
-     We work around these by sending a separate `typeString` message
-     for each character of the string to be typed.
-     */
     NSString *escapedString = [string slStringByEscapingForJavaScriptLiteral];
-    if ((kCFCoreFoundationVersionNumber > kCFCoreFoundationVersionNumber_iOS_5_1) &&
-        (kCFCoreFoundationVersionNumber <= kCFCoreFoundationVersionNumber_iOS_6_1)) {
+    if (!SLKeyboardShouldTypeCharacterByCharacter()) {
         [self waitUntilTappable:YES
                 thenSendMessage:@"typeString('%@')", escapedString];
     } else {
@@ -69,6 +77,105 @@
     }
 }
 
+- (void)replaceTextOfElement:(SLUIAElement *)element withString:(NSString *)string strategy:(SLTextEntryStrategy)strategy {
+    NSString *strategyName;
+    switch (strategy) {
+        case SLTextEntryStrategyPerCharacter:
+            strategyName = @"'perCharacter'";
+            break;
+        case SLTextEntryStrategyChunked:
+            strategyName = @"'chunked'";
+            break;
+        case SLTextEntryStrategySetValue:
+            strategyName = @"'setValue'";
+            break;
+    }
+    NSString *quotedString = [NSString stringWithFormat:@"'%@'", [string slStringByEscapingForJavaScriptLiteral]];
+    NSString *chunkLength = [NSString stringWithFormat:@"%lu", (unsigned long)kSLKeyboardChunkLength];
+    NSString *typeCharacterByCharacter = (SLKeyboardShouldTypeCharacterByCharacter() ? @"true" : @"false");
+    NSString *checkKeyboardTappability = ([self canDetermineTappability] ? @"true" : @"false");
+    NSString *retryDelay = [NSString stringWithFormat:@"%g", SLUIAElementWaitRetryDelay];
+    NSString *keyboardTimeout = [NSString stringWithFormat:@"%g", [[self class] defaultTimeout]];
+
+    __block NSString *warning = nil;
+    [element waitUntilTappable:YES thenPerformActionWithUIARepresentation:^(NSString *UIARepresentation) {
+        // Tap to show the keyboard (if the element doesn't already have keyboard focus,
+        // because in that case a real user would probably not tap again before typing),
+        // clear any current text, then enter and verify the new text--all within JavaScript,
+        // for improved performance. Failures to tap or clear the element propagate; a failure
+        // to type falls back on `setValue` and returns a warning, as `-typeString:withSetValueFallbackUsingElement:` would.
+        // A value that doesn't match the text entered also falls back on `setValue`, except that
+        // text typed character-by-character is left as typed (as it was before strategies were introduced)
+        // and only warned about. The values of secure text fields are masked, so cannot be verified.
+        NSString *canVerifyValue = [NSString stringWithFormat:@"(%@.toString().indexOf('UIASecureTextField') < 0)", UIARepresentation];
+        warning = [[SLTerminal sharedTerminal] evalFunctionWithName:@"SLKeyboardReplaceText"
+                                                                    params:@[ @"element", @"keyboard", @"string", @"strategy",
+                                                                              @"chunkLength", @"typeCharacterByCharacter",
+                                                                              @"checkKeyboardTappability", @"canVerifyValue",
+                                                                              @"retryDelay", @"keyboardTimeout" ]
+                                                                      body:@"if (!element.hasKeyboardFocus()) element.tap();\
+                                                                             element.setValue('');\
+                                                                             \
+                                                                             var typeCharacters = function(text) {\
+                                                                                 for (var i = 0; i < text.length; i++) {\
+                                                                                     keyboard.typeString(text[i]);\
+                                                                                 }\
+                                                                             };\
+                                                                             if (strategy === 'setValue') {\
+                                                                                 element.setValue(string);\
+                                                                             } else {\
+                                                                                 try {\
+                                                                                     var startTime = (Date.now() / 1000);\
+                                                                                     while (!(keyboard.isValid() &&\
+                                                                                              (!checkKeyboardTappability || (keyboard.hitpoint() != null)))) {\
+                                                                                         if (((Date.now() / 1000) - startTime) >= keyboardTimeout) {\
+                                                                                             throw 'The keyboard does not exist or is not tappable.';\
+                                                                                         }\
+                                                                                         UIATarget.localTarget().delay(retryDelay);\
+                                                                                     }\
+                                                                                     if (strategy === 'chunked') {\
+                                                                                         var chunksWereTyped = true;\
+                                                                                         try {\
+                                                                                             for (var i = 0; i < string.length; i += chunkLength) {\
+                                                                                                 keyboard.typeString(string.substr(i, chunkLength));\
+                                                                                             }\
+                                                                                         } catch (e) {\
+                                                                                             chunksWereTyped = false;\
+                                                                                         }\
+                                                                                         if (!chunksWereTyped || (canVerifyValue && (element.value() != string))) {\
+                                                                                             element.setValue('');\
+                                                                                             typeCharacters(string);\
+                                                                                         }\
+                                                                                     } else if (typeCharacterByCharacter) {\
+                                                                                         typeCharacters(string);\
+                                                                                     } else {\
+                                                                                         keyboard.typeString(string);\
+                                                                                     }\
+                                                                                 } catch (e) {\
+                                                                                     element.setValue(string);\
+                                                                                     return ('fell back on UIAElement.setValue due to an exception in UIAKeyboard.typeString: ' + e);\
+                                                                                 }\
+                                                                             }\
+                                                                             \
+                                                                             if (canVerifyValue && string.length && (element.value() != string)) {\
+                                                                                 if (strategy === 'perCharacter') {\
+                                                                                     return 'has a value which does not match the text typed.';\
+                                                                                 }\
+                                                                                 element.setValue(string);\
+                                                                                 return 'fell back on UIAElement.setValue because the value of the element did not match the text entered.';\
+                                                                             }\
+                                                                             return '';"
+                                                                  withArgs:@[ UIARepresentation, _UIARepresentation, quotedString, strategyName,
+                                                                              chunkLength, typeCharacterByCharacter,
+                                                                              checkKeyboardTappability, canVerifyValue,
+                                                                              retryDelay, keyboardTimeout ]];
+    } timeout:[[element class] defaultTimeout]];
+
+    if ([warning length]) {
+        [[SLLogger sharedLogger] logWarning:[NSString stringWithFormat:@"%@ %@", element, warning]];
+    }
+}
+
 - (void)hide
 {
     [[SLKeyboardKey elementWithAccessibilityLabel:(@"Hide keyboard")] tap];
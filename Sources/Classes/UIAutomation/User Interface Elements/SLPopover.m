@@ -22,6 +22,7 @@
 
 #import "SLPopover.h"
 #import "SLUIAElement+Subclassing.h"
+#import "SLUIQuiescence.h"
 
 @implementation SLPopover
 
@@ -40,7 +41,7 @@
     [self waitUntilTappable:NO thenSendMessage:@"dismiss()"];
 
     // wait for the dismissal animation to finish
-    [NSThread sleepForTimeInterval:0.5];
+    (void)SLWaitForUIQuiescence([[self class] defaultTimeout]);
 }
 
 @end
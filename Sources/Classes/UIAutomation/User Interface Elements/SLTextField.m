@@ -22,6 +22,8 @@
 
 #import "SLTextField.h"
 #import "SLUIAElement+Subclassing.h"
+#import "SLKeyboard+Internal.h"
+#import "SLTimeProfile.h"
 #import <Subliminal/SLTestAssertions.h>
 
 @implementation SLTextField
@@ -38,6 +40,14 @@
 {
     SLAssertTrueWithTimeout([self isValid], [SLElement defaultTimeout], @"Element '%@' does not exist", self);
 
+    // The standard keyboard can focus, clear, and type into the element in a single round trip to UIAutomation
+    // --as can any keyboard if the text is to be set rather than typed.
+    if ([keyboard isMemberOfClass:[SLKeyboard class]] || (self.textEntryStrategy == SLTextEntryStrategySetValue)) {
+        SLKeyboard *standardKeyboard = ([keyboard isMemberOfClass:[SLKeyboard class]] ? (SLKeyboard *)keyboard : [SLKeyboard keyboard]);
+        [standardKeyboard replaceTextOfElement:self withString:text strategy:self.textEntryStrategy];
+        return;
+    }
+
     // Tap to show the keyboard (if the field doesn't already have keyboard focus,
     // because in that case a real user would probably not tap again before typing)
     if (![self hasKeyboardFocus]) {
@@ -116,7 +126,7 @@
     if ([[self text] length]) {
         // If the field newly became first responder, we must delay for a second or `setValue('')` won't have an effect.
         if (didNewlyBecomeFirstResponder) {
-            [NSThread sleepForTimeInterval:1.0];
+            SLTimeProfileSleep(1.0);
         }
         [self waitUntilTappable:YES thenSendMessage:@"setValue(' ')"];
         [[SLKeyboardKey elementWithAccessibilityLabel:@"Delete"] tap];
@@ -50,6 +50,19 @@
  */
 @property (nonatomic) id<SLKeyboard> defaultKeyboard;
 
+/**
+ The strategy by which `-setText:` and `-setText:withKeyboard:` enter text
+ when using the standard keyboard.
+
+ Tests may use a faster strategy than the default to enter long strings,
+ e.g. `SLTextEntryStrategySetValue` for bulk data such as addresses.
+ `SLTextEntryStrategySetValue` is also used with custom keyboards;
+ the other strategies only with the standard keyboard.
+
+ Defaults to `SLTextEntryStrategyPerCharacter`.
+ */
+@property (nonatomic) SLTextEntryStrategy textEntryStrategy;
+
 @end
 
 
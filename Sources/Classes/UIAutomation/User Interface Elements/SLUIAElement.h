@@ -421,6 +421,26 @@
 
 - (void)captureScreenshotWithFilename:(NSString *)filename;
 
+/**
+ Determines whether a screenshot of the specified element matches a reference screenshot.
+
+ See `-[SLDevice screenshotInRect:matchesReferenceNamed:tolerance:failureReason:]`
+ for how the screenshot is captured and compared. `SLAssertScreenshotMatches`
+ may be used to fail a test case if the screenshot does not match.
+
+ @param referenceName The name of the reference screenshot, without the ".png" extension.
+ @param tolerance The greatest score at which the screenshot matches the reference,
+ from `0.0` to `1.0`.
+ @param failureReason If this method returns `NO`, and this parameter is not `NULL`,
+ on return, a description of why the screenshot does not match.
+ @return `YES` if the screenshot matches the reference, otherwise `NO`.
+
+ @exception SLUIAElementInvalidException Raised if the element is not valid
+ by the end of the [default timeout](+defaultTimeout).
+ */
+- (BOOL)matchesReferenceScreenshotNamed:(NSString *)referenceName tolerance:(double)tolerance
+                          failureReason:(NSString **)failureReason;
+
 @end
 
 
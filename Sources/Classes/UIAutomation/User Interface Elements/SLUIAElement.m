@@ -234,12 +234,25 @@ static const void *const kDefaultTimeoutKey = &kDefaultTimeoutKey;
     if (!filename) {
         filename = @"element_screenshot";
     }
-    if (CGRectIsNull(self.rect)) {
+    // resolve the element's rect only once--each evaluation requires a round trip to UIAutomation
+    CGRect rect = self.rect;
+    if (CGRectIsNull(rect)) {
         NSString *warningString = [NSString stringWithFormat:@"Could not take screenshot with filename %@: Could not determine element's position on-screen.", filename];
         [[SLLogger sharedLogger] logWarning:warningString];
         return;
     }
-    [[SLDevice currentDevice] captureScreenshotWithFilename:filename inRect:self.rect];
+    [[SLDevice currentDevice] captureScreenshotWithFilename:filename inRect:rect];
+}
+
+- (BOOL)matchesReferenceScreenshotNamed:(NSString *)referenceName tolerance:(double)tolerance
+                          failureReason:(NSString *__autoreleasing *)failureReason {
+    CGRect rect = self.rect;
+    if (CGRectIsNull(rect)) {
+        if (failureReason) *failureReason = @"Could not determine the element's position on-screen.";
+        return NO;
+    }
+    return [[SLDevice currentDevice] screenshotInRect:rect matchesReferenceNamed:referenceName
+                                            tolerance:tolerance failureReason:failureReason];
 }
 
 @end
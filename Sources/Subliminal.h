@@ -26,6 +26,7 @@
 #import "SLTestAssertions.h"
 
 #import "SLDevice.h"
+#import "SLUIQuiescence.h"
 #import "SLElement.h"
 #import "NSObject+SLAccessibilityDescription.h"
 #import "NSObject+SLAccessibilityHierarchy.h"
@@ -0,0 +1,137 @@
+//
+//  SIEventLogMergerTests.m
+//  subliminal-instrument
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SIEventLogMerger.h"
+#import "SISLLogEvents.h"
+
+@interface SIEventLogMergerTests : SenTestCase
+@end
+
+@implementation SIEventLogMergerTests {
+    NSString *_logDirectory;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    _logDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSProcessInfo processInfo] globallyUniqueString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:_logDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_logDirectory error:NULL];
+
+    [super tearDown];
+}
+
+- (NSString *)writeLogNamed:(NSString *)name withLines:(NSArray *)lines {
+    NSString *path = [_logDirectory stringByAppendingPathComponent:name];
+    NSString *header = @"{\"type\":\"logStarted\",\"version\":1,\"timestamp\":100.0,\"date\":1390000000.0}";
+    NSString *log = [[@[ header ] arrayByAddingObjectsFromArray:lines] componentsJoinedByString:@"\n"];
+    [[log stringByAppendingString:@"\n"] writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    return path;
+}
+
+- (NSString *)writeShardLogNamed:(NSString *)name withTest:(NSString *)test failed:(BOOL)failed duration:(NSTimeInterval)duration {
+    return [self writeLogNamed:name withLines:@[
+        @"{\"type\":\"testingStarted\",\"timestamp\":100.0,\"message\":\"Testing started.\"}",
+        [NSString stringWithFormat:@"{\"type\":\"testStarted\",\"timestamp\":100.0,\"test\":\"%@\",\"message\":\"Test \\\"%@\\\" started.\"}", test, test],
+        [NSString stringWithFormat:@"{\"type\":\"testFinished\",\"timestamp\":101.0,\"test\":\"%@\",\"numCasesExecuted\":1,\"numCasesFailed\":%d,"
+                                   @"\"numCasesFailedUnexpectedly\":0,\"duration\":1.0,\"message\":\"Test \\\"%@\\\" finished.\"}", test, failed, test],
+        [NSString stringWithFormat:@"{\"type\":\"testingFinished\",\"timestamp\":%f,\"numTestsExecuted\":1,\"numTestsFailed\":%d,"
+                                   @"\"duration\":%f,\"message\":\"Testing finished.\"}", 100.0 + duration, failed, duration]
+    ]];
+}
+
+- (NSArray *)eventsMergedFromLogsAtPaths:(NSArray *)paths merger:(SIEventLogMerger *__autoreleasing *)merger {
+    NSMutableArray *events = [[NSMutableArray alloc] init];
+    SIEventLogMerger *logMerger = [[SIEventLogMerger alloc] initWithPaths:paths];
+    [logMerger mergeWithEventHandler:^(NSDictionary *event) {
+        [events addObject:event];
+    }];
+    if (merger) *merger = logMerger;
+    return [events copy];
+}
+
+- (NSArray *)eventsOfSubtype:(SISLLogEventSubtype)subtype inEvents:(NSArray *)events {
+    return [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type == %@ AND subtype == %@",
+                                                @(SISLLogEventTypeTestStatus), @(subtype)]];
+}
+
+- (void)testMergedLogsReportTestingStartedAndFinishedOnce {
+    NSArray *paths = @[
+        [self writeShardLogNamed:@"Shard 0.jsonl" withTest:@"FooTest" failed:NO duration:10.0],
+        [self writeShardLogNamed:@"Shard 1.jsonl" withTest:@"BarTest" failed:NO duration:20.0]
+    ];
+    SIEventLogMerger *merger = nil;
+    NSArray *events = [self eventsMergedFromLogsAtPaths:paths merger:&merger];
+
+    STAssertTrue([[self eventsOfSubtype:SISLLogEventSubtypeTestingStarted inEvents:events] count] == 1,
+                 @"Testing should have been reported to have started once.");
+    STAssertEqualObjects([[self eventsOfSubtype:SISLLogEventSubtypeTestStarted inEvents:events] valueForKeyPath:@"info.test"],
+                         (@[ @"FooTest", @"BarTest" ]), @"The tests of each log should have been reported in turn.");
+
+    NSArray *testingFinishedEvents = [self eventsOfSubtype:SISLLogEventSubtypeTestingFinished inEvents:events];
+    STAssertTrue([testingFinishedEvents count] == 1, @"Testing should have been reported to have finished once.");
+    STAssertEqualObjects([testingFinishedEvents lastObject], [events lastObject], @"Testing should have been reported to have finished last.");
+
+    NSDictionary *info = [testingFinishedEvents lastObject][@"info"];
+    STAssertEqualObjects(info[@"numTestsExecuted"], @2, @"The tests executed by each log should have been totaled.");
+    STAssertEqualObjects(info[@"numTestsFailed"], @0, @"The tests failed by each log should have been totaled.");
+    STAssertEqualObjects(info[@"duration"], @20.0, @"The duration should have been that of the longest-running log.");
+    STAssertEqualObjects([testingFinishedEvents lastObject][@"message"], @"Testing finished: executed 2 tests, with 0 failures.", @"");
+    STAssertTrue(merger.succeeded, @"The merge should have succeeded.");
+}
+
+- (void)testMergeFailsIfATestFailed {
+    NSArray *paths = @[
+        [self writeShardLogNamed:@"Shard 0.jsonl" withTest:@"FooTest" failed:NO duration:10.0],
+        [self writeShardLogNamed:@"Shard 1.jsonl" withTest:@"BarTest" failed:YES duration:20.0]
+    ];
+    SIEventLogMerger *merger = nil;
+    NSArray *events = [self eventsMergedFromLogsAtPaths:paths merger:&merger];
+
+    STAssertEqualObjects([events lastObject][@"info"][@"numTestsFailed"], @1, @"The tests failed by each log should have been totaled.");
+    STAssertFalse(merger.succeeded, @"The merge should have failed because a test failed.");
+}
+
+- (void)testMissingAndUnfinishedLogsAreReportedAsErrors {
+    NSArray *paths = @[
+        [self writeShardLogNamed:@"Shard 0.jsonl" withTest:@"FooTest" failed:NO duration:10.0],
+        [self writeLogNamed:@"Shard 1.jsonl" withLines:@[ @"{\"type\":\"testingStarted\",\"timestamp\":100.0,\"message\":\"Testing started.\"}" ]],
+        [_logDirectory stringByAppendingPathComponent:@"Shard 2.jsonl"]
+    ];
+    SIEventLogMerger *merger = nil;
+    NSArray *events = [self eventsMergedFromLogsAtPaths:paths merger:&merger];
+
+    NSArray *errorEvents = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type == %@", @(SISLLogEventTypeError)]];
+    STAssertTrue([errorEvents count] == 2, @"The unfinished and missing logs should have been reported as errors.");
+    STAssertTrue([[errorEvents[0] objectForKey:@"message"] rangeOfString:@"Shard 1.jsonl"].location != NSNotFound,
+                 @"The unfinished log should have been reported.");
+    STAssertTrue([[errorEvents[1] objectForKey:@"message"] rangeOfString:@"Shard 2.jsonl"].location != NSNotFound,
+                 @"The missing log should have been reported.");
+    STAssertFalse(merger.succeeded, @"The merge should have failed because logs were missing or unfinished.");
+}
+
+@end
@@ -23,15 +23,28 @@
  This `UIALogger` is a mock version of the `UIALogger` class that is part of
  the UIAutomation framework. It is designed to format messages as the real
  `UIALogger` does and then return the formatted messages to its caller.
+
+ Because `SLLogger` may log several messages in one script, the messages
+ are also recorded, to be retrieved using `_takeMessages`.
  */
 UIALogger = {
+	_messages: [],
+
+	_takeMessages: function() {
+		var messages = this._messages;
+		this._messages = [];
+		return messages;
+	},
+
 	_timestamp: function() {
 		// A sample timestamp of the form logged by UIAutomation.
 		return "2014-01-16 00:00:23 +0000";
 	},
 
 	_primitiveLog: function(messageType, message) {
-		return this._timestamp() + " " + messageType + ": " + message;
+		var formattedMessage = this._timestamp() + " " + messageType + ": " + message;
+		this._messages.push(formattedMessage);
+		return formattedMessage;
 	},
 
 	logDebug: function(message) {
@@ -94,9 +94,9 @@ static SILoggingTerminal *__sharedTerminal = nil;
 #pragma mark - Evaluation
 
 // This method is called when the real `SLTerminal` is asked to evaluate a script,
-// i.e. when `SLLogger` tries to log a message to UIAutomation.
-// We evaluate the message in our own context, using a simplified version of
-// UIAutomation's logger, and make it available to our client.
+// i.e. when `SLLogger` tries to log one or more messages to UIAutomation.
+// We evaluate the messages in our own context, using a simplified version of
+// UIAutomation's logger, and make them available to our client.
 - (id)eval:(NSString *)script {
     NSParameterAssert(script);
 
@@ -107,19 +107,29 @@ static SILoggingTerminal *__sharedTerminal = nil;
     JSStringRelease(jsScript);
     NSAssert(jsResult, @"\"%@\" threw an exception when evaluated.", script);
 
-    JSStringRef jsResultString = JSValueToStringCopy(_loggingContext, jsResult, NULL);
-    NSAssert(jsResultString, @"Could not convert the result of evaluating \"%@\" to a string.", script);
-
-    NSString *message = CFBridgingRelease(JSStringCopyCFString(kCFAllocatorDefault, jsResultString));
-    JSStringRelease(jsResultString);
-    NSAssert([message length], @"Either a `nil` message was logged, or our script returned `nil`.");
-
-    NSDictionary *messageLoggedInfo = @{
-        SILoggingTerminalMessageUserInfoKey: message
-    };
-    [[NSNotificationCenter defaultCenter] postNotificationName:SILoggingTerminalMessageLoggedNotification
-                                                        object:self
-                                                      userInfo:messageLoggedInfo];
+    // retrieve the messages logged by the script, as a JSON array
+    JSStringRef jsMessagesScript = JSStringCreateWithUTF8CString("JSON.stringify(UIALogger._takeMessages());");
+    JSValueRef jsMessages = JSEvaluateScript(_loggingContext, jsMessagesScript, NULL, NULL, 0, NULL);
+    JSStringRelease(jsMessagesScript);
+    NSAssert(jsMessages, @"Could not retrieve the messages logged by \"%@\".", script);
+
+    JSStringRef jsMessagesString = JSValueToStringCopy(_loggingContext, jsMessages, NULL);
+    NSAssert(jsMessagesString, @"Could not convert the messages logged by \"%@\" to a string.", script);
+
+    NSString *messagesJSON = CFBridgingRelease(JSStringCopyCFString(kCFAllocatorDefault, jsMessagesString));
+    JSStringRelease(jsMessagesString);
+    NSArray *messages = [NSJSONSerialization JSONObjectWithData:[messagesJSON dataUsingEncoding:NSUTF8StringEncoding]
+                                                        options:0 error:NULL];
+    NSAssert([messages count], @"Either no message was logged by \"%@\", or our script did not record it.", script);
+
+    for (NSString *message in messages) {
+        NSDictionary *messageLoggedInfo = @{
+            SILoggingTerminalMessageUserInfoKey: message
+        };
+        [[NSNotificationCenter defaultCenter] postNotificationName:SILoggingTerminalMessageLoggedNotification
+                                                            object:self
+                                                          userInfo:messageLoggedInfo];
+    }
 
     // `-[SLTerminal eval:]` is expected to return the result of evaluation.
     // UIAutomation's logging functions return `undefined`, so we return `nil`.
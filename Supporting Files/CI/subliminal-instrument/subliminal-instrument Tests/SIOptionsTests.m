@@ -58,6 +58,43 @@
                          @"Instruments arguments were not parsed as expected.");
 }
 
+- (void)testEventLogOptionSetsAbsoluteEventLogPath {
+    SIOptions *options = [self optionsFrom:@[ @"--event-log", @"Events.jsonl", @"Integration Tests.app" ]];
+
+    NSString *expectedPath = [[[NSFileManager defaultManager] currentDirectoryPath] stringByAppendingPathComponent:@"Events.jsonl"];
+    STAssertEqualObjects([options eventLogPath], [expectedPath stringByStandardizingPath],
+                         @"The event log path was not parsed as expected.");
+    STAssertEqualObjects([options instrumentsArguments], @[ @"Integration Tests.app" ],
+                         @"The event log option should not have been passed to `instruments`.");
+}
+
+- (void)testEventLogOptionRequiresPath {
+    STAssertThrows([self optionsFrom:@[ @"--event-log" ]],
+                   @"Options parsing should reject the event log option if no path is specified.");
+}
+
+- (void)testMergeEventLogsOptionSetsAbsoluteEventLogPaths {
+    SIOptions *options = [self optionsFrom:@[ @"--merge-event-logs", @"Shard 0.jsonl", @"/tmp/Shard 1.jsonl" ]];
+
+    NSString *expectedRelativePath = [[[NSFileManager defaultManager] currentDirectoryPath] stringByAppendingPathComponent:@"Shard 0.jsonl"];
+    NSArray *expectedPaths = @[ [expectedRelativePath stringByStandardizingPath], [@"/tmp/Shard 1.jsonl" stringByStandardizingPath] ];
+    STAssertEqualObjects([options eventLogPathsToMerge], expectedPaths,
+                         @"The paths of the event logs to merge were not parsed as expected.");
+    STAssertFalse([[options instrumentsArguments] count], @"The paths should not have been passed to `instruments`.");
+}
+
+- (void)testMergeEventLogsOptionRequiresPaths {
+    STAssertThrows([self optionsFrom:@[ @"--merge-event-logs" ]],
+                   @"Options parsing should reject the merge option if no paths are specified.");
+}
+
+- (void)testMergeEventLogsOptionProhibitsInstrumentsArguments {
+    STAssertThrows([self optionsFrom:@[ @"Integration Tests.app", @"--merge-event-logs", @"Shard 0.jsonl" ]],
+                   @"Options parsing should reject arguments to `instruments` when merging event logs.");
+    STAssertThrows([self optionsFrom:@[ @"--event-log", @"Events.jsonl", @"--merge-event-logs", @"Shard 0.jsonl" ]],
+                   @"Options parsing should reject the event log option when merging event logs.");
+}
+
 - (void)testTemplateOptionIsProhibited {
     STAssertThrows([self optionsFrom:(@[ @"-t", @"foo.tracetemplate" ])],
                    @"Options parsing should reject the template option.");
@@ -128,6 +128,7 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                                                          info:nil
                                                       message:message];
     [[SLLogger sharedLogger] logMessage:message];
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(expectedEvent, _lastEvent, @"");
 }
 
@@ -138,6 +139,7 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                                                          info:nil
                                                       message:message];
     [[SLLogger sharedLogger] logDebug:message];
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(expectedEvent, _lastEvent, @"");
 }
 
@@ -369,6 +371,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
     STAssertEqualObjects(_lastEvent[@"info"][@"test"], test, @"Test start message did not carry test name.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"test"], test, @"Intra-test message did not carry test name.");
 
     [[SLLogger sharedLogger] logTestFinish:test withNumCasesExecuted:0 numCasesFailed:0 numCasesFailedUnexpectedly:0];
@@ -376,6 +380,7 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
 
     // sanity check
     [[SLLogger sharedLogger] logMessage:@"foo"];
+    [[SLLogger sharedLogger] flush];
     STAssertNil(_lastEvent[@"info"][@"test"], @"");
 }
 
@@ -385,6 +390,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
     STAssertEqualObjects(_lastEvent[@"info"][@"test"], test, @"Test start message did not carry test name.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"test"], test, @"Intra-test message did not carry test name.");
 
     [[SLLogger sharedLogger] logTestAbort:test];
@@ -392,6 +399,7 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
 
     // sanity check
     [[SLLogger sharedLogger] logMessage:@"foo"];
+    [[SLLogger sharedLogger] flush];
     STAssertNil(_lastEvent[@"info"][@"test"], @"");
 }
 
@@ -402,6 +410,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
     STAssertNil(_lastEvent[@"info"][@"testCase"], @"No test case, nor set-up, has yet begun.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"testCase"], @"setUpTest",
                          @"Message before test case start was not reported as in test set-up.");
 }
@@ -415,6 +425,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
     [[SLLogger sharedLogger] logTest:test casePass:testCase];
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"testCase"], @"tearDownTest",
                          @"Message after test case finish was not reported as in test tear-down.");
 
@@ -433,6 +445,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                          @"Test case start message did not carry test case name.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"testCase"], testCase,
                          @"Intra- test case message did not carry test case name.");
 
@@ -451,6 +465,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                          @"Test case start message did not carry test case name.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"testCase"], testCase,
                          @"Intra- test case message did not carry test case name.");
 
@@ -469,6 +485,8 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                          @"Test case start message did not carry test case name.");
 
     [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[SLLogger sharedLogger] flush];
     STAssertEqualObjects(_lastEvent[@"info"][@"testCase"], testCase,
                          @"Intra- test case message did not carry test case name.");
 
@@ -477,4 +495,71 @@ static NSTimeInterval kSampleTimeInterval = 413758794.502608;
                          @"Test case pass message did not carry test name.");
 }
 
+#pragma mark -Parsing Event Logs
+
+// Returns an event log line declaring that the log was started at the sample date, at the specified (monotonic) timestamp.
++ (NSString *)eventLogHeaderWithTimestamp:(NSTimeInterval)timestamp {
+    NSTimeInterval sampleDate = kSampleTimeInterval + NSTimeIntervalSince1970;
+    return [NSString stringWithFormat:@"{\"type\":\"logStarted\",\"version\":1,\"timestamp\":%f,\"date\":%f}", timestamp, sampleDate];
+}
+
+- (void)testCanParseEventLogEventWithDuration {
+    NSDictionary *expectedEvent = [[self class] eventWithType:SISLLogEventTypeTestStatus
+                                                      subtype:SISLLogEventSubtypeTestCasePassed
+                                                         info:@{ @"test": @"FooTest", @"testCase": @"testFoo", @"duration": @(1.5) }
+                                                      message:@"Test case \"-[FooTest testFoo]\" passed."];
+
+    [_parser parseEventLogLine:[[self class] eventLogHeaderWithTimestamp:100.0]];
+    STAssertNil(_lastEvent, @"The event log's header should not have been reported as an event.");
+
+    [_parser parseEventLogLine:@"{\"type\":\"testCasePassed\",\"timestamp\":100.0,\"test\":\"FooTest\",\"testCase\":\"testFoo\","
+                               @"\"duration\":1.5,\"message\":\"Test case \\\"-[FooTest testFoo]\\\" passed.\"}"];
+    STAssertEqualObjects(expectedEvent, _lastEvent, @"");
+}
+
+- (void)testCanParseEventLogTestFailure {
+    NSDictionary *expectedEvent = [[self class] eventWithType:SISLLogEventTypeTestStatus
+                                                      subtype:SISLLogEventSubtypeTestFailure
+                                                         info:@{ @"fileName": @"FooTest.m", @"lineNumber": @(62) }
+                                                      message:@"FooTest.m:62: foo"];
+
+    [_parser parseEventLogLine:[[self class] eventLogHeaderWithTimestamp:100.0]];
+    [_parser parseEventLogLine:@"{\"type\":\"failure\",\"timestamp\":100.0,\"fileName\":\"FooTest.m\",\"lineNumber\":62,\"message\":\"FooTest.m:62: foo\"}"];
+    STAssertEqualObjects(expectedEvent, _lastEvent, @"");
+}
+
+- (void)testEventLogEventsAreTimestampedRelativeToHeader {
+    [_parser parseEventLogLine:[[self class] eventLogHeaderWithTimestamp:100.0]];
+    [_parser parseEventLogLine:@"{\"type\":\"message\",\"timestamp\":160.0,\"message\":\"foo\"}"];
+
+    NSDate *expectedDate = [NSDate dateWithTimeIntervalSinceReferenceDate:(kSampleTimeInterval + 60.0)];
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    [formatter setLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"]];
+    [formatter setDateFormat:@"yyyy-MM-dd'T'HH:mm:ssZZZZZ"];
+    STAssertEqualObjects(_lastEvent[@"timestamp"], [formatter stringFromDate:expectedDate],
+                         @"The event should have been timestamped relative to the date at which the log was started.");
+}
+
+- (void)testUnparseableEventLogLineIsReportedAsDefaultEvent {
+    NSString *line = @"{\"type\":\"message\",\"timest";
+    NSDictionary *expectedEvent = [[self class] eventWithType:SISLLogEventTypeDefault
+                                                      subtype:SISLLogEventSubtypeNone
+                                                         info:nil
+                                                      message:line];
+
+    [_parser parseEventLogLine:line];
+    STAssertEqualObjects(expectedEvent, _lastEvent, @"");
+}
+
+- (void)testStdoutLogMessagesAreIgnoredIfSpecified {
+    _parser.ignoresStdoutLogMessages = YES;
+
+    [[SLLogger sharedLogger] logWarning:@"be careful!"];
+    STAssertNil(_lastEvent, @"Messages logged to `stdout` should have been ignored.");
+
+    [_parser parseStderrLine:@"boo"];
+    STAssertEqualObjects(_lastEvent[@"message"], @"boo", @"Messages logged to `stderr` should still have been parsed.");
+}
+
 @end
+
@@ -0,0 +1,67 @@
+//
+//  SIEventLogMerger.h
+//  subliminal-instrument
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Instances of `SIEventLogMerger` combine the event logs (see `SLLogger`) written
+ by several runs of the tests--e.g. by the shards of a run, see
+ `-[SLTestController shardCount]`--into a single series of events,
+ as if the tests had been run by a single application.
+ */
+@interface SIEventLogMerger : NSObject
+
+/**
+ Initializes and returns a newly allocated merger for the event logs at the specified paths.
+
+ @param paths The paths of the event logs to merge.
+
+ @return An initialized merger.
+ */
+- (instancetype)initWithPaths:(NSArray *)paths;
+
+/**
+ Reads the event logs in turn, passing their events to the specified handler.
+
+ The events of each log are passed through unchanged, except that only the first
+ log's testing-started event is passed, and the logs' testing-finished events are
+ replaced by a single event, passed after all the logs have been read, that reports
+ the total number of tests executed and failed across all logs. Its duration
+ is that of the longest-running log, the logs having been written concurrently.
+
+ Logs which cannot be read, or which end before testing finished (e.g. because
+ the application crashed), are reported as events of type `SISLLogEventTypeError`.
+
+ @param eventHandler A block to be invoked with each event.
+ The format of the events is described in `SISLLogEvents.h`.
+ */
+- (void)mergeWithEventHandler:(void (^)(NSDictionary *event))eventHandler;
+
+/**
+ Whether the logs could all be read, and each recorded testing having finished,
+ without any test failing.
+
+ This is undefined until the receiver has merged the logs.
+ */
+@property (nonatomic, readonly) BOOL succeeded;
+
+@end
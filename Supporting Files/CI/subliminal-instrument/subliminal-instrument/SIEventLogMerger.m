@@ -0,0 +1,136 @@
+//
+//  SIEventLogMerger.m
+//  subliminal-instrument
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SIEventLogMerger.h"
+
+#import "SISLLogEvents.h"
+#import "SISLLogParser.h"
+
+@interface SIEventLogMerger () <SISLLogParserDelegate>
+@end
+
+@implementation SIEventLogMerger {
+    NSArray *_paths;
+    void (^_eventHandler)(NSDictionary *);
+
+    BOOL _testingStarted, _currentLogFinishedTesting;
+    NSUInteger _numTestsExecuted, _numTestsFailed;
+    NSTimeInterval _duration;
+    NSString *_latestTimestamp;
+}
+
+- (instancetype)initWithPaths:(NSArray *)paths {
+    NSParameterAssert([paths count]);
+
+    self = [super init];
+    if (self) {
+        _paths = [paths copy];
+    }
+    return self;
+}
+
+- (void)reportError:(NSString *)message withParser:(SISLLogParser *)parser {
+    _succeeded = NO;
+    // parse the message as if written by `instruments` to `stderr`, to produce an error event
+    [parser parseStderrLine:message];
+}
+
+- (void)mergeWithEventHandler:(void (^)(NSDictionary *))eventHandler {
+    NSParameterAssert(eventHandler);
+
+    _eventHandler = [eventHandler copy];
+    _succeeded = YES;
+
+    for (NSString *path in _paths) {
+        @autoreleasepool {
+            // each log needs its own parser, to track the log's start date and the tests in progress
+            SISLLogParser *parser = [[SISLLogParser alloc] init];
+            parser.delegate = self;
+            _currentLogFinishedTesting = NO;
+
+            NSError *readError = nil;
+            NSString *log = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:&readError];
+            if (!log) {
+                [self reportError:[NSString stringWithFormat:@"The event log at \"%@\" could not be read: %@", path, [readError localizedDescription]]
+                       withParser:parser];
+                continue;
+            }
+
+            [log enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+                if ([line length]) [parser parseEventLogLine:line];
+            }];
+
+            if (!_currentLogFinishedTesting) {
+                [self reportError:[NSString stringWithFormat:@"The event log at \"%@\" ends before testing finished.", path]
+                       withParser:parser];
+            }
+        }
+    }
+
+    if (_testingStarted) {
+        NSMutableDictionary *event = [[NSMutableDictionary alloc] initWithDictionary:@{
+            @"type": @(SISLLogEventTypeTestStatus),
+            @"subtype": @(SISLLogEventSubtypeTestingFinished),
+            @"message": [NSString stringWithFormat:@"Testing finished: executed %lu test%@, with %lu failure%@.",
+                                                   (unsigned long)_numTestsExecuted, (_numTestsExecuted == 1 ? @"" : @"s"),
+                                                   (unsigned long)_numTestsFailed, (_numTestsFailed == 1 ? @"" : @"s")],
+            @"info": @{ @"numTestsExecuted": @(_numTestsExecuted), @"numTestsFailed": @(_numTestsFailed), @"duration": @(_duration) }
+        }];
+        if (_latestTimestamp) event[@"timestamp"] = _latestTimestamp;
+        _eventHandler([event copy]);
+    }
+    if (_numTestsFailed) _succeeded = NO;
+
+    _eventHandler = nil;
+}
+
+#pragma mark - SISLLogParserDelegate
+
+- (void)parser:(SISLLogParser *)parser didParseEvent:(NSDictionary *)event {
+    // the timestamps are formatted identically, so sort chronologically
+    NSString *timestamp = event[@"timestamp"];
+    if (!_latestTimestamp || ([timestamp compare:_latestTimestamp] == NSOrderedDescending)) {
+        _latestTimestamp = timestamp;
+    }
+
+    if ([event[@"type"] unsignedIntegerValue] == SISLLogEventTypeTestStatus) {
+        switch ([event[@"subtype"] unsignedIntegerValue]) {
+            case SISLLogEventSubtypeTestingStarted:
+                if (_testingStarted) return;
+                _testingStarted = YES;
+                break;
+
+            case SISLLogEventSubtypeTestingFinished:
+                _currentLogFinishedTesting = YES;
+                _numTestsExecuted += [event[@"info"][@"numTestsExecuted"] unsignedIntegerValue];
+                _numTestsFailed += [event[@"info"][@"numTestsFailed"] unsignedIntegerValue];
+                _duration = MAX(_duration, [event[@"info"][@"duration"] doubleValue]);
+                return;
+
+            default:
+                break;
+        }
+    }
+    _eventHandler(event);
+}
+
+@end
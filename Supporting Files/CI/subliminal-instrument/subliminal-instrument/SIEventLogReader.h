@@ -0,0 +1,67 @@
+//
+//  SIEventLogReader.h
+//  subliminal-instrument
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Instances of `SIEventLogReader` read the lines of an event log
+ (see `SLLogger`) as they are written by the application under test.
+ */
+@interface SIEventLogReader : NSObject
+
+/**
+ Initializes and returns a newly allocated reader for the event log at the specified path.
+
+ The log need not exist when the reader is initialized, or when it begins reading.
+
+ @param path The path of the event log.
+ @param lineHandler A block to be invoked with each line of the log
+ (excluding the newline character), on a private serial queue.
+
+ @return An initialized reader.
+ */
+- (instancetype)initWithPath:(NSString *)path lineHandler:(void (^)(NSString *line))lineHandler;
+
+/**
+ Begins reading the event log, periodically polling the log for new lines.
+ */
+- (void)beginReading;
+
+/**
+ Reads any lines remaining in the event log and stops reading.
+
+ If the log ends with a partial line (e.g. because the application was terminated
+ while writing the line), that line will also be passed to the line handler.
+
+ This method blocks until all lines have been passed to the line handler.
+ */
+- (void)finishReading;
+
+/**
+ Whether the reader has found the event log.
+
+ If this is `NO` after the reader has finished reading, the application under test
+ did not write the log (for instance, because it was not running in the Simulator).
+ */
+@property (nonatomic, readonly) BOOL foundLog;
+
+@end
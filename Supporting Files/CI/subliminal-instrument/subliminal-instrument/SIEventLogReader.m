@@ -0,0 +1,115 @@
+//
+//  SIEventLogReader.m
+//  subliminal-instrument
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SIEventLogReader.h"
+
+/// The interval at which the reader polls the event log for new lines.
+static const NSTimeInterval kPollInterval = 0.1;
+
+@implementation SIEventLogReader {
+    NSString *_path;
+    void (^_lineHandler)(NSString *);
+
+    // only accessed on the read queue
+    dispatch_queue_t _readQueue;
+    dispatch_source_t _pollTimer;
+    NSFileHandle *_fileHandle;
+    NSMutableData *_lineBuffer;
+}
+
+- (instancetype)initWithPath:(NSString *)path lineHandler:(void (^)(NSString *))lineHandler {
+    NSParameterAssert([path length] && lineHandler);
+
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _lineHandler = [lineHandler copy];
+        _readQueue = dispatch_queue_create("com.inkling.subliminal-instrument.SIEventLogReader.readQueue", DISPATCH_QUEUE_SERIAL);
+        _lineBuffer = [[NSMutableData alloc] init];
+    }
+    return self;
+}
+
+- (void)beginReading {
+    dispatch_sync(_readQueue, ^{
+        NSAssert(!_pollTimer, @"The reader has already begun reading.");
+
+        _pollTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _readQueue);
+        dispatch_source_set_timer(_pollTimer, dispatch_time(DISPATCH_TIME_NOW, 0),
+                                  (uint64_t)(kPollInterval * NSEC_PER_SEC), (uint64_t)(kPollInterval * NSEC_PER_SEC / 10));
+        __weak SIEventLogReader *weakSelf = self;
+        dispatch_source_set_event_handler(_pollTimer, ^{
+            [weakSelf readAvailableLines];
+        });
+        dispatch_resume(_pollTimer);
+    });
+}
+
+- (void)finishReading {
+    dispatch_sync(_readQueue, ^{
+        if (_pollTimer) {
+            dispatch_source_cancel(_pollTimer);
+            _pollTimer = nil;
+        }
+
+        [self readAvailableLines];
+
+        if ([_lineBuffer length]) {
+            NSString *line = [[NSString alloc] initWithData:_lineBuffer encoding:NSUTF8StringEncoding];
+            if (line) _lineHandler(line);
+            [_lineBuffer setLength:0];
+        }
+
+        [_fileHandle closeFile];
+        _fileHandle = nil;
+    });
+}
+
+- (void)readAvailableLines {
+    if (!_fileHandle) {
+        _fileHandle = [NSFileHandle fileHandleForReadingAtPath:_path];
+        if (!_fileHandle) return;
+        _foundLog = YES;
+    }
+
+    @autoreleasepool {
+        // `-availableData` returns the data up to the end of a regular file
+        NSData *data = [_fileHandle availableData];
+        if (![data length]) return;
+        [_lineBuffer appendData:data];
+
+        const char *bytes = [_lineBuffer bytes];
+        NSUInteger length = [_lineBuffer length], lineStart = 0;
+        for (NSUInteger i = 0; i < length; i++) {
+            if (bytes[i] != '\n') continue;
+
+            NSData *lineData = [_lineBuffer subdataWithRange:NSMakeRange(lineStart, i - lineStart)];
+            NSString *line = [[NSString alloc] initWithData:lineData encoding:NSUTF8StringEncoding];
+            NSAssert(line, @"lineData wasn't able to be converted into a UTF8 string: %@", lineData);
+            _lineHandler(line);
+            lineStart = i + 1;
+        }
+        [_lineBuffer replaceBytesInRange:NSMakeRange(0, lineStart) withBytes:NULL length:0];
+    }
+}
+
+@end
@@ -56,6 +56,32 @@
  */
 @property (nonatomic, readonly) NSArray *reporters;
 
+/**
+ The path of the event log to be written by the application and read
+ by the `subliminal-instrument` executable, as an absolute path.
+
+ If this is non-`nil`, the path will be passed to the application using the
+ `SL_EVENT_LOG_PATH` environment variable, and the `subliminal-instrument` executable
+ will report the events that the application writes to the log rather than
+ parsing the Automation instrument's output. See `SLLogger` for more information.
+
+ Defaults to `nil`.
+ */
+@property (nonatomic, readonly) NSString *eventLogPath;
+
+/**
+ The paths of event logs to merge, as absolute paths.
+
+ If this is non-`nil`, the `subliminal-instrument` executable will not launch
+ the `instruments` executable, but will instead report the events of these logs
+ as if they had been written by a single run of the tests. This allows the reports
+ of several shards of a run (see `-[SLTestController shardCount]`) to be combined.
+ See `SIEventLogMerger` for more information.
+
+ Defaults to `nil`.
+ */
+@property (nonatomic, readonly) NSArray *eventLogPathsToMerge;
+
 /**
  The arguments to pass to the `instruments` executable when launched
  by the `subliminal-instrument` executable.
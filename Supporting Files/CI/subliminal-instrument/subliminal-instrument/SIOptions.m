@@ -29,7 +29,7 @@ static NSString *const SIOptionsErrorDomain = @"SIOptionsError";
 @implementation SIOptions
 
 + (NSString *)usagePattern {
-    return @"[--help] [INSTRUMENTS ARGUMENTS]";
+    return @"[--help] ([--event-log PATH] [INSTRUMENTS ARGUMENTS] | --merge-event-logs PATH...)";
 }
 
 + (NSString *)optionDescriptions {
@@ -42,6 +42,22 @@ static NSString *const SIOptionsErrorDomain = @"SIOptionsError";
     [usageString appendString:[helpOptionString stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
     [usageString appendFormat:@"%@\n", @"Show help."];
 
+    NSString *eventLogOptionString = [NSString stringWithFormat:@"%@%@", indentString, @"--event-log PATH"];
+    [usageString appendString:[eventLogOptionString stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"Have the application write an event log to PATH, and report\n"];
+    [usageString appendString:[@"" stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"the events from that log rather than from `instruments`' output.\n"];
+    [usageString appendString:[@"" stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"Only supported when running the application in the Simulator.\n"];
+
+    NSString *mergeEventLogsOptionString = [NSString stringWithFormat:@"%@%@", indentString, @"--merge-event-logs PATH..."];
+    [usageString appendString:[mergeEventLogsOptionString stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"Rather than running `instruments`, report the events from\n"];
+    [usageString appendString:[@"" stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"the event logs at the specified PATHs (e.g. those written by\n"];
+    [usageString appendString:[@"" stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
+    [usageString appendString:@"the shards of a run) as if written by a single run.\n"];
+
     NSString *instrumentsArgumentsString = [NSString stringWithFormat:@"%@%@", indentString, @"INSTRUMENTS ARGUMENTS"];
     [usageString appendString:[instrumentsArgumentsString stringByPaddingToLength:descriptionStartIndex withString:@" " startingAtIndex:0]];
     [usageString appendString:@"Arguments to the `instruments` CLI tool (see `instruments(1)`).\n"];
@@ -86,6 +102,8 @@ static NSString *const SIOptionsErrorDomain = @"SIOptionsError";
 
 - (BOOL)consumeSIArguments:(NSMutableArray *)arguments error:(NSError *__autoreleasing *)error {
     NSString *const kHelpOption = @"--help";
+    NSString *const kEventLogOption = @"--event-log";
+    NSString *const kMergeEventLogsOption = @"--merge-event-logs";
 
     NSParameterAssert(error);
 
@@ -96,6 +114,49 @@ static NSString *const SIOptionsErrorDomain = @"SIOptionsError";
         [arguments removeObject:kHelpOption];
     }
 
+    NSUInteger mergeEventLogsOptionIndex = [arguments indexOfObject:kMergeEventLogsOption];
+    if (mergeEventLogsOptionIndex != NSNotFound) {
+        // all arguments following the option are paths of logs to merge
+        NSRange pathsRange = NSMakeRange(mergeEventLogsOptionIndex + 1, [arguments count] - (mergeEventLogsOptionIndex + 1));
+        if (!pathsRange.length) {
+            *error = [[self class] errorWithDescription:@"The merge option (--merge-event-logs) requires one or more paths."];
+            return NO;
+        }
+
+        NSMutableArray *eventLogPathsToMerge = [[NSMutableArray alloc] initWithCapacity:pathsRange.length];
+        for (NSString *path in [arguments subarrayWithRange:pathsRange]) {
+            NSString *absolutePath = path;
+            if (![absolutePath isAbsolutePath]) {
+                absolutePath = [[[NSFileManager defaultManager] currentDirectoryPath] stringByAppendingPathComponent:absolutePath];
+            }
+            [eventLogPathsToMerge addObject:[absolutePath stringByStandardizingPath]];
+        }
+        _eventLogPathsToMerge = [eventLogPathsToMerge copy];
+        [arguments removeObjectsInRange:NSMakeRange(mergeEventLogsOptionIndex, pathsRange.length + 1)];
+    }
+
+    NSUInteger eventLogOptionIndex = [arguments indexOfObject:kEventLogOption];
+    if (eventLogOptionIndex != NSNotFound) {
+        if (eventLogOptionIndex + 1 >= [arguments count]) {
+            *error = [[self class] errorWithDescription:@"The event log option (--event-log) requires a path."];
+            return NO;
+        }
+
+        // The path must be absolute, because the application would otherwise resolve it relative to its home directory.
+        NSString *eventLogPath = arguments[eventLogOptionIndex + 1];
+        if (![eventLogPath isAbsolutePath]) {
+            eventLogPath = [[[NSFileManager defaultManager] currentDirectoryPath] stringByAppendingPathComponent:eventLogPath];
+        }
+        _eventLogPath = [eventLogPath stringByStandardizingPath];
+        [arguments removeObjectsInRange:NSMakeRange(eventLogOptionIndex, 2)];
+    }
+
+    // when merging event logs, `instruments` is not run
+    if (_eventLogPathsToMerge && (_eventLogPath || [arguments count])) {
+        *error = [[self class] errorWithDescription:@"Neither an event log (--event-log) nor arguments to `instruments` may be specified when merging event logs (--merge-event-logs)."];
+        return NO;
+    }
+
     return YES;
 }
 
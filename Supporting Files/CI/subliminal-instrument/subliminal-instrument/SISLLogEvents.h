@@ -43,6 +43,16 @@
                                     If the error occurred in test set-up, this will be "setUpTest".
                                     If the error occurred in test tear-down, this will be "tearDownTest".
 
+                    Events parsed from an event log (see `-[SISLLogParser parseEventLogLine:]`)
+                    that mark the end of a test case, test, or the test run
+                    (i.e. those of subtypes `SISLLogEventSubtypeTestCasePassed`,
+                    `SISLLogEventSubtypeTestCaseFailed`, `SISLLogEventSubtypeTestCaseFailedUnexpectedly`,
+                    `SISLLogEventSubtypeTestFinished`, `SISLLogEventSubtypeTestTerminatedAbnormally`,
+                    and `SISLLogEventSubtypeTestingFinished`) will also contain the following field:
+
+                    * "duration":   the number of seconds that the test case, test, or run
+                                    took to execute, as an `NSNumber *` wrapping a double.
+
                     The dictionary may contain additional fields based on the event's subtype.
                     See `SISLLogEventSubtype`. This dictionary may be omitted
                     if it would be empty.
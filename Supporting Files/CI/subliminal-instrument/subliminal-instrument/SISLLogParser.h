@@ -32,6 +32,11 @@
  output by an `instruments` executable (running Subliminal tests) to a parser's
  `-parseStdoutLine:` and `-parseStderrLine:` methods. When an event is parsed,
  the log parser will call the client, its delegate, with the event. 
+
+ Alternatively, if the application under test writes an event log (see `SLLogger`),
+ the client may feed each line of that log to the parser's `-parseEventLogLine:`
+ method. The events so parsed carry the precise times at which they occurred in the
+ application, and the durations of tests and test cases.
  */
 @interface SISLLogParser : NSObject
 
@@ -40,6 +45,17 @@
  */
 @property (nonatomic, weak) id<SISLLogParserDelegate> delegate;
 
+/**
+ Whether the parser ignores the messages logged by the tests to `stdout`.
+
+ Set this to `YES` when the events logged by the tests are to be parsed from an
+ event log using `-parseEventLogLine:`, so that they are not reported twice.
+ Lines written to `stdout` by the `instruments` executable itself will still be parsed.
+
+ Defaults to `NO`.
+ */
+@property (nonatomic) BOOL ignoresStdoutLogMessages;
+
 /**
  Parses a message written by an `instruments` executable to `stdout`.
  
@@ -58,6 +74,17 @@
  */
 - (void)parseStderrLine:(NSString *)message;
 
+/**
+ Parses a line of an event log written by the application under test.
+
+ The parser will notify its delegate if an event is parsed from the line.
+ Lines that cannot be parsed (e.g. because the application was terminated
+ while writing the line) are reported as events of type `SISLLogEventTypeDefault`.
+
+ @param line A line of an event log written by `SLLogger`.
+ */
+- (void)parseEventLogLine:(NSString *)line;
+
 @end
 
 
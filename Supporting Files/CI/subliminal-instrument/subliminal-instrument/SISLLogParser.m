@@ -26,6 +26,8 @@
 
 @implementation SISLLogParser {
     NSString *_currentTest, *_currentTestCase;
+    NSDate *_eventLogStartDate;
+    NSTimeInterval _eventLogStartTimestamp;
 }
 
 + (NSDateFormatter *)iso8601DateFormatter {
@@ -238,6 +240,9 @@
     NSString *messageType = nil, *message = nil;
     [[self class] parseMessageType:&messageType andMessage:&message fromLine:line];
 
+    // messages logged by the tests are the ones with message types
+    if (messageType && self.ignoresStdoutLogMessages) return;
+
     SISLLogEventType eventType;
     SISLLogEventSubtype eventSubtype;
     NSDictionary *info = nil;
@@ -278,4 +283,80 @@
     [self.delegate parser:self didParseEvent:[event copy]];
 }
 
++ (NSDictionary *)eventTypesForEventLogTypes {
+    static NSDictionary *__eventTypes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // values are pairs of `SISLLogEventType` and `SISLLogEventSubtype`
+        __eventTypes = @{
+            @"message":                     @[ @(SISLLogEventTypeDefault),    @(SISLLogEventSubtypeNone) ],
+            @"debug":                       @[ @(SISLLogEventTypeDebug),      @(SISLLogEventSubtypeNone) ],
+            @"warning":                     @[ @(SISLLogEventTypeWarning),    @(SISLLogEventSubtypeNone) ],
+            // errors logged by the tests are treated as failures, as when parsed from `stdout`
+            @"error":                       @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestFailure) ],
+            @"failure":                     @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestFailure) ],
+            @"exception":                   @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestError) ],
+            @"testingStarted":              @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestingStarted) ],
+            @"testStarted":                 @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestStarted) ],
+            @"testCaseStarted":             @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestCaseStarted) ],
+            @"testCasePassed":              @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestCasePassed) ],
+            // test cases that passed when retried are reported as passing, with a warning
+            @"testCaseFlakyPassed":         @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestCasePassed) ],
+            @"testCaseRetried":             @[ @(SISLLogEventTypeWarning),    @(SISLLogEventSubtypeNone) ],
+            @"testCaseFailed":              @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestCaseFailed) ],
+            @"testCaseFailedUnexpectedly":  @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestCaseFailedUnexpectedly) ],
+            @"testFinished":                @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestFinished) ],
+            @"testTerminatedAbnormally":    @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestTerminatedAbnormally) ],
+            @"testingFinished":             @[ @(SISLLogEventTypeTestStatus), @(SISLLogEventSubtypeTestingFinished) ]
+        };
+    });
+    return __eventTypes;
+}
+
+- (void)parseEventLogLine:(NSString *)line {
+    NSDictionary *record = [NSJSONSerialization JSONObjectWithData:[line dataUsingEncoding:NSUTF8StringEncoding]
+                                                           options:0 error:NULL];
+    if (![record isKindOfClass:[NSDictionary class]]) {
+        // e.g. the application was terminated while writing the line
+        NSMutableDictionary *event = [[NSMutableDictionary alloc] initWithDictionary:@{
+            @"timestamp": [[[self class] iso8601DateFormatter] stringFromDate:[NSDate date]],
+            @"type": @(SISLLogEventTypeDefault),
+            @"subtype": @(SISLLogEventSubtypeNone),
+            @"message": line
+        }];
+        [self synchronizeTestStateWithEvent:event];
+        [self.delegate parser:self didParseEvent:[event copy]];
+        return;
+    }
+
+    NSString *recordType = record[@"type"];
+    NSTimeInterval recordTimestamp = [record[@"timestamp"] doubleValue];
+
+    // The first record specifies the date corresponding to the (monotonic) timestamps of subsequent records.
+    if ([recordType isEqualToString:@"logStarted"]) {
+        _eventLogStartDate = [NSDate dateWithTimeIntervalSince1970:[record[@"date"] doubleValue]];
+        _eventLogStartTimestamp = recordTimestamp;
+        return;
+    }
+
+    NSDate *date = (_eventLogStartDate ? [_eventLogStartDate dateByAddingTimeInterval:(recordTimestamp - _eventLogStartTimestamp)]
+                                       : [NSDate date]);
+
+    NSArray *eventTypes = [[self class] eventTypesForEventLogTypes][recordType] ?: @[ @(SISLLogEventTypeDefault), @(SISLLogEventSubtypeNone) ];
+
+    NSMutableDictionary *info = [[NSMutableDictionary alloc] initWithDictionary:record];
+    [info removeObjectsForKeys:@[ @"timestamp", @"type", @"message" ]];
+
+    NSMutableDictionary *event = [[NSMutableDictionary alloc] initWithDictionary:@{
+        @"timestamp": [[[self class] iso8601DateFormatter] stringFromDate:date],
+        @"type": eventTypes[0],
+        @"subtype": eventTypes[1],
+        @"message": record[@"message"] ?: @""
+    }];
+    if ([info count]) event[@"info"] = [info copy];
+
+    [self synchronizeTestStateWithEvent:event];
+    [self.delegate parser:self didParseEvent:[event copy]];
+}
+
 @end
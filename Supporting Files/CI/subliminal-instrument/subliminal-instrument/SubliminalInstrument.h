@@ -90,6 +90,10 @@
 /**
  Launches the `instruments` executable with `arguments`
  and sets `terminationStatus` after the executable has exited.
+
+ If `arguments` specify event logs to merge, the receiver instead reports
+ the events of those logs as if written by a single run of the tests, and sets
+ `terminationStatus` to `0` if the logs were merged and no tests failed, otherwise `1`.
  */
 - (void)run;
 
@@ -26,6 +26,8 @@
 #import "NSTask+Utilities.h"
 #import "SIOptions.h"
 
+#import "SIEventLogMerger.h"
+#import "SIEventLogReader.h"
 #import "SISLLogParser.h"
 #import "SIReporter.h"
 
@@ -36,6 +38,7 @@
 @implementation SubliminalInstrument {
     SIOptions *_options;
     SISLLogParser *_logParser;
+    dispatch_queue_t _parseQueue;
 }
 
 + (NSString *)traceTemplatePath {
@@ -69,6 +72,8 @@
 
         _logParser = [[SISLLogParser alloc] init];
         _logParser.delegate = self;
+        // the event log and `instruments`' output are read on different threads, but are parsed serially
+        _parseQueue = dispatch_queue_create("com.inkling.subliminal-instrument.SubliminalInstrument.parseQueue", DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
@@ -98,6 +103,11 @@
         return;
     }
 
+    if (_options.eventLogPathsToMerge) {
+        [self mergeEventLogs];
+        return;
+    }
+
     NSTask *instrumentsTask = [[NSTask alloc] init];
     instrumentsTask.launchPath = [[self class] instrumentsPath];
 
@@ -105,6 +115,28 @@
     NSMutableArray *instrumentsArguments = [[NSMutableArray alloc] initWithArray:_options.instrumentsArguments];
     [instrumentsArguments insertObject:@"-t" atIndex:0];
     [instrumentsArguments insertObject:traceTemplatePath atIndex:1];
+
+    /*
+     If the application is to write an event log, pass it the log's path
+     (alongside any other environment variable settings) and report the events
+     read from the log rather than those logged to `stdout`.
+     */
+    SIEventLogReader *eventLogReader = nil;
+    if (_options.eventLogPath) {
+        // make sure that we don't read the log of a previous run
+        [[NSFileManager defaultManager] removeItemAtPath:_options.eventLogPath error:NULL];
+        [instrumentsArguments addObjectsFromArray:@[ @"-e", @"SL_EVENT_LOG_PATH", _options.eventLogPath ]];
+
+        _logParser.ignoresStdoutLogMessages = YES;
+        eventLogReader = [[SIEventLogReader alloc] initWithPath:_options.eventLogPath lineHandler:^(NSString *line) {
+            dispatch_sync(_parseQueue, ^{
+                @autoreleasepool {
+                    [_logParser parseEventLogLine:line];
+                }
+            });
+        }];
+    }
+
     instrumentsTask.arguments = instrumentsArguments;
 
     // Make sure that instruments exits when we do
@@ -123,20 +155,54 @@
 
      The autorelease pools below cover both line parsing,
      and the event reporting that happens in response to line parsing.
+     Lines are parsed on `_parseQueue` (synchronously, so that no lines remain
+     to be parsed once `instruments` exits) because the parser is not thread-safe.
      */
+    [eventLogReader beginReading];
     [launchTask launchUsingPseudoTerminal:YES outputHandler:^(NSString *line) {
-        @autoreleasepool {
-            [_logParser parseStdoutLine:line];
-        }
+        dispatch_sync(_parseQueue, ^{
+            @autoreleasepool {
+                [_logParser parseStdoutLine:line];
+            }
+        });
     } errorHandler:^(NSString *line) {
+        dispatch_sync(_parseQueue, ^{
+            @autoreleasepool {
+                [_logParser parseStderrLine:line];
+            }
+        });
+    }];
+
+    if (eventLogReader) {
+        [eventLogReader finishReading];
+        if (!eventLogReader.foundLog) {
+            [self.standardError printString:@"The application did not write an event log to \"%@\". Event logs may only be written by applications running in the Simulator.\n", _options.eventLogPath];
+        }
+    }
+
+    [_options.reporters makeObjectsPerformSelector:@selector(finishReporting)];
+
+    _terminationStatus = launchTask.terminationStatus;
+}
+
+- (void)mergeEventLogs {
+    SIEventLogMerger *merger = [[SIEventLogMerger alloc] initWithPaths:_options.eventLogPathsToMerge];
+
+    for (SIReporter *reporter in _options.reporters) {
+        [reporter beginReportingWithStandardOutput:self.standardOutput
+                                     standardError:self.standardError];
+    }
+
+    [merger mergeWithEventHandler:^(NSDictionary *event) {
         @autoreleasepool {
-            [_logParser parseStderrLine:line];
+            [_options.reporters makeObjectsPerformSelector:@selector(reportEvent:) withObject:event];
         }
     }];
 
     [_options.reporters makeObjectsPerformSelector:@selector(finishReporting)];
 
-    _terminationStatus = launchTask.terminationStatus;
+    // there is no `instruments` exit status to return, so report whether the merged run succeeded
+    _terminationStatus = merger.succeeded ? 0 : 1;
 }
 
 #pragma - SISLLogParserDelegate
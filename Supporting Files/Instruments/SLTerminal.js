@@ -38,8 +38,11 @@ var _target = UIATarget.localTarget();
 // and to avoid collisions with UIAutomation/arbitrary JS executed by/using Subliminal
 var SLTerminal = {} 
 
-// private variable
+// private variables
 SLTerminal._scriptIndex = 0;
+// until the first script has been evaluated, the preferences may hold
+// the index of a script from a previous launch, so we must not catch up to it (see below)
+SLTerminal._hasEvaluatedScript = false;
 
 // public variables (manipulated by SLTerminal)
 SLTerminal.scriptLoggingEnabled = false;
@@ -50,7 +53,12 @@ while(!SLTerminal.hasShutDown) {
 	while (true) {
 		var scriptIndex = _target.frontMostApp().preferencesValueForKey("scriptIndex");
 		
-		if (scriptIndex === SLTerminal._scriptIndex) {
+		// SLTerminal abandons scripts whose evaluation is interrupted (when a test times out)
+		// and moves on to the next index: if it did so before we read the script,
+		// catch up to its current script rather than waiting for an index that will never come
+		if ((scriptIndex === SLTerminal._scriptIndex) ||
+			(SLTerminal._hasEvaluatedScript && (typeof scriptIndex === "number") && (scriptIndex > SLTerminal._scriptIndex))) {
+			SLTerminal._scriptIndex = scriptIndex;
 			break;
 		}
 		_target.delay(0.1);
@@ -64,16 +72,19 @@ while(!SLTerminal.hasShutDown) {
 	
 	// Evaluate the script
 	var result = null;
+	var exception = "";
 	try {
 		result = eval(script);
 	} catch (e) {
 		// Special case SyntaxErrors so that we can examine the malformed script
-		var message = e.toString();
+		exception = e.toString();
 		if ((e instanceof Error) && e.name === "SyntaxError") {
-			message += " from script: \"" + script + "\"";
+			exception += " from script: \"" + script + "\"";
 		}
-		_target.frontMostApp().setPreferencesValueForKey(message, "exception");
 	}
+	// Always write the exception key, even if empty, so that the exception of an abandoned script
+	// (written after SLTerminal has moved on) is not mistaken for the exception of this script
+	_target.frontMostApp().setPreferencesValueForKey(exception, "exception");
 
 	// Serialize the result only if we can guarantee that it can be serialized to the preferences
 	var resultType = (typeof result);
@@ -87,4 +98,5 @@ while(!SLTerminal.hasShutDown) {
 	// Notify SLTerminal that we've finished evaluation
 	_target.frontMostApp().setPreferencesValueForKey(SLTerminal._scriptIndex, "resultIndex");
 	SLTerminal._scriptIndex++;
+	SLTerminal._hasEvaluatedScript = true;
 }
@@ -0,0 +1,142 @@
+//
+//  SLOcclusionPortableTests.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+/*
+ Exercises the geometry of the occlusion engine without UIKit or SenTestingKit,
+ so that it may be built and run on any platform with a C99 compiler:
+
+    rake test:portable
+
+ `SLOcclusionTests.m` covers the engine's semantics within the unit test target;
+ these tests focus on the arithmetic which is independent of the platform:
+ inverting transforms, the treatment of the edges of bounds, and clipping.
+ */
+
+#include "SLOcclusion.h"
+
+#include <stdio.h>
+
+static int __failureCount = 0;
+
+#define SLAssertEqual(actual, expected, description) do { \
+    long __actual = (long)(actual), __expected = (long)(expected); \
+    if (__actual != __expected) { \
+        fprintf(stderr, "%s:%d: %s: %s (got %ld, expected %ld)\n", \
+                __FILE__, __LINE__, __func__, (description), __actual, __expected); \
+        __failureCount++; \
+    } \
+} while (0)
+
+static const SLOcclusionTransform SLOcclusionTransformIdentity = { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+
+// a window {{0, 0}, {320, 480}} followed by a target {{10, 10}, {100, 100}}
+static size_t SLMakeWindowAndTarget(SLOcclusionNode *nodes) {
+    nodes[0] = SLOcclusionNodeMake(SLOcclusionTransformIdentity, (SLOcclusionRect){ 0, 0, 320, 480 },
+                                   -1, SLOcclusionNodeKindOpaque);
+    nodes[1] = SLOcclusionNodeMake((SLOcclusionTransform){ 1.0, 0.0, 0.0, 1.0, 10, 10 }, (SLOcclusionRect){ 0, 0, 100, 100 },
+                                   -1, SLOcclusionNodeKindTarget);
+    return 2;
+}
+
+static void testBoundsContainTheirMinimumEdgesButNotTheirMaximumEdges(void) {
+    SLOcclusionNode nodes[2];
+    const size_t nodeCount = SLMakeWindowAndTarget(nodes);
+
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 10.0, 10.0 }),
+                  SLOcclusionVisibilityVisible, "The target should contain its minimum edges.");
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 110.0, 60.0 }),
+                  SLOcclusionVisibilityOccluded, "The target should not contain its maximum x edge.");
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 60.0, 110.0 }),
+                  SLOcclusionVisibilityOccluded, "The target should not contain its maximum y edge.");
+}
+
+static void testScaledAndRotatedNodesAreInverted(void) {
+    SLOcclusionNode nodes[3];
+    size_t nodeCount = SLMakeWindowAndTarget(nodes);
+
+    // a 10x10 occluder scaled by 2, rotated by 180 degrees, and translated to {100, 100},
+    // covering {{80, 80}, {20, 20}}
+    nodes[nodeCount++] = SLOcclusionNodeMake((SLOcclusionTransform){ -2.0, 0.0, 0.0, -2.0, 100, 100 },
+                                             (SLOcclusionRect){ 0, 0, 10, 10 },
+                                             -1, SLOcclusionNodeKindOpaque);
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 85.5, 85.5 }),
+                  SLOcclusionVisibilityOccluded, "The transformed occluder should cover the point.");
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 100.5, 100.5 }),
+                  SLOcclusionVisibilityVisible, "The transformed occluder should not extend past its origin.");
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 79.5, 85.5 }),
+                  SLOcclusionVisibilityVisible, "The transformed occluder should be scaled.");
+}
+
+static void testNearlySingularTransformsCoverNothing(void) {
+    SLOcclusionNode nodes[3];
+    size_t nodeCount = SLMakeWindowAndTarget(nodes);
+
+    nodes[nodeCount++] = SLOcclusionNodeMake((SLOcclusionTransform){ 1e-7, 0.0, 0.0, 1e-7, 60, 60 },
+                                             (SLOcclusionRect){ 0, 0, 100, 100 },
+                                             -1, SLOcclusionNodeKindOpaque);
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 60.0, 60.0 }),
+                  SLOcclusionVisibilityVisible, "A node scaled almost to zero should not cover any point.");
+}
+
+static void testClippingAncestorsAreTransformed(void) {
+    SLOcclusionNode nodes[4];
+    size_t nodeCount = SLMakeWindowAndTarget(nodes);
+
+    // a clipping container translated to {50, 50}, of size {20, 20}, containing a full-screen occluder
+    nodes[nodeCount++] = SLOcclusionNodeMake((SLOcclusionTransform){ 1.0, 0.0, 0.0, 1.0, 50, 50 },
+                                             (SLOcclusionRect){ 0, 0, 20, 20 },
+                                             -1, SLOcclusionNodeKindTransparent);
+    const long clipIndex = (long)nodeCount - 1;
+    nodes[nodeCount++] = SLOcclusionNodeMake(SLOcclusionTransformIdentity, (SLOcclusionRect){ 0, 0, 320, 480 },
+                                             clipIndex, SLOcclusionNodeKindOpaque);
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 60.5, 60.5 }),
+                  SLOcclusionVisibilityOccluded, "The occluder should cover points within its container.");
+    SLAssertEqual(SLOcclusionVisibilityOfPoint(nodes, nodeCount, (SLOcclusionPoint){ 20.5, 20.5 }),
+                  SLOcclusionVisibilityVisible, "The occluder should be clipped to its container.");
+}
+
+static void testVisiblePointsAreCounted(void) {
+    SLOcclusionNode nodes[3];
+    size_t nodeCount = SLMakeWindowAndTarget(nodes);
+
+    nodes[nodeCount++] = SLOcclusionNodeMake((SLOcclusionTransform){ 1.0, 0.0, 0.0, 1.0, 50, 50 },
+                                             (SLOcclusionRect){ 0, 0, 20, 20 },
+                                             -1, SLOcclusionNodeKindOpaque);
+    const SLOcclusionPoint points[] = { { 10.5, 10.5 }, { 60.5, 60.5 }, { 109.5, 109.5 }, { 200.5, 200.5 } };
+    SLAssertEqual(SLOcclusionNumberOfVisiblePoints(nodes, nodeCount, points, 4), 2,
+                  "Two of the four points should be visible.");
+}
+
+int main(void) {
+    testBoundsContainTheirMinimumEdgesButNotTheirMaximumEdges();
+    testScaledAndRotatedNodesAreInverted();
+    testNearlySingularTransformsCoverNothing();
+    testClippingAncestorsAreTransformed();
+    testVisiblePointsAreCounted();
+
+    if (__failureCount) {
+        fprintf(stderr, "%d assertion(s) failed.\n", __failureCount);
+        return 1;
+    }
+    printf("Portable occlusion tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+//
+//  SLAccessibilityContainerIndexTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLAccessibilityContainerIndex.h"
+
+
+@interface SLTestAccessibilityContainer : NSObject
+@property (nonatomic, strong) NSMutableArray *elements;
+@property (nonatomic) NSUInteger numberOfElementRequests;
+@end
+
+@implementation SLTestAccessibilityContainer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _elements = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (NSInteger)accessibilityElementCount {
+    return [self.elements count];
+}
+
+- (id)accessibilityElementAtIndex:(NSInteger)index {
+    self.numberOfElementRequests++;
+    return self.elements[index];
+}
+
+- (NSInteger)indexOfAccessibilityElement:(id)element {
+    return [self.elements indexOfObject:element];
+}
+
+@end
+
+
+@interface SLAccessibilityContainerIndexTests : SenTestCase
+@end
+
+@implementation SLAccessibilityContainerIndexTests {
+    SLTestAccessibilityContainer *_container;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // lay out a 10 x 10 grid of 10pt-square elements
+    _container = [[SLTestAccessibilityContainer alloc] init];
+    for (NSUInteger idx = 0; idx < 100; idx++) {
+        UIAccessibilityElement *element = [[UIAccessibilityElement alloc] initWithAccessibilityContainer:_container];
+        element.accessibilityFrame = CGRectMake((idx % 10) * 10.0, (idx / 10) * 10.0, 10.0, 10.0);
+        [_container.elements addObject:element];
+    }
+}
+
+- (void)testSmallContainersAreNotIndexed {
+    [_container.elements removeObjectsInRange:NSMakeRange(10, 90)];
+    STAssertNil([SLAccessibilityContainerIndex indexForContainer:_container],
+                @"Small containers should not be indexed.");
+}
+
+- (void)testElementIsNotCoveredByElementsAfterIt {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    STAssertNotNil(index, @"Large containers should be indexed.");
+
+    UIAccessibilityElement *element = _container.elements[55];
+    const CGPoint center = CGPointMake(CGRectGetMidX(element.accessibilityFrame), CGRectGetMidY(element.accessibilityFrame));
+    STAssertFalse([index elementBeforeElement:element containsPoint:center],
+                  @"The element should not have been covered.");
+
+    // cover the element with an element that comes after it
+    UIAccessibilityElement *coveringElement = [[UIAccessibilityElement alloc] initWithAccessibilityContainer:_container];
+    coveringElement.accessibilityFrame = CGRectMake(0.0, 0.0, 100.0, 100.0);
+    [_container.elements addObject:coveringElement];
+    index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    STAssertFalse([index elementBeforeElement:element containsPoint:center],
+                  @"The element should not have been covered by an element that comes after it.");
+}
+
+- (void)testElementIsCoveredByElementsBeforeIt {
+    UIAccessibilityElement *coveringElement = [[UIAccessibilityElement alloc] initWithAccessibilityContainer:_container];
+    coveringElement.accessibilityFrame = CGRectMake(52.0, 52.0, 5.0, 5.0);
+    [_container.elements insertObject:coveringElement atIndex:0];
+
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    UIAccessibilityElement *element = _container.elements[56];
+    STAssertTrue(CGRectEqualToRect(element.accessibilityFrame, CGRectMake(50.0, 50.0, 10.0, 10.0)),
+                 @"Test element was not at the expected position.");
+
+    STAssertTrue([index elementBeforeElement:element containsPoint:CGPointMake(55.0, 55.0)],
+                 @"The element should have been covered by an element that comes before it.");
+    STAssertFalse([index elementBeforeElement:element containsPoint:CGPointMake(58.0, 58.0)],
+                  @"The element should not have been covered outside the frame of the preceding element.");
+    STAssertFalse([index elementBeforeElement:coveringElement containsPoint:CGPointMake(55.0, 55.0)],
+                  @"The first element should not have been covered.");
+}
+
+- (void)testAllElementsAreConsideredIfElementIsNotInContainer {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    STAssertTrue([index elementBeforeElement:[[NSObject alloc] init] containsPoint:CGPointMake(95.0, 95.0)],
+                 @"All elements should have been considered.");
+    STAssertFalse([index elementBeforeElement:[[NSObject alloc] init] containsPoint:CGPointMake(105.0, 95.0)],
+                  @"No element should contain a point outside the container's elements.");
+}
+
+- (void)testIndexIsReusedUntilContainerChanges {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    NSUInteger numberOfElementRequests = _container.numberOfElementRequests;
+    STAssertTrue([SLAccessibilityContainerIndex indexForContainer:_container] == index,
+                 @"The index should have been reused.");
+    STAssertTrue((_container.numberOfElementRequests - numberOfElementRequests) <= 2,
+                 @"Only the container's first and last elements should have been requested again, to validate the index.");
+
+    [_container.elements removeLastObject];
+    STAssertFalse([SLAccessibilityContainerIndex indexForContainer:_container] == index,
+                  @"The index should have been rebuilt because the number of elements changed.");
+}
+
+- (void)testIndexIsReusedWhenRunLoopRuns {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    STAssertTrue([SLAccessibilityContainerIndex indexForContainer:_container] == index,
+                 @"The index should have been reused because the container did not change.");
+}
+
+- (void)testIndexIsRebuiltWhenContainerScrolls {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+
+    for (UIAccessibilityElement *element in _container.elements) {
+        element.accessibilityFrame = CGRectOffset(element.accessibilityFrame, 0.0, -5.0);
+    }
+    STAssertFalse([SLAccessibilityContainerIndex indexForContainer:_container] == index,
+                  @"The index should have been rebuilt because the container's elements moved.");
+}
+
+- (void)testQueriesReflectThatTheQueriedElementMovedAfterIndexing {
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+
+    // move the element being queried under an element that comes before it
+    UIAccessibilityElement *element = _container.elements[55];
+    element.accessibilityFrame = CGRectMake(0.0, 0.0, 10.0, 10.0);
+    STAssertTrue([index elementBeforeElement:element containsPoint:CGPointMake(5.0, 5.0)],
+                 @"The index should have reflected that the queried element moved.");
+}
+
+- (void)testQueriesReflectThatACoveringElementMovedAfterIndexing {
+    // cover an element with an element that comes before it
+    UIAccessibilityElement *coveringElement = _container.elements[1];
+    UIAccessibilityElement *coveredElement = _container.elements[60];
+    coveringElement.accessibilityFrame = coveredElement.accessibilityFrame;
+    const CGPoint center = CGPointMake(CGRectGetMidX(coveredElement.accessibilityFrame), CGRectGetMidY(coveredElement.accessibilityFrame));
+
+    SLAccessibilityContainerIndex *index = [SLAccessibilityContainerIndex indexForContainer:_container];
+    STAssertTrue([index elementBeforeElement:coveredElement containsPoint:center],
+                 @"The element should have been covered by an element that comes before it.");
+
+    // then move the covering element away
+    coveringElement.accessibilityFrame = CGRectMake(10.0, 0.0, 10.0, 10.0);
+    STAssertFalse([index elementBeforeElement:coveredElement containsPoint:center],
+                  @"The index should have reflected that the covering element moved.");
+}
+
+#pragma mark - Benchmarks
+
+- (void)testIndexedQueriesAreFasterThanScanningTheContainer {
+    // lay out a container large enough that the difference is measurable
+    [_container.elements removeAllObjects];
+    for (NSUInteger idx = 0; idx < 2500; idx++) {
+        UIAccessibilityElement *element = [[UIAccessibilityElement alloc] initWithAccessibilityContainer:_container];
+        element.accessibilityFrame = CGRectMake((idx % 50) * 10.0, (idx / 50) * 10.0, 10.0, 10.0);
+        [_container.elements addObject:element];
+    }
+
+    // query the last element, as `-slAccessibilityVisibilityTargetViewWithRect:` would
+    // when evaluating the element's visibility repeatedly
+    static const NSUInteger kQueries = 200;
+    UIAccessibilityElement *element = [_container.elements lastObject];
+    const CGPoint center = CGPointMake(CGRectGetMidX(element.accessibilityFrame), CGRectGetMidY(element.accessibilityFrame));
+
+    NSDate *scanStart = [NSDate date];
+    for (NSUInteger query = 0; query < kQueries; query++) {
+        for (NSInteger idx = 0; idx < [_container accessibilityElementCount]; idx++) {
+            id precedingElement = [_container accessibilityElementAtIndex:idx];
+            if (precedingElement == element) break;
+            if (CGRectContainsPoint([precedingElement accessibilityFrame], center)) break;
+        }
+    }
+    NSTimeInterval scanDuration = [[NSDate date] timeIntervalSinceDate:scanStart];
+
+    NSDate *indexStart = [NSDate date];
+    for (NSUInteger query = 0; query < kQueries; query++) {
+        (void)[[SLAccessibilityContainerIndex indexForContainer:_container] elementBeforeElement:element containsPoint:center];
+    }
+    NSTimeInterval indexDuration = [[NSDate date] timeIntervalSinceDate:indexStart];
+
+    NSLog(@"%lu queries of a container of %lu elements took %g s using an index (vs. %g s scanning the container).",
+          (unsigned long)kQueries, (unsigned long)[_container.elements count], indexDuration, scanDuration);
+    STAssertTrue(indexDuration < scanDuration,
+                 @"Querying the index (including building it once) should have been faster than scanning the container.");
+}
+
+@end
@@ -0,0 +1,82 @@
+//
+//  SLCoverageBenchmark.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+/*
+ A microbenchmark of the coverage kernel (see `SLCoverage.h`).
+
+ This file is not part of any target: it is a standalone program, so that the kernel
+ may be tuned on any platform. To run it, from the root of the repository:
+
+     cc -O2 -std=c99 -I Sources/Classes/Internal "Unit Tests/SLCoverageBenchmark.c" \
+        Sources/Classes/Internal/SLCoverage.c -o /tmp/SLCoverageBenchmark && /tmp/SLCoverageBenchmark
+
+ Pass `-U__SSE2__` (on x86) to benchmark the scalar implementation for comparison.
+ */
+
+#include "SLCoverage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+// The processor time used by the benchmark, in seconds. (`clock` is the only timer in standard C.)
+static double SLBenchmarkNow(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+int main(void) {
+    // The sizes of an element: a button, a table view cell, and a full-screen view
+    // on an iPad with a Retina display.
+    const size_t sizes[][2] = { { 44, 44 }, { 320, 44 }, { 1536, 2048 } };
+    const size_t strides[] = { 1, 2, 4 };
+    const size_t kPixelsPerTrial = 1 << 26;
+
+    for (size_t sizeIndex = 0; sizeIndex < sizeof(sizes) / sizeof(sizes[0]); sizeIndex++) {
+        const size_t width = sizes[sizeIndex][0], height = sizes[sizeIndex][1];
+        const size_t bytesPerRow = 4 * width;
+        unsigned char *pixels = (unsigned char *)malloc(bytesPerRow * height);
+        srand(0);
+        for (size_t byte = 0; byte < bytesPerRow * height; byte++) {
+            pixels[byte] = (unsigned char)(rand() & 0xFF);
+        }
+
+        for (size_t strideIndex = 0; strideIndex < sizeof(strides) / sizeof(strides[0]); strideIndex++) {
+            const size_t stride = strides[strideIndex];
+            const size_t iterations = (kPixelsPerTrial / (width * height)) + 1;
+
+            size_t visiblePixelCount = 0;
+            const double start = SLBenchmarkNow();
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                visiblePixelCount += SLCoverageOfPixels(pixels, width, height, bytesPerRow, stride, 3).visiblePixelCount;
+            }
+            const double duration = SLBenchmarkNow() - start;
+
+            printf("%4zu x %4zu, stride %zu: %8.3f us per rendering, %7.1f Mpixels/s (checksum %zu)\n",
+                   width, height, stride,
+                   (duration / iterations) * 1e6, ((double)(width * height * iterations) / duration) / 1e6,
+                   visiblePixelCount);
+        }
+        free(pixels);
+    }
+    return 0;
+}
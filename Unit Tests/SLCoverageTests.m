@@ -0,0 +1,110 @@
+//
+//  SLCoverageTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLCoverage.h"
+
+
+@interface SLCoverageTests : SenTestCase
+@end
+
+@implementation SLCoverageTests {
+    // a synthetic rendering, with padding at the end of each row
+    unsigned char *_pixels;
+    size_t _width, _height, _bytesPerRow;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // an odd width exercises both the vectorized and scalar portions of the kernel
+    _width = 37;
+    _height = 10;
+    _bytesPerRow = (4 * _width) + 12;
+    _pixels = (unsigned char *)calloc(_bytesPerRow * _height, 1);
+}
+
+- (void)tearDown {
+    free(_pixels);
+    [super tearDown];
+}
+
+- (void)setAlpha:(unsigned char)alpha atX:(size_t)x y:(size_t)y {
+    unsigned char *pixel = _pixels + (y * _bytesPerRow) + (4 * x);
+    // premultiplied, to make sure that the kernel examines only alpha
+    pixel[0] = pixel[1] = pixel[2] = alpha;
+    pixel[3] = alpha;
+}
+
+- (void)testTransparentRenderingIsNotCovered {
+    SLCoverage coverage = SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 1, 3);
+    STAssertEquals(coverage.sampledPixelCount, _width * _height, @"Every pixel should have been sampled.");
+    STAssertEquals(coverage.visiblePixelCount, (size_t)0, @"No pixel should have been visible.");
+    STAssertEquals(SLCoverageFraction(coverage), 0.0, @"No fraction of the rendering should have been visible.");
+}
+
+- (void)testOpaqueRenderingIsCovered {
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            [self setAlpha:255 atX:x y:y];
+        }
+    }
+    SLCoverage coverage = SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 1, 3);
+    STAssertEquals(coverage.visiblePixelCount, _width * _height, @"Every pixel should have been visible.");
+    STAssertEquals(SLCoverageFraction(coverage), 1.0, @"The whole rendering should have been visible.");
+}
+
+- (void)testPixelsAreVisibleIfTheirAlphaIsAtLeastTheMinimum {
+    [self setAlpha:2 atX:0 y:0];
+    [self setAlpha:3 atX:1 y:0];
+    [self setAlpha:128 atX:35 y:4];
+    [self setAlpha:255 atX:36 y:9];
+    SLCoverage coverage = SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 1, 3);
+    STAssertEquals(coverage.visiblePixelCount, (size_t)3, @"Only pixels with alpha of at least 3 should have been visible.");
+
+    coverage = SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 1, 0);
+    STAssertEquals(coverage.visiblePixelCount, _width * _height, @"Every pixel should have been visible if the minimum alpha is 0.");
+}
+
+- (void)testStrideSamplesEveryNthPixelOfEveryNthRow {
+    [self setAlpha:255 atX:0 y:0];
+    [self setAlpha:255 atX:3 y:3];
+    [self setAlpha:255 atX:36 y:9];     // sampled
+    [self setAlpha:255 atX:1 y:0];      // not sampled
+    [self setAlpha:255 atX:3 y:4];      // not sampled
+    SLCoverage coverage = SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 3, 3);
+    STAssertEquals(coverage.sampledPixelCount, (size_t)(13 * 4), @"Every third pixel of every third row should have been sampled.");
+    STAssertEquals(coverage.visiblePixelCount, (size_t)3, @"Only the sampled pixels should have been visible.");
+
+    STAssertEquals(SLCoverageOfPixels(_pixels, _width, _height, _bytesPerRow, 0, 3).sampledPixelCount, _width * _height,
+                   @"A stride of 0 should have been treated as a stride of 1.");
+}
+
+- (void)testStrideForMaxSampledPixelCount {
+    STAssertEquals(SLCoverageStrideForMaxSampledPixelCount(37, 10, 370), (size_t)1, @"Every pixel should be sampled.");
+    STAssertEquals(SLCoverageStrideForMaxSampledPixelCount(37, 10, 369), (size_t)2, @"Every other pixel should be sampled.");
+    STAssertEquals(SLCoverageStrideForMaxSampledPixelCount(1536, 2048, 1 << 16), (size_t)7,
+                   @"Large renderings should be sampled sparsely.");
+}
+
+@end
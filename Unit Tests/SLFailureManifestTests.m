@@ -0,0 +1,121 @@
+//
+//  SLFailureManifestTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLFailureManifest.h"
+#import "SharedSLTests.h"
+
+@interface SLFailureManifestTests : SenTestCase
+@end
+
+@implementation SLFailureManifestTests {
+    NSString *_path;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    NSString *filename = [NSString stringWithFormat:@"SLFailureManifestTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    _path = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:NULL];
+    [super tearDown];
+}
+
+- (void)testFailuresAreRecordedInOrderUnderTheirUnfocusedNames {
+    SLFailureManifest *manifest = [[SLFailureManifest alloc] initWithSeed:27];
+    [manifest recordFailureOfTestCase:@"focus_testTwo" inTest:[TestWithAFocusedTestCase class]];
+    [manifest recordFailureOfTest:[Focus_TestThatIsFocused class]];
+    [manifest recordFailureOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [manifest recordFailureOfTestCase:@"focus_testTwo" inTest:[TestWithAFocusedTestCase class]];
+
+    NSArray *expectedFailures = @[ @"TestWithAFocusedTestCase.testTwo", @"TestThatIsFocused", @"TestWithSomeTestCases.testOne" ];
+    STAssertEqualObjects([manifest failureDescriptions], expectedFailures, @"The failures were not recorded as expected.");
+}
+
+- (void)testManifestsAreWrittenAndRead {
+    SLFailureManifest *manifest = [[SLFailureManifest alloc] initWithSeed:27];
+    [manifest recordFailureOfTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    [manifest recordFailureOfTest:[TestOneOfRunGroupOne class]];
+
+    NSError *error = nil;
+    STAssertTrue([manifest writeToFile:_path error:&error], @"The manifest should have been written: %@", error);
+
+    SLFailureManifest *readManifest = [[SLFailureManifest alloc] initWithContentsOfFile:_path error:&error];
+    STAssertNotNil(readManifest, @"The manifest should have been read: %@", error);
+    STAssertEquals([readManifest seed], (unsigned int)27, @"The seed should have been read.");
+    STAssertEqualObjects([readManifest failureDescriptions], [manifest failureDescriptions], @"The failures should have been read.");
+}
+
+- (void)testReadingAManifestThatDoesNotExistFails {
+    NSError *error = nil;
+    STAssertNil([[SLFailureManifest alloc] initWithContentsOfFile:_path error:&error], @"The manifest should not have been read.");
+    STAssertNotNil(error, @"An error should have been returned.");
+}
+
+- (void)testTestsWithFailuresAreReturnedInTheOrderInWhichTheyFailed {
+    SLFailureManifest *manifest = [[SLFailureManifest alloc] initWithSeed:27];
+    [manifest recordFailureOfTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    [manifest recordFailureOfTest:[TestOneOfRunGroupTwo class]];
+    [manifest recordFailureOfTest:[TestOneOfRunGroupThree class]];
+    [manifest recordFailureOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+
+    NSArray *tests = @[ [TestOneOfRunGroupOne class], [TestOneOfRunGroupTwo class], [TestWithSomeTestCases class] ];
+    STAssertEqualObjects([manifest testsWithFailuresFromTests:tests], (@[ [TestWithSomeTestCases class], [TestOneOfRunGroupTwo class] ]),
+                         @"The tests with failures should have been returned in order of failure.");
+}
+
+- (void)testOnlyTheTestCasesThatFailedAreRunAgainUnlessTheirTestFailed {
+    NSSet *testCases = [NSSet setWithObjects:@"testOne", @"testTwo", @"testThree", nil];
+
+    SLFailureManifest *manifest = [[SLFailureManifest alloc] initWithSeed:27];
+    [manifest recordFailureOfTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    STAssertEqualObjects([manifest testCasesWithFailuresFromTestCases:testCases ofTest:[TestWithSomeTestCases class]],
+                         [NSSet setWithObject:@"testTwo"], @"Only the test case that failed should be run again.");
+
+    [manifest recordFailureOfTest:[TestWithSomeTestCases class]];
+    STAssertEqualObjects([manifest testCasesWithFailuresFromTestCases:testCases ofTest:[TestWithSomeTestCases class]],
+                         testCases, @"All test cases should be run again if their test failed.");
+}
+
+- (void)testFailuresAreReproducedByFailuresOfTheSameTestCaseOrTest {
+    SLFailureManifest *manifest = [[SLFailureManifest alloc] initWithSeed:27];
+    [manifest recordFailureOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [manifest recordFailureOfTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    [manifest recordFailureOfTest:[TestOneOfRunGroupOne class]];
+
+    SLFailureManifest *rerunManifest = [[SLFailureManifest alloc] initWithSeed:28];
+    [rerunManifest recordFailureOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [rerunManifest recordFailureOfTestCase:@"testFoo" inTest:[TestOneOfRunGroupOne class]];
+
+    STAssertTrue([manifest failure:@"TestWithSomeTestCases.testOne" wasReproducedByManifest:rerunManifest],
+                 @"The failure should have been reproduced.");
+    STAssertFalse([manifest failure:@"TestWithSomeTestCases.testTwo" wasReproducedByManifest:rerunManifest],
+                  @"The failure should not have been reproduced.");
+    STAssertTrue([manifest failure:@"TestOneOfRunGroupOne" wasReproducedByManifest:rerunManifest],
+                 @"A failure of a test should be reproduced by a failure of any of its cases.");
+}
+
+@end
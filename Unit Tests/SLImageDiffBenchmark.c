@@ -0,0 +1,154 @@
+//
+//  SLImageDiffBenchmark.c
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+/*
+ A microbenchmark of the image diff kernel (see `SLImageDiff.h`).
+
+ This file is not part of any target: it is a standalone program, so that the kernel
+ may be tuned on any platform. To run it, from the root of the repository:
+
+     cc -O2 -std=c99 -I Sources/Classes/Internal "Unit Tests/SLImageDiffBenchmark.c" \
+        Sources/Classes/Internal/SLImageDiff.c -o /tmp/SLImageDiffBenchmark && /tmp/SLImageDiffBenchmark
+
+ By default, the benchmark compares synthetic renderings. To compare fixture images instead,
+ pass the paths of two binary PPM (`P6`) images of the same size, e.g. as converted from PNGs
+ by ImageMagick (`convert screenshot.png screenshot.ppm`):
+
+     /tmp/SLImageDiffBenchmark screenshot.ppm reference.ppm
+
+ Pass `-U__SSE2__` (on x86) to benchmark the scalar implementation for comparison.
+ */
+
+#include "SLImageDiff.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+// The processor time used by the benchmark, in seconds. (`clock` is the only timer in standard C.)
+static double SLBenchmarkNow(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+// Reads a binary PPM image into opaque 32-bit RGBA pixels. Returns `NULL` if the image cannot be read.
+static unsigned char *SLBenchmarkReadPPM(const char *path, size_t *width, size_t *height) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    unsigned char *pixels = NULL;
+    unsigned int maxValue;
+    if ((fscanf(file, "P6 %zu %zu %u", width, height, &maxValue) == 3) && (maxValue == 255) && (fgetc(file) != EOF)) {
+        const size_t pixelCount = *width * *height;
+        pixels = (unsigned char *)malloc(4 * pixelCount);
+        for (size_t pixel = 0; pixels && (pixel < pixelCount); pixel++) {
+            if (fread(pixels + (4 * pixel), 3, 1, file) != 1) {
+                free(pixels);
+                pixels = NULL;
+                break;
+            }
+            pixels[(4 * pixel) + 3] = 255;
+        }
+    }
+    fclose(file);
+    return pixels;
+}
+
+static void SLBenchmarkDiff(const char *description,
+                            const unsigned char *pixels, const unsigned char *referencePixels,
+                            size_t width, size_t height) {
+    const size_t kPixelsPerTrial = 1 << 26;
+    const size_t iterations = (kPixelsPerTrial / (width * height)) + 1;
+    unsigned char *mask = (unsigned char *)calloc(width * height, 1);
+
+    SLImageDiff diff = { 0, 0, 0, 0, 0.0 };
+    const double start = SLBenchmarkNow();
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        diff = SLImageDiffOfPixels(pixels, 4 * width, referencePixels, 4 * width,
+                                   width, height, 2, mask, width);
+    }
+    const double duration = SLBenchmarkNow() - start;
+
+    printf("%4zu x %4zu, %-19s: %8.3f us per comparison, %7.1f Mpixels/s "
+           "(%zu of %zu tiles changed, %zu pixels differ, score %.6f)\n",
+           width, height, description,
+           (duration / iterations) * 1e6, ((double)(width * height * iterations) / duration) / 1e6,
+           diff.changedTileCount, diff.tileCount, diff.differingPixelCount, diff.score);
+    free(mask);
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc == 3) {
+        size_t width, height, referenceWidth, referenceHeight;
+        unsigned char *pixels = SLBenchmarkReadPPM(argv[1], &width, &height);
+        unsigned char *referencePixels = SLBenchmarkReadPPM(argv[2], &referenceWidth, &referenceHeight);
+        int status = 0;
+        if (!(pixels && referencePixels)) {
+            fprintf(stderr, "Could not read the images: they must be binary PPMs with a maximum value of 255.\n");
+            status = 1;
+        } else if ((width != referenceWidth) || (height != referenceHeight)) {
+            fprintf(stderr, "The images must be the same size.\n");
+            status = 1;
+        } else {
+            SLBenchmarkDiff("fixtures", pixels, referencePixels, width, height);
+        }
+        free(pixels);
+        free(referencePixels);
+        return status;
+    }
+
+    // The sizes of an element: a button, a table view cell, and a full-screen view
+    // on an iPad with a Retina display.
+    const size_t sizes[][2] = { { 44, 44 }, { 320, 44 }, { 1536, 2048 } };
+
+    for (size_t sizeIndex = 0; sizeIndex < sizeof(sizes) / sizeof(sizes[0]); sizeIndex++) {
+        const size_t width = sizes[sizeIndex][0], height = sizes[sizeIndex][1];
+        const size_t length = 4 * width * height;
+        unsigned char *pixels = (unsigned char *)malloc(length);
+        unsigned char *referencePixels = (unsigned char *)malloc(length);
+        srand(0);
+        for (size_t byte = 0; byte < length; byte++) {
+            pixels[byte] = (unsigned char)(rand() & 0xFF);
+        }
+
+        // the common case: the renderings match
+        memcpy(referencePixels, pixels, length);
+        SLBenchmarkDiff("identical", pixels, referencePixels, width, height);
+
+        // a small region has changed, e.g. a label's text
+        for (size_t y = height / 4; y < height / 2; y++) {
+            memset(referencePixels + (4 * ((y * width) + (width / 4))), 0xFF, 4 * (width / 4));
+        }
+        SLBenchmarkDiff("quarter changed", pixels, referencePixels, width, height);
+
+        // the worst case: every pixel differs
+        for (size_t byte = 0; byte < length; byte++) {
+            referencePixels[byte] = (unsigned char)~pixels[byte];
+        }
+        SLBenchmarkDiff("every pixel changed", pixels, referencePixels, width, height);
+
+        free(pixels);
+        free(referencePixels);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+//
+//  SLImageDiffTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLImageDiff.h"
+
+
+@interface SLImageDiffTests : SenTestCase
+@end
+
+@implementation SLImageDiffTests {
+    // synthetic renderings, with padding at the end of each row
+    unsigned char *_pixels, *_referencePixels, *_mask;
+    size_t _width, _height, _bytesPerRow;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // an odd width exercises both the vectorized and scalar portions of the kernel,
+    // and partial tiles
+    _width = 37;
+    _height = 21;
+    _bytesPerRow = (4 * _width) + 12;
+    _pixels = (unsigned char *)malloc(_bytesPerRow * _height);
+    _referencePixels = (unsigned char *)malloc(_bytesPerRow * _height);
+    for (size_t byte = 0; byte < _bytesPerRow * _height; byte++) {
+        _pixels[byte] = _referencePixels[byte] = (unsigned char)(byte * 7);
+    }
+    _mask = (unsigned char *)calloc(_width * _height, 1);
+}
+
+- (void)tearDown {
+    free(_pixels);
+    free(_referencePixels);
+    free(_mask);
+    [super tearDown];
+}
+
+- (SLImageDiff)diff {
+    return SLImageDiffOfPixels(_pixels, _bytesPerRow, _referencePixels, _bytesPerRow,
+                               _width, _height, 2, _mask, _width);
+}
+
+- (void)testIdenticalRenderingsDoNotDiffer {
+    SLImageDiff diff = [self diff];
+    STAssertEquals(diff.pixelCount, _width * _height, @"Every pixel should have been compared.");
+    STAssertEquals(diff.tileCount, (size_t)6, @"The renderings should have been compared in 16 x 16 tiles.");
+    STAssertEquals(diff.changedTileCount, (size_t)0, @"No tile should have changed.");
+    STAssertEquals(diff.differingPixelCount, (size_t)0, @"No pixel should have differed.");
+    STAssertEquals(diff.score, 0.0, @"The renderings should not have differed.");
+}
+
+- (void)testPixelsDifferOnlyIfAChannelDiffersByMoreThanTheTolerance {
+    _pixels[(5 * _bytesPerRow) + (4 * 3) + 1] += 2;
+    SLImageDiff diff = [self diff];
+    STAssertEquals(diff.changedTileCount, (size_t)1, @"The tile should have changed.");
+    STAssertEquals(diff.differingPixelCount, (size_t)0, @"The pixel should not have differed.");
+
+    _pixels[(5 * _bytesPerRow) + (4 * 3) + 1] += 1;
+    diff = [self diff];
+    STAssertEquals(diff.differingPixelCount, (size_t)1, @"The pixel should have differed.");
+}
+
+- (void)testDifferingPixelsAreMasked {
+    // one pixel in the vectorized portion of a row, one in the scalar portion
+    _pixels[(5 * _bytesPerRow) + (4 * 3) + 0] = 0;
+    _referencePixels[(5 * _bytesPerRow) + (4 * 3) + 0] = 255;
+    _pixels[(20 * _bytesPerRow) + (4 * 36) + 3] = 0;
+    _referencePixels[(20 * _bytesPerRow) + (4 * 36) + 3] = 255;
+
+    SLImageDiff diff = [self diff];
+    STAssertEquals(diff.changedTileCount, (size_t)2, @"Two tiles should have changed.");
+    STAssertEquals(diff.differingPixelCount, (size_t)2, @"Two pixels should have differed.");
+    STAssertEquals(_mask[(5 * _width) + 3], (unsigned char)255, @"The first pixel should have been masked.");
+    STAssertEquals(_mask[(20 * _width) + 36], (unsigned char)255, @"The second pixel should have been masked.");
+
+    size_t maskedPixelCount = 0;
+    for (size_t pixel = 0; pixel < _width * _height; pixel++) {
+        maskedPixelCount += (_mask[pixel] != 0);
+    }
+    STAssertEquals(maskedPixelCount, (size_t)2, @"Only the differing pixels should have been masked.");
+}
+
+- (void)testScoreWeighsLuminanceAndAlpha {
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            unsigned char *pixel = _pixels + (y * _bytesPerRow) + (4 * x);
+            unsigned char *referencePixel = _referencePixels + (y * _bytesPerRow) + (4 * x);
+            pixel[0] = pixel[1] = pixel[2] = 0;
+            pixel[3] = 255;
+            referencePixel[0] = referencePixel[1] = referencePixel[2] = referencePixel[3] = 255;
+        }
+    }
+    STAssertEquals([self diff].score, 1.0, @"Opaque black should differ entirely from opaque white.");
+
+    // blue contributes the least to luminance, but a difference in alpha is weighed fully
+    unsigned char *pixel = _pixels;
+    memcpy(_pixels, _referencePixels, _bytesPerRow * _height);
+    pixel[2] = 0;
+    const double blueScore = [self diff].score;
+    pixel[2] = 255;
+    pixel[3] = 0;
+    const double alphaScore = [self diff].score;
+    STAssertTrue((blueScore > 0.0) && (blueScore < alphaScore), @"A difference in blue should have weighed less than one in alpha.");
+    STAssertEqualsWithAccuracy(alphaScore, 1.0 / (_width * _height), 1e-9, @"A difference in alpha should have weighed fully.");
+}
+
+@end
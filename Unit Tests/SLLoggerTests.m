@@ -0,0 +1,264 @@
+//
+//  SLLoggerTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+#import <Subliminal/Subliminal.h>
+#import <Subliminal/SLTerminal.h>
+#import <OCMock/OCMock.h>
+
+@interface SLLogger (Internal)
+- (instancetype)initWithEventLogPath:(NSString *)eventLogPath;
+@end
+
+@interface SLLoggerTestsDescribedObject : NSObject
+@property (nonatomic) NSUInteger numberOfDescriptions;
+@end
+
+@implementation SLLoggerTestsDescribedObject
+- (NSString *)description {
+    self.numberOfDescriptions++;
+    return [super description];
+}
+@end
+
+
+@interface SLLoggerTests : SenTestCase
+@end
+
+@implementation SLLoggerTests {
+    id _terminalMock;
+    NSMutableArray *_evaluatedScripts;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // record the scripts that the logger evaluates rather than sending them to UIAutomation
+    _evaluatedScripts = [[NSMutableArray alloc] init];
+    NSMutableArray *evaluatedScripts = _evaluatedScripts;
+    _terminalMock = [OCMockObject partialMockForObject:[SLTerminal sharedTerminal]];
+    [[[_terminalMock stub] andDo:^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *script;
+        [invocation getArgument:&script atIndex:2];
+        @synchronized(evaluatedScripts) {
+            [evaluatedScripts addObject:[script copy]];
+        }
+    }] eval:OCMOCK_ANY];
+
+    // discard any messages logged by previous tests
+    [[SLLogger sharedLogger] flush];
+    @synchronized(_evaluatedScripts) {
+        [_evaluatedScripts removeAllObjects];
+    }
+}
+
+- (void)tearDown {
+    [[SLLogger sharedLogger] flush];
+    [_terminalMock stopMocking];
+    [super tearDown];
+}
+
+- (NSArray *)evaluatedScripts {
+    @synchronized(_evaluatedScripts) {
+        return [_evaluatedScripts copy];
+    }
+}
+
+- (void)testMessagesAreBufferedUntilFlushed {
+    [[SLLogger sharedLogger] logMessage:@"foo"];
+    [[SLLogger sharedLogger] logDebug:@"bar"];
+
+    // wait for the messages to be enqueued
+    dispatch_sync([[SLLogger sharedLogger] loggingQueue], ^{});
+    STAssertEquals([[self evaluatedScripts] count], (NSUInteger)0, @"Messages should have been buffered.");
+
+    [[SLLogger sharedLogger] flush];
+    STAssertEqualObjects([self evaluatedScripts], @[ @"UIALogger.logMessage('foo');UIALogger.logDebug('bar');" ],
+                         @"The messages should have been output in a single script.");
+}
+
+- (void)testBufferedMessagesAreOutputAfterAShortInterval {
+    [[SLLogger sharedLogger] logMessage:@"foo"];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    STAssertEqualObjects([self evaluatedScripts], @[ @"UIALogger.logMessage('foo');" ],
+                         @"The message should have been output without being explicitly flushed.");
+}
+
+- (void)testBufferedMessagesAreOutputBeforeTestStatus {
+    [[SLLogger sharedLogger] logMessage:@"foo"];
+    [[SLLogger sharedLogger] logTest:@"Test" caseStart:@"testCase"];
+
+    STAssertEqualObjects([self evaluatedScripts],
+                         @[ @"UIALogger.logMessage('foo');UIALogger.logStart('Test case \\\"-[Test testCase]\\\" started.');" ],
+                         @"The message should have been output, in order, before the test status.");
+}
+
+- (void)testBufferedMessagesAreOutputBeforeErrors {
+    [[SLLogger sharedLogger] logMessage:@"foo"];
+    [[SLLogger sharedLogger] logError:@"bar"];
+
+    STAssertEqualObjects([self evaluatedScripts], @[ @"UIALogger.logMessage('foo');UIALogger.logError('bar');" ],
+                         @"The message should have been output, in order, before the error.");
+}
+
+- (void)testMessagesAreEscaped {
+    [[SLLogger sharedLogger] logMessage:@"'foo'"];
+    [[SLLogger sharedLogger] flush];
+
+    STAssertEqualObjects([self evaluatedScripts], @[ @"UIALogger.logMessage('\\'foo\\'');" ],
+                         @"The message should have been escaped.");
+}
+
+- (void)testEventLogRecordsEventsWithTestStateAndDurations {
+    NSString *eventLogPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"SLLoggerTests.jsonl"];
+    SLLogger *logger = [[SLLogger alloc] initWithEventLogPath:eventLogPath];
+
+    [logger logTestStart:@"Test"];
+    [logger logTest:@"Test" caseStart:@"testCase"];
+    [logger logMessage:@"foo"];
+    NSException *exception = [NSException exceptionWithName:@"SLTestAssertionFailedException" reason:@"bar"
+                                                    userInfo:@{ SLLoggerExceptionFilenameKey: @"Test.m", SLLoggerExceptionLineNumberKey: @(62) }];
+    [logger logException:exception expected:YES];
+    [logger logTest:@"Test" caseFail:@"testCase" expected:YES];
+    [logger logTestFinish:@"Test" withNumCasesExecuted:1 numCasesFailed:1 numCasesFailedUnexpectedly:0];
+    [logger flush];
+
+    NSString *eventLog = [NSString stringWithContentsOfFile:eventLogPath encoding:NSUTF8StringEncoding error:NULL];
+    NSMutableArray *events = [[NSMutableArray alloc] init];
+    [eventLog enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        [events addObject:[NSJSONSerialization JSONObjectWithData:[line dataUsingEncoding:NSUTF8StringEncoding] options:0 error:NULL]];
+    }];
+    [[NSFileManager defaultManager] removeItemAtPath:eventLogPath error:NULL];
+
+    STAssertEqualObjects([events valueForKey:@"type"],
+                         (@[ @"logStarted", @"testStarted", @"testCaseStarted", @"message", @"failure", @"testCaseFailed", @"testFinished" ]),
+                         @"The events were not logged as expected.");
+    STAssertNotNil(events[0][@"date"], @"The log should begin with the date at which it was created.");
+
+    NSDictionary *messageEvent = events[3];
+    STAssertEqualObjects(messageEvent[@"message"], @"foo", @"The message was not logged.");
+    STAssertEqualObjects(messageEvent[@"test"], @"Test", @"The message should have been attributed to the current test.");
+    STAssertEqualObjects(messageEvent[@"testCase"], @"testCase", @"The message should have been attributed to the current test case.");
+
+    NSDictionary *failureEvent = events[4];
+    STAssertEqualObjects(failureEvent[@"fileName"], @"Test.m", @"The failure's call site was not logged.");
+    STAssertEqualObjects(failureEvent[@"lineNumber"], @(62), @"The failure's call site was not logged.");
+
+    NSTimeInterval testCaseDuration = [events[5][@"duration"] doubleValue];
+    NSTimeInterval testDuration = [events[6][@"duration"] doubleValue];
+    STAssertTrue((testCaseDuration >= 0.0) && (testDuration >= testCaseDuration),
+                 @"The durations of the test case and test were not logged as expected.");
+    STAssertNil(events[6][@"testCase"], @"The test's completion should not be attributed to a test case.");
+
+    // the message should only have been written to the event log
+    for (NSString *script in [self evaluatedScripts]) {
+        STAssertTrue([script rangeOfString:@"'foo'"].location == NSNotFound,
+                     @"Messages should not be output to UIAutomation when an event log is being written.");
+    }
+}
+
+#pragma mark - Sinks
+
+- (void)testMessagesBelowEverySinksThresholdAreNotFormatted {
+    SLUIALoggerSink *uiaLoggerSink = [[SLLogger sharedLogger] sinks][0];
+    SLLogLevel originalLevel = uiaLoggerSink.minimumLevel;
+    uiaLoggerSink.minimumLevel = SLLogLevelMessage;
+
+    SLLoggerTestsDescribedObject *object = [[SLLoggerTestsDescribedObject alloc] init];
+    SLLogDebug(@"%@", object);
+    STAssertEquals(object.numberOfDescriptions, (NSUInteger)0, @"The debug message should not have been formatted.");
+
+    SLLog(@"%@", object);
+    STAssertEquals(object.numberOfDescriptions, (NSUInteger)1, @"The message should have been formatted.");
+
+    uiaLoggerSink.minimumLevel = originalLevel;
+}
+
+- (void)testSinksReceiveRecordsAtOrAboveTheirThresholdAndTestStatus {
+    SLLogger *logger = [[SLLogger alloc] initWithEventLogPath:nil];
+    SLRingBufferLoggerSink *sink = [[SLRingBufferLoggerSink alloc] initWithCapacity:10];
+    sink.minimumLevel = SLLogLevelWarning;
+    [logger addSink:sink];
+
+    [logger logDebug:@"foo"];
+    [logger logMessage:@"bar"];
+    [logger logWarning:@"baz"];
+    [logger logTest:@"Test" caseStart:@"testCase"];
+    [logger flush];
+
+    STAssertEqualObjects([[sink records] valueForKey:@"type"], (@[ @"warning", @"testCaseStarted" ]),
+                         @"The sink should only have received the warning and the test status.");
+    STAssertEqualObjects([self evaluatedScripts],
+                         (@[ @"UIALogger.logDebug('foo');UIALogger.logMessage('bar');UIALogger.logWarning('baz');",
+                             @"UIALogger.logStart('Test case \\\"-[Test testCase]\\\" started.');" ]),
+                         @"The UIALogger sink should have received every record.");
+}
+
+- (void)testRingBufferSinkRetainsMostRecentRecords {
+    SLLogger *logger = [[SLLogger alloc] initWithEventLogPath:nil];
+    SLRingBufferLoggerSink *sink = [[SLRingBufferLoggerSink alloc] initWithCapacity:2];
+    [logger addSink:sink];
+
+    [logger logMessage:@"foo"];
+    [logger logMessage:@"bar"];
+    [logger logMessage:@"baz"];
+    [logger flush];
+
+    STAssertEqualObjects([[sink records] valueForKey:@"message"], (@[ @"bar", @"baz" ]),
+                         @"The sink should have retained the most recent records, in order.");
+
+    [sink removeAllRecords];
+    STAssertEquals([[sink records] count], (NSUInteger)0, @"The sink should have discarded its records.");
+}
+
+- (void)testRepeatedMessagesAreLoggedOncePerTestCaseWithTheirCount {
+    SLLogger *logger = [[SLLogger alloc] initWithEventLogPath:nil];
+    SLRingBufferLoggerSink *sink = [[SLRingBufferLoggerSink alloc] initWithCapacity:10];
+    [logger addSink:sink];
+
+    [logger logTest:@"Test" caseStart:@"testCase"];
+    for (NSUInteger i = 0; i < 3; i++) {
+        [logger logOnce:@"foo" level:SLLogLevelWarning];
+    }
+    [logger logOnce:@"bar" level:SLLogLevelMessage];
+    [logger logTest:@"Test" casePass:@"testCase"];
+    [logger logOnce:@"foo" level:SLLogLevelWarning];
+    [logger flush];
+
+    NSArray *records = [sink records];
+    STAssertEqualObjects([records valueForKey:@"message"],
+                         (@[ @"Test case \"-[Test testCase]\" started.",
+                             @"foo", @"bar",
+                             @"The following warning was logged 3 times: foo",
+                             @"Test case \"-[Test testCase]\" passed.",
+                             @"foo" ]),
+                         @"Each message should have been logged once per test case, "
+                         @"with its count logged before the test case finished.");
+    STAssertEqualObjects([records[3] info][@"occurrenceCount"], @3,
+                         @"The count should have been recorded.");
+    STAssertEqualObjects([records[3] info][@"testCase"], @"testCase",
+                         @"The count should have been attributed to the test case.");
+}
+
+@end
+
@@ -0,0 +1,204 @@
+//
+//  SLOcclusionTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLOcclusion.h"
+
+
+static const SLOcclusionTransform SLOcclusionTransformIdentity = { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+
+static SLOcclusionTransform SLOcclusionTransformMakeTranslation(double tx, double ty) {
+    return (SLOcclusionTransform){ 1.0, 0.0, 0.0, 1.0, tx, ty };
+}
+
+static SLOcclusionRect SLOcclusionRectMake(double x, double y, double width, double height) {
+    return (SLOcclusionRect){ x, y, width, height };
+}
+
+static SLOcclusionPoint SLOcclusionPointMake(double x, double y) {
+    return (SLOcclusionPoint){ x, y };
+}
+
+
+@interface SLOcclusionTests : SenTestCase
+@end
+
+@implementation SLOcclusionTests {
+    // a synthetic view hierarchy: a window containing a target view
+    SLOcclusionNode _nodes[8];
+    size_t _nodeCount;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // window: {{0, 0}, {320, 480}}, white background
+    _nodes[0] = SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 480),
+                                    -1, SLOcclusionNodeKindOpaque);
+    // target: {{10, 10}, {100, 100}}
+    _nodes[1] = SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(10, 10), SLOcclusionRectMake(0, 0, 100, 100),
+                                    -1, SLOcclusionNodeKindTarget);
+    _nodeCount = 2;
+}
+
+- (void)appendNode:(SLOcclusionNode)node {
+    _nodes[_nodeCount++] = node;
+}
+
+#pragma mark - Basic visibility
+
+- (void)testTargetIsVisibleWithinItsBounds {
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityVisible, @"The target should be visible within its bounds.");
+}
+
+- (void)testTargetIsNotVisibleOutsideItsBounds {
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(110.5, 60.5)),
+                   SLOcclusionVisibilityOccluded, @"The target should not be visible outside its bounds.");
+}
+
+- (void)testOpaqueNodesDrawnBeforeTheTargetDoNotOccludeIt {
+    // the window is opaque but is drawn before the target
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(10.5, 10.5)),
+                   SLOcclusionVisibilityVisible, @"Nodes drawn before the target should not occlude it.");
+}
+
+#pragma mark - Occlusion
+
+- (void)testOpaqueNodesDrawnAfterTheTargetOccludeIt {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityOccluded, @"An opaque node drawn after the target should occlude it.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 20.5)),
+                   SLOcclusionVisibilityVisible, @"An opaque node should only occlude the target within its bounds.");
+}
+
+- (void)testTransparentNodesDoNotOccludeTheTarget {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 480),
+                                         -1, SLOcclusionNodeKindTransparent)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityVisible, @"A transparent node should not occlude the target.");
+}
+
+- (void)testTargetDescendantsDrawnAfterAnOccluderAreVisible {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 480),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindTarget)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityVisible, @"A target node drawn after an occluder should be visible.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 20.5)),
+                   SLOcclusionVisibilityOccluded, @"The occluder should still occlude the rest of the target.");
+}
+
+- (void)testIndeterminateNodesCoveringTheTargetCannotBeResolved {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindIndeterminate)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityIndeterminate, @"The visibility of a point covered by an indeterminate node should be indeterminate.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 20.5)),
+                   SLOcclusionVisibilityVisible, @"An indeterminate node should not affect points outside its bounds.");
+}
+
+- (void)testIndeterminateNodesCoveringOccludedPointsDoNotAffectVisibility {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindIndeterminate)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityOccluded, @"An indeterminate node cannot make an occluded point visible.");
+}
+
+#pragma mark - Transforms and clipping
+
+- (void)testNodesAreTransformed {
+    // a 10x40 occluder rotated by 90 degrees and translated to {120, 50}, covering {{80, 50}, {40, 10}}
+    [self appendNode:SLOcclusionNodeMake((SLOcclusionTransform){ 0.0, 1.0, -1.0, 0.0, 120, 50 },
+                                         SLOcclusionRectMake(0, 0, 10, 40),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(90.5, 55.5)),
+                   SLOcclusionVisibilityOccluded, @"The rotated occluder should cover the point.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(90.5, 65.5)),
+                   SLOcclusionVisibilityVisible, @"The rotated occluder should not cover the point.");
+}
+
+- (void)testNonInvertibleNodesCoverNothing {
+    [self appendNode:SLOcclusionNodeMake((SLOcclusionTransform){ 0.0, 0.0, 0.0, 0.0, 60, 60 },
+                                         SLOcclusionRectMake(0, 0, 100, 100),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.0, 60.0)),
+                   SLOcclusionVisibilityVisible, @"A node scaled to zero should not cover any point.");
+}
+
+- (void)testNodesAreClippedByTheirAncestors {
+    // a transparent clipping container at {{0, 0}, {50, 480}}, containing a full-screen occluder
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 50, 480),
+                                         -1, SLOcclusionNodeKindTransparent)];
+    long clipIndex = (long)_nodeCount - 1;
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 480),
+                                         clipIndex, SLOcclusionNodeKindOpaque)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 60.5)),
+                   SLOcclusionVisibilityOccluded, @"The occluder should cover points within its container.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 60.5)),
+                   SLOcclusionVisibilityVisible, @"The occluder should be clipped to its container.");
+}
+
+- (void)testClippingIsCumulative {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 50, 480),
+                                         -1, SLOcclusionNodeKindTransparent)];
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 50),
+                                         (long)_nodeCount - 1, SLOcclusionNodeKindTransparent)];
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformIdentity, SLOcclusionRectMake(0, 0, 320, 480),
+                                         (long)_nodeCount - 1, SLOcclusionNodeKindOpaque)];
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 20.5)),
+                   SLOcclusionVisibilityOccluded, @"The occluder should cover points within both clipping ancestors.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(20.5, 60.5)),
+                   SLOcclusionVisibilityVisible, @"The occluder should be clipped by its parent.");
+    STAssertEquals(SLOcclusionVisibilityOfPoint(_nodes, _nodeCount, SLOcclusionPointMake(60.5, 20.5)),
+                   SLOcclusionVisibilityVisible, @"The occluder should be clipped by its grandparent.");
+}
+
+#pragma mark - Counting visible points
+
+- (void)testNumberOfVisiblePoints {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindOpaque)];
+    SLOcclusionPoint points[] = {
+        SLOcclusionPointMake(10.5, 10.5), SLOcclusionPointMake(60.5, 60.5), SLOcclusionPointMake(109.5, 109.5)
+    };
+    STAssertEquals(SLOcclusionNumberOfVisiblePoints(_nodes, _nodeCount, points, 3), 2L,
+                   @"Two of the three points should be visible.");
+}
+
+- (void)testNumberOfVisiblePointsIsIndeterminateIfAnyPointIsIndeterminate {
+    [self appendNode:SLOcclusionNodeMake(SLOcclusionTransformMakeTranslation(50, 50), SLOcclusionRectMake(0, 0, 20, 20),
+                                         -1, SLOcclusionNodeKindIndeterminate)];
+    SLOcclusionPoint points[] = {
+        SLOcclusionPointMake(10.5, 10.5), SLOcclusionPointMake(60.5, 60.5)
+    };
+    STAssertEquals(SLOcclusionNumberOfVisiblePoints(_nodes, _nodeCount, points, 2), -1L,
+                   @"The number of visible points should be indeterminate.");
+}
+
+@end
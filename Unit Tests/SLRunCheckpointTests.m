@@ -0,0 +1,157 @@
+//
+//  SLRunCheckpointTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLRunCheckpoint.h"
+#import "SharedSLTests.h"
+
+@interface SLRunCheckpointTests : SenTestCase
+@end
+
+@implementation SLRunCheckpointTests {
+    NSString *_checkpointPath;
+}
+
+- (void)setUp {
+    NSString *filename = [NSString stringWithFormat:@"SLRunCheckpointTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    _checkpointPath = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_checkpointPath error:NULL];
+}
+
+- (void)testProgressIsReadBackFromTheFile {
+    NSArray *tests = @[ [TestWithSomeTestCases class], [TestOneOfRunGroupOne class], [TestTwoOfRunGroupOne class] ];
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithSeed:27 tests:tests];
+    STAssertTrue([checkpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [checkpoint recordStartOfTest:[TestWithSomeTestCases class]];
+    [checkpoint recordStartOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [checkpoint recordCompletionOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class] failed:YES unexpectedly:YES];
+    [checkpoint recordCompletionOfTest:[TestWithSomeTestCases class] aborted:NO failed:YES];
+    [checkpoint recordStartOfTest:[TestOneOfRunGroupOne class]];
+    [checkpoint recordStartOfTestCase:@"testFoo" inTest:[TestOneOfRunGroupOne class]];
+
+    SLRunCheckpoint *readCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertEquals([readCheckpoint seed], (unsigned int)27, @"The seed of the run should have been read.");
+    STAssertEqualObjects([readCheckpoint testNames], (@[ @"TestWithSomeTestCases", @"TestOneOfRunGroupOne", @"TestTwoOfRunGroupOne" ]),
+                         @"The tests of the run should have been read.");
+    STAssertFalse([readCheckpoint runWasCompleted], @"The run should not have completed.");
+    STAssertEquals([readCheckpoint numTestsCompleted], (NSUInteger)1, @"One test should have completed.");
+    STAssertEquals([readCheckpoint numTestsFailed], (NSUInteger)1, @"One test should have failed.");
+    STAssertEqualObjects([readCheckpoint failures], (@[ @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testOne" } ]),
+                         @"The failed test case should have been read.");
+    NSUInteger numTestCasesFailed = 0, numTestCasesFailedUnexpectedly = 0;
+    STAssertEquals([readCheckpoint numTestCasesCompletedInTest:[TestWithSomeTestCases class]
+                                                        failed:&numTestCasesFailed
+                                            failedUnexpectedly:&numTestCasesFailedUnexpectedly],
+                   (NSUInteger)1, @"The completed test case should have been counted.");
+    STAssertEquals(numTestCasesFailed, (NSUInteger)1, @"The failed test case should have been counted.");
+    STAssertEquals(numTestCasesFailedUnexpectedly, (NSUInteger)1, @"The test case should have been counted as failing unexpectedly.");
+
+    NSSet *allTests = [NSSet setWithArray:tests];
+    STAssertEqualObjects([readCheckpoint testsToResumeFromTests:allTests], (@[ [TestOneOfRunGroupOne class], [TestTwoOfRunGroupOne class] ]),
+                         @"The tests which did not complete should be resumed, in order.");
+    STAssertEqualObjects([readCheckpoint interruptedTestCaseOfTest:[TestOneOfRunGroupOne class]], @"testFoo",
+                         @"The test case which was running should have been identified.");
+    STAssertFalse([readCheckpoint testWasInterruptedOutsideOfTestCase:[TestOneOfRunGroupOne class]],
+                  @"The test was interrupted while running a test case.");
+    STAssertEquals([[readCheckpoint testCasesToResumeFromTestCases:[NSSet setWithObject:@"testFoo"] ofTest:[TestOneOfRunGroupOne class]] count],
+                   (NSUInteger)0, @"The interrupted test case should not be resumed.");
+}
+
+- (void)testTestsInterruptedOutsideOfATestCaseAreIdentified {
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithSeed:27 tests:@[ [TestWithSomeTestCases class] ]];
+    STAssertTrue([checkpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [checkpoint recordStartOfTest:[TestWithSomeTestCases class]];
+    [checkpoint recordStartOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [checkpoint recordCompletionOfTestCase:@"testOne" inTest:[TestWithSomeTestCases class] failed:NO unexpectedly:NO];
+
+    SLRunCheckpoint *readCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertTrue([readCheckpoint testWasInterruptedOutsideOfTestCase:[TestWithSomeTestCases class]],
+                 @"The test was interrupted while not running a test case.");
+    STAssertNil([readCheckpoint interruptedTestCaseOfTest:[TestWithSomeTestCases class]],
+                @"No test case was running when the test was interrupted.");
+    NSSet *testCases = [NSSet setWithObjects:@"testOne", @"testTwo", @"testThree", nil];
+    STAssertEqualObjects([readCheckpoint testCasesToResumeFromTestCases:testCases ofTest:[TestWithSomeTestCases class]],
+                         ([NSSet setWithObjects:@"testTwo", @"testThree", nil]), @"Completed test cases should not be resumed.");
+}
+
+- (void)testFixturesInterruptedWhileBeingSetUpAreIdentified {
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithSeed:27 tests:@[ [TestOneWithSharedFixtures class] ]];
+    STAssertTrue([checkpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [checkpoint recordStartOfFixtureSetUp:@selector(setUpSuite) inClass:[AbstractTestWithSharedFixtures class]];
+    [checkpoint recordCompletionOfFixtureSetUp:@selector(setUpSuite) inClass:[AbstractTestWithSharedFixtures class]];
+    [checkpoint recordStartOfFixtureSetUp:@selector(setUpRunGroup) inClass:[AbstractTestWithSharedFixtures class]];
+
+    SLRunCheckpoint *readCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertTrue([readCheckpoint fixtureSetUpWasInterrupted:@selector(setUpRunGroup) inClass:[AbstractTestWithSharedFixtures class]],
+                 @"The fixture was interrupted while being set up.");
+    STAssertFalse([readCheckpoint fixtureSetUpWasInterrupted:@selector(setUpSuite) inClass:[AbstractTestWithSharedFixtures class]],
+                  @"The fixture completed being set up.");
+    STAssertFalse([readCheckpoint runWasCompleted], @"A fixture's records should not be mistaken for the completion of the run.");
+}
+
+- (void)testCompletedRunsAreIdentified {
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithSeed:27 tests:@[ [TestWithSomeTestCases class] ]];
+    STAssertTrue([checkpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [checkpoint recordStartOfTest:[TestWithSomeTestCases class]];
+    [checkpoint recordCompletionOfTest:[TestWithSomeTestCases class] aborted:NO failed:NO];
+    [checkpoint recordCompletionOfRun];
+
+    SLRunCheckpoint *readCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertTrue([readCheckpoint runWasCompleted], @"The run should have completed.");
+}
+
+- (void)testAPartiallyWrittenRecordIsIgnoredAndTerminatedWhenResuming {
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithSeed:27 tests:@[ [TestWithSomeTestCases class] ]];
+    STAssertTrue([checkpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [checkpoint recordStartOfTest:[TestWithSomeTestCases class]];
+    checkpoint = nil;
+
+    // simulate the application crashing while writing a record
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:_checkpointPath];
+    [fileHandle seekToEndOfFile];
+    [fileHandle writeData:[@"{\"test\": \"TestWithSomeTe" dataUsingEncoding:NSUTF8StringEncoding]];
+    [fileHandle closeFile];
+
+    SLRunCheckpoint *resumedCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertNotNil(resumedCheckpoint, @"The checkpoint should have been read despite the partially-written record.");
+    STAssertTrue([resumedCheckpoint openFileAtPath:_checkpointPath error:NULL], @"The file should have been opened.");
+    [resumedCheckpoint recordCompletionOfTest:[TestWithSomeTestCases class] aborted:YES failed:YES];
+    resumedCheckpoint = nil;
+
+    SLRunCheckpoint *readCheckpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:NULL];
+    STAssertEquals([readCheckpoint numTestsCompleted], (NSUInteger)1, @"The record appended after resuming should have been read.");
+}
+
+- (void)testAFileThatIsNotACheckpointCannotBeRead {
+    [@"{ \"foo\": 1 }\n" writeToFile:_checkpointPath atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+
+    NSError *error = nil;
+    STAssertNil([[SLRunCheckpoint alloc] initWithContentsOfFile:_checkpointPath error:&error],
+                @"A file that is not a checkpoint should not have been read.");
+    STAssertNotNil(error, @"An error should have been returned.");
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  SLScreenshotWriterTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLScreenshotWriter.h"
+
+@interface SLScreenshotWriterTests : SenTestCase
+@end
+
+@implementation SLScreenshotWriterTests {
+    NSString *_directory;
+    SLScreenshotWriter *_writer;
+    UIView *_view;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    NSString *directoryName = [NSString stringWithFormat:@"SLScreenshotWriterTests-%@", [[NSProcessInfo processInfo] globallyUniqueString]];
+    _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:directoryName];
+    _writer = [[SLScreenshotWriter alloc] initWithDirectory:_directory];
+
+    _view = [[UIView alloc] initWithFrame:CGRectMake(0.0, 0.0, 20.0, 20.0)];
+    _view.backgroundColor = [UIColor redColor];
+}
+
+- (void)tearDown {
+    [_writer waitUntilScreenshotsAreWritten];
+    [[NSFileManager defaultManager] removeItemAtPath:_directory error:NULL];
+    [super tearDown];
+}
+
+- (void)captureWithFilename:(NSString *)filename inRect:(CGRect)rect {
+    [_writer captureViews:@[ _view ] onScreenOfSize:CGSizeMake(20.0, 20.0) scale:2.0 inRect:rect withFilename:filename];
+}
+
+- (NSArray *)writtenFilenames {
+    [_writer waitUntilScreenshotsAreWritten];
+    NSArray *filenames = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directory error:NULL];
+    return [filenames sortedArrayUsingSelector:@selector(compare:)];
+}
+
+- (void)testScreenshotsAreWrittenAsPNGsAtTheScreensScale {
+    [self captureWithFilename:@"foo" inRect:CGRectNull];
+
+    STAssertEqualObjects([self writtenFilenames], @[ @"foo.png" ], @"The screenshot should have been written.");
+    UIImage *image = [UIImage imageWithContentsOfFile:[_directory stringByAppendingPathComponent:@"foo.png"]];
+    STAssertEquals(image.size, CGSizeMake(40.0, 40.0), @"The screenshot should have been rendered at the screen's scale.");
+}
+
+- (void)testScreenshotsCanBeCroppedToARect {
+    [self captureWithFilename:@"foo" inRect:CGRectMake(5.0, 5.0, 10.0, 5.0)];
+
+    UIImage *image = [UIImage imageWithContentsOfFile:[_directory stringByAppendingPathComponent:@"foo.png"]];
+    STAssertEquals(image.size, CGSizeMake(20.0, 10.0), @"The screenshot should have been cropped to the rect.");
+}
+
+- (void)testScreenshotsIdenticalToThePreviousScreenshotAreNotWritten {
+    [self captureWithFilename:@"foo" inRect:CGRectNull];
+    [self captureWithFilename:@"bar" inRect:CGRectNull];
+
+    _view.backgroundColor = [UIColor blueColor];
+    [self captureWithFilename:@"baz" inRect:CGRectNull];
+
+    STAssertEqualObjects([self writtenFilenames], (@[ @"baz.png", @"foo.png" ]),
+                         @"The second screenshot should not have been written.");
+}
+
+- (void)testScreenshotsWithTheSameNameAreNotOverwritten {
+    [self captureWithFilename:@"foo" inRect:CGRectNull];
+    _view.backgroundColor = [UIColor blueColor];
+    [self captureWithFilename:@"foo" inRect:CGRectNull];
+
+    STAssertEqualObjects([self writtenFilenames], (@[ @"foo 1.png", @"foo.png" ]),
+                         @"The second screenshot should have been written under a distinct name.");
+}
+
+@end
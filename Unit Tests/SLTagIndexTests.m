@@ -0,0 +1,94 @@
+//
+//  SLTagIndexTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+#import <OCMock/OCMock.h>
+
+#import "SLTagIndex.h"
+#import "SharedSLTests.h"
+
+@interface SLTagIndexTests : SenTestCase
+@end
+
+@implementation SLTagIndexTests
+
+- (void)testAnIndexWithoutTagsMatchesEverything {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:nil];
+    STAssertTrue([tagIndex matchesTest:[TestWithTagAAAandCCC class]], @"The test should have matched.");
+    STAssertTrue([tagIndex matchesTestCaseWithSelector:@selector(testOtherCase) ofTest:[TestWithSomeTaggedTestCases class]],
+                 @"The test case should have matched.");
+}
+
+- (void)testTestsMatchIfTaggedWithAnInclusionTagAndNoExclusionTags {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:[NSSet setWithObjects:@"CCC", @"-BBB", nil]];
+    STAssertTrue([tagIndex matchesTest:[TestWithTagAAAandCCC class]], @"The test should have matched.");
+    STAssertFalse([tagIndex matchesTest:[TestWithTagBBBandCCC class]], @"The test should have been excluded.");
+    STAssertFalse([tagIndex matchesTest:[TestWithSomeTestCases class]], @"The test should not have been included.");
+}
+
+- (void)testTestCasesMatchByTheirUnfocusedNames {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:[NSSet setWithObject:@"testTwo"]];
+    STAssertTrue([tagIndex matchesTestCaseWithSelector:@selector(testTwo) ofTest:[TestWithAFocusedTestCase class]],
+                 @"The test case should have matched.");
+    STAssertFalse([tagIndex matchesTestCaseWithSelector:@selector(testOne) ofTest:[TestWithAFocusedTestCase class]],
+                  @"The test case should not have matched.");
+}
+
+- (void)testTestCasesMatchByTheTagsTheirTestsAssign {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:[NSSet setWithObjects:@"CCC", @"-AAA", nil]];
+    Class testClass = [TestWithSomeTaggedTestCases class];
+    STAssertTrue([tagIndex matchesTestCaseWithSelector:@selector(testCaseWithTagBBBandCCC) ofTest:testClass],
+                 @"The test case should have matched.");
+    STAssertFalse([tagIndex matchesTestCaseWithSelector:@selector(testCaseWithTagAAAandCCC) ofTest:testClass],
+                  @"The test case should have been excluded.");
+    STAssertFalse([tagIndex matchesTestCaseWithSelector:@selector(testOtherCase) ofTest:testClass],
+                  @"The test case should not have been included.");
+}
+
+- (void)testTagsAreReadOncePerTest {
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:[NSSet setWithObject:@"AAA"]];
+
+    id testMock = [OCMockObject partialMockForClass:[TestWithTagAAAandCCC class]];
+    [[[testMock expect] andForwardToRealObject] tags];
+    [[testMock reject] tags];
+
+    STAssertTrue([tagIndex matchesTest:[TestWithTagAAAandCCC class]], @"The test should have matched.");
+    STAssertTrue([tagIndex matchesTestCaseWithSelector:@selector(testFoo) ofTest:[TestWithTagAAAandCCC class]],
+                 @"The test case should have matched.");
+    STAssertNoThrow([testMock verify], @"The test's tags should have been read exactly once.");
+    [testMock stopMocking];
+}
+
+- (void)testIndexesMayHaveMoreTagsThanFitInAWord {
+    NSMutableSet *tags = [[NSMutableSet alloc] init];
+    for (NSUInteger i = 0; i < 200; i++) {
+        [tags addObject:[NSString stringWithFormat:@"tag%lu", (unsigned long)i]];
+    }
+    [tags addObject:@"-BBB"];
+    [tags addObject:@"CCC"];
+
+    SLTagIndex *tagIndex = [[SLTagIndex alloc] initWithTags:tags];
+    STAssertTrue([tagIndex matchesTest:[TestWithTagAAAandCCC class]], @"The test should have matched.");
+    STAssertFalse([tagIndex matchesTest:[TestWithTagBBBandCCC class]], @"The test should have been excluded.");
+}
+
+@end
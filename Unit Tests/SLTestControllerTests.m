@@ -26,6 +26,7 @@
 #import <OCMock/OCMock.h>
 
 #import "SLTest+Internal.h"
+#import "SLRunCheckpoint.h"
 #import "TestUtilities.h"
 #import "SharedSLTests.h"
 
@@ -55,7 +56,8 @@
     if ((testMethod == @selector(testTestsRunInRandomOrderWithinRunGroupsWhen_SLTestControllerRandomSeed_IsSpecified)) ||
         (testMethod == @selector(testTestsRunInDeterminateOrderWithinRunGroupsWhenASeedIsSpecified)) ||
         (testMethod == @selector(testTheSeedUsedIsLoggedIfATestFails)) ||
-        (testMethod == @selector(testTheUserIsWarnedWhenUsingAPredeterminedSeed))) {
+        (testMethod == @selector(testTheUserIsWarnedWhenUsingAPredeterminedSeed)) ||
+        (testMethod == @selector(testTestsRunInTheOrderDeterminedByASpecifiedSeedEvenIfDurationsHaveBeenRecorded))) {
         _testsUsedToTestRandomizationWithinRunGroups = [NSSet setWithObjects:
             [TestWithSomeTestCases class],
             [TestWhichSupportsAllPlatforms class],
@@ -68,8 +70,43 @@
 }
 
 - (void)tearDownTestWithSelector:(SEL)testMethod {
+    NSString *timingsPath = [SLTestController sharedTestController].timingsPath;
+    if (timingsPath) {
+        [[NSFileManager defaultManager] removeItemAtPath:timingsPath error:NULL];
+        [[NSFileManager defaultManager] removeItemAtPath:[timingsPath stringByAppendingString:@".lock"] error:NULL];
+        [SLTestController sharedTestController].timingsPath = nil;
+    }
+    NSString *timingsOutputPath = [SLTestController sharedTestController].timingsOutputPath;
+    if (timingsOutputPath) {
+        [[NSFileManager defaultManager] removeItemAtPath:timingsOutputPath error:NULL];
+        [[NSFileManager defaultManager] removeItemAtPath:[timingsOutputPath stringByAppendingString:@".lock"] error:NULL];
+        [SLTestController sharedTestController].timingsOutputPath = nil;
+    }
+    for (NSString *manifestPath in @[ [SLTestController sharedTestController].failureManifestPath ?: @"",
+                                      [SLTestController sharedTestController].rerunManifestPath ?: @"" ]) {
+        if ([manifestPath length]) [[NSFileManager defaultManager] removeItemAtPath:manifestPath error:NULL];
+    }
+    [SLTestController sharedTestController].failureManifestPath = nil;
+    [SLTestController sharedTestController].rerunManifestPath = nil;
+    NSString *checkpointPath = [SLTestController sharedTestController].checkpointPath;
+    if (checkpointPath) {
+        [[NSFileManager defaultManager] removeItemAtPath:checkpointPath error:NULL];
+        [SLTestController sharedTestController].checkpointPath = nil;
+    }
+    NSString *timeProfilePath = [SLTestController sharedTestController].timeProfilePath;
+    if (timeProfilePath) {
+        [[NSFileManager defaultManager] removeItemAtPath:timeProfilePath error:NULL];
+        [SLTestController sharedTestController].timeProfilePath = nil;
+    }
+
     if (testMethod == @selector(testTheUserIsNotifiedWhenRunningTaggedTests)) {
         unsetenv("SL_TAGS");
+    } else if ((testMethod == @selector(testEachTestRunsInExactlyOneShard)) ||
+               (testMethod == @selector(testTestsAreAssignedToShardsIndependentlyOfTheSeed)) ||
+               (testMethod == @selector(testTheUserIsNotifiedWhenRunningAShard)) ||
+               (testMethod == @selector(testShardsAreBalancedByRecordedDuration))) {
+        [SLTestController sharedTestController].shardIndex = 0;
+        [SLTestController sharedTestController].shardCount = 1;
     }
 }
 
@@ -354,6 +391,565 @@ static const NSUInteger kNumSeedTrials = 100;
     STAssertNoThrow([_loggerMock verify], @"Test was not run/messages were not logged as expected.");
 }
 
+#pragma mark -Sharding
+
+- (NSSet *)testsUsedToTestSharding {
+    return [NSSet setWithObjects:
+        [TestOneOfRunGroupOne class],
+        [TestTwoOfRunGroupOne class],
+        [TestOneOfRunGroupTwo class],
+        [TestTwoOfRunGroupTwo class],
+        [TestThreeOfRunGroupTwo class],
+        [TestOneOfRunGroupThree class],
+        nil
+    ];
+}
+
+- (NSArray *)runOrderOfShard:(NSUInteger)shardIndex ofCount:(NSUInteger)shardCount usingTests:(NSSet *)tests seed:(unsigned int)seed {
+    [SLTestController sharedTestController].shardCount = shardCount;
+    [SLTestController sharedTestController].shardIndex = shardIndex;
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsUsingSeedAndWaitUntilFinished(tests, seed, nil);
+    // only the tests of the shard will have run, so don't verify the mocks
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    return [runOrder copy];
+}
+
+- (void)testEachTestRunsInExactlyOneShard {
+    NSSet *tests = [self testsUsedToTestSharding];
+
+    const NSUInteger kShardCount = 3;
+    NSCountedSet *testsRun = [[NSCountedSet alloc] init];
+    for (NSUInteger shardIndex = 0; shardIndex < kShardCount; shardIndex++) {
+        NSArray *runOrder = [self runOrderOfShard:shardIndex ofCount:kShardCount usingTests:tests seed:SLTestControllerRandomSeed];
+        STAssertTrue([runOrder count] > 0, @"Shard %lu did not run any tests.", (unsigned long)shardIndex);
+
+        NSArray *runGroups = [runOrder valueForKey:@"runGroup"];
+        STAssertEqualObjects(runGroups, [runGroups sortedArrayUsingSelector:@selector(compare:)],
+                             @"Tests were not run in ascending order of group within shard %lu.", (unsigned long)shardIndex);
+
+        [testsRun addObjectsFromArray:runOrder];
+    }
+
+    STAssertEqualObjects([NSSet setWithArray:[testsRun allObjects]], tests, @"Not all tests were run by the shards.");
+    for (Class test in tests) {
+        STAssertTrue([testsRun countForObject:test] == 1, @"%@ was run by more than one shard.", test);
+    }
+}
+
+- (void)testTestsAreAssignedToShardsIndependentlyOfTheSeed {
+    NSSet *tests = [self testsUsedToTestSharding];
+
+    NSSet *testsRunUsingFirstSeed = [NSSet setWithArray:[self runOrderOfShard:1 ofCount:2 usingTests:tests seed:716839131]];
+    NSSet *testsRunUsingSecondSeed = [NSSet setWithArray:[self runOrderOfShard:1 ofCount:2 usingTests:tests seed:27]];
+    STAssertEqualObjects(testsRunUsingFirstSeed, testsRunUsingSecondSeed,
+                         @"The tests assigned to a shard should not depend on the seed.");
+}
+
+- (void)testTheUserIsNotifiedWhenRunningAShard {
+    [SLTestController sharedTestController].shardCount = 2;
+    [SLTestController sharedTestController].shardIndex = 1;
+
+    [[_loggerMock expect] logMessage:@"Running 3 tests in shard 2 of 2."];
+    [[_loggerMock expect] logTestingStart];
+
+    SLRunTestsAndWaitUntilFinished([self testsUsedToTestSharding], nil);
+    STAssertNoThrow([_loggerMock verify], @"Test was not run/messages were not logged as expected.");
+}
+
+#pragma mark -Scheduling by duration
+
+// writes a timings file recording the specified durations (keyed by test name)
+// and directs the shared test controller to use it
+- (void)useTimingsWithDurations:(NSDictionary *)durations {
+    NSMutableDictionary *tests = [[NSMutableDictionary alloc] initWithCapacity:[durations count]];
+    for (NSString *testName in durations) {
+        tests[testName] = @{ @"duration": durations[testName], @"testCases": @{} };
+    }
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"version": @1, @"tests": tests } options:0 error:NULL];
+
+    NSString *timingsPath = [SLTestController sharedTestController].timingsPath;
+    if (!timingsPath) {
+        NSString *filename = [NSString stringWithFormat:@"SLTestControllerTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+        timingsPath = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+        [SLTestController sharedTestController].timingsPath = timingsPath;
+    }
+    [data writeToFile:timingsPath atomically:YES];
+}
+
+- (void)testTestsRunLongestFirstWithinRunGroupsWhenDurationsHaveBeenRecorded {
+    NSSet *tests = [self testsUsedToTestSharding];
+    [self useTimingsWithDurations:@{
+        @"TestOneOfRunGroupOne":    @1,
+        @"TestTwoOfRunGroupOne":    @5,
+        @"TestOneOfRunGroupTwo":    @2,
+        @"TestTwoOfRunGroupTwo":    @7,
+        @"TestThreeOfRunGroupTwo":  @3,
+        @"TestOneOfRunGroupThree":  @4
+    }];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([testMocks makeObjectsPerformSelector:@selector(verify)], @"One or more tests were not run.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    NSArray *expectedRunOrder = @[
+        [TestTwoOfRunGroupOne class], [TestOneOfRunGroupOne class],
+        [TestTwoOfRunGroupTwo class], [TestThreeOfRunGroupTwo class], [TestOneOfRunGroupTwo class],
+        [TestOneOfRunGroupThree class]
+    ];
+    STAssertEqualObjects(runOrder, expectedRunOrder,
+                         @"Tests should have run in ascending order of group, and longest-first within each group.");
+}
+
+- (void)testTestsRunInTheOrderDeterminedByASpecifiedSeedEvenIfDurationsHaveBeenRecorded {
+    NSSet *tests = _testsUsedToTestRandomizationWithinRunGroups;
+    const unsigned int kSeed = 27;
+
+    NSMutableArray *runOrderWithoutDurations = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrderWithoutDurations];
+    SLRunTestsUsingSeedAndWaitUntilFinished(tests, kSeed, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    // record durations that would reverse the seeded order were the tests to run longest-first
+    NSMutableDictionary *durations = [[NSMutableDictionary alloc] initWithCapacity:[tests count]];
+    [runOrderWithoutDurations enumerateObjectsUsingBlock:^(Class test, NSUInteger idx, BOOL *stop) {
+        durations[NSStringFromClass(test)] = @(idx + 1);
+    }];
+    [self useTimingsWithDurations:durations];
+
+    NSMutableArray *runOrderWithDurations = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrderWithDurations];
+    SLRunTestsUsingSeedAndWaitUntilFinished(tests, kSeed, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    STAssertEqualObjects(runOrderWithDurations, runOrderWithoutDurations,
+                         @"Tests should have run in the order determined by the seed, regardless of their durations.");
+}
+
+- (void)testShardsAreBalancedByRecordedDuration {
+    NSSet *tests = [self testsUsedToTestSharding];
+    NSDictionary *durations = @{
+        @"TestOneOfRunGroupOne":    @100,
+        @"TestTwoOfRunGroupOne":    @1,
+        @"TestOneOfRunGroupTwo":    @1,
+        @"TestTwoOfRunGroupTwo":    @1,
+        @"TestThreeOfRunGroupTwo":  @1,
+        @"TestOneOfRunGroupThree":  @1
+    };
+
+    [self useTimingsWithDurations:durations];
+    NSString *timingsPath = [SLTestController sharedTestController].timingsPath;
+    NSData *timingsData = [NSData dataWithContentsOfFile:timingsPath];
+
+    NSArray *firstShardRunOrder = [self runOrderOfShard:0 ofCount:2 usingTests:tests seed:SLTestControllerRandomSeed];
+    STAssertEqualObjects([NSData dataWithContentsOfFile:timingsPath], timingsData,
+                         @"The first shard should not have recorded its durations, lest the second shard be partitioned differently.");
+    NSArray *secondShardRunOrder = [self runOrderOfShard:1 ofCount:2 usingTests:tests seed:SLTestControllerRandomSeed];
+    STAssertEqualObjects([NSData dataWithContentsOfFile:timingsPath], timingsData,
+                         @"The second shard should not have recorded its durations.");
+
+    STAssertEqualObjects(firstShardRunOrder, @[ [TestOneOfRunGroupOne class] ],
+                         @"The longest test should have been assigned to a shard by itself.");
+    NSMutableSet *expectedSecondShardTests = [tests mutableCopy];
+    [expectedSecondShardTests removeObject:[TestOneOfRunGroupOne class]];
+    STAssertEqualObjects([NSSet setWithArray:secondShardRunOrder], expectedSecondShardTests,
+                         @"The other tests should have been assigned to the other shard.");
+}
+
+- (void)testShardsRecordTheirDurationsToTheTimingsOutputFile {
+    NSSet *tests = [self testsUsedToTestSharding];
+    [self useTimingsWithDurations:@{ @"TestOneOfRunGroupOne": @100, @"TestThatIsNotFocused": @3 }];
+    NSString *timingsPath = [SLTestController sharedTestController].timingsPath;
+    NSData *timingsData = [NSData dataWithContentsOfFile:timingsPath];
+    NSString *filename = [NSString stringWithFormat:@"SLTestControllerTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    [SLTestController sharedTestController].timingsOutputPath = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+
+    (void)[self runOrderOfShard:0 ofCount:2 usingTests:tests seed:SLTestControllerRandomSeed];
+    (void)[self runOrderOfShard:1 ofCount:2 usingTests:tests seed:SLTestControllerRandomSeed];
+    STAssertEqualObjects([NSData dataWithContentsOfFile:timingsPath], timingsData,
+                         @"The shards should not have written to the timings file.");
+
+    NSData *data = [NSData dataWithContentsOfFile:[SLTestController sharedTestController].timingsOutputPath];
+    NSDictionary *timings = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL][@"tests"];
+    NSMutableSet *expectedTestNames = [NSMutableSet setWithObject:@"TestThatIsNotFocused"];
+    for (Class test in tests) [expectedTestNames addObject:NSStringFromClass(test)];
+    STAssertEqualObjects([NSSet setWithArray:[timings allKeys]], expectedTestNames,
+                         @"The durations of both shards' tests should have been added to those read from the timings file.");
+}
+
+- (void)testTheDurationsOfTestsAreRecordedToTheTimingsFile {
+    NSSet *tests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    [self useTimingsWithDurations:@{ @"TestThatIsNotFocused": @3 }];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+
+    NSData *data = [NSData dataWithContentsOfFile:[SLTestController sharedTestController].timingsPath];
+    NSDictionary *timings = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL][@"tests"];
+    STAssertEqualObjects([NSSet setWithArray:[timings allKeys]],
+                         ([NSSet setWithObjects:@"TestWithSomeTestCases", @"TestOneOfRunGroupOne", @"TestThatIsNotFocused", nil]),
+                         @"The durations of the tests that ran should have been added to those already recorded.");
+    STAssertEqualObjects([NSSet setWithArray:[timings[@"TestWithSomeTestCases"][@"testCases"] allKeys]],
+                         ([NSSet setWithObjects:@"testOne", @"testTwo", @"testThree", nil]),
+                         @"The durations of the test's cases should have been recorded.");
+}
+
+- (void)testTheUserIsNotifiedWhenRunningTestsByDuration {
+    [self useTimingsWithDurations:@{ @"TestOneOfRunGroupOne": @1 }];
+    NSString *expectedMessage = [NSString stringWithFormat:@"Running tests longest-first within each run group, by the durations recorded at \"%@\".",
+                                 [SLTestController sharedTestController].timingsPath];
+
+    [[_loggerMock expect] logMessage:expectedMessage];
+    [[_loggerMock expect] logTestingStart];
+
+    SLRunTestsAndWaitUntilFinished([self testsUsedToTestSharding], nil);
+    STAssertNoThrow([_loggerMock verify], @"Test was not run/messages were not logged as expected.");
+}
+
+- (void)testTheSeedIsNotLoggedWhenRunningTestsByDuration {
+    NSSet *tests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    [self useTimingsWithDurations:@{ @"TestOneOfRunGroupOne": @1 }];
+
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:[NSMutableArray array]];
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed due to assertion failing."
+                                                   userInfo:nil];
+    [[[[self mockOfTestWithSomeTestCasesAmongMocks:testMocks] expect] andThrow:exception] testTwo];
+
+    // the seed would not reproduce the run order, because specifying it randomizes the tests
+    [[_loggerMock reject] logMessage:[OCMArg checkWithBlock:^BOOL(NSString *message) {
+        return [message hasPrefix:@"The run order may be reproduced using seed"];
+    }]];
+    NSString *expectedMessage = [NSString stringWithFormat:@"The run order was determined by the durations recorded at \"%@\", so may not be reproduced using a seed.",
+                                 [SLTestController sharedTestController].timingsPath];
+    [[_loggerMock expect] logMessage:expectedMessage];
+    [[_loggerMock expect] logWarning:@"Tests were run longest-first rather than in a random order."];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+    STAssertNoThrow([_loggerMock verify], @"The user should have been told that the run order was determined by duration.");
+}
+
+#pragma mark -Rerunning failures
+
+- (NSString *)temporaryManifestPath {
+    NSString *filename = [NSString stringWithFormat:@"SLTestControllerTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+}
+
+// writes a manifest recording the specified failures (dictionaries with "test" and optional "testCase" keys)
+// and directs the shared test controller to run them again
+- (void)rerunFailures:(NSArray *)failures {
+    NSString *manifestPath = [self temporaryManifestPath];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"version": @1, @"seed": @27, @"failures": failures } options:0 error:NULL];
+    [data writeToFile:manifestPath atomically:YES];
+    [SLTestController sharedTestController].rerunManifestPath = manifestPath;
+}
+
+// finds the mock of `TestWithSomeTestCases`, the only one of the tests used below with a test case called `testOne`
+- (id)mockOfTestWithSomeTestCasesAmongMocks:(NSArray *)testMocks {
+    for (id testMock in testMocks) {
+        if ([testMock respondsToSelector:@selector(testOne)]) return testMock;
+    }
+    return nil;
+}
+
+- (void)testFailuresAreRecordedToTheFailureManifest {
+    NSSet *tests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    NSString *manifestPath = [self temporaryManifestPath];
+    [SLTestController sharedTestController].failureManifestPath = manifestPath;
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed due to assertion failing."
+                                                   userInfo:nil];
+    [[[[self mockOfTestWithSomeTestCasesAmongMocks:testMocks] expect] andThrow:exception] testTwo];
+
+    SLRunTestsUsingSeedAndWaitUntilFinished(tests, 27, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    NSData *data = [NSData dataWithContentsOfFile:manifestPath];
+    NSDictionary *manifest = (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil);
+    STAssertEqualObjects(manifest[@"seed"], @27, @"The seed of the run should have been recorded.");
+    STAssertEqualObjects(manifest[@"failures"], (@[ @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testTwo" } ]),
+                         @"The failed test case should have been recorded.");
+}
+
+- (void)testOnlyFailuresRunWhenRerunningFailures {
+    NSMutableSet *tests = [[self testsUsedToTestSharding] mutableCopy];
+    [tests addObject:[TestWithSomeTestCases class]];
+    [self rerunFailures:@[
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testTwo" },
+        @{ @"test": @"TestOneOfRunGroupOne" }
+    ]];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    id testWithSomeTestCasesMock = [self mockOfTestWithSomeTestCasesAmongMocks:testMocks];
+    [[[testWithSomeTestCasesMock expect] andForwardToRealObject] testTwo];
+    [[testWithSomeTestCasesMock reject] testOne];
+    [[testWithSomeTestCasesMock reject] testThree];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([testWithSomeTestCasesMock verify], @"Only the test case that failed should have run.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    STAssertEqualObjects(runOrder, (@[ [TestWithSomeTestCases class], [TestOneOfRunGroupOne class] ]),
+                         @"Only the tests that failed should have run, in the order in which they failed.");
+}
+
+- (void)testReproducedFailuresAreReportedSeparatelyFromFailuresThatPass {
+    NSSet *tests = [NSSet setWithObject:[TestWithSomeTestCases class]];
+    [self rerunFailures:@[
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testOne" },
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testTwo" }
+    ]];
+
+    id testMock = [OCMockObject partialMockForClass:[TestWithSomeTestCases class]];
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed due to assertion failing."
+                                                   userInfo:nil];
+    [[[testMock expect] andThrow:exception] testOne];
+
+    [[_loggerMock expect] logMessage:@"1 failure was reproduced: TestWithSomeTestCases.testOne."];
+    [[_loggerMock expect] logWarning:@"1 failure passed when run again, and may be flaky: TestWithSomeTestCases.testTwo."];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    [testMock stopMocking];
+    STAssertNoThrow([_loggerMock verify], @"The results of running the failures again were not reported as expected.");
+}
+
+- (void)testAllTestsRunIfTheRerunManifestCannotBeRead {
+    NSSet *tests = [self testsUsedToTestSharding];
+    [SLTestController sharedTestController].rerunManifestPath = [self temporaryManifestPath];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([testMocks makeObjectsPerformSelector:@selector(verify)], @"All tests should have run.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+}
+
+#pragma mark -Resuming interrupted runs
+
+// writes a checkpoint file describing a run with the specified seed and tests (names, in order),
+// followed by the specified records, and directs the shared test controller to resume it
+- (void)resumeRunWithSeed:(unsigned int)seed tests:(NSArray *)testNames records:(NSArray *)records {
+    NSMutableString *checkpoint = [[NSMutableString alloc] init];
+    NSDictionary *run = @{ @"version": @1, @"seed": @(seed), @"tests": testNames };
+    for (NSDictionary *record in [@[ run ] arrayByAddingObjectsFromArray:records]) {
+        NSData *data = [NSJSONSerialization dataWithJSONObject:record options:0 error:NULL];
+        [checkpoint appendFormat:@"%@\n", [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]];
+    }
+    NSString *checkpointPath = [self temporaryManifestPath];
+    [checkpoint writeToFile:checkpointPath atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [SLTestController sharedTestController].checkpointPath = checkpointPath;
+}
+
+- (void)testProgressIsRecordedToTheCheckpoint {
+    NSSet *tests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    NSString *checkpointPath = [self temporaryManifestPath];
+    [SLTestController sharedTestController].checkpointPath = checkpointPath;
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsUsingSeedAndWaitUntilFinished(tests, 27, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    SLRunCheckpoint *checkpoint = [[SLRunCheckpoint alloc] initWithContentsOfFile:checkpointPath error:NULL];
+    STAssertEquals([checkpoint seed], (unsigned int)27, @"The seed of the run should have been recorded.");
+    STAssertEqualObjects([checkpoint testNames], [runOrder valueForKey:@"description"],
+                         @"The order of the run's tests should have been recorded.");
+    STAssertEquals([checkpoint numTestsCompleted], [tests count], @"Each test should have been recorded as completing.");
+    STAssertTrue([checkpoint runWasCompleted], @"The run should have been recorded as completing.");
+}
+
+- (void)testRunResumesAfterTheTestCaseThatWasInterrupted {
+    NSSet *tests = [[self testsUsedToTestSharding] setByAddingObject:[TestWithSomeTestCases class]];
+    [self resumeRunWithSeed:27
+                      tests:@[ @"TestOneOfRunGroupOne", @"TestWithSomeTestCases", @"TestTwoOfRunGroupOne" ]
+                    records:@[
+        @{ @"test": @"TestOneOfRunGroupOne" },
+        @{ @"test": @"TestOneOfRunGroupOne", @"testCase": @"testFoo" },
+        @{ @"test": @"TestOneOfRunGroupOne", @"testCase": @"testFoo", @"completed": @YES, @"failed": @NO },
+        @{ @"test": @"TestOneOfRunGroupOne", @"completed": @YES, @"failed": @NO, @"aborted": @NO },
+        @{ @"test": @"TestWithSomeTestCases" },
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testOne" },
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testOne", @"completed": @YES, @"failed": @NO },
+        @{ @"test": @"TestWithSomeTestCases", @"testCase": @"testTwo" }
+    ]];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    id testWithSomeTestCasesMock = [self mockOfTestWithSomeTestCasesAmongMocks:testMocks];
+    [[testWithSomeTestCasesMock reject] testOne];
+    [[testWithSomeTestCasesMock reject] testTwo];
+    [[[testWithSomeTestCasesMock expect] andForwardToRealObject] testThree];
+
+    // the test case that was running when the application crashed should be reported as having failed,
+    // and the test case that completed before the crash should be counted along with those that run...
+    [[_loggerMock expect] logTest:@"TestWithSomeTestCases" caseFail:@"testTwo" expected:NO];
+    [[_loggerMock expect] logTestFinish:@"TestWithSomeTestCases"
+                   withNumCasesExecuted:3
+                         numCasesFailed:1
+             numCasesFailedUnexpectedly:1];
+    // ...and the tests that completed before the crash should be counted
+    [[_loggerMock expect] logTestingFinishWithNumTestsExecuted:3 numTestsFailed:1];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([testWithSomeTestCasesMock verify], @"Only the test case that had not run should have run.");
+    STAssertNoThrow([_loggerMock verify], @"The interrupted test case was not reported as expected.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    STAssertEqualObjects(runOrder, (@[ [TestWithSomeTestCases class], [TestTwoOfRunGroupOne class] ]),
+                         @"Only the tests that had not completed should have run, in the order recorded.");
+}
+
+- (void)testTestInterruptedOutsideOfATestCaseIsReportedAsAborted {
+    NSSet *tests = [NSSet setWithObjects:[TestOneOfRunGroupOne class], [TestTwoOfRunGroupOne class], nil];
+    [self resumeRunWithSeed:27
+                      tests:@[ @"TestOneOfRunGroupOne", @"TestTwoOfRunGroupOne" ]
+                    records:@[ @{ @"test": @"TestOneOfRunGroupOne" } ]];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+
+    [[_loggerMock expect] logTestAbort:@"TestOneOfRunGroupOne"];
+    [[_loggerMock expect] logTestingFinishWithNumTestsExecuted:2 numTestsFailed:1];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([_loggerMock verify], @"The interrupted test was not reported as expected.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    STAssertEqualObjects(runOrder, @[ [TestTwoOfRunGroupOne class] ],
+                         @"The interrupted test should not have been run again.");
+}
+
+- (void)testANewRunStartsIfTheCheckpointRecordsACompletedRun {
+    NSSet *tests = [NSSet setWithObjects:[TestOneOfRunGroupOne class], [TestTwoOfRunGroupOne class], nil];
+    [self resumeRunWithSeed:27
+                      tests:@[ @"TestOneOfRunGroupOne", @"TestTwoOfRunGroupOne" ]
+                    records:@[
+        @{ @"test": @"TestOneOfRunGroupOne" },
+        @{ @"test": @"TestOneOfRunGroupOne", @"completed": @YES, @"failed": @NO, @"aborted": @NO },
+        @{ @"test": @"TestTwoOfRunGroupOne" },
+        @{ @"test": @"TestTwoOfRunGroupOne", @"completed": @YES, @"failed": @NO, @"aborted": @NO },
+        @{ @"completed": @YES }
+    ]];
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([testMocks makeObjectsPerformSelector:@selector(verify)], @"All tests should have run.");
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+}
+
+#pragma mark -Sharing fixtures
+
+- (void)testARunGroupFixtureIsSetUpOnceAroundTheTestsOfItsGroup {
+    [AbstractTestWithSharedFixtures resetFixtures];
+    NSSet *tests = [[self testsUsedToTestSharding] setByAddingObjectsFromArray:@[
+        [TestOneWithSharedFixtures class], [TestTwoWithSharedFixtures class]
+    ]];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+
+    NSArray *fixturesSetUp = [AbstractTestWithSharedFixtures runGroupFixturesSetUp];
+    STAssertEquals([fixturesSetUp count], (NSUInteger)1, @"The run group fixture should have been set up once.");
+    STAssertEqualObjects([AbstractTestWithSharedFixtures runGroupFixturesUsed],
+                         (@[ fixturesSetUp[0], fixturesSetUp[0] ]),
+                         @"Each test of the run group should have used the fixture that was set up.");
+    STAssertEqualObjects([AbstractTestWithSharedFixtures runGroupFixturesTornDown], fixturesSetUp,
+                         @"The fixture should have been passed to the run group's tear-down.");
+}
+
+- (void)testASuiteFixtureIsSetUpOnceAroundTheRun {
+    [AbstractTestWithSharedFixtures resetFixtures];
+    NSSet *tests = [[self testsUsedToTestSharding] setByAddingObjectsFromArray:@[
+        [TestOneWithSharedFixtures class], [TestTwoWithSharedFixtures class]
+    ]];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+
+    NSArray *fixturesSetUp = [AbstractTestWithSharedFixtures suiteFixturesSetUp];
+    STAssertEquals([fixturesSetUp count], (NSUInteger)1, @"The suite fixture should have been set up once.");
+    STAssertEqualObjects([AbstractTestWithSharedFixtures suiteFixturesUsed],
+                         (@[ fixturesSetUp[0], fixturesSetUp[0] ]),
+                         @"Each test should have used the fixture that was set up.");
+    STAssertEqualObjects([AbstractTestWithSharedFixtures suiteFixturesTornDown], fixturesSetUp,
+                         @"The fixture should have been passed to the suite's tear-down.");
+}
+
+- (void)testTestsAbortIfTheirRunGroupFixtureFailsToSetUp {
+    [AbstractTestWithSharedFixtures resetFixtures];
+    [AbstractTestWithSharedFixtures setSetUpRunGroupFails:YES];
+    NSSet *tests = [NSSet setWithObjects:[TestOneOfRunGroupOne class],
+                                         [TestOneWithSharedFixtures class], [TestTwoWithSharedFixtures class], nil];
+
+    [[_loggerMock expect] logTestAbort:@"TestOneWithSharedFixtures"];
+    [[_loggerMock expect] logTestAbort:@"TestTwoWithSharedFixtures"];
+    [[_loggerMock reject] logTestAbort:@"TestOneOfRunGroupOne"];
+    [[_loggerMock expect] logTestingFinishWithNumTestsExecuted:3 numTestsFailed:2];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([_loggerMock verify], @"Only the tests sharing the fixture should have aborted.");
+    STAssertEquals([[AbstractTestWithSharedFixtures runGroupFixturesUsed] count], (NSUInteger)0,
+                   @"The tests sharing the fixture should not have run.");
+    STAssertEqualObjects([AbstractTestWithSharedFixtures runGroupFixturesTornDown], @[ [NSNull null] ],
+                         @"The run group should still have been torn down, without a fixture.");
+}
+
+- (void)testAFixtureInterruptedWhileBeingSetUpIsNotSetUpAgain {
+    [AbstractTestWithSharedFixtures resetFixtures];
+    NSSet *tests = [NSSet setWithObjects:[TestOneOfRunGroupOne class],
+                                         [TestOneWithSharedFixtures class], [TestTwoWithSharedFixtures class], nil];
+    [self resumeRunWithSeed:27
+                      tests:@[ @"TestOneOfRunGroupOne", @"TestOneWithSharedFixtures", @"TestTwoWithSharedFixtures" ]
+                    records:@[ @{ @"fixture": @"AbstractTestWithSharedFixtures", @"setUp": @"setUpRunGroup" } ]];
+
+    [[_loggerMock expect] logTestAbort:@"TestOneWithSharedFixtures"];
+    [[_loggerMock expect] logTestAbort:@"TestTwoWithSharedFixtures"];
+    [[_loggerMock reject] logTestAbort:@"TestOneOfRunGroupOne"];
+    [[_loggerMock expect] logTestingFinishWithNumTestsExecuted:3 numTestsFailed:2];
+
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    STAssertNoThrow([_loggerMock verify], @"Only the tests sharing the fixture should have aborted.");
+    STAssertEquals([[AbstractTestWithSharedFixtures runGroupFixturesSetUp] count], (NSUInteger)0,
+                   @"The fixture should not have been set up again.");
+    STAssertEquals([[AbstractTestWithSharedFixtures runGroupFixturesTornDown] count], (NSUInteger)0,
+                   @"The fixture should not have been torn down, not having been set up.");
+    STAssertEquals([[AbstractTestWithSharedFixtures suiteFixturesSetUp] count], (NSUInteger)1,
+                   @"Fixtures which were not interrupted should have been set up as usual.");
+}
+
+#pragma mark -Profiling runs
+
+- (void)testTheProfileOfTheRunIsWrittenToTheTimeProfilePath {
+    NSSet *tests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    NSString *timeProfilePath = [self temporaryManifestPath];
+    [SLTestController sharedTestController].timeProfilePath = timeProfilePath;
+
+    NSMutableArray *runOrder = [[NSMutableArray alloc] initWithCapacity:[tests count]];
+    NSArray *testMocks = [self mocksToRecordRunOrderOfTests:tests inArray:runOrder];
+    SLRunTestsAndWaitUntilFinished(tests, nil);
+    [testMocks makeObjectsPerformSelector:@selector(stopMocking)];
+
+    NSData *data = [NSData dataWithContentsOfFile:timeProfilePath];
+    NSDictionary *profile = (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil);
+    STAssertEqualObjects([profile[@"tests"] valueForKey:@"test"], [runOrder valueForKey:@"description"],
+                         @"The tests should have been profiled in the order in which they ran.");
+    NSDictionary *testWithSomeTestCases = [[profile[@"tests"] filteredArrayUsingPredicate:
+                                            [NSPredicate predicateWithFormat:@"test == %@", @"TestWithSomeTestCases"]] lastObject];
+    STAssertEqualObjects([NSSet setWithArray:[testWithSomeTestCases[@"testCases"] valueForKey:@"testCase"]],
+                         ([NSSet setWithObjects:@"testOne", @"testTwo", @"testThree", nil]),
+                         @"The test's cases should have been profiled.");
+    STAssertNotNil([testWithSomeTestCases[@"testCases"] lastObject][@"activities"],
+                   @"The time spent in each activity should have been recorded for each test case.");
+}
+
 #pragma mark -Focusing
 
 - (void)testWhenSomeTestsAreFocusedOnlyThoseTestsAreRun {
@@ -30,6 +30,12 @@
 #import "SharedSLTests.h"
 #import "SLTest+Internal.h"
 
+// register tests in a section other than the default so that `+allTests`
+// continues to scan the runtime for the other test cases in this file
+#define SLTestTestsRegistrationSectionName "__sl_tests_unit"
+_SLRegisterTestInSection(TestWithSomeTestCases, SLTestTestsRegistrationSectionName)
+_SLRegisterTestInSection(TestOneOfRunGroupOne, SLTestTestsRegistrationSectionName)
+
 @interface SLTestTests : SenTestCase
 
 @end
@@ -58,6 +64,11 @@
 }
 
 - (void)tearDown {
+    [[SLTestController sharedTestController] setDefaultTestTimeLimit:0.0];
+    [[SLTestController sharedTestController] setDefaultTestCaseTimeLimit:0.0];
+
+    // output any messages buffered by the logger while the terminal is still mocked
+    [[SLLogger sharedLogger] flush];
     [_terminalMock stopMocking];
     [_loggerMock stopMocking];
 }
@@ -101,11 +112,37 @@
         [TestWithTagAAAandCCC class],
         [TestWithTagBBBandCCC class],
         [TestWithSomeTaggedTestCases class],
+        [TestWithARetriedTestCase class],
+        [AbstractTestWithSharedFixtures class],
+        [TestOneWithSharedFixtures class],
+        [TestTwoWithSharedFixtures class],
         nil
     ];
     STAssertEqualObjects(allTests, expectedTests, @"Unexpected tests returned.");
 }
 
+- (void)testRegisteredTestsAreReturned {
+    NSSet *registeredTests = [SLTest testsRegisteredInSection:SLTestTestsRegistrationSectionName];
+    NSSet *expectedTests = [NSSet setWithObjects:[TestWithSomeTestCases class], [TestOneOfRunGroupOne class], nil];
+    STAssertEqualObjects(registeredTests, expectedTests, @"Unexpected tests returned.");
+}
+
+- (void)testUnregisteredTestsAreThoseConcreteTestsWhichAreNotRegistered {
+    NSSet *registeredTests = [SLTest testsRegisteredInSection:SLTestTestsRegistrationSectionName];
+    NSSet *unregisteredTests = [SLTest unregisteredTestsGivenRegisteredTests:registeredTests];
+    STAssertTrue([unregisteredTests containsObject:[TestWithTagAAAandCCC class]],
+                 @"A concrete test which was not registered should have been returned.");
+    STAssertFalse([unregisteredTests intersectsSet:registeredTests],
+                  @"Registered tests should not have been returned.");
+    STAssertFalse([unregisteredTests containsObject:[AbstractTestWithSharedFixtures class]],
+                  @"Abstract tests need not be registered, so should not have been returned.");
+}
+
+- (void)testNoTestsAreRegisteredByDefault {
+    STAssertEquals([[SLTest testsRegisteredInSection:SLTestRegistrationSectionName] count], (NSUInteger)0,
+                   @"No tests should have been registered, so `+allTests` should fall back to scanning the runtime.");
+}
+
 - (void)testTestsWithTagsIncludesTestsWithAtLeastOneSpecifiedTag {
     NSSet *tags = [NSSet setWithObject:@"CCC"];
     NSSet *expectedTests = [NSSet setWithObjects:[TestWithTagAAAandCCC class], [TestWithTagBBBandCCC class], nil];
@@ -1269,6 +1306,265 @@
     STAssertNoThrow([failingTestMock verify], @"Test did not run as expected.");
 }
 
+#pragma mark -Retrying test cases
+
+- (void)testTestCasesAreNotRetriedByDefault {
+    STAssertEquals([TestWithSomeTestCases numberOfRetriesForTestCaseWithSelector:@selector(testOne)], (NSUInteger)0,
+                   @"Test cases should not be retried by default.");
+
+    Class failingTestClass = [TestWithSomeTestCases class];
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    // *** Begin expected test run
+
+    // If the test case fails...
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed."
+                                                   userInfo:nil];
+    [[[failingTestMock expect] andThrow:exception] testOne];
+
+    // ...it is not executed again...
+    [[failingTestMock reject] testOne];
+    [[_loggerMock reject] logTest:OCMOCK_ANY caseRetry:OCMOCK_ANY afterAttempt:1];
+
+    // ...and is logged as failing.
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass) caseFail:@"testOne" expected:YES];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([failingTestMock verify], @"Test did not run as expected.");
+    STAssertNoThrow([_loggerMock verify], @"Test case failure was not logged as expected.");
+}
+
+- (void)testIfRetriedTestCasePassesAfterFailingAFlakyPassIsLogged {
+    Class testClass = [TestWithARetriedTestCase class];
+    SEL retriedTestCase = @selector(testRetriedCase);
+    id testMock = [OCMockObject partialMockForClass:testClass];
+    OCMExpectationSequencer *testSequencer = [OCMExpectationSequencer sequencerWithMocks:@[ testMock, _loggerMock ]];
+
+    // *** Begin expected test run
+
+    // If the test case fails on its first attempt...
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed."
+                                                   userInfo:nil];
+    [[[testMock expect] andThrow:exception] testRetriedCase];
+    [[testMock expect] tearDownTestCaseWithSelector:retriedTestCase];
+    [[_loggerMock expect] logTest:NSStringFromClass(testClass) caseRetry:NSStringFromSelector(retriedTestCase) afterAttempt:1];
+
+    // ...it is set up and executed again...
+    [[testMock expect] setUpTestCaseWithSelector:retriedTestCase];
+    [[testMock expect] testRetriedCase];
+    [[testMock expect] tearDownTestCaseWithSelector:retriedTestCase];
+
+    // ...and, passing, is logged as having passed only when retried...
+    [[_loggerMock expect] logTest:NSStringFromClass(testClass) caseFlakyPass:NSStringFromSelector(retriedTestCase) numAttempts:2];
+
+    // ...rather than as failing.
+    [[_loggerMock reject] logTest:NSStringFromClass(testClass) caseFail:NSStringFromSelector(retriedTestCase) expected:YES];
+    [[_loggerMock expect] logTestFinish:NSStringFromClass(testClass)
+                   withNumCasesExecuted:2
+                         numCasesFailed:0
+             numCasesFailedUnexpectedly:0];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:testClass], nil);
+    STAssertNoThrow([testSequencer verify], @"Test case was not retried/messages were not logged in the expected sequence.");
+}
+
+- (void)testIfRetriedTestCaseFailsOnEveryAttemptAFailureIsLogged {
+    Class failingTestClass = [TestWithARetriedTestCase class];
+    SEL failingTestCase = @selector(testRetriedCase);
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    // *** Begin expected test run
+
+    // If the test case fails on every attempt...
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed."
+                                                   userInfo:nil];
+    // (these values will need to be updated if the test class' definition changes)
+    for (NSUInteger attempt = 1; attempt <= 3; attempt++) {
+        [[failingTestMock expect] setUpTestCaseWithSelector:failingTestCase];
+        [[[failingTestMock expect] andThrow:exception] testRetriedCase];
+        [[failingTestMock expect] tearDownTestCaseWithSelector:failingTestCase];
+    }
+
+    // ...it is retried until its retries are exhausted...
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass) caseRetry:NSStringFromSelector(failingTestCase) afterAttempt:1];
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass) caseRetry:NSStringFromSelector(failingTestCase) afterAttempt:2];
+    [[_loggerMock reject] logTest:NSStringFromClass(failingTestClass) caseRetry:NSStringFromSelector(failingTestCase) afterAttempt:3];
+
+    // ...and then is logged as failing, once.
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass) caseFail:NSStringFromSelector(failingTestCase) expected:YES];
+    [[_loggerMock expect] logTestFinish:NSStringFromClass(failingTestClass)
+                   withNumCasesExecuted:2
+                         numCasesFailed:1
+             numCasesFailedUnexpectedly:0];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([failingTestMock verify], @"Test case was not retried as expected.");
+    STAssertNoThrow([_loggerMock verify], @"Test case failure was not logged as expected.");
+}
+
+- (void)testExceptionsOfAttemptsWhichWillBeRetriedAreLoggedAsWarnings {
+    Class failingTestClass = [TestWithARetriedTestCase class];
+    SEL failingTestCase = @selector(testRetriedCase);
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    // *** Begin expected test run
+
+    // If the test case fails on every attempt...
+    NSException *exception = [NSException exceptionWithName:SLTestAssertionFailedException
+                                                     reason:@"Test case failed."
+                                                   userInfo:nil];
+    [[[failingTestMock stub] andThrow:exception] testRetriedCase];
+
+    // ...the exceptions of the attempts which will be retried are logged as warnings...
+    // (these values will need to be updated if the test class' definition changes)
+    [[_loggerMock expect] logRetriedException:OCMOCK_ANY expected:YES];
+    [[_loggerMock expect] logRetriedException:OCMOCK_ANY expected:YES];
+
+    // ...and only the exception of the last attempt is logged as an error.
+    [[_loggerMock expect] logException:OCMOCK_ANY expected:YES];
+    [[_loggerMock reject] logException:OCMOCK_ANY expected:YES];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([_loggerMock verify], @"The exceptions were not logged as expected.");
+}
+
+#pragma mark -Limiting test durations
+
+- (void)testTestsAndTestCasesHaveNoTimeLimitsByDefault {
+    STAssertEquals([TestWithSomeTestCases timeLimit], (NSTimeInterval)0.0,
+                   @"Tests should not have time limits by default.");
+    STAssertEquals([TestWithSomeTestCases timeLimitForTestCaseWithSelector:@selector(testOne)], (NSTimeInterval)0.0,
+                   @"Test cases should not have time limits by default.");
+}
+
+- (void)runWithTestCaseExceedingItsTimeLimitSwallowingTimeout:(BOOL)swallowTimeout {
+    Class failingTestClass = [TestWithSomeTestCases class];
+    SEL failingTestCase = @selector(testOne);
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    [[SLTestController sharedTestController] setDefaultTestCaseTimeLimit:0.5];
+
+    // *** Begin expected test run
+
+    // If the test case waits for longer than its time limit...
+    __block NSTimeInterval actualWaitTimeInterval = 0.0;
+    [[[failingTestMock expect] andDo:^(NSInvocation *invocation) {
+        SLTest *test = [invocation target];
+        NSTimeInterval startTimeInterval = [NSDate timeIntervalSinceReferenceDate];
+        @try {
+            [test wait:5.0];
+        }
+        @catch (NSException *exception) {
+            actualWaitTimeInterval = [NSDate timeIntervalSinceReferenceDate] - startTimeInterval;
+            if (!swallowTimeout) @throw exception;
+        }
+    }] testOne];
+
+    // ...the test case's tear-down still executes...
+    [[failingTestMock expect] tearDownTestCaseWithSelector:failingTestCase];
+
+    // ...the test case is logged as having failed unexpectedly
+    // (even if the test case caught the timeout exception)...
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass)
+                         caseFail:NSStringFromSelector(failingTestCase)
+                         expected:NO];
+
+    // ...and the other test cases still execute.
+    [[failingTestMock expect] testTwo];
+    [[failingTestMock expect] testThree];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([failingTestMock verify], @"Test did not run as expected.");
+    STAssertNoThrow([_loggerMock verify], @"Test case failure was not logged as expected.");
+    STAssertTrue((actualWaitTimeInterval > 0.0) && (actualWaitTimeInterval < 1.0),
+                 @"The test case should have been interrupted shortly after its time limit elapsed.");
+}
+
+- (void)testIfTestCaseExceedsItsTimeLimitItFailsAndOtherTestCasesStillExecute {
+    [self runWithTestCaseExceedingItsTimeLimitSwallowingTimeout:NO];
+}
+
+- (void)testIfTestCaseExceedsItsTimeLimitItFailsEvenIfItCatchesTheTimeout {
+    [self runWithTestCaseExceedingItsTimeLimitSwallowingTimeout:YES];
+}
+
+- (void)testIfTestExceedsItsTimeLimitItsRemainingTestCasesFailWithoutExecuting {
+    Class failingTestClass = [TestWithSomeTestCases class];
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    [[SLTestController sharedTestController] setDefaultTestTimeLimit:0.5];
+
+    // *** Begin expected test run
+
+    // If whichever test case executes first exceeds the test's time limit...
+    __block NSUInteger numTestCasesExecuted = 0;
+    void (^exceedTimeLimit)(NSInvocation *) = ^(NSInvocation *invocation) {
+        numTestCasesExecuted++;
+        [(SLTest *)[invocation target] wait:5.0];
+    };
+    [[[failingTestMock stub] andDo:exceedTimeLimit] testOne];
+    [[[failingTestMock stub] andDo:exceedTimeLimit] testTwo];
+    [[[failingTestMock stub] andDo:exceedTimeLimit] testThree];
+
+    // ...the test's tear-down still executes...
+    [[failingTestMock expect] tearDownTest];
+
+    // ...and the test finishes with that test case having failed, and the remaining test cases
+    // having failed without executing.
+    [[_loggerMock expect] logTestFinish:NSStringFromClass(failingTestClass)
+                   withNumCasesExecuted:3
+                         numCasesFailed:3
+             numCasesFailedUnexpectedly:3];
+    [[_loggerMock expect] logTestingFinishWithNumTestsExecuted:1 numTestsFailed:1];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([failingTestMock verify], @"Test did not run as expected.");
+    STAssertNoThrow([_loggerMock verify], @"Test was not logged as expected.");
+    STAssertEquals(numTestCasesExecuted, (NSUInteger)1, @"Only the test case that exceeded the test's time limit should have executed.");
+}
+
+- (void)testIfTestExceedsItsTimeLimitItsTestCasesAreNotRetried {
+    Class failingTestClass = [TestWithARetriedTestCase class];
+    SEL failingTestCase = @selector(testRetriedCase);
+    id failingTestMock = [OCMockObject partialMockForClass:failingTestClass];
+
+    [[SLTestController sharedTestController] setDefaultTestTimeLimit:0.5];
+
+    // *** Begin expected test run
+
+    // If the retried test case exceeds the test's time limit...
+    __block NSUInteger numAttempts = 0;
+    [[[failingTestMock stub] andDo:^(NSInvocation *invocation) {
+        numAttempts++;
+        [(SLTest *)[invocation target] wait:5.0];
+    }] testRetriedCase];
+
+    // ...it is not retried, but is logged as failing.
+    [[_loggerMock reject] logTest:NSStringFromClass(failingTestClass) caseRetry:NSStringFromSelector(failingTestCase) afterAttempt:1];
+    [[_loggerMock expect] logTest:NSStringFromClass(failingTestClass) caseFail:NSStringFromSelector(failingTestCase) expected:NO];
+
+    // *** End expected test run
+
+    SLRunTestsAndWaitUntilFinished([NSSet setWithObject:failingTestClass], nil);
+    STAssertNoThrow([_loggerMock verify], @"Test case failure was not logged as expected.");
+    STAssertEquals(numAttempts, (NSUInteger)1, @"The test case should not have been retried after the test exceeded its time limit.");
+}
+
 #pragma mark - Test assertions
 
 // Note: throughout the below tests, we provide implementations of SLTest test cases
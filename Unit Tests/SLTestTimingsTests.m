@@ -0,0 +1,169 @@
+//
+//  SLTestTimingsTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLTestTimings.h"
+#import "SharedSLTests.h"
+
+@interface SLTestTimingsTests : SenTestCase
+@end
+
+@implementation SLTestTimingsTests {
+    NSString *_path;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    NSString *filename = [NSString stringWithFormat:@"SLTestTimingsTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    _path = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:NULL];
+    [[NSFileManager defaultManager] removeItemAtPath:[_path stringByAppendingString:@".lock"] error:NULL];
+    [super tearDown];
+}
+
+- (void)writeTimings:(NSDictionary *)tests {
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"version": @1, @"tests": tests } options:0 error:NULL];
+    [data writeToFile:_path atomically:YES];
+}
+
+- (NSDictionary *)writtenTimings {
+    NSData *data = [NSData dataWithContentsOfFile:_path];
+    return (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL][@"tests"] : nil);
+}
+
+#pragma mark - Estimating durations
+
+- (void)testTimingsAreEmptyIfTheFileDoesNotExist {
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertFalse([timings hasRecordedDurations], @"There should be no recorded durations.");
+    STAssertTrue([timings estimatedDurationOfTest:[TestWithSomeTestCases class]] < 0.0,
+                 @"A test without a recorded duration should have a negative estimated duration.");
+}
+
+- (void)testTimingsAreEmptyIfTheFileIsOfAnUnknownVersion {
+    NSDictionary *tests = @{ @"TestWithSomeTestCases": @{ @"duration": @3 } };
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"version": @2, @"tests": tests } options:0 error:NULL];
+    [data writeToFile:_path atomically:YES];
+
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertFalse([timings hasRecordedDurations], @"Timings of an unknown version should have been ignored.");
+}
+
+- (void)testEstimatedDurationIncludesSetUpAndTearDown {
+    [self writeTimings:@{ @"TestWithSomeTestCases": @{ @"duration": @10, @"testCases": @{ @"testOne": @2, @"testTwo": @3, @"testThree": @4 } } }];
+
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertTrue([timings hasRecordedDurations], @"The durations should have been read.");
+    STAssertEqualsWithAccuracy([timings estimatedDurationOfTest:[TestWithSomeTestCases class]], 10.0, 0.001,
+                               @"The test's estimated duration should be its recorded duration.");
+    STAssertTrue([timings estimatedDurationOfTest:[TestOneOfRunGroupOne class]] < 0.0,
+                 @"A test without a recorded duration should have a negative estimated duration.");
+}
+
+- (void)testEstimatedDurationOnlyIncludesTestCasesThatWillRun {
+    // only `focus_testTwo` will run; `testOne` is not focused
+    [self writeTimings:@{ @"TestWithAFocusedTestCase": @{ @"duration": @4, @"testCases": @{ @"testOne": @1, @"testTwo": @2 } } }];
+
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertEqualsWithAccuracy([timings estimatedDurationOfTest:[TestWithAFocusedTestCase class]], 3.0, 0.001,
+                               @"The test's estimated duration should include only set-up, tear-down, and the focused test case.");
+}
+
+- (void)testTestCasesWithoutRecordedDurationsAreEstimatedAtTheMeanDuration {
+    [self writeTimings:@{ @"TestWithSomeTestCases": @{ @"duration": @6, @"testCases": @{ @"testOne": @2, @"testTwo": @3 } } }];
+
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertEqualsWithAccuracy([timings estimatedDurationOfTest:[TestWithSomeTestCases class]], 8.5, 0.001,
+                               @"`testThree` should have been estimated to take as long as the test's other cases on average.");
+}
+
+#pragma mark - Recording durations
+
+- (void)testRecordedDurationsAreWrittenToTheFile {
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    [timings recordDuration:1.0 ofTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [timings recordDuration:2.0 ofTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    [timings recordDuration:3.0 ofTestCase:@"testThree" inTest:[TestWithSomeTestCases class]];
+    [timings recordDuration:7.5 ofTest:[TestWithSomeTestCases class]];
+
+    NSError *error = nil;
+    STAssertTrue([timings mergeRecordedDurationsIntoFile:_path error:&error], @"The file should have been written: %@", error);
+
+    NSDictionary *expectedTimings = @{
+        @"TestWithSomeTestCases": @{ @"duration": @7.5, @"testCases": @{ @"testOne": @1, @"testTwo": @2, @"testThree": @3 } }
+    };
+    STAssertEqualObjects([self writtenTimings], expectedTimings, @"The recorded durations were not written as expected.");
+
+    SLTestTimings *readTimings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertEqualsWithAccuracy([readTimings estimatedDurationOfTest:[TestWithSomeTestCases class]], 7.5, 0.001,
+                               @"The written durations should have been read.");
+}
+
+- (void)testFocusedTestCasesAreRecordedUnderTheirUnfocusedNames {
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    [timings recordDuration:2.0 ofTestCase:@"focus_testTwo" inTest:[TestWithAFocusedTestCase class]];
+    [timings recordDuration:3.0 ofTest:[TestWithAFocusedTestCase class]];
+    STAssertTrue([timings mergeRecordedDurationsIntoFile:_path error:NULL], @"The file should have been written.");
+
+    NSDictionary *expectedTimings = @{
+        @"TestWithAFocusedTestCase": @{ @"duration": @3, @"testCases": @{ @"testTwo": @2 } }
+    };
+    STAssertEqualObjects([self writtenTimings], expectedTimings,
+                         @"The test case should have been recorded under its unfocused name.");
+}
+
+- (void)testRecordedDurationsAreMergedWithThoseInTheFile {
+    [self writeTimings:@{
+        @"TestOneOfRunGroupOne": @{ @"duration": @5, @"testCases": @{ @"testFoo": @4 } },
+        @"TestWithSomeTestCases": @{ @"duration": @20, @"testCases": @{ @"testOne": @5, @"testThree": @3, @"testThatWasRemoved": @7 } }
+    }];
+
+    // only some of the test's cases ran this time, e.g. because the others were not focused
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    [timings recordDuration:1.0 ofTestCase:@"testOne" inTest:[TestWithSomeTestCases class]];
+    [timings recordDuration:2.0 ofTestCase:@"testTwo" inTest:[TestWithSomeTestCases class]];
+    [timings recordDuration:4.5 ofTest:[TestWithSomeTestCases class]];
+    STAssertTrue([timings mergeRecordedDurationsIntoFile:_path error:NULL], @"The file should have been written.");
+
+    // the durations of the cases that ran should have been updated,
+    // that of the case that did not run should have been preserved,
+    // and that of the case that no longer exists should have been discarded;
+    // the test's duration should be that of its set-up and tear-down (1.5s) plus its cases
+    NSDictionary *expectedTimings = @{
+        @"TestOneOfRunGroupOne": @{ @"duration": @5, @"testCases": @{ @"testFoo": @4 } },
+        @"TestWithSomeTestCases": @{ @"duration": @7.5, @"testCases": @{ @"testOne": @1, @"testTwo": @2, @"testThree": @3 } }
+    };
+    STAssertEqualObjects([self writtenTimings], expectedTimings, @"The recorded durations were not merged as expected.");
+}
+
+- (void)testTheFileIsNotWrittenIfNoDurationsWereRecorded {
+    SLTestTimings *timings = [[SLTestTimings alloc] initWithContentsOfFile:_path];
+    STAssertTrue([timings mergeRecordedDurationsIntoFile:_path error:NULL], @"Merging nothing should succeed.");
+    STAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:_path], @"The file should not have been written.");
+}
+
+@end
@@ -0,0 +1,186 @@
+//
+//  SLTimeProfileTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+#import <OCMock/OCMock.h>
+
+#import "SLTimeProfile.h"
+#import "SLTestTimings.h"
+#import "SLLogger.h"
+#import "SharedSLTests.h"
+
+@interface SLTimeProfileTests : SenTestCase
+@end
+
+@implementation SLTimeProfileTests {
+    NSString *_path;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    NSString *filename = [NSString stringWithFormat:@"SLTimeProfileTests-%@.json", [[NSProcessInfo processInfo] globallyUniqueString]];
+    _path = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:NULL];
+    [super tearDown];
+}
+
+- (NSDictionary *)writtenProfile {
+    NSData *data = [NSData dataWithContentsOfFile:_path];
+    return (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil);
+}
+
+// records a run of `TestWithSomeTestCases` in which `testOne` was retried
+// and Subliminal spent time evaluating scripts and sleeping
+- (SLTimeProfile *)profileOfTestWithSomeTestCases {
+    SLTimeProfile *profile = [[SLTimeProfile alloc] init];
+    Class test = [TestWithSomeTestCases class];
+    [profile recordSetUpDuration:0.5 ofTest:test];
+
+    SLTimeProfileActivityDurations activityDurations = { { 0.0 } };
+    activityDurations.durations[SLTimeProfileActivityTerminalEval] = 1.0;
+    activityDurations.durations[SLTimeProfileActivitySleep] = 0.5;
+    [profile recordSetUpDuration:0.25 ofTestCase:@"testOne" inTest:test];
+    [profile recordTearDownDuration:0.25 ofTestCase:@"testOne" inTest:test];
+    [profile recordSetUpDuration:0.25 ofTestCase:@"testOne" inTest:test];
+    [profile recordTearDownDuration:0.25 ofTestCase:@"testOne" inTest:test];
+    [profile recordDuration:3.0 activityDurations:activityDurations ofTestCase:@"testOne" inTest:test];
+
+    activityDurations.durations[SLTimeProfileActivityTerminalEval] = 0.5;
+    activityDurations.durations[SLTimeProfileActivitySleep] = 0.0;
+    [profile recordSetUpDuration:0.25 ofTestCase:@"testTwo" inTest:test];
+    [profile recordTearDownDuration:0.25 ofTestCase:@"testTwo" inTest:test];
+    [profile recordDuration:1.0 activityDurations:activityDurations ofTestCase:@"testTwo" inTest:test];
+
+    [profile recordTearDownDuration:0.5 ofTest:test];
+    [profile recordDuration:5.0 ofTest:test];
+    return profile;
+}
+
+#pragma mark - Recording activities
+
+- (void)testTimeSpentInActivitiesIsAccumulated {
+    SLTimeProfileActivityDurations durationsAtStart = SLTimeProfileGetActivityDurations();
+    SLTimeProfileSleep(0.1);
+    SLTimeProfileRecordActivity(SLTimeProfileActivityAppHookLookup, [SLLogRecord currentTimestamp] - 1.0);
+    SLTimeProfileActivityDurations durations = SLTimeProfileGetActivityDurations();
+
+    STAssertEqualsWithAccuracy(durations.durations[SLTimeProfileActivitySleep] - durationsAtStart.durations[SLTimeProfileActivitySleep],
+                               0.1, 0.05, @"The time slept should have been recorded.");
+    STAssertEqualsWithAccuracy(durations.durations[SLTimeProfileActivityAppHookLookup] - durationsAtStart.durations[SLTimeProfileActivityAppHookLookup],
+                               1.0, 0.05, @"The time spent looking up app hooks should have been recorded.");
+    STAssertEqualsWithAccuracy(durations.durations[SLTimeProfileActivityTerminalEval], durationsAtStart.durations[SLTimeProfileActivityTerminalEval],
+                               0.001, @"No time should have been recorded for activities that did not occur.");
+}
+
+- (void)testTimeSpentByOtherThreadsIsNotAccumulated {
+    SLTimeProfileActivityDurations durationsAtStart = SLTimeProfileGetActivityDurations();
+
+    dispatch_queue_t queue = dispatch_queue_create("com.inkling.subliminal.SLTimeProfileTests.queue", DISPATCH_QUEUE_SERIAL);
+    dispatch_semaphore_t recordedSemaphore = dispatch_semaphore_create(0);
+    __block double durationRecordedByOtherThread = 0.0;
+    // dispatch_async, unlike dispatch_sync, guarantees that the block will not run on this thread
+    dispatch_async(queue, ^{
+        SLTimeProfileRecordActivity(SLTimeProfileActivityTerminalEval, [SLLogRecord currentTimestamp] - 1.0);
+        durationRecordedByOtherThread = SLTimeProfileGetActivityDurations().durations[SLTimeProfileActivityTerminalEval];
+        dispatch_semaphore_signal(recordedSemaphore);
+    });
+    dispatch_semaphore_wait(recordedSemaphore, DISPATCH_TIME_FOREVER);
+    dispatch_release(recordedSemaphore);
+    dispatch_release(queue);
+
+    STAssertEqualsWithAccuracy(durationRecordedByOtherThread, 1.0, 0.05,
+                               @"The time should have been recorded for the thread that spent it.");
+    STAssertEqualsWithAccuracy(SLTimeProfileGetActivityDurations().durations[SLTimeProfileActivityTerminalEval],
+                               durationsAtStart.durations[SLTimeProfileActivityTerminalEval], 0.001,
+                               @"Time spent by another thread should not have been recorded for this thread.");
+}
+
+#pragma mark - Recording durations
+
+- (void)testRecordedDurationsAreForwardedToTimings {
+    Class test = [TestWithSomeTestCases class];
+    SLTimeProfileActivityDurations activityDurations = { { 0.0 } };
+
+    SLTimeProfile *profile = [[SLTimeProfile alloc] init];
+    id timingsMock = [OCMockObject mockForClass:[SLTestTimings class]];
+    profile.timings = timingsMock;
+
+    [[timingsMock expect] recordDuration:3.0 ofTestCase:@"testOne" inTest:test];
+    [[timingsMock expect] recordDuration:5.0 ofTest:test];
+    [profile recordDuration:3.0 activityDurations:activityDurations ofTestCase:@"testOne" inTest:test];
+    [profile recordDuration:5.0 ofTest:test];
+    STAssertNoThrow([timingsMock verify], @"The profile should have forwarded the durations it recorded to its timings.");
+}
+
+- (void)testRecordedDurationsAreWrittenToTheFile {
+    SLTimeProfile *profile = [self profileOfTestWithSomeTestCases];
+    STAssertTrue([profile hasRecordedDurations], @"The profile should have recorded durations.");
+
+    NSError *error = nil;
+    STAssertTrue([profile writeToFile:_path error:&error], @"The file should have been written: %@", error);
+
+    NSDictionary *writtenProfile = [self writtenProfile];
+    STAssertEqualObjects(writtenProfile[@"version"], @1, @"The version of the file should have been written.");
+    STAssertEqualObjects(writtenProfile[@"duration"], @5, @"The duration of the run should be that of its tests.");
+    STAssertEqualObjects(writtenProfile[@"activities"][@"terminalEval"], @1.5,
+                         @"The time spent in each activity should have been totaled across test cases.");
+
+    NSDictionary *test = [writtenProfile[@"tests"] lastObject];
+    STAssertEqualObjects(test[@"test"], @"TestWithSomeTestCases", @"The test should have been written.");
+    STAssertEqualObjects(test[@"setUp"], @0.5, @"The test's set-up should have been written.");
+    STAssertEqualObjects(test[@"tearDown"], @0.5, @"The test's tear-down should have been written.");
+    STAssertEqualObjects([test[@"testCases"] valueForKey:@"testCase"], (@[ @"testOne", @"testTwo" ]),
+                         @"The test cases should have been written in the order in which they ran.");
+
+    NSDictionary *testCase = test[@"testCases"][0];
+    STAssertEqualObjects(testCase[@"duration"], @3, @"The test case's duration should have been written.");
+    STAssertEqualObjects(testCase[@"setUp"], @0.5, @"The test case's set-up should have been summed across attempts.");
+    STAssertEqualObjects(testCase[@"tearDown"], @0.5, @"The test case's tear-down should have been summed across attempts.");
+    STAssertEqualObjects(testCase[@"activities"][@"sleep"], @0.5, @"The test case's activities should have been written.");
+}
+
+- (void)testTestsThatDidNotCompleteAreNotWritten {
+    SLTimeProfile *profile = [[SLTimeProfile alloc] init];
+    [profile recordSetUpDuration:0.5 ofTest:[TestWithSomeTestCases class]];
+    STAssertFalse([profile hasRecordedDurations], @"A test whose duration was not recorded should not count.");
+
+    STAssertTrue([profile writeToFile:_path error:NULL], @"The file should have been written.");
+    STAssertEqualObjects([self writtenProfile][@"tests"], @[], @"A test whose duration was not recorded should not have been written.");
+}
+
+#pragma mark - Summarizing
+
+- (void)testSummaryBreaksDownTheTimeSpentInTestCases {
+    NSArray *summary = [[self profileOfTestWithSomeTestCases] summary];
+    STAssertEquals([summary count], (NSUInteger)3, @"The summary should describe tests, test cases, and the slowest test cases.");
+    STAssertTrue([summary[0] rangeOfString:@"5.0s"].location != NSNotFound, @"The summary should report the duration of the run.");
+    STAssertTrue([summary[1] rangeOfString:@"1.5s (38%) evaluating UIAutomation scripts"].location != NSNotFound,
+                 @"The summary should break down the time spent in test cases.");
+    STAssertTrue([summary[2] rangeOfString:@"-[TestWithSomeTestCases testOne] (3.0s), -[TestWithSomeTestCases testTwo] (1.0s)"].location != NSNotFound,
+                 @"The summary should list the slowest test cases first.");
+}
+
+@end
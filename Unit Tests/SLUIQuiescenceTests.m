@@ -0,0 +1,103 @@
+//
+//  SLUIQuiescenceTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLUIQuiescence.h"
+#import <QuartzCore/QuartzCore.h>
+
+@interface SLUIQuiescenceTests : SenTestCase
+@end
+
+@implementation SLUIQuiescenceTests {
+    CALayer *_rootLayer, *_layer;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    // don't let Core Animation add implicit animations to the layers
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _rootLayer = [CALayer layer];
+    _layer = [CALayer layer];
+    [_rootLayer addSublayer:_layer];
+    [_rootLayer layoutIfNeeded];
+}
+
+- (void)tearDown {
+    [CATransaction commit];
+    [super tearDown];
+}
+
+// returns an animation of the specified duration which began at the specified offset
+// from the current time, in the time space of the test layer
+- (CABasicAnimation *)animationWithDuration:(CFTimeInterval)duration beganAtOffset:(CFTimeInterval)offset {
+    CABasicAnimation *animation = [CABasicAnimation animationWithKeyPath:@"opacity"];
+    animation.fromValue = @0.0f;
+    animation.toValue = @1.0f;
+    animation.duration = duration;
+    animation.beginTime = [_layer convertTime:CACurrentMediaTime() fromLayer:nil] + offset;
+    animation.removedOnCompletion = NO;
+    return animation;
+}
+
+- (void)testLayerTreeWithoutAnimationsIsQuiescent {
+    STAssertTrue(SLLayerTreeIsQuiescent(_rootLayer), @"A layer tree without animations should be quiescent.");
+}
+
+- (void)testLayerTreeWithAnimationInFlightIsNotQuiescent {
+    [_layer addAnimation:[self animationWithDuration:10.0 beganAtOffset:0.0] forKey:@"test"];
+    STAssertFalse(SLLayerTreeIsQuiescent(_rootLayer),
+                  @"A layer tree with an animation in flight should not be quiescent.");
+}
+
+- (void)testLayerTreeWithFinishedAnimationIsQuiescent {
+    // the animation is not removed on completion, so will remain attached to the layer
+    [_layer addAnimation:[self animationWithDuration:1.0 beganAtOffset:-2.0] forKey:@"test"];
+    STAssertTrue(SLLayerTreeIsQuiescent(_rootLayer),
+                 @"A layer tree whose animations have finished should be quiescent.");
+
+    // unless the animation repeats
+    CABasicAnimation *repeatingAnimation = [self animationWithDuration:1.0 beganAtOffset:-2.0];
+    repeatingAnimation.repeatCount = 3.0f;
+    [_layer addAnimation:repeatingAnimation forKey:@"test"];
+    STAssertFalse(SLLayerTreeIsQuiescent(_rootLayer),
+                  @"A layer tree with an animation that is still repeating should not be quiescent.");
+}
+
+- (void)testLayerTreeWithIndefinitelyRepeatingAnimationIsQuiescent {
+    CABasicAnimation *animation = [self animationWithDuration:1.0 beganAtOffset:0.0];
+    animation.repeatCount = HUGE_VALF;
+    [_layer addAnimation:animation forKey:@"test"];
+    STAssertTrue(SLLayerTreeIsQuiescent(_rootLayer),
+                 @"Animations which repeat indefinitely should be ignored.");
+}
+
+- (void)testAnimationsOfHiddenLayersAreIgnored {
+    [_layer addAnimation:[self animationWithDuration:10.0 beganAtOffset:0.0] forKey:@"test"];
+    _layer.hidden = YES;
+    STAssertTrue(SLLayerTreeIsQuiescent(_rootLayer),
+                 @"The animations of hidden layers should be ignored.");
+}
+
+@end
@@ -0,0 +1,121 @@
+//
+//  SLWatchdogTests.m
+//  Subliminal
+//
+//  For details and documentation:
+//  http://github.com/inkling/Subliminal
+//
+//  Copyright 2013-2014 Inkling Systems, Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "SLWatchdog.h"
+#import "SLTest.h"
+
+@interface SLWatchdogTests : SenTestCase
+@end
+
+@implementation SLWatchdogTests
+
+- (void)testWatchdogsExpireOnceTheirTimeLimitElapses {
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.2 name:@"test"];
+    STAssertFalse([watchdog hasExpired], @"The watchdog should not have expired yet.");
+
+    [NSThread sleepForTimeInterval:0.3];
+    STAssertTrue([watchdog hasExpired], @"The watchdog should have expired.");
+}
+
+- (void)testInterruptIfExpiredThrowsOnlyWhileAnExpiredWatchdogIsGuarding {
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.2 name:@"test"];
+    [watchdog guardBlock:^{
+        STAssertNoThrow([SLWatchdog interruptIfExpired], @"The watchdog should not have expired yet.");
+        [NSThread sleepForTimeInterval:0.3];
+        STAssertThrowsSpecificNamed([SLWatchdog interruptIfExpired], NSException, SLTestTimeoutException,
+                                    @"The watchdog should have interrupted the block.");
+    }];
+
+    STAssertNoThrow([SLWatchdog interruptIfExpired], @"The watchdog should no longer be guarding.");
+}
+
+- (void)testInterruptIfExpiredThrowsIfAnyGuardingWatchdogHasExpired {
+    SLWatchdog *outerWatchdog = [[SLWatchdog alloc] initWithTimeLimit:0.2 name:@"outer"];
+    [outerWatchdog guardBlock:^{
+        [NSThread sleepForTimeInterval:0.3];
+
+        SLWatchdog *innerWatchdog = [[SLWatchdog alloc] initWithTimeLimit:10.0 name:@"inner"];
+        [innerWatchdog guardBlock:^{
+            @try {
+                [SLWatchdog interruptIfExpired];
+                STFail(@"The outer watchdog should have interrupted the block.");
+            }
+            @catch (NSException *exception) {
+                STAssertEqualObjects([exception name], SLTestTimeoutException, @"Unexpected exception thrown.");
+                STAssertTrue([[exception reason] rangeOfString:@"outer"].location != NSNotFound,
+                             @"The exception should have identified the watchdog that expired.");
+            }
+        }];
+    }];
+}
+
+- (void)testInterruptIfExpiredOnlyInterruptsTheGuardedThread {
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.1 name:@"test"];
+    [watchdog guardBlock:^{
+        [NSThread sleepForTimeInterval:0.2];
+
+        NSThread *guardedThread = [NSThread currentThread];
+        BOOL __block otherThreadWasInterrupted = NO, guardedThreadWasInterrupted = NO;
+        dispatch_queue_t otherQueue = dispatch_queue_create("com.inkling.subliminal.SLWatchdogTests.otherQueue", DISPATCH_QUEUE_SERIAL);
+        // dispatch asynchronously so that the block is guaranteed to execute on another thread
+        dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+        dispatch_async(otherQueue, ^{
+            @try {
+                [SLWatchdog interruptIfExpired];
+            }
+            @catch (NSException *exception) {
+                otherThreadWasInterrupted = YES;
+            }
+            @try {
+                [SLWatchdog interruptIfExpiredOnBehalfOfThread:guardedThread];
+            }
+            @catch (NSException *exception) {
+                guardedThreadWasInterrupted = [[exception name] isEqualToString:SLTestTimeoutException];
+            }
+            dispatch_semaphore_signal(semaphore);
+        });
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        dispatch_release(semaphore);
+        dispatch_release(otherQueue);
+
+        STAssertFalse(otherThreadWasInterrupted,
+                      @"The watchdog should not have interrupted a thread that it was not guarding.");
+        STAssertTrue(guardedThreadWasInterrupted,
+                     @"The watchdog should have interrupted code waiting on behalf of the thread it was guarding.");
+        STAssertThrowsSpecificNamed([SLWatchdog interruptIfExpired], NSException, SLTestTimeoutException,
+                                    @"The watchdog should have interrupted the block.");
+    }];
+}
+
+- (void)testGuardBlockRethrowsExceptionsAndStopsGuarding {
+    SLWatchdog *watchdog = [[SLWatchdog alloc] initWithTimeLimit:0.1 name:@"test"];
+    STAssertThrowsSpecificNamed([watchdog guardBlock:^{
+        [NSException raise:NSInternalInconsistencyException format:@"Test exception."];
+    }], NSException, NSInternalInconsistencyException, @"The block's exception should have been rethrown.");
+
+    [NSThread sleepForTimeInterval:0.2];
+    STAssertNoThrow([SLWatchdog interruptIfExpired], @"The watchdog should no longer be guarding.");
+}
+
+@end
@@ -232,3 +232,45 @@
 - (void)testOtherCase;
 
 @end
+
+
+@interface TestWithARetriedTestCase : SLTest
+
+- (void)testRetriedCase;
+- (void)testOtherCase;
+
+@end
+
+
+// shares a fixture between the tests of run group 4, and a fixture between all tests in the run,
+// recording the fixtures' set-up, use, and tear-down
+@interface AbstractTestWithSharedFixtures : SLTest
+
++ (void)setSetUpRunGroupFails:(BOOL)setUpRunGroupFails;
+
++ (NSArray *)runGroupFixturesSetUp;
++ (NSArray *)runGroupFixturesTornDown;
++ (NSArray *)suiteFixturesSetUp;
++ (NSArray *)suiteFixturesTornDown;
+
+// the fixtures that the concrete tests' `testFoo` found in use (`NSNull` if none)
++ (NSArray *)runGroupFixturesUsed;
++ (NSArray *)suiteFixturesUsed;
+
++ (void)resetFixtures;
+
+- (void)recordFixturesUsed;
+
+@end
+
+@interface TestOneWithSharedFixtures : AbstractTestWithSharedFixtures
+
+- (void)testFoo;
+
+@end
+
+@interface TestTwoWithSharedFixtures : AbstractTestWithSharedFixtures
+
+- (void)testFoo;
+
+@end
@@ -292,3 +292,97 @@
 - (void)testOtherCase {}
 
 @end
+
+
+@implementation TestWithARetriedTestCase
+
++ (NSUInteger)numberOfRetriesForTestCaseWithSelector:(SEL)testCaseSelector {
+    if (testCaseSelector == @selector(testRetriedCase)) {
+        return 2;
+    }
+    return [super numberOfRetriesForTestCaseWithSelector:testCaseSelector];
+}
+
+- (void)testRetriedCase {}
+- (void)testOtherCase {}
+
+@end
+
+
+static BOOL __setUpRunGroupFails = NO;
+static NSMutableArray *__runGroupFixturesSetUp, *__runGroupFixturesTornDown;
+static NSMutableArray *__suiteFixturesSetUp, *__suiteFixturesTornDown;
+static NSMutableArray *__runGroupFixturesUsed, *__suiteFixturesUsed;
+
+@implementation AbstractTestWithSharedFixtures
+
++ (void)setSetUpRunGroupFails:(BOOL)setUpRunGroupFails {
+    __setUpRunGroupFails = setUpRunGroupFails;
+}
+
++ (NSArray *)runGroupFixturesSetUp { return [__runGroupFixturesSetUp copy]; }
++ (NSArray *)runGroupFixturesTornDown { return [__runGroupFixturesTornDown copy]; }
++ (NSArray *)suiteFixturesSetUp { return [__suiteFixturesSetUp copy]; }
++ (NSArray *)suiteFixturesTornDown { return [__suiteFixturesTornDown copy]; }
++ (NSArray *)runGroupFixturesUsed { return [__runGroupFixturesUsed copy]; }
++ (NSArray *)suiteFixturesUsed { return [__suiteFixturesUsed copy]; }
+
++ (void)resetFixtures {
+    __setUpRunGroupFails = NO;
+    __runGroupFixturesSetUp = [[NSMutableArray alloc] init];
+    __runGroupFixturesTornDown = [[NSMutableArray alloc] init];
+    __suiteFixturesSetUp = [[NSMutableArray alloc] init];
+    __suiteFixturesTornDown = [[NSMutableArray alloc] init];
+    __runGroupFixturesUsed = [[NSMutableArray alloc] init];
+    __suiteFixturesUsed = [[NSMutableArray alloc] init];
+}
+
++ (NSUInteger)runGroup {
+    return 4;
+}
+
++ (id)setUpRunGroup {
+    if (__setUpRunGroupFails) {
+        [NSException raise:NSInternalInconsistencyException format:@"The run group fixture failed to set up."];
+    }
+    NSObject *fixture = [[NSObject alloc] init];
+    [__runGroupFixturesSetUp addObject:fixture];
+    return fixture;
+}
+
++ (void)tearDownRunGroupWithFixture:(id)fixture {
+    [__runGroupFixturesTornDown addObject:(fixture ?: [NSNull null])];
+}
+
++ (id)setUpSuite {
+    NSObject *fixture = [[NSObject alloc] init];
+    [__suiteFixturesSetUp addObject:fixture];
+    return fixture;
+}
+
++ (void)tearDownSuiteWithFixture:(id)fixture {
+    [__suiteFixturesTornDown addObject:(fixture ?: [NSNull null])];
+}
+
+- (void)recordFixturesUsed {
+    [__runGroupFixturesUsed addObject:([self runGroupFixture] ?: [NSNull null])];
+    [__suiteFixturesUsed addObject:([self suiteFixture] ?: [NSNull null])];
+}
+
+@end
+
+@implementation TestOneWithSharedFixtures
+
+- (void)testFoo {
+    [self recordFixturesUsed];
+}
+
+@end
+
+@implementation TestTwoWithSharedFixtures
+
+- (void)testFoo {
+    [self recordFixturesUsed];
+}
+
+@end